@@ -37,7 +37,7 @@
  * 
  * 5. Configuration:
  *    - Web Interface (192.168.4.1)
- *    - EEPROM Settings Storage
+ *    - Journaled Settings Storage (CRC, wear leveling)
  *    - WiFi Configuration
  *    - Real-time updates
  * 
@@ -61,32 +61,51 @@
 
 #include <ESP8266WiFi.h>
 #include <ESP8266WebServer.h>
-#include <EEPROM.h>
 #include <ArduinoJson.h>
 #include <LedControl.h>
 #include <FS.h>
 #include <SPI.h>
 #include <MaxMatrix.h>
 #include "settings.h"
+#include "framebuffer.h"
+#include "input.h"
+#include "scheduler.h"
+#include "animpack.h"
+#include "animfile.h"
+#include "textraster.h"
+#include "compositor.h"
+#include "eventqueue.h"
+#include "livestream.h"
+#include "webjson.h"
+#include "webassets.h"
+#include "configstore.h"
+#include "preset.h"
+#include "animations.h"
+#include "effects.h"
+#include "animupload.h"
+#include "profiler.h"
+#include "recorder.h"
+#include "unitsync.h"
+#include "textstore.h"
 
 // Deklarasi Fungsi
-void leftSignal();
-void rightSignal();
 void brakeLight();
 void hazardLight();
 void parkingLight();
 void customPattern(uint8_t patternIndex);
 void setBrightness(uint8_t level);
-void transitionEffect(uint8_t* oldPattern, uint8_t* newPattern);
+bool transitionEffect(const uint8_t* oldPattern, const uint8_t* newPattern);
 void policeMode();
 void runningLight();
 void nightRiderEffect();
 void strobeEffect();
-void smoothAnimation(uint8_t* pattern1, uint8_t* pattern2, uint16_t duration);
+void fadeTo(uint8_t targetLevel, uint16_t duration);
+void fadeIn(uint16_t duration);
+void fadeOut(uint16_t duration);
 
-Current Date: 2025-05-09 20:30:05 UTC
-Current User: Brodot23
-Version: STOPLAMP BRODOT v2.0
+// Current Date: 2025-05-09 20:30:05 UTC
+// Current User: Brodot23
+// Version: STOPLAMP BRODOT v2.0
 
 // Struct Definitions
 struct Settings {
@@ -100,6 +119,7 @@ struct Settings {
     bool wifiEnabled;
     uint8_t lastUsedBrakeMode;
     uint8_t lastUsedSeinMode;
+    uint8_t syncRole;       // SYNC_ROLE_*, berlaku setelah restart
 };
 
 struct AnimationSettings {
@@ -107,7 +127,7 @@ struct AnimationSettings {
     uint8_t patternCount;
     bool loopAnimation;
     uint8_t currentPattern;
-    uint8_t currentStep;
+    uint16_t currentStep;   // Geser baris di strip pola (0..frameCount*8-1)
     bool animationDirection;
 };
 
@@ -143,9 +163,12 @@ struct StateManager {
     uint8_t currentPriority;    // Current display priority
     bool isBraking;            // Brake state
     bool isSeining;            // Sein state
-    uint8_t startupMode;       // Current startup mode
+    uint8_t startupMode;       // Sub-mode combined yang sedang tampil (MODE_TEXT/MODE_ANIMATION)
     unsigned long lastStateChange; // Timestamp of last state change
     bool isInitialized;        // System initialization flag
+    uint8_t idlePhase;         // Transisi yang sedang berjalan di layer idle
+    bool autoHazard;           // Hazard dari hard brake (brakeSettings.autoHazard)
+    unsigned long autoHazardUntil;
     struct {
         uint8_t step;          // Current animation step
         bool blinkState;       // Current blink state
@@ -153,18 +176,6 @@ struct StateManager {
     } animation;
 };
 
-// Define stop text pattern with line bars
-const uint8_t STOP_TEXT[] = {
-    0x66, 0x66, 0x66, 0x66,  // Left ||
-    0x7E, 0x7E, 0x60, 0x7E,  // S
-    0x7E, 0x18, 0x18, 0x7E,  // T
-    0x7E, 0x66, 0x66, 0x66,  // O
-    0x7E, 0x62, 0x62, 0x7E,  // P
-    0x00, 0x00, 0x00, 0x00,  // Space
-    0x21, 0x21, 0x21, 0x21,  // !!!
-    0x66, 0x66, 0x66, 0x66   // Right ||
-};
-
 // Global Variables
 LedControl lc = LedControl(DIN_PIN, CLK_PIN, CS_PIN, MATRIX_COUNT);
 ESP8266WebServer server(80);
@@ -175,29 +186,71 @@ AnimationSettings animSettings;
 SeinSettings seinSettings;
 BrakeSettings brakeSettings;
 
+// Snapshot semua setting yang disimpan sebagai satu record configstore
+struct PersistedConfig {
+    Settings settings;
+    AnimationSettings animation;
+    SeinSettings sein;
+    BrakeSettings brake;
+};
+
+static_assert(sizeof(PersistedConfig) <= CONFIGSTORE_PAYLOAD_MAX, "PersistedConfig melebihi slot configstore");
+
 // Display buffers
-uint8_t displayBuffer[MATRIX_COUNT][8];
+uint8_t displayBuffer[MATRIX_COUNT][8];     // Kanvas layer yang sedang dirender
 uint8_t tempBuffer[MATRIX_COUNT][8];
-
-// Timing variables
-unsigned long lastUpdate = 0;
-unsigned long lastBlinkUpdate = 0;
-unsigned long lastScrollUpdate = 0;
-unsigned long lastAnimationUpdate = 0;
-unsigned long lastSeinUpdate = 0;
-unsigned long lastBrakeUpdate = 0;
+uint8_t compositeBuffer[MATRIX_COUNT][8];   // Hasil komposit yang di-push ke chain
+uint8_t currentLayer = LAYER_IDLE;
+bool composingFrame = false;
+
+// Render timers (scheduler.h): satu deadline absolut per sumber animasi
+#define TIMER_SCROLL 0
+#define TIMER_ANIMATION 1
+#define TIMER_MODE_SWITCH 2
+#define TIMER_SEIN 3
+#define TIMER_BRAKE 4
+#define TIMER_EFFECT 5
+#define TIMER_TRANSITION 6
+#define TIMER_CROSSFADE 7
+
+// Timer milik setiap layer compositor: layer hanya dirender saat salah satunya jatuh tempo
+#define IDLE_TIMERS ((1 << TIMER_SCROLL) | (1 << TIMER_ANIMATION) | (1 << TIMER_MODE_SWITCH) | \
+                     (1 << TIMER_EFFECT) | (1 << TIMER_TRANSITION) | (1 << TIMER_CROSSFADE))
+
+// Crossfade antar pola playlist idle (framebufferBlend dari frame komposit terakhir pola lama)
+#define CROSSFADE_IDLE 0
+#define CROSSFADE_ARMED 1       // Pola berganti, frame terakhir pola lama belum di-push
+#define CROSSFADE_READY 2       // Frame komposit berikutnya yang berubah memulai crossfade
+#define CROSSFADE_RUNNING 3
+#define CROSSFADE_FRAME_MS (TRANSITION_FADE_TIME / FB_BLEND_MAX)
+#define BRAKE_TIMERS (1 << TIMER_BRAKE)
+#define SEIN_TIMERS (1 << TIMER_SEIN)
 
 // State variables
+bool resetRequested = false;
+unsigned long resetRequestTime = 0;
 uint8_t currentTextPosition = 0;
 uint8_t currentAnimationFrame = 0;
-uint8_t currentBrakeLevel = 0;
-uint8_t currentSeinStep = 0;
-bool blinkState = false;
+AnimationState brakeAnimation;     // Player mode rem (BRAKE_ANIMATIONS)
+AnimationState seinAnimation;      // Player mode sein (SEIN_ANIMATIONS)
+EffectState idleEffect;            // Kernel prosedural entry playlist EFFECT_PLAYLIST_BASE..
+uint32_t idleEffectStarted = 0;
+uint32_t idleEffectLast = 0;      // Frame terakhir, untuk akumulator fase
+uint8_t crossfadeState = CROSSFADE_IDLE;
+uint8_t crossfadeFrom[MATRIX_COUNT][8];
+uint32_t crossfadeStart = 0;
+
+// customText di record configstore terakhir; setelah pindah preset bisa beda dengan RAM
+char storedCustomText[MAX_TEXT_LENGTH];
 
 // Function prototypes
 void loadDefaultSettings();
 void saveSettingsToEEPROM();
-void loadSettingsFromEEPROM();
+bool loadSettingsFromEEPROM();
+void snapshotConfig(PersistedConfig* config);
+bool applyPreset(uint8_t index);
+uint8_t setCustomText(const char* text);
+void releaseCustomText(const char* stored);
 void initializeDisplay();
 void initializeWiFi();
 void initializeState();
@@ -208,6 +261,90 @@ void copyBuffer();
 void updateDisplay();
 void handleWebServer();
 
+// Display prototypes
+void displayStartupAnimation();
+void renderIdleFrame();
+void renderIdleMode();
+void displayAnimation();
+void displayAnimationFile(uint8_t entry);
+void displayAnimationEffect(uint8_t entry);
+void advanceAnimationPlaylist();
+bool playlistEntryValid(uint8_t entry);
+void displayScrollingText(const char* text, bool scroll = true);
+void displayPattern(const uint8_t* pattern);
+void clearDisplay();
+void setIntensity(uint8_t level);
+void updateAllDisplays();
+
+// Sein & brake prototypes (mode: tabel descriptor di animations.cpp)
+void readAnimationParams(AnimationParams* params);
+void renderAnimation(AnimationState* anim, const AnimationParams* params, uint8_t timer,
+                     uint8_t level, uint8_t sides);
+void playLight(uint8_t light);
+void updateSeinDisplay();
+void updateBrakeDisplay();
+void initializeBrakeMode();
+void initializeSeinMode();
+void handleInput();
+void serviceInput();
+uint8_t localSyncInputs();
+void lockAnimationPhase(uint8_t group);
+bool serviceAutoHazard();
+void serviceSerial();
+void renderPriorityFrame();
+void pushComposite();
+void pushCrossfade();
+void requestRedraw();
+void postConfigChanged(uint8_t section);
+void handleEvent(const Event* event);
+
+// Live stream prototypes (WebSocket port 81)
+void writeLiveState(JsonObject payload);
+const char* applyLiveCommand(const char* command, JsonVariant data, const char** error);
+
+// Web server prototypes
+void setupWebServer();
+void handleRoot();
+void handleGetSettings();
+void handlePostSettings();
+void handleGetAnimation();
+void handlePostAnimation();
+void handleGetBrake();
+void handlePostBrake();
+void handleGetSein();
+void handlePostSein();
+void handleGetStatus();
+void handleGetConfig();
+void handlePatchConfig();
+void handleGetPresets();
+void handlePostPreset();
+void handleApplyPreset();
+void handleDeletePreset();
+void handlePatternUpload();
+void handlePatternUploadData();
+void handleMetrics();
+void handleGetRecording();
+void handlePostRecorder();
+void handleReset();
+void handleNotFound();
+
+// Config JSON prototypes (endpoint lama dan /api/config)
+void writeSettingsJson(JsonObject out);
+void writeAnimationJson(JsonObject out);
+void writeBrakeJson(JsonObject out);
+void writeSeinJson(JsonObject out);
+void writeConfigJson(JsonObject out);
+uint8_t applySettingsJson(JsonVariant doc);
+void sendCustomTextError(uint8_t result);
+void applyAnimationJson(JsonVariant doc);
+void applyBrakeJson(JsonVariant doc);
+void applySeinJson(JsonVariant doc);
+bool parseRequestBody(JsonDocument& doc);
+
+// Pattern tables (didefinisikan di bagian bawah sketch, di PROGMEM)
+extern const TextFont scrollFont;
+extern const AnimationPack animationPack;
+
 #ifdef DEBUG
   #define DEBUG_PRINT(x) Serial.println(x)
 #else
@@ -236,160 +373,11 @@ void errorHandler(uint8_t errorCode) {
     displayPattern(errorPattern);
 }
 
-struct StoplampSettings {
-    uint8_t brightness;
-    uint8_t patternIndex;
-    uint8_t mode;
-};
-
-StoplampSettings currentSettings;
-
-// Fungsi EEPROM
-void saveSettings() {
-    // Fungsi untuk menyimpan settings ke EEPROM
-void saveSettings() {
-    // Simpan flag initialized untuk menandai EEPROM sudah terisi
-    EEPROM.write(EEPROM_INITIALIZED_ADDR, EEPROM_INITIALIZED_KEY);
-    
-    // Simpan pengaturan ke EEPROM
-    EEPROM.write(EEPROM_BRIGHTNESS_ADDR, currentSettings.brightness);
-    EEPROM.write(EEPROM_PATTERN_ADDR, currentSettings.patternIndex);
-    EEPROM.write(EEPROM_MODE_ADDR, currentSettings.mode);
-    
-    // Debug output jika DEBUG_MODE aktif
-    #ifdef DEBUG_MODE
-        Serial.println(F("Settings saved to EEPROM:"));
-        Serial.print(F("Brightness: ")); 
-        Serial.println(currentSettings.brightness);
-        Serial.print(F("Pattern: ")); 
-        Serial.println(currentSettings.patternIndex);
-        Serial.print(F("Mode: ")); 
-        Serial.println(currentSettings.mode);
-    #endif
-}
-}
-
-void loadSettings() {
-    // Fungsi untuk memuat settings dari EEPROM
-void loadSettings() {
-    // Cek apakah EEPROM sudah diinisialisasi
-    if (EEPROM.read(EEPROM_INITIALIZED_ADDR) != EEPROM_INITIALIZED_KEY) {
-        // Jika belum, gunakan default settings
-        currentSettings.brightness = 8;      // Default brightness (0-15)
-        currentSettings.patternIndex = 0;    // Default pattern
-        currentSettings.mode = 0;            // Default mode (normal)
-        
-        // Simpan default settings ke EEPROM
-        saveSettings();
-        
-        #ifdef DEBUG_MODE
-            Serial.println(F("First run - Default settings saved"));
-        #endif
-    } 
-    else {
-        // Baca settings yang tersimpan
-        currentSettings.brightness = EEPROM.read(EEPROM_BRIGHTNESS_ADDR);
-        currentSettings.patternIndex = EEPROM.read(EEPROM_PATTERN_ADDR);
-        currentSettings.mode = EEPROM.read(EEPROM_MODE_ADDR);
-        
-        // Validasi nilai yang dibaca
-        currentSettings.brightness = constrain(currentSettings.brightness, 0, 15);
-        currentSettings.patternIndex = constrain(currentSettings.patternIndex, 0, NUM_PATTERNS - 1);
-        currentSettings.mode = constrain(currentSettings.mode, 0, 5); // Sesuaikan dengan jumlah mode
-        
-        #ifdef DEBUG_MODE
-            Serial.println(F("Settings loaded from EEPROM:"));
-            Serial.print(F("Brightness: ")); 
-            Serial.println(currentSettings.brightness);
-            Serial.print(F("Pattern: ")); 
-            Serial.println(currentSettings.patternIndex);
-            Serial.print(F("Mode: ")); 
-            Serial.println(currentSettings.mode);
-        #endif
-    }
-    
-    // Terapkan settings yang dimuat
-    matrix.setIntensity(currentSettings.brightness);
-    customPattern(currentSettings.patternIndex);
-}
-}
-
-void updateSettings() {
-    // Fungsi untuk mengupdate settings
-void updateSettings(uint8_t brightness, uint8_t pattern, uint8_t mode) {
-    bool changed = false;
-    
-    // Update brightness jika berbeda
-    if (currentSettings.brightness != brightness) {
-        currentSettings.brightness = brightness;
-        matrix.setIntensity(brightness);  // Terapkan brightness baru
-        changed = true;
-    }
-    
-    // Update pattern jika berbeda
-    if (currentSettings.patternIndex != pattern) {
-        currentSettings.patternIndex = pattern;
-        customPattern(pattern);  // Terapkan pattern baru
-        changed = true;
-    }
-    
-    // Update mode jika berbeda
-    if (currentSettings.mode != mode) {
-        currentSettings.mode = mode;
-        changed = true;
-    }
-    
-    // Jika ada perubahan, simpan ke EEPROM
-    if (changed) {
-        saveSettings();
-        
-        #ifdef DEBUG_MODE
-            Serial.println(F("Settings updated:"));
-            Serial.print(F("Brightness: ")); 
-            Serial.println(currentSettings.brightness);
-            Serial.print(F("Pattern: ")); 
-            Serial.println(currentSettings.patternIndex);
-            Serial.print(F("Mode: ")); 
-            Serial.println(currentSettings.mode);
-        #endif
-    }
-}
-}
-
-void setup() {
-    Serial.begin(9600);
-    void setup() {
-    // Inisialisasi komunikasi serial untuk debugging
-    Serial.begin(9600);
-    
-    // Inisialisasi MAX7219 LED Matrix
-    matrix.init();  // Inisialisasi modul LED matrix
-    matrix.setIntensity(8);  // Set brightness default (0-15)
-    matrix.clear();  // Bersihkan display
-    
-    // Display startup animation/test
-    uint8_t startupPattern[8] = {
-        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
-    };
-    displayPattern(startupPattern);
-    delay(500);
-    matrix.clear();
-    
-    // Load settings dari EEPROM
-    loadSettings();
-    
-    #ifdef DEBUG_MODE
-        displayVersionInfo();
-        Serial.println(F("Setup completed"));
-    #endif
-}
-    loadSettings();  // Tambahkan ini
-}
-
 void setup() {
     Serial.begin(115200);
     Serial.println("\nSTOPLAMP BRODOT v2.0");
     Serial.println("Starting system initialization...");
+    profilerBegin();
     
     // Initialize SPIFFS
     if (!SPIFFS.begin()) {
@@ -399,18 +387,22 @@ void setup() {
     Serial.println("SPIFFS mounted successfully");
 
 
-    // Initialize EEPROM
-    EEPROM.begin(512);
-    Serial.println("EEPROM initialized");
+    // Cari record config terbaru di sektor EEPROM
+    configstoreInit();
+    Serial.printf("Config store: seq %u, sector %u, slot %u\n", configstoreGetStats()->sequence,
+                  configstoreGetStats()->sector, configstoreGetStats()->slot);
+    
+    // Event lane harus siap sebelum ISR input pertama
+    eventqueueInit();
     
-    // Configure input pins with internal pullup
-    pinMode(BRAKE_PIN, INPUT_PULLUP);
-    pinMode(SEIN_LEFT_PIN, INPUT_PULLUP);
-    pinMode(SEIN_RIGHT_PIN, INPUT_PULLUP);
+    // Configure input pins with internal pullup and pin-change interrupts
+    inputInit(BRAKE_PIN, SEIN_LEFT_PIN, SEIN_RIGHT_PIN);
     Serial.println("Input pins configured");
 
     // Initialize LED Matrix controllers
     initializeDisplay();
+    schedulerInit();
+    textrasterSetFont(&scrollFont);
     Serial.println("LED Matrix initialized");
 
     // Load settings or set defaults
@@ -421,6 +413,10 @@ void setup() {
     } else {
         Serial.println("Settings loaded from EEPROM");
     }
+    inputSetSensitivity(brakeSettings.sensitivity);
+    
+    // Preset dibaca sekali ke RAM, pindah preset tidak menyentuh flash
+    presetBegin(sizeof(PersistedConfig), SETTINGS_SCHEMA);
 
     // Initialize WiFi
     initializeWiFi();
@@ -428,6 +424,7 @@ void setup() {
 
     // Initialize web server endpoints
     setupWebServer();
+    livestreamBegin(compositeBuffer, MATRIX_COUNT, writeLiveState, applyLiveCommand);
     Serial.println("Web server started");
 
     // Initialize system state
@@ -438,8 +435,9 @@ void setup() {
     clearBuffer();
     clearAllDisplays();
     
-    // Display startup animation
-    displayStartupAnimation();
+    // Startup animation dijalankan loop() sebagai fase IDLE_STARTUP,
+    // web server dan input sudah aktif selama animasi
+    schedulerKick();
     
     Serial.println("Setup complete!");
     Serial.printf("Memory free: %d bytes\n", ESP.getFreeHeap());
@@ -448,9 +446,13 @@ void setup() {
 void initializeDisplay() {
     for (int i = 0; i < MATRIX_COUNT; i++) {
         lc.shutdown(i, false);
-        lc.setIntensity(i, settings.brightness);
         lc.clearDisplay(i);
     }
+    framebufferInit(DIN_PIN, CLK_PIN, CS_PIN, MATRIX_COUNT);
+    compositorInit(MATRIX_COUNT);
+    compositorSetCoverage(LAYER_IDLE, COMPOSITOR_ALL_MODULES, false);
+    compositorSetCoverage(LAYER_BRAKE, COMPOSITOR_ALL_MODULES, false);
+    setIntensity(settings.brightness);
 }
 
 void loadDefaultSettings() {
@@ -465,6 +467,7 @@ void loadDefaultSettings() {
     settings.wifiEnabled = true;
     settings.lastUsedBrakeMode = BRAKE_MODE_PROGRESSIVE;
     settings.lastUsedSeinMode = SEIN_MODE_EDGE;
+    settings.syncRole = SYNC_ROLE_HOST;
 
     // Animation settings
     animSettings.patternCount = ANIMATION_COUNT;
@@ -500,44 +503,154 @@ void loadDefaultSettings() {
 }
 
 bool loadSettingsFromEEPROM() {
-    uint32_t signature;
-    EEPROM.get(0, signature);
-    
-    if (signature != SETTINGS_SIGNATURE) {
+    PersistedConfig config;
+    if (!configstoreLoad(&config, sizeof(config), SETTINGS_SCHEMA)) {
         return false;
     }
 
-    EEPROM.get(SETTINGS_BASE_ADDR, settings);
-    EEPROM.get(ANIMATION_ADDR, animSettings);
-    EEPROM.get(SEIN_SETTINGS_ADDR, seinSettings);
-    EEPROM.get(BRAKE_SETTINGS_ADDR, brakeSettings);
-
     // Validate loaded settings
-    if (settings.brightness > MAX_BRIGHTNESS ||
-        settings.textSpeed < MIN_SPEED || settings.textSpeed > MAX_SPEED ||
-        settings.animationSpeed < MIN_SPEED || settings.animationSpeed > MAX_SPEED) {
+    if (config.settings.brightness > MAX_BRIGHTNESS ||
+        config.settings.textSpeed < MIN_SPEED || config.settings.textSpeed > MAX_SPEED ||
+        config.settings.animationSpeed < MIN_SPEED || config.settings.animationSpeed > MAX_SPEED) {
         return false;
     }
 
+    settings = config.settings;
+    animSettings = config.animation;
+    seinSettings = config.sein;
+    brakeSettings = config.brake;
+    strlcpy(storedCustomText, settings.customText, sizeof(storedCustomText));
     return true;
 }
 
+void snapshotConfig(PersistedConfig* config) {
+    memset(config, 0, sizeof(PersistedConfig));    // Padding ikut CRC, harus deterministik
+    config->settings = settings;
+    config->animation = animSettings;
+    config->sein = seinSettings;
+    config->brake = brakeSettings;
+}
+
+// Tulis langsung ke flash; perubahan dari web lewat configstoreRequestSave() (digabung)
 void saveSettingsToEEPROM() {
-    EEPROM.put(0, (uint32_t)SETTINGS_SIGNATURE);
-    EEPROM.put(SETTINGS_BASE_ADDR, settings);
-    EEPROM.put(ANIMATION_ADDR, animSettings);
-    EEPROM.put(SEIN_SETTINGS_ADDR, seinSettings);
-    EEPROM.put(BRAKE_SETTINGS_ADDR, brakeSettings);
-    EEPROM.commit();
+    PersistedConfig config;
+    snapshotConfig(&config);
+    if (!configstoreWrite(&config, sizeof(config), SETTINGS_SCHEMA)) {
+        Serial.println("Config store write failed");
+        return;
+    }
+    
+    char previous[MAX_TEXT_LENGTH];
+    strlcpy(previous, storedCustomText, sizeof(previous));
+    strlcpy(storedCustomText, settings.customText, sizeof(storedCustomText));
+    releaseCustomText(previous);
+}
+
+// Teks yang lebih panjang dari field setting tinggal di SPIFFS (textstore.h). File
+// dihapus begitu tidak dirujuk lagi oleh RAM, record configstore, atau preset mana pun.
+bool customTextReferenced(const char* stored) {
+    if (!strcmp(settings.customText, stored) || !strcmp(storedCustomText, stored)) {
+        return true;
+    }
+    for (uint8_t i = 0; i < PRESET_COUNT; i++) {
+        const PersistedConfig* config = (const PersistedConfig*)presetGet(i);
+        if (config && !strcmp(config->settings.customText, stored)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void releaseCustomText(const char* stored) {
+    if (textstoreIsRef(stored) && !customTextReferenced(stored)) {
+        textstoreRemove(stored);
+    }
+}
+
+// Hasil TEXTSTORE_*; gagal = setting tidak berubah
+uint8_t setCustomText(const char* text) {
+    char previous[MAX_TEXT_LENGTH];
+    strlcpy(previous, settings.customText, sizeof(previous));
+    uint8_t result = textstoreSet(settings.customText, sizeof(settings.customText), text);
+    if (result != TEXTSTORE_OK) {
+        return result;
+    }
+    releaseCustomText(previous);
+    textrasterBuild(text, settings.customText, MATRIX_COUNT);
+    return TEXTSTORE_OK;
+}
+
+// Pindah preset: snapshot dari RAM disalin utuh, state turunan (intensitas layer, raster
+// teks, playlist) diperbarui di sini sehingga frame berikutnya sudah memakai preset baru.
+// WiFi tidak ikut preset dan tidak ada tulis flash; config tersimpan berubah hanya
+// kalau setting diubah lagi setelahnya.
+bool applyPreset(uint8_t index) {
+    const PersistedConfig* config = (const PersistedConfig*)presetGet(index);
+    if (!config) {
+        return false;
+    }
+    
+    uint32_t start = micros();
+    bool textChanged = strcmp(settings.customText, config->settings.customText) != 0;
+    char previousText[MAX_TEXT_LENGTH];
+    strlcpy(previousText, settings.customText, sizeof(previousText));
+    bool playlistChanged = animSettings.patternCount != config->animation.patternCount ||
+                           memcmp(animSettings.selectedPatterns, config->animation.selectedPatterns,
+                                  config->animation.patternCount) != 0;
+    
+    Settings network = settings;
+    settings = config->settings;
+    strlcpy(settings.wifiSSID, network.wifiSSID, sizeof(settings.wifiSSID));
+    strlcpy(settings.wifiPass, network.wifiPass, sizeof(settings.wifiPass));
+    settings.wifiEnabled = network.wifiEnabled;
+    settings.syncRole = network.syncRole;
+    seinSettings = config->sein;
+    brakeSettings = config->brake;
+    inputSetSensitivity(brakeSettings.sensitivity);
+    
+    if (playlistChanged) {
+        animSettings = config->animation;
+        animSettings.currentPattern = 0;
+        animSettings.currentStep = 0;
+        animfileClose();
+    } else {
+        // Posisi playlist yang sedang berjalan dipertahankan
+        uint8_t pattern = animSettings.currentPattern;
+        uint16_t step = animSettings.currentStep;
+        animSettings = config->animation;
+        animSettings.currentPattern = pattern;
+        animSettings.currentStep = step;
+    }
+    
+    if (textChanged) {
+        releaseCustomText(previousText);
+        textrasterBuild(textstoreResolve(settings.customText), settings.customText, MATRIX_COUNT);
+    }
+    compositorSetIntensity(LAYER_IDLE, FB_LEVEL(settings.brightness));
+    if (compositorEnabled(LAYER_SEIN)) {
+        compositorSetIntensity(LAYER_SEIN, FB_LEVEL(seinSettings.brightness));
+    }
+    if (compositorEnabled(LAYER_BRAKE) &&
+        animationEffect(BRAKE_ANIMATIONS, BRAKE_MODE_COUNT, brakeSettings.mode) != ANIM_FX_FADE_IN) {
+        compositorSetIntensity(LAYER_BRAKE, FB_LEVEL(brakeSettings.intensity));
+    }
+    
+    requestRedraw();
+    livestreamNotifyState();
+    presetSetActive(index, micros() - start);
+    return true;
 }
 
 void initializeState() {
     stateManager.currentPriority = PRIORITY_IDLE;
     stateManager.isBraking = false;
     stateManager.isSeining = false;
-    stateManager.startupMode = settings.startupMode;
+    stateManager.startupMode = MODE_ANIMATION;  // Combined mulai dari animasi
     stateManager.lastStateChange = millis();
     stateManager.isInitialized = true;
+    stateManager.idlePhase = IDLE_STARTUP;
+    stateManager.autoHazard = false;
+    stateManager.autoHazardUntil = 0;
     stateManager.animation.step = 0;
     stateManager.animation.blinkState = false;
     stateManager.animation.lastUpdate = millis();
@@ -556,476 +669,1696 @@ void clearAllDisplays() {
     for (int i = 0; i < MATRIX_COUNT; i++) {
         lc.clearDisplay(i);
     }
+    framebufferInvalidate();
 }
 
 void displayStartupAnimation() {
     // Implementasi animasi startup
-    // Efek fade in teks "STOPLAMP BRODOT v2.0"
-    for (int brightness = 0; brightness <= settings.brightness; brightness++) {
-        for (int i = 0; i < MATRIX_COUNT; i++) {
-            lc.setIntensity(i, brightness);
-        }
-        displayScrollingText("STOPLAMP BRODOT v2.0", false);
-        delay(50);
-    }
-    delay(1000);
+    // Efek fade in teks "STOPLAMP BRODOT v2.0", lalu ditahan STARTUP_HOLD_TIME.
+    // Satu langkah per frame: fade dijalankan framebufferService(), akhir fase oleh scheduler.
+    uint32_t fadeTime = (uint32_t)STARTUP_FADE_STEP * (settings.brightness + 1);
     
-    // Reset brightness
-    for (int i = 0; i < MATRIX_COUNT; i++) {
-        lc.setIntensity(i, settings.brightness);
+    if (!schedulerActive(TIMER_TRANSITION)) {
+        compositorSetIntensity(LAYER_IDLE, 0);
+        fadeTo(settings.brightness, fadeTime);
+    }
+    if (schedulerDue(TIMER_TRANSITION, fadeTime + STARTUP_HOLD_TIME)) {
+        schedulerStop(TIMER_TRANSITION);
+        setIntensity(settings.brightness);
+        stateManager.idlePhase = IDLE_RUNNING;
+        renderIdleMode();
+        return;
     }
+    
+    displayScrollingText("STOPLAMP BRODOT v2.0", false);
 }
 
 // Display Animation Functions
 void displayAnimation() {
-    if (millis() - lastAnimationUpdate >= settings.animationSpeed) {
-        uint8_t* currentAnimationPattern = ANIMATION_PATTERNS[animSettings.selectedPatterns[animSettings.currentPattern]];
-        
-        // Update display with current frame
-        for (int i = 0; i < MATRIX_COUNT; i++) {
-            for (int row = 0; row < 8; row++) {
-                displayBuffer[i][row] = currentAnimationPattern[i * 8 + row + animSettings.currentStep];
-            }
-            updateMatrixDisplay(i);
-        }
+    uint8_t entry = animSettings.selectedPatterns[animSettings.currentPattern];
+    if (animfileIsPlaylistRef(entry)) {
+        displayAnimationFile(entry);
+        return;
+    }
+    if (effectIsPlaylistRef(entry)) {
+        displayAnimationEffect(entry);
+        return;
+    }
+    
+    // Frame pertama setelah masuk idle langsung tampil, berikutnya mengikuti deadline
+    bool firstFrame = !schedulerActive(TIMER_ANIMATION);
+    if (schedulerDue(TIMER_ANIMATION, settings.animationSpeed) || firstFrame) {
+        // Decode langsung dari flash ke displayBuffer, strip pola berulang sehingga tidak ada overrun
+        uint8_t patternIndex = animSettings.selectedPatterns[animSettings.currentPattern];
+        animpackRenderWindow(&animationPack, patternIndex, animSettings.currentStep, displayBuffer, MATRIX_COUNT);
+        updateAllDisplays();
+
+        // Satu lintasan = seluruh strip pola, panjangnya mengikuti frameCount pola ini
+        uint16_t stepCount = (uint16_t)animpackFrameCount(&animationPack, patternIndex) * FB_ROWS;
 
         // Update animation state
         if (animSettings.animationDirection) {
             animSettings.currentStep++;
-            if (animSettings.currentStep >= 16) {
+            if (animSettings.currentStep >= stepCount) {
                 if (animSettings.loopAnimation) {
-                    animSettings.currentStep = 0;
-                    animSettings.currentPattern = (animSettings.currentPattern + 1) % animSettings.patternCount;
+                    advanceAnimationPlaylist();
                 } else {
                     animSettings.animationDirection = false;
-                    animSettings.currentStep = 15;
+                    animSettings.currentStep = stepCount - 1;
                 }
             }
         } else {
-            animSettings.currentStep--;
-            if (animSettings.currentStep == 0 || animSettings.currentStep > 16) {
-                animSettings.animationDirection = true;
-                animSettings.currentStep = 0;
-                animSettings.currentPattern = (animSettings.currentPattern + 1) % animSettings.patternCount;
+            if (animSettings.currentStep == 0 || --animSettings.currentStep == 0) {
+                advanceAnimationPlaylist();
             }
         }
-        
-        lastAnimationUpdate = millis();
     }
 }
 
-// Sein Display Functions
-void updateSeinDisplay() {
-    switch (seinSettings.mode) {
-        case SEIN_MODE_BASIC:
-            displayBasicArrow();
-            break;
-        case SEIN_MODE_EDGE:
-            displayEdgeArrow();
-            break;
-        case SEIN_MODE_PROGRESSIVE:
-            displayProgressiveArrow();
-            break;
-        case SEIN_MODE_PULSE:
-            displayPulseArrow();
+void displayAnimationFile(uint8_t entry) {
+    // Biasanya sudah dibuka (dan di-prefetch) saat entry sebelumnya selesai
+    if (!animfileIsOpen() || animfileCurrentEntry() != entry) {
+        if (!animfileOpen(entry)) {
+            advanceAnimationPlaylist();
+            return;
+        }
+    }
+    
+    uint16_t period = animfileFrameDelay() ? animfileFrameDelay() : settings.animationSpeed;
+    bool firstFrame = !schedulerActive(TIMER_ANIMATION);
+    if (!schedulerDue(TIMER_ANIMATION, period) && !firstFrame) {
+        return;
+    }
+    
+    if (!animfileNextFrame(displayBuffer, MATRIX_COUNT)) {
+        animfileClose();
+        advanceAnimationPlaylist();
+        return;
+    }
+    updateAllDisplays();
+    
+    if (animfileFinished()) {
+        advanceAnimationPlaylist();
+        // Buka entry berikutnya sekarang, satu periode sebelum frame pertamanya dibutuhkan
+        uint8_t next = animSettings.selectedPatterns[animSettings.currentPattern];
+        if (animfileIsPlaylistRef(next)) {
+            animfileOpen(next);
+        } else {
+            animfileClose();
+        }
+    }
+}
+
+// Efek prosedural: tanpa data frame, satu lintasan 16 langkah x settings.animationSpeed
+// tetapi dirender per EFFECT_FRAME_INTERVAL.
+void displayAnimationEffect(uint8_t entry) {
+    uint32_t now = millis();
+    bool firstFrame = !schedulerActive(TIMER_ANIMATION);
+    if (animSettings.currentStep == 0) {
+        effectBeginPreset(&idleEffect, entry, MATRIX_COUNT, micros());
+        idleEffectStarted = now;
+        idleEffectLast = now;
+        animSettings.currentStep = 1;
+        firstFrame = true;
+    }
+    if (!schedulerDue(TIMER_ANIMATION, EFFECT_FRAME_INTERVAL) && !firstFrame) {
+        return;
+    }
+    
+    if (now - idleEffectStarted >= 16UL * settings.animationSpeed) {
+        setIntensity(settings.brightness);
+        advanceAnimationPlaylist();
+        return;
+    }
+    
+    effectAdvance(&idleEffect, now - idleEffectLast);
+    idleEffectLast = now;
+    effectRender(&idleEffect, displayBuffer);
+    // Fade combined mode memegang intensitas layer idle, kernel hanya mengatur di luar fade
+    if (stateManager.idlePhase == IDLE_RUNNING) {
+        setIntensity(((uint16_t)settings.brightness * idleEffect.level + EFFECT_LEVEL_MAX / 2) / EFFECT_LEVEL_MAX);
+    }
+    updateAllDisplays();
+}
+
+// Entry playlist: pola bawaan, kernel prosedural, atau pola upload yang ada di SPIFFS.
+// Dipakai semua jalur yang menyimpan playlist (POST /animation dan WebSocket).
+bool playlistEntryValid(uint8_t entry) {
+    return entry < ANIMATION_COUNT || effectIsPlaylistRef(entry) || animfileExists(entry);
+}
+
+void advanceAnimationPlaylist() {
+    // Pola berikutnya masuk dengan crossfade selama layer idle yang teratas
+    if (animSettings.patternCount > 1 && compositorTopLayer() == LAYER_IDLE) {
+        crossfadeState = CROSSFADE_ARMED;
+    }
+    animSettings.animationDirection = true;
+    animSettings.currentStep = 0;
+    animSettings.currentPattern = (animSettings.currentPattern + 1) % animSettings.patternCount;
+}
+
+// Sein & Brake Display Functions
+// Perilaku setiap mode ada di tabel descriptor animations.cpp; di sini hanya parameter
+// dari setting, efek intensitas dan coverage layer.
+void readAnimationParams(AnimationParams* params) {
+    params->value[ANIM_PARAM_NONE] = 0;
+    params->value[ANIM_PARAM_SEIN_SPEED] = seinSettings.speed;
+    params->value[ANIM_PARAM_SEIN_EDGE_SPEED] = seinSettings.edgeSpeed;
+    params->value[ANIM_PARAM_SEIN_STEP_DELAY] = seinSettings.progressive.delay;
+    params->value[ANIM_PARAM_SEIN_STEPS] = seinSettings.progressive.steps;
+    params->value[ANIM_PARAM_BRAKE_STEP_DELAY] = brakeSettings.progressive.delay;
+    params->value[ANIM_PARAM_BRAKE_STEPS] = brakeSettings.progressive.steps;
+}
+
+// Satu langkah animasi layer yang sedang dirender (currentLayer), level = intensitas layer
+void renderAnimation(AnimationState* anim, const AnimationParams* params, uint8_t timer,
+                     uint8_t level, uint8_t sides) {
+    bool stepped = false;
+    uint16_t period = animationPeriod(anim, params);
+    if (period && schedulerDue(timer, period)) {
+        stepped = animationAdvance(anim, params);
+    }
+    
+    switch (anim->desc.effect) {
+        case ANIM_FX_LEVEL:
+            setIntensity(animationLevel(anim, params, level));
             break;
-        case SEIN_MODE_DOUBLE:
-            displayDoubleArrow();
+        case ANIM_FX_PULSE:
+            if (stepped) {
+                setIntensity(animationLevel(anim, params, level));
+            }
             break;
-        case SEIN_MODE_RUNNING:
-            displayRunningLight();
+        case ANIM_FX_FADE_IN:
+            // Level pecahan di-dither oleh framebufferService(), render tidak perlu dijadwalkan
+            if (!anim->started) {
+                compositorSetIntensity(currentLayer, 0);
+                compositorFadeIntensity(currentLayer, FB_LEVEL(level), FADE_STEP_TIME * (level + 1));
+            }
             break;
     }
+    anim->started = true;
+    
+    animationRender(anim, params, displayBuffer, MATRIX_COUNT, sides);
+    updateAllDisplays();
 }
 
-void displayBasicArrow() {
-    static const uint8_t arrowPattern[8] = {
-        0b00011000,
-        0b00111100,
-        0b01111110,
-        0b11111111,
-        0b01111110,
-        0b00111100,
-        0b00011000,
-        0b00000000
-    };
-
-    clearBuffer();
+void updateSeinDisplay() {
+    AnimationParams params;
+    readAnimationParams(&params);
+    animationSelect(&seinAnimation, SEIN_ANIMATIONS, SEIN_MODE_COUNT, seinSettings.mode);
     
-    if (millis() - lastSeinUpdate >= seinSettings.speed) {
-        blinkState = !blinkState;
-        lastSeinUpdate = millis();
+    uint8_t sides = 0;
+    if (seinSettings.direction == 'L' || seinSettings.direction == 'H') {
+        sides |= ANIM_SIDE_LEFT;
+    }
+    if (seinSettings.direction == 'R' || seinSettings.direction == 'H') {
+        sides |= ANIM_SIDE_RIGHT;
     }
+    
+    // Sein menutup modul terluar di sisi aktif; modul lain tetap menampilkan rem/idle.
+    // Running light hanya menutup piksel yang menyala.
+    bool pixelCoverage;
+    uint16_t moduleMask = animationCoverage(&seinAnimation, &params, MATRIX_COUNT, sides, &pixelCoverage);
+    compositorSetCoverage(LAYER_SEIN, moduleMask, pixelCoverage);
+    
+    renderAnimation(&seinAnimation, &params, TIMER_SEIN, seinSettings.brightness, sides);
+}
 
-    if (blinkState) {
-        if (seinSettings.direction == 'L' || seinSettings.direction == 'H') {
-            for (int row = 0; row < 8; row++) {
-                displayBuffer[0][row] = arrowPattern[row];
-            }
-        }
-        if (seinSettings.direction == 'R' || seinSettings.direction == 'H') {
-            for (int row = 0; row < 8; row++) {
-                displayBuffer[7][row] = reverseByte(arrowPattern[row]);
-            }
+void updateBrakeDisplay() {
+    AnimationParams params;
+    readAnimationParams(&params);
+    animationSelect(&brakeAnimation, BRAKE_ANIMATIONS, BRAKE_MODE_COUNT, brakeSettings.mode);
+    renderAnimation(&brakeAnimation, &params, TIMER_BRAKE, brakeSettings.intensity, ANIM_SIDE_BOTH);
+}
+
+// Utility Functions for Display
+void displayPattern(const uint8_t* pattern) {
+    // Pola 8 baris yang sama di semua modul
+    for (int i = 0; i < MATRIX_COUNT; i++) {
+        for (int row = 0; row < 8; row++) {
+            displayBuffer[i][row] = pattern[row];
         }
     }
+    updateAllDisplays();
+}
 
+void clearDisplay() {
+    clearBuffer();
     updateAllDisplays();
 }
 
-void displayEdgeArrow() {
-    static const uint8_t edgePattern[16] = {
-        0b10000000, 0b11000000, 0b11100000, 0b11110000,
-        0b11111000, 0b11111100, 0b11111110, 0b11111111,
-        0b11111111, 0b11111110, 0b11111100, 0b11111000,
-        0b11110000, 0b11100000, 0b11000000, 0b10000000
-    };
+void setIntensity(uint8_t level) {
+    // Intensitas layer yang sedang dirender, berlaku di modul yang dimiliki layer itu
+    compositorSetIntensity(currentLayer, FB_LEVEL(min(level, (uint8_t)MAX_BRIGHTNESS)));
+}
 
-    if (millis() - lastSeinUpdate >= seinSettings.edgeSpeed) {
-        currentSeinStep = (currentSeinStep + 1) % 16;
-        lastSeinUpdate = millis();
+void updateAllDisplays() {
+    // displayBuffer menjadi isi layer aktif; di dalam renderPriorityFrame()
+    // komposit dan push dilakukan sekali setelah semua layer dirender
+    compositorCommit(currentLayer, displayBuffer);
+    if (!composingFrame) {
+        pushComposite();
     }
+}
 
-    clearBuffer();
+void pushComposite() {
+    // Hanya baris yang berubah yang dikirim, satu pulsa CS per baris untuk seluruh chain
+    uint32_t start = profilerNow();
+    bool changed = compositorCompose(compositeBuffer);
+    
+    if (crossfadeState != CROSSFADE_IDLE && compositorTopLayer() != LAYER_IDLE) {
+        // Rem/sein menutup idle: crossfade dibatalkan, frame komposit langsung tampil
+        crossfadeState = CROSSFADE_IDLE;
+        schedulerStop(TIMER_CROSSFADE);
+        changed = true;
+    }
+    if (crossfadeState == CROSSFADE_READY && changed) {
+        crossfadeState = CROSSFADE_RUNNING;
+        crossfadeStart = millis();
+        schedulerStart(TIMER_CROSSFADE, CROSSFADE_FRAME_MS);
+    }
+    
+    if (crossfadeState == CROSSFADE_RUNNING) {
+        pushCrossfade();
+    } else if (changed) {
+        framebufferPush(compositeBuffer);
+    }
+    
+    if (crossfadeState == CROSSFADE_ARMED) {
+        // Frame terakhir pola lama sudah tampil penuh: itu sumber crossfade
+        memcpy(crossfadeFrom, compositeBuffer, sizeof(crossfadeFrom));
+        crossfadeState = CROSSFADE_READY;
+    }
+    profilerRecord(PROFILE_PUSH, start);
+}
 
-    if (seinSettings.direction == 'L' || seinSettings.direction == 'H') {
-        for (int row = 0; row < 8; row++) {
-            displayBuffer[0][row] = edgePattern[(currentSeinStep + row) % 16];
-        }
+// Satu langkah crossfade per CROSSFADE_FRAME_MS; frame pola baru yang masuk selama
+// crossfade langsung menjadi target, sumber tetap frame terakhir pola lama
+void pushCrossfade() {
+    schedulerDue(TIMER_CROSSFADE, CROSSFADE_FRAME_MS);
+    
+    uint32_t elapsed = millis() - crossfadeStart;
+    uint8_t mix = (elapsed >= TRANSITION_FADE_TIME) ? FB_BLEND_MAX :
+                  (elapsed * FB_BLEND_MAX) / TRANSITION_FADE_TIME;
+    framebufferBlend(crossfadeFrom, compositeBuffer, mix);
+    
+    if (mix >= FB_BLEND_MAX) {
+        crossfadeState = CROSSFADE_IDLE;
+        schedulerStop(TIMER_CROSSFADE);
     }
-    if (seinSettings.direction == 'R' || seinSettings.direction == 'H') {
-        for (int row = 0; row < 8; row++) {
-            displayBuffer[7][row] = reverseByte(edgePattern[(currentSeinStep + row) % 16]);
+}
+
+// Setting berubah lewat web: semua layer dirender ulang pada loop berikutnya
+void requestRedraw() {
+    compositorInvalidateAll();
+    schedulerKick();
+}
+
+// Handler HTTP hanya mengubah setting di RAM; redraw menunggu giliran di lane NORMAL
+// sehingga tidak pernah menahan edge rem/sein, tulis flash ditunda oleh configstore
+void postConfigChanged(uint8_t section) {
+    presetClearActive();
+    inputSetSensitivity(brakeSettings.sensitivity);
+    if (!eventqueuePost(EVENT_CONFIG_CHANGED, PRIORITY_NORMAL, &section, sizeof(section))) {
+        configstoreRequestSave();
+        requestRedraw();
+    }
+}
+
+// Text Display Functions
+void displayScrollingText(const char* text, bool scroll) {
+    static uint16_t textPosition = 0;
+    
+    // Raster hanya saat sumber teks berganti (atau di-invalidate oleh POST /settings)
+    if (!textrasterIsFor(text)) {
+        textrasterBuild(textstoreResolve(text), text, MATRIX_COUNT);
+        textPosition = 0;
+    }
+    
+    if (scroll && schedulerDue(TIMER_SCROLL, settings.textSpeed)) {
+        textPosition++;
+        if (textPosition >= textrasterCycleLength()) {
+            textPosition = 0;
         }
     }
 
+    // Biaya per frame tetap: MATRIX_COUNT x 8 byte digeser dari bitmap
+    textrasterRenderWindow(textPosition, displayBuffer, MATRIX_COUNT);
     updateAllDisplays();
 }
 
-// Brake Display Functions
-void updateBrakeDisplay() {
-    switch (brakeSettings.mode) {
-        case BRAKE_MODE_FULL:
-            displayFullBrake();
+// Main Loop
+void loop() {
+    uint32_t loopStart = profilerNow();
+    uint32_t start = loopStart;
+    
+    // Edge dari ISR diproses sebelum dan sesudah web server,
+    // jadi latency rem tidak bergantung pada trafik HTTP
+    serviceInput();
+    profilerRecord(PROFILE_INPUT, start);
+    
+    // Handle web client requests
+    start = profilerNow();
+    server.handleClient();
+    profilerRecord(PROFILE_WEB, start);
+    
+    start = profilerNow();
+    serviceInput();
+    profilerRecord(PROFILE_INPUT, start);
+    
+    // Render hanya saat ada deadline yang jatuh tempo (atau diminta lewat schedulerKick)
+    if (schedulerFrameDue()) {
+        renderPriorityFrame();
+    }
+    
+    // Waktu sisa sebelum deadline berikutnya dipakai untuk membaca frame animasi file
+    animfilePrefetch();
+    
+    // Fade dan temporal dithering berjalan di antara frame, tanpa render ulang
+    framebufferService();
+    
+    // Perekam (jika aktif): input dan frame yang berubah sejak iterasi sebelumnya
+    recorderCapture(compositeBuffer, inputGetLevels());
+    recorderService();
+    
+    // State dan mirror ke klien WebSocket, dibatasi fps sehingga tidak bersaing dengan render
+    start = profilerNow();
+    livestreamService();
+    profilerRecord(PROFILE_LIVESTREAM, start);
+    
+    // Perubahan config beruntun digabung menjadi satu record flash
+    if (configstoreSaveDue()) {
+        start = profilerNow();
+        saveSettingsToEEPROM();
+        profilerRecord(PROFILE_CONFIG_SAVE, start);
+    }
+    
+    serviceSerial();
+    
+    if (resetRequested && millis() - resetRequestTime >= RESET_RESTART_DELAY) {
+        if (configstorePending()) {
+            saveSettingsToEEPROM();
+        }
+        ESP.restart();
+    }
+    
+    profilerSampleHeap();
+    profilerRecord(PROFILE_LOOP, loopStart);
+    
+    // Allow WiFi stack processing
+    yield();
+}
+
+void renderPriorityFrame() {
+    // Layer atas dirender lebih dulu: coverage-nya menentukan layer bawah yang tertutup.
+    // Layer yang tidak jatuh tempo atau tertutup penuh tidak dirender sama sekali.
+    composingFrame = true;
+    
+    if (compositorNeedsRender(LAYER_SEIN, SEIN_TIMERS)) {
+        uint32_t start = profilerNow();
+        currentLayer = LAYER_SEIN;
+        updateSeinDisplay();
+        profilerRecord(PROFILE_RENDER_SEIN, start);
+    }
+    if (compositorNeedsRender(LAYER_BRAKE, BRAKE_TIMERS)) {
+        uint32_t start = profilerNow();
+        currentLayer = LAYER_BRAKE;
+        updateBrakeDisplay();
+        profilerRecord(PROFILE_RENDER_BRAKE, start);
+    }
+    if (compositorNeedsRender(LAYER_IDLE, IDLE_TIMERS)) {
+        uint32_t start = profilerNow();
+        currentLayer = LAYER_IDLE;
+        renderIdleFrame();
+        profilerRecord(PROFILE_RENDER_IDLE, start);
+    }
+    
+    currentLayer = LAYER_IDLE;
+    composingFrame = false;
+    pushComposite();
+    schedulerFrameDone();
+}
+
+// Compositor layer idle: transisi berjalan sebagai state machine yang dilangkahkan
+// per frame. Rem/sein mengganti prioritas dan membatalkan transisi pada frame berikutnya.
+void renderIdleFrame() {
+    switch (stateManager.idlePhase) {
+        case IDLE_STARTUP:
+            displayStartupAnimation();
+            break;
+            
+        case IDLE_FADE_OUT:
+            // Mode lama tetap bergerak selama fade out
+            if (schedulerDue(TIMER_TRANSITION, TRANSITION_FADE_TIME)) {
+                // Hanya state runtime: settings.startupMode tetap MODE_COMBINED
+                stateManager.startupMode = (stateManager.startupMode == MODE_TEXT) ? 
+                                          MODE_ANIMATION : MODE_TEXT;
+                stateManager.lastStateChange = millis();
+                stateManager.idlePhase = IDLE_FADE_IN;
+                fadeIn(TRANSITION_FADE_TIME);
+            }
+            renderIdleMode();
             break;
-        case BRAKE_MODE_PROGRESSIVE:
-            displayProgressiveBrake();
+            
+        case IDLE_FADE_IN:
+            if (schedulerDue(TIMER_TRANSITION, TRANSITION_FADE_TIME)) {
+                schedulerStop(TIMER_TRANSITION);
+                stateManager.idlePhase = IDLE_RUNNING;
+            }
+            renderIdleMode();
             break;
-        case BRAKE_MODE_WARNING:
-            displayWarningBrake();
+            
+        default:
+            if (settings.startupMode == MODE_COMBINED && 
+                schedulerDue(TIMER_MODE_SWITCH, COMBINED_SWITCH_INTERVAL)) {
+                stateManager.idlePhase = IDLE_FADE_OUT;
+                fadeOut(TRANSITION_FADE_TIME);
+                schedulerDue(TIMER_TRANSITION, TRANSITION_FADE_TIME);
+            }
+            renderIdleMode();
             break;
-        case BRAKE_MODE_EMERGENCY:
-            displayEmergencyBrake();
+    }
+}
+
+void renderIdleMode() {
+    switch (settings.startupMode) {
+        case MODE_TEXT:
+            displayScrollingText(settings.customText);
             break;
-        case BRAKE_MODE_SMOOTH:
-            displaySmoothBrake();
+            
+        case MODE_ANIMATION:
+            displayAnimation();
             break;
-        case BRAKE_MODE_STOP_TEXT:
-            displayStopMode();
+            
+        case MODE_COMBINED:
+            if (stateManager.startupMode == MODE_TEXT) {
+                displayScrollingText(settings.customText);
+            } else {
+                displayAnimation();
+            }
             break;
     }
 }
 
-void displayFullBrake() {
-    // Fill all matrices with maximum brightness
-    for (int i = 0; i < MATRIX_COUNT; i++) {
-        lc.setIntensity(i, brakeSettings.intensity);
-        for (int row = 0; row < 8; row++) {
-            displayBuffer[i][row] = 0xFF;
+// Input Handling
+void serviceInput() {
+    // Lane CRITICAL/HIGH dulu: edge ISR hanya timestamp, level stabil sudah diputuskan
+    // integrator di ISR timer1 (tidak menunggu loop())
+    Event event;
+    while (eventqueueTake(&event, PRIORITY_HIGH)) {
+        if (!inputTakeEdge(&event)) {
+            handleEvent(&event);
+        }
+    }
+    
+    uint8_t edges = inputTakeChanges();
+    if (serviceAutoHazard()) {
+        edges |= INPUT_EDGE_SEIN_LEFT | INPUT_EDGE_SEIN_RIGHT;
+    }
+    
+    // State lokal dikirim ke unit lain sebelum frame sendiri di-render,
+    // lalu state unit lain digabung seperti edge lokal
+    unitsyncPublish(localSyncInputs());
+    uint8_t sync = unitsyncService();
+    
+    if (edges || (sync & SYNC_CHANGED_INPUTS)) {
+        handleInput();
+    }
+    if (sync & SYNC_CHANGED_PHASE) {
+        if (stateManager.isSeining) {
+            lockAnimationPhase(SYNC_GROUP_SEIN);
+        }
+        if (stateManager.isBraking) {
+            lockAnimationPhase(SYNC_GROUP_BRAKE);
+        }
+    }
+    if (edges || (sync & SYNC_CHANGED_INPUTS)) {
+        // Preemptive push: frame untuk state baru langsung di-latch tanpa menunggu renderer
+        renderPriorityFrame();
+        inputMarkLatched(edges);
+    }
+    
+    // Event config (simpan EEPROM, redraw) baru diproses setelah frame rem/sein ter-latch.
+    // Take ini juga mengambil lane HIGH/CRITICAL: edge yang di-post ISR selama render harus
+    // lewat inputTakeEdge, kalau tidak channel itu tidak pernah mem-post edge lagi.
+    while (eventqueueTake(&event, PRIORITY_LOW)) {
+        if (!inputTakeEdge(&event)) {
+            handleEvent(&event);
         }
     }
-    updateAllDisplays();
 }
 
-void displayProgressiveBrake() {
-    static uint8_t currentLevel = 0;
-    static unsigned long lastProgressiveUpdate = 0;
-
-    if (millis() - lastProgressiveUpdate >= brakeSettings.progressive.delay) {
-        if (currentLevel < brakeSettings.progressive.steps) {
-            currentLevel++;
+// Level stabil input lokal dalam SYNC_INPUT_* (bit channel sama dengan INPUT_EDGE_*)
+uint8_t localSyncInputs() {
+    uint8_t inputs = (inputGetLevels() >> 4) & (SYNC_INPUT_BRAKE | SYNC_INPUT_SEIN_LEFT | SYNC_INPUT_SEIN_RIGHT);
+    if (stateManager.autoHazard) {
+        inputs |= SYNC_INPUT_HAZARD;
+    }
+    return inputs;
+}
+
+// Pumping rem (hard brake) menyalakan hazard selama rem ditahan + AUTO_HAZARD_TIME.
+// Return true jika state hazard berubah dan sein perlu di-render ulang.
+bool serviceAutoHazard() {
+    unsigned long now = millis();
+    if (inputTakeHardBrake() && brakeSettings.autoHazard) {
+        stateManager.autoHazardUntil = now + AUTO_HAZARD_TIME;
+        if (!stateManager.autoHazard) {
+            stateManager.autoHazard = true;
+            return true;
+        }
+    }
+    if (!stateManager.autoHazard) {
+        return false;
+    }
+    if (inputActive(INPUT_BRAKE)) {
+        stateManager.autoHazardUntil = now + AUTO_HAZARD_TIME;
+    } else if ((long)(now - stateManager.autoHazardUntil) >= 0 || !brakeSettings.autoHazard) {
+        stateManager.autoHazard = false;
+        return true;
+    }
+    return false;
+}
+
+// Perintah satu karakter dari Serial Monitor: dump metrics profiler atau reset histogram
+void serviceSerial() {
+    while (Serial.available() > 0) {
+        int command = Serial.read();
+        if (command == PROFILE_SERIAL_DUMP) {
+            profilerWriteMetrics(Serial);
+        } else if (command == PROFILE_SERIAL_RESET) {
+            profilerReset();
+            Serial.println("Profiler reset");
+        }
+    }
+}
+
+void handleEvent(const Event* event) {
+    switch (event->type) {
+        case EVENT_CONFIG_CHANGED:
+            configstoreRequestSave();
+            requestRedraw();
+            livestreamNotifyState();
+            break;
+        default:
+            break;
+    }
+}
+
+void handleInput() {
+    // Level stabil dari integrator input.h (aktif LOW sudah dibalik), di-OR dengan
+    // input unit lain (unitsync.h): rem/sein di satu unit menyalakan semua unit
+    uint8_t remote = unitsyncRemoteInputs();
+    bool brakeActive = inputActive(INPUT_BRAKE) || (remote & SYNC_INPUT_BRAKE);
+    if (brakeActive != stateManager.isBraking) {
+        stateManager.isBraking = brakeActive;
+        if (brakeActive) {
+            initializeBrakeMode();
+        }
+        handlePriorityChange();
+    }
+    
+    bool leftActive = inputActive(INPUT_SEIN_LEFT) || (remote & SYNC_INPUT_SEIN_LEFT);
+    bool rightActive = inputActive(INPUT_SEIN_RIGHT) || (remote & SYNC_INPUT_SEIN_RIGHT);
+    
+    // Arah dihitung ulang setiap kali, jadi hazard -> kiri dan akhir auto hazard ikut terbaca
+    char direction = 'N';
+    if ((leftActive && rightActive) || stateManager.autoHazard || (remote & SYNC_INPUT_HAZARD)) {
+        direction = 'H';
+    } else if (leftActive) {
+        direction = 'L';
+    } else if (rightActive) {
+        direction = 'R';
+    }
+    
+    if (direction == seinSettings.direction && (direction != 'N') == stateManager.isSeining) {
+        return;
+    }
+    seinSettings.hazard = (direction == 'H');
+    seinSettings.direction = direction;
+    stateManager.isSeining = (direction != 'N');
+    if (stateManager.isSeining) {
+        initializeSeinMode();
+    } else {
+        handlePriorityChange();
+    }
+}
+
+void initializeBrakeMode() {
+    animationRestart(&brakeAnimation);
+    schedulerStop(TIMER_BRAKE);
+    lockAnimationPhase(SYNC_GROUP_BRAKE);
+    compositorInvalidate(LAYER_BRAKE);
+    settings.lastUsedBrakeMode = brakeSettings.mode;
+}
+
+void initializeSeinMode() {
+    animationRestart(&seinAnimation);
+    schedulerStop(TIMER_SEIN);
+    lockAnimationPhase(SYNC_GROUP_SEIN);
+    compositorInvalidate(LAYER_SEIN);
+    settings.lastUsedSeinMode = seinSettings.mode;
+    handlePriorityChange();
+}
+
+// Dengan unit lain aktif, langkah animasi dan deadline berikutnya dihitung dari origin
+// bersama (unitsync.h), bukan dari saat input terbaca di unit ini. Sendirian: tidak ada
+// origin, timer mulai seperti biasa pada render pertama.
+void lockAnimationPhase(uint8_t group) {
+    uint32_t origin;
+    if (!unitsyncPhaseOrigin(group, &origin)) {
+        return;
+    }
+    
+    bool sein = (group == SYNC_GROUP_SEIN);
+    AnimationState* anim = sein ? &seinAnimation : &brakeAnimation;
+    AnimationParams params;
+    readAnimationParams(&params);
+    if (sein) {
+        animationSelect(anim, SEIN_ANIMATIONS, SEIN_MODE_COUNT, seinSettings.mode);
+    } else {
+        animationSelect(anim, BRAKE_ANIMATIONS, BRAKE_MODE_COUNT, brakeSettings.mode);
+    }
+    uint16_t period = animationPeriod(anim, &params);
+    if (!period) {
+        return;
+    }
+    
+    // Origin di masa depan hanya terjadi sesaat setelah offset jam dikoreksi
+    int32_t elapsed = (int32_t)(millis() - origin);
+    uint32_t steps = elapsed > 0 ? (uint32_t)elapsed / period : 0;
+    if (animationSeek(anim, &params, steps)) {
+        compositorInvalidate(sein ? LAYER_SEIN : LAYER_BRAKE);
+    }
+    schedulerStartAt(sein ? TIMER_SEIN : TIMER_BRAKE, period, origin + (steps + 1) * period);
+}
+
+void handlePriorityChange() {
+    // Setiap input punya layer sendiri: sein di atas rem, rem di atas idle
+    if (stateManager.isBraking && !compositorEnabled(LAYER_BRAKE)) {
+        // Mode dengan fade-in (smooth) memulai fade sendiri dari gelap
+        if (animationEffect(BRAKE_ANIMATIONS, BRAKE_MODE_COUNT, brakeSettings.mode) != ANIM_FX_FADE_IN) {
+            compositorSetIntensity(LAYER_BRAKE, FB_LEVEL(brakeSettings.intensity));
+        }
+    }
+    if (stateManager.isSeining && !compositorEnabled(LAYER_SEIN)) {
+        compositorSetIntensity(LAYER_SEIN, FB_LEVEL(seinSettings.brightness));
+    }
+    compositorEnable(LAYER_BRAKE, stateManager.isBraking);
+    compositorEnable(LAYER_SEIN, stateManager.isSeining);
+    
+    // Transisi idle yang tertutup penuh (rem) tidak dilanjutkan
+    if (stateManager.idlePhase != IDLE_RUNNING && compositorOccluded(LAYER_IDLE)) {
+        stateManager.idlePhase = IDLE_RUNNING;
+        schedulerStop(TIMER_TRANSITION);
+        compositorSetIntensity(LAYER_IDLE, FB_LEVEL(settings.brightness));
+    }
+    
+    // Layer baru dirender pada kesempatan pertama
+    schedulerKick();
+    
+    // SEIN (2) > BRAKE (1) > IDLE (0), dipakai untuk status
+    uint8_t newPriority = PRIORITY_IDLE;
+    if (stateManager.isSeining) {
+        newPriority = PRIORITY_SEIN;
+    } else if (stateManager.isBraking) {
+        newPriority = PRIORITY_BRAKE;
+    }
+
+    if (newPriority == stateManager.currentPriority) {
+        return;
+    }
+
+    stateManager.currentPriority = newPriority;
+    stateManager.lastStateChange = millis();
+    livestreamNotifyState();
+}
+
+// Web Server Implementation
+void setupWebServer() {
+    // Bundle gzip dari make -C sim assets didaftarkan lebih dulu sehingga "/" dilayani dari sana
+    if (webassetsBegin(server)) {
+        Serial.printf("Web assets: %u gzip files\n", webassetsCount());
+    }
+    server.on("/", HTTP_GET, handleRoot);
+    server.on("/settings", HTTP_GET, handleGetSettings);
+    server.on("/settings", HTTP_POST, handlePostSettings);
+    server.on("/animation", HTTP_GET, handleGetAnimation);
+    server.on("/animation", HTTP_POST, handlePostAnimation);
+    server.on("/brake", HTTP_GET, handleGetBrake);
+    server.on("/brake", HTTP_POST, handlePostBrake);
+    server.on("/sein", HTTP_GET, handleGetSein);
+    server.on("/sein", HTTP_POST, handlePostSein);
+    server.on("/reset", HTTP_POST, handleReset);
+    server.on("/status", HTTP_GET, handleGetStatus);
+    server.on("/api/config", HTTP_GET, handleGetConfig);
+    server.on("/api/config", HTTP_PATCH, handlePatchConfig);
+    server.on("/api/presets", HTTP_GET, handleGetPresets);
+    server.on("/api/presets", HTTP_POST, handlePostPreset);
+    server.on("/api/presets", HTTP_DELETE, handleDeletePreset);
+    server.on("/api/presets/apply", HTTP_POST, handleApplyPreset);
+    server.on("/api/patterns", HTTP_POST, handlePatternUpload, handlePatternUploadData);
+    server.on("/metrics", HTTP_GET, handleMetrics);
+    server.on("/api/recorder", HTTP_GET, handleGetRecording);
+    server.on("/api/recorder", HTTP_POST, handlePostRecorder);
+    
+    server.onNotFound(handleNotFound);
+    webjsonBegin(server);
+    server.begin();
+}
+
+// Fallback tanpa bundle web: index.html mentah, tanpa cache
+void handleRoot() {
+    if (!SPIFFS.exists("/index.html")) {
+        server.send(404, "text/plain", "File not found");
+        return;
+    }
+    
+    File file = SPIFFS.open("/index.html", "r");
+    server.streamFile(file, "text/html");
+    file.close();
+}
+
+// Config JSON
+// Satu writer dan satu parser per struct, dipakai endpoint lama dan /api/config
+void writeSettingsJson(JsonObject out) {
+    out["startupMode"] = settings.startupMode;
+    out["brightness"] = settings.brightness;
+    out["textSpeed"] = settings.textSpeed;
+    out["animationSpeed"] = settings.animationSpeed;
+    out["customText"] = textstoreResolve(settings.customText);
+    out["wifiEnabled"] = settings.wifiEnabled;
+    out["syncRole"] = settings.syncRole;
+}
+
+void writeAnimationJson(JsonObject out) {
+    out["patternCount"] = animSettings.patternCount;
+    out["loopAnimation"] = animSettings.loopAnimation;
+    out["animationSpeed"] = settings.animationSpeed;
+    out["fileBase"] = ANIMFILE_PLAYLIST_BASE;
+    
+    JsonArray patterns = out.createNestedArray("selectedPatterns");
+    for (int i = 0; i < animSettings.patternCount; i++) {
+        patterns.add(animSettings.selectedPatterns[i]);
+    }
+}
+
+void writeBrakeJson(JsonObject out) {
+    out["mode"] = brakeSettings.mode;
+    out["level"] = brakeSettings.level;
+    out["sensitivity"] = brakeSettings.sensitivity;
+    out["intensity"] = brakeSettings.intensity;
+    out["steps"] = brakeSettings.progressive.steps;
+    out["delay"] = brakeSettings.progressive.delay;
+    out["preWarning"] = brakeSettings.preWarning;
+    out["autoHazard"] = brakeSettings.autoHazard;
+}
+
+void writeSeinJson(JsonObject out) {
+    out["mode"] = seinSettings.mode;
+    out["speed"] = seinSettings.speed;
+    out["edgeSpeed"] = seinSettings.edgeSpeed;
+    out["brightness"] = seinSettings.brightness;
+    out["steps"] = seinSettings.progressive.steps;
+    out["delay"] = seinSettings.progressive.delay;
+}
+
+// Field yang tidak ada dibiarkan, nilai di luar batas di-constrain. customText
+// diproses lebih dulu: kalau ditolak (TEXTSTORE_ERR_*) tidak ada field yang berubah.
+uint8_t applySettingsJson(JsonVariant doc) {
+    if (doc.containsKey("customText")) {
+        uint8_t result = setCustomText(doc["customText"] | "");
+        if (result != TEXTSTORE_OK) {
+            return result;
+        }
+    }
+    if (doc.containsKey("startupMode")) {
+        settings.startupMode = constrain(doc["startupMode"], MODE_TEXT, MODE_COMBINED);
+    }
+    if (doc.containsKey("brightness")) {
+        settings.brightness = constrain(doc["brightness"], 0, MAX_BRIGHTNESS);
+        setIntensity(settings.brightness);
+    }
+    if (doc.containsKey("textSpeed")) {
+        settings.textSpeed = constrain(doc["textSpeed"], MIN_SPEED, MAX_SPEED);
+    }
+    if (doc.containsKey("animationSpeed")) {
+        settings.animationSpeed = constrain(doc["animationSpeed"], MIN_SPEED, MAX_SPEED);
+    }
+    if (doc.containsKey("wifiEnabled")) {
+        settings.wifiEnabled = doc["wifiEnabled"];
+    }
+    if (doc.containsKey("syncRole")) {
+        settings.syncRole = constrain(doc["syncRole"], SYNC_ROLE_OFF, SYNC_ROLE_COUNT - 1);
+    }
+    return TEXTSTORE_OK;
+}
+
+void applyAnimationJson(JsonVariant doc) {
+    if (doc.containsKey("selectedPatterns")) {
+        JsonArray patterns = doc["selectedPatterns"];
+        uint8_t count = 0;
+        for (JsonVariant pattern : patterns) {
+            uint8_t index = pattern;
+            if (playlistEntryValid(index) && count < ANIMATION_COUNT) {
+                animSettings.selectedPatterns[count++] = index;
+            }
+        }
+        if (count > 0) {
+            animSettings.patternCount = count;
+            animSettings.currentPattern = 0;
+            animSettings.currentStep = 0;
+            animfileClose();
+        }
+    }
+    if (doc.containsKey("loopAnimation")) {
+        animSettings.loopAnimation = doc["loopAnimation"];
+    }
+    if (doc.containsKey("animationSpeed")) {
+        settings.animationSpeed = constrain(doc["animationSpeed"], MIN_SPEED, MAX_SPEED);
+    }
+}
+
+void applyBrakeJson(JsonVariant doc) {
+    if (doc.containsKey("mode")) {
+        brakeSettings.mode = constrain(doc["mode"], BRAKE_MODE_FULL, BRAKE_MODE_STOP_TEXT);
+    }
+    if (doc.containsKey("level")) {
+        brakeSettings.level = constrain(doc["level"], 1, 4);
+    }
+    if (doc.containsKey("sensitivity")) {
+        brakeSettings.sensitivity = constrain(doc["sensitivity"], 1, 5);
+    }
+    if (doc.containsKey("intensity")) {
+        brakeSettings.intensity = constrain(doc["intensity"], 1, MAX_BRIGHTNESS);
+    }
+    if (doc.containsKey("steps")) {
+        brakeSettings.progressive.steps = constrain(doc["steps"], 3, 5);
+    }
+    if (doc.containsKey("delay")) {
+        brakeSettings.progressive.delay = constrain(doc["delay"], MIN_SPEED, MAX_SPEED);
+    }
+    if (doc.containsKey("preWarning")) {
+        brakeSettings.preWarning = doc["preWarning"];
+    }
+    if (doc.containsKey("autoHazard")) {
+        brakeSettings.autoHazard = doc["autoHazard"];
+    }
+}
+
+void applySeinJson(JsonVariant doc) {
+    if (doc.containsKey("mode")) {
+        seinSettings.mode = constrain(doc["mode"], SEIN_MODE_BASIC, SEIN_MODE_RUNNING);
+    }
+    if (doc.containsKey("speed")) {
+        seinSettings.speed = constrain(doc["speed"], MIN_SPEED, MAX_SPEED);
+    }
+    if (doc.containsKey("edgeSpeed")) {
+        seinSettings.edgeSpeed = constrain(doc["edgeSpeed"], MIN_SPEED, MAX_SPEED);
+    }
+    if (doc.containsKey("brightness")) {
+        seinSettings.brightness = constrain(doc["brightness"], 0, MAX_BRIGHTNESS);
+    }
+    if (doc.containsKey("steps")) {
+        seinSettings.progressive.steps = constrain(doc["steps"], 1, MATRIX_COUNT / 2);
+    }
+    if (doc.containsKey("delay")) {
+        seinSettings.progressive.delay = constrain(doc["delay"], MIN_SPEED, MAX_SPEED);
+    }
+}
+
+// Body POST/PATCH: false = respons 400 sudah dikirim
+bool parseRequestBody(JsonDocument& doc) {
+    if (!server.hasArg("plain")) {
+        server.send(400, "text/plain", "Missing body");
+        return false;
+    }
+    
+    DeserializationError error = deserializeJson(doc, server.arg("plain"));
+    if (error || !doc.is<JsonObject>()) {
+        server.send(400, "text/plain", "Invalid JSON");
+        return false;
+    }
+    return true;
+}
+
+// customText ditolak applySettingsJson()
+void sendCustomTextError(uint8_t result) {
+    if (result == TEXTSTORE_ERR_TOO_LONG) {
+        server.send(413, "text/plain", "customText too long");
+    } else {
+        server.send(507, "text/plain", "customText write failed");
+    }
+}
+
+void handleGetSettings() {
+    StaticJsonDocument<512> doc;
+    writeSettingsJson(doc.to<JsonObject>());
+    webjsonSendCached(server, doc);
+}
+
+void handlePostSettings() {
+    StaticJsonDocument<512> doc;
+    if (!parseRequestBody(doc)) {
+        return;
+    }
+    
+    uint8_t result = applySettingsJson(doc.as<JsonVariant>());
+    if (result != TEXTSTORE_OK) {
+        sendCustomTextError(result);
+        return;
+    }
+    postConfigChanged(CONFIG_SECTION_SETTINGS);
+    server.send(200, "text/plain", "Settings updated");
+}
+
+void handleGetAnimation() {
+    StaticJsonDocument<1536> doc;
+    JsonObject out = doc.to<JsonObject>();
+    writeAnimationJson(out);
+    out["currentPattern"] = animSettings.currentPattern;
+    webjsonSend(server, 200, doc);
+}
+
+void handlePostAnimation() {
+    StaticJsonDocument<1536> doc;
+    if (!parseRequestBody(doc)) {
+        return;
+    }
+    
+    applyAnimationJson(doc.as<JsonVariant>());
+    postConfigChanged(CONFIG_SECTION_ANIMATION);
+    server.send(200, "text/plain", "Animation updated");
+}
+
+void handleGetBrake() {
+    StaticJsonDocument<512> doc;
+    writeBrakeJson(doc.to<JsonObject>());
+    webjsonSendCached(server, doc);
+}
+
+void handlePostBrake() {
+    StaticJsonDocument<512> doc;
+    if (!parseRequestBody(doc)) {
+        return;
+    }
+    
+    applyBrakeJson(doc.as<JsonVariant>());
+    postConfigChanged(CONFIG_SECTION_BRAKE);
+    server.send(200, "text/plain", "Brake settings updated");
+}
+
+void handleGetSein() {
+    StaticJsonDocument<512> doc;
+    writeSeinJson(doc.to<JsonObject>());
+    webjsonSendCached(server, doc);
+}
+
+void handlePostSein() {
+    StaticJsonDocument<512> doc;
+    if (!parseRequestBody(doc)) {
+        return;
+    }
+    
+    applySeinJson(doc.as<JsonVariant>());
+    postConfigChanged(CONFIG_SECTION_SEIN);
+    server.send(200, "text/plain", "Sein settings updated");
+}
+
+// /api/config: seluruh config dalam satu resource, hanya field tersimpan (tanpa state runtime)
+// sehingga ETag stabil selama config tidak berubah
+void writeConfigJson(JsonObject out) {
+    writeSettingsJson(out.createNestedObject("settings"));
+    writeAnimationJson(out.createNestedObject("animation"));
+    writeBrakeJson(out.createNestedObject("brake"));
+    writeSeinJson(out.createNestedObject("sein"));
+}
+
+void handleGetConfig() {
+    StaticJsonDocument<CONFIG_JSON_CAPACITY> doc;
+    writeConfigJson(doc.to<JsonObject>());
+    webjsonSendCached(server, doc);
+}
+
+// Update parsial: satu parse, section yang ada diterapkan, satu commit EEPROM
+void handlePatchConfig() {
+    StaticJsonDocument<CONFIG_JSON_CAPACITY> doc;
+    if (!parseRequestBody(doc)) {
+        return;
+    }
+    
+    bool applied = false;
+    if (doc.containsKey("settings")) {
+        uint8_t result = applySettingsJson(doc["settings"]);
+        if (result != TEXTSTORE_OK) {
+            sendCustomTextError(result);
+            return;
+        }
+        applied = true;
+    }
+    if (doc.containsKey("animation")) {
+        applyAnimationJson(doc["animation"]);
+        applied = true;
+    }
+    if (doc.containsKey("brake")) {
+        applyBrakeJson(doc["brake"]);
+        applied = true;
+    }
+    if (doc.containsKey("sein")) {
+        applySeinJson(doc["sein"]);
+        applied = true;
+    }
+    if (!applied) {
+        server.send(400, "text/plain", "No config section");
+        return;
+    }
+    
+    postConfigChanged(CONFIG_SECTION_ALL);
+    
+    // Config baru + ETag-nya, klien tidak perlu GET ulang
+    doc.clear();
+    writeConfigJson(doc.to<JsonObject>());
+    char etag[WEBJSON_ETAG_LENGTH];
+    webjsonFormatEtag(webjsonHash(doc), etag);
+    webjsonSend(server, 200, doc, etag);
+}
+
+// Presets
+void writePresetsJson(JsonObject out) {
+    uint8_t active = presetActive();
+    if (active != PRESET_NONE) {
+        out["active"] = presetName(active);
+    } else {
+        out["active"] = (const char*)NULL;
+    }
+    JsonArray list = out.createNestedArray("presets");
+    for (uint8_t i = 0; i < PRESET_COUNT; i++) {
+        if (presetName(i)) {
+            list.add(presetName(i));
+        }
+    }
+}
+
+void handleGetPresets() {
+    StaticJsonDocument<512> doc;
+    writePresetsJson(doc.to<JsonObject>());
+    webjsonSend(server, 200, doc);
+}
+
+// {"name":"..."}: simpan config aktif sebagai preset (nama sama = ditimpa)
+void handlePostPreset() {
+    StaticJsonDocument<256> doc;
+    if (!parseRequestBody(doc)) {
+        return;
+    }
+    const char* name = doc["name"] | "";
+    if (!name[0] || strlen(name) >= PRESET_NAME_LENGTH) {
+        server.send(400, "text/plain", "Invalid preset name");
+        return;
+    }
+    
+    uint8_t index = presetFind(name);
+    if (index == PRESET_NONE) {
+        index = presetFreeSlot();
+    }
+    if (index == PRESET_NONE) {
+        server.send(507, "text/plain", "Preset slots full");
+        return;
+    }
+    
+    // Teks preset yang ditimpa dilepas setelah preset baru tersimpan
+    char previousText[MAX_TEXT_LENGTH] = "";
+    const PersistedConfig* previous = (const PersistedConfig*)presetGet(index);
+    if (previous) {
+        strlcpy(previousText, previous->settings.customText, sizeof(previousText));
+    }
+    
+    PersistedConfig config;
+    snapshotConfig(&config);
+    if (!presetSave(index, name, &config)) {
+        server.send(500, "text/plain", "Preset write failed");
+        return;
+    }
+    releaseCustomText(previousText);
+    
+    doc.clear();
+    writePresetsJson(doc.to<JsonObject>());
+    webjsonSend(server, 200, doc);
+}
+
+// {"name":"..."}: pindah preset, tanpa tulis flash
+void handleApplyPreset() {
+    StaticJsonDocument<256> doc;
+    if (!parseRequestBody(doc)) {
+        return;
+    }
+    if (!applyPreset(presetFind(doc["name"] | ""))) {
+        server.send(404, "text/plain", "Preset not found");
+        return;
+    }
+    
+    doc.clear();
+    writePresetsJson(doc.to<JsonObject>());
+    webjsonSend(server, 200, doc);
+}
+
+void handleDeletePreset() {
+    StaticJsonDocument<256> doc;
+    if (!parseRequestBody(doc)) {
+        return;
+    }
+    uint8_t index = presetFind(doc["name"] | "");
+    char previousText[MAX_TEXT_LENGTH] = "";
+    const PersistedConfig* previous = (const PersistedConfig*)presetGet(index);
+    if (previous) {
+        strlcpy(previousText, previous->settings.customText, sizeof(previousText));
+    }
+    if (!presetRemove(index)) {
+        server.send(404, "text/plain", "Preset not found");
+        return;
+    }
+    releaseCustomText(previousText);
+    
+    doc.clear();
+    writePresetsJson(doc.to<JsonObject>());
+    webjsonSend(server, 200, doc);
+}
+
+// Upload pola kustom (multipart, file format animfile.h): POST /api/patterns?slot=N&activate=0|1.
+// Potongan body langsung di-stream ke SPIFFS oleh animupload.h, handler ini hanya
+// dipanggil setelah body selesai.
+AnimUploadResult patternUpload;
+bool patternUploadStarted = false;  // Request ini membawa file part
+bool patternUploadOk = false;
+
+// Hasil upload hanya berlaku untuk satu request
+void resetPatternUpload() {
+    patternUploadStarted = false;
+    patternUploadOk = false;
+    memset(&patternUpload, 0, sizeof(patternUpload));
+}
+
+void handlePatternUploadData() {
+    HTTPUpload& upload = server.upload();
+    switch (upload.status) {
+        case UPLOAD_FILE_START: {
+            resetPatternUpload();
+            patternUploadStarted = true;
+            uint8_t slot = animuploadFreeSlot();
+            if (server.hasArg("slot")) {
+                long requested = server.arg("slot").toInt();
+                slot = (requested >= 0 && requested < ANIMUPLOAD_SLOT_COUNT) ? requested : ANIMUPLOAD_NONE;
+            }
+            animuploadBegin(slot);
+            break;
+        }
+        case UPLOAD_FILE_WRITE:
+            // Setelah error sisa body hanya dibuang, tidak ada tulis flash
+            animuploadWrite(upload.buf, upload.currentSize);
+            break;
+        case UPLOAD_FILE_END:
+            patternUploadOk = animuploadFinish(&patternUpload);
+            break;
+        case UPLOAD_FILE_ABORTED:
+            animuploadAbort();
+            break;
+    }
+}
+
+// Pola baru langsung masuk playlist yang sedang berjalan: entry yang sudah ada di playlist
+// cukup dibuka ulang (tanpa tulis config), entry baru disisipkan setelah pola aktif
+// (playlist penuh: menggantikan entry itu) dan playlist disimpan lewat journal
+// configstore seperti perubahan setting lain. Hasil: posisi entry di playlist.
+uint8_t activateUploadedPattern(uint8_t entry, bool activate) {
+    int16_t position = -1;
+    for (uint8_t i = 0; i < animSettings.patternCount; i++) {
+        if (animSettings.selectedPatterns[i] == entry) {
+            position = i;
+            break;
         }
-        lastProgressiveUpdate = millis();
     }
-
-    clearBuffer();
-
-    // Calculate fill level
-    uint8_t fillPattern = 0;
-    for (int i = 0; i < (8 * currentLevel / brakeSettings.progressive.steps); i++) {
-        fillPattern |= (1 << i);
+    
+    bool added = position < 0;
+    if (added && animSettings.patternCount < ANIMATION_COUNT) {
+        position = animSettings.currentPattern + 1;
+        memmove(&animSettings.selectedPatterns[position + 1], &animSettings.selectedPatterns[position],
+                animSettings.patternCount - position);
+        animSettings.selectedPatterns[position] = entry;
+        animSettings.patternCount++;
+    } else if (added) {
+        position = (animSettings.currentPattern + 1) % animSettings.patternCount;
+        animSettings.selectedPatterns[position] = entry;
     }
-
-    // Update all matrices
-    for (int i = 0; i < MATRIX_COUNT; i++) {
-        for (int row = 0; row < 8; row++) {
-            displayBuffer[i][row] = fillPattern;
-        }
+    
+    if (activate) {
+        animfileClose();
+        animSettings.currentPattern = position;
+        animSettings.currentStep = 0;
+        animSettings.animationDirection = true;
+        schedulerStop(TIMER_ANIMATION);
     }
-
-    updateAllDisplays();
+    if (added) {
+        postConfigChanged(CONFIG_SECTION_ANIMATION);
+    } else {
+        requestRedraw();
+        livestreamNotifyState();
+    }
+    return position;
 }
 
-void displayWarningBrake() {
-    static bool warningState = false;
-    static unsigned long lastWarningUpdate = 0;
-
-    if (millis() - lastWarningUpdate >= 200) {
-        warningState = !warningState;
-        lastWarningUpdate = millis();
+void handlePatternUpload() {
+    if (!patternUploadStarted) {
+        server.send(400, "text/plain", "Missing file part");
+        return;
     }
+    if (!patternUploadOk) {
+        uint8_t error = animuploadError();
+        int code = 400;
+        if (error == ANIMUPLOAD_ERR_TOO_LONG) code = 413;
+        else if (error == ANIMUPLOAD_ERR_SPACE) code = 507;
+        else if (error == ANIMUPLOAD_ERR_WRITE) code = 500;
+        server.send(code, "text/plain", animuploadErrorText(error));
+        resetPatternUpload();
+        return;
+    }
+    
+    bool activate = !server.hasArg("activate") || server.arg("activate") != "0";
+    uint8_t position = activateUploadedPattern(patternUpload.entry, activate);
+    
+    StaticJsonDocument<256> doc;
+    doc["entry"] = patternUpload.entry;
+    doc["devices"] = patternUpload.devices;
+    doc["frames"] = patternUpload.frameCount;
+    doc["frameDelay"] = patternUpload.frameDelay;
+    doc["bytes"] = patternUpload.bytes;
+    doc["replaced"] = patternUpload.replaced;
+    doc["position"] = position;
+    doc["active"] = activate;
+    doc["uploadMicros"] = animuploadGetStats()->lastMicros;
+    webjsonSend(server, patternUpload.replaced ? 200 : 201, doc);
+    resetPatternUpload();
+}
 
-    clearBuffer();
-
-    if (warningState) {
-        for (int i = 0; i < MATRIX_COUNT; i++) {
-            for (int row = 0; row < 8; row++) {
-                displayBuffer[i][row] = 0xFF;
-            }
+// Perekam frame (recorder.h): POST {"record":true|false} memulai/menghentikan ring di
+// SPIFFS, GET mengunduh kedua segmen berurutan (format biner, lihat sim/replay.cpp)
+void writeRecording(Print& out) {
+    char paths[2][RECORDER_PATH_LENGTH];
+    uint8_t count = recorderSegmentPaths(paths);
+    uint8_t block[WEBJSON_CHUNK_SIZE];
+    for (uint8_t i = 0; i < count; i++) {
+        File file = SPIFFS.open(paths[i], "r");
+        size_t n;
+        while (file && (n = file.read(block, sizeof(block))) > 0) {
+            out.write(block, n);
         }
     }
-
-    updateAllDisplays();
 }
 
-// Utility Functions for Display
-void updateMatrixDisplay(int matrix) {
-    for (int row = 0; row < 8; row++) {
-        lc.setRow(matrix, row, displayBuffer[matrix][row]);
-    }
+void writeRecorderJson(JsonObject out) {
+    const RecorderStats* stats = recorderGetStats();
+    out["active"] = recorderActive();
+    out["records"] = stats->records;
+    out["frames"] = stats->frames;
+    out["bytes"] = stats->bytes;
+    out["flushes"] = stats->flushes;
+    out["segments"] = stats->segments;
+    out["dropped"] = stats->dropped;
+    out["maxFlushMicros"] = stats->maxFlushMicros;
 }
 
-void updateAllDisplays() {
-    for (int i = 0; i < MATRIX_COUNT; i++) {
-        updateMatrixDisplay(i);
+// Unit sync: time base, unit lain yang terdengar ([id, ms sejak paket, SYNC_INPUT_*])
+void writeSyncJson(JsonObject out) {
+    const UnitSyncStats* stats = unitsyncGetStats();
+    out["role"] = settings.syncRole;
+    out["active"] = unitsyncActive();
+    out["master"] = unitsyncIsMaster();
+    out["masterId"] = stats->masterId;
+    out["offset"] = stats->offset;
+    out["sent"] = stats->sent;
+    out["received"] = stats->received;
+    out["rejected"] = stats->rejected;
+    out["duplicates"] = stats->duplicates;
+    out["sendErrors"] = stats->sendErrors;
+    out["resyncs"] = stats->resyncs;
+    out["lastLatency"] = stats->lastLatency;
+    out["maxLatency"] = stats->maxLatency;
+    
+    UnitSyncPeer peers[UNITSYNC_MAX_PEERS];
+    uint8_t count = unitsyncGetPeers(peers);
+    JsonArray list = out.createNestedArray("peers");
+    for (uint8_t i = 0; i < count; i++) {
+        JsonArray entry = list.createNestedArray();
+        entry.add(peers[i].unitId);
+        entry.add(peers[i].age);
+        entry.add(peers[i].inputs);
     }
 }
 
-uint8_t reverseByte(uint8_t b) {
-    b = (b & 0xF0) >> 4 | (b & 0x0F) << 4;
-    b = (b & 0xCC) >> 2 | (b & 0x33) << 2;
-    b = (b & 0xAA) >> 1 | (b & 0x55) << 1;
-    return b;
+void handleGetRecording() {
+    char paths[2][RECORDER_PATH_LENGTH];
+    if (recorderSegmentPaths(paths) == 0) {
+        server.send(404, "text/plain", "No recording");
+        return;
+    }
+    recorderFlush();
+    webjsonSendStream(server, 200, "application/octet-stream", writeRecording);
 }
 
-// Text Display Functions
-void displayScrollingText(const char* text, bool scroll = true) {
-    static int textPosition = 0;
-    static unsigned long lastScrollUpdate = 0;
-    
-    if (scroll && millis() - lastScrollUpdate >= settings.textSpeed) {
-        textPosition++;
-        if (textPosition >= (strlen(text) * 8)) {
-            textPosition = 0;
-        }
-        lastScrollUpdate = millis();
+void handlePostRecorder() {
+    StaticJsonDocument<256> doc;
+    if (!parseRequestBody(doc)) {
+        return;
+    }
+    if (!doc["record"].is<bool>()) {
+        server.send(400, "text/plain", "record must be true or false");
+        return;
     }
-
-    clearBuffer();
-    
-    int charIndex = textPosition / 8;
-    int charOffset = textPosition % 8;
     
-    for (int i = 0; i < MATRIX_COUNT + 1; i++) {
-        if (charIndex + i < strlen(text)) {
-            char currentChar = text[charIndex + i];
-            const uint8_t* charPattern = getCharacterPattern(currentChar);
-            
-            for (int row = 0; row < 8; row++) {
-                if (i == 0) {
-                    if (i < MATRIX_COUNT) {
-                        displayBuffer[i][row] = charPattern[row] << charOffset;
-                    }
-                } else {
-                    if (i - 1 < MATRIX_COUNT) {
-                        displayBuffer[i-1][row] |= charPattern[row] >> (8 - charOffset);
-                    }
-                }
-            }
+    if (doc["record"]) {
+        RecorderInfo info;
+        info.devices = MATRIX_COUNT;
+        info.startupMode = settings.startupMode;
+        info.seinMode = seinSettings.mode;
+        info.brakeMode = brakeSettings.mode;
+        if (!recorderBegin(&info, NULL)) {
+            server.send(500, "text/plain", "Cannot open recording");
+            return;
         }
+    } else {
+        recorderStop();
     }
     
-    updateAllDisplays();
+    doc.clear();
+    writeRecorderJson(doc.to<JsonObject>());
+    webjsonSend(server, 200, doc);
 }
 
-// Main Loop
-void loop() {
-    // Handle web client requests
-    server.handleClient();
+// Histogram profiler.h dalam format teks Prometheus (scrape interval bebas, tidak direset)
+void handleMetrics() {
+    webjsonSendStream(server, 200, "text/plain; version=0.0.4", profilerWriteMetrics);
+}
+
+void handleGetStatus() {
+    StaticJsonDocument<3584> doc;
+    const FramebufferStats* fbStats = framebufferGetStats();
     
-    // Handle input and state updates
-    handleInput();
+    doc["priority"] = stateManager.currentPriority;
+    doc["braking"] = stateManager.isBraking;
+    doc["seining"] = stateManager.isSeining;
+    doc["freeHeap"] = ESP.getFreeHeap();
     
-    // Update display based on priority
-    switch (stateManager.currentPriority) {
-        case PRIORITY_SEIN:
-            updateSeinDisplay();
-            break;
-            
-        case PRIORITY_BRAKE:
-            updateBrakeDisplay();
-            break;
-            
-        case PRIORITY_IDLE:
-            switch (settings.startupMode) {
-                case MODE_TEXT:
-                    displayScrollingText(settings.customText);
-                    break;
-                    
-                case MODE_ANIMATION:
-                    displayAnimation();
-                    break;
-                    
-                case MODE_COMBINED:
-                    if (millis() - stateManager.lastStateChange > 5000) {
-                        settings.startupMode = (settings.startupMode == MODE_TEXT) ? 
-                                              MODE_ANIMATION : MODE_TEXT;
-                        stateManager.lastStateChange = millis();
-                    }
-                    if (settings.startupMode == MODE_TEXT) {
-                        displayScrollingText(settings.customText);
-                    } else {
-                        displayAnimation();
-                    }
-                    break;
-            }
-            break;
+    JsonObject transport = doc.createNestedObject("transport");
+    transport["frames"] = fbStats->frames;
+    transport["transactions"] = fbStats->transactions;
+    transport["bytes"] = fbStats->bytes;
+    transport["rowsSkipped"] = fbStats->rowsSkipped;
+    transport["lastFrameTransactions"] = fbStats->lastFrameTransactions;
+    transport["lastFrameBytes"] = fbStats->lastFrameBytes;
+    transport["registerWrites"] = fbStats->registerWrites;
+    transport["ditherPushes"] = fbStats->ditherPushes;
+    
+    // Edge-to-latch latency dalam mikrodetik
+    static const char* const channelNames[INPUT_COUNT] = { "brake", "seinLeft", "seinRight" };
+    JsonObject latency = doc.createNestedObject("latency");
+    for (uint8_t channel = 0; channel < INPUT_COUNT; channel++) {
+        const InputLatencyStats* stats = inputGetLatency(channel);
+        JsonObject entry = latency.createNestedObject(channelNames[channel]);
+        entry["count"] = stats->count;
+        entry["min"] = stats->minMicros;
+        entry["avg"] = inputGetAverageLatency(channel);
+        entry["max"] = stats->maxMicros;
     }
     
-    // Allow WiFi stack processing
-    yield();
-}
-
-// Input Handling
-void handleInput() {
-    // Read brake input (active low)
-    bool brakeActive = !digitalRead(BRAKE_PIN);
-    if (brakeActive != stateManager.isBraking) {
-        stateManager.isBraking = brakeActive;
-        if (brakeActive) {
-            initializeBrakeMode();
-        }
-        handlePriorityChange();
+    // Integrator debounce: transisi mentah, yang diteruskan, dan bounce yang dibuang
+    JsonObject input = doc.createNestedObject("input");
+    input["hardBrakes"] = inputGetHardBrakes();
+    input["autoHazard"] = stateManager.autoHazard;
+    for (uint8_t channel = 0; channel < INPUT_COUNT; channel++) {
+        const InputFilterStats* stats = inputGetFilterStats(channel);
+        JsonObject entry = input.createNestedObject(channelNames[channel]);
+        entry["windowMs"] = inputGetWindow(channel) * INPUT_SAMPLE_INTERVAL_US / 1000;
+        entry["raw"] = stats->rawTransitions;
+        entry["accepted"] = stats->accepted;
+        entry["filtered"] = stats->filtered;
     }
     
-    // Read sein inputs (active low)
-    bool leftActive = !digitalRead(SEIN_LEFT_PIN);
-    bool rightActive = !digitalRead(SEIN_RIGHT_PIN);
+    const AnimFileStats* fileStats = animfileGetStats();
+    JsonObject animfile = doc.createNestedObject("animfile");
+    animfile["opens"] = fileStats->opens;
+    animfile["framesRead"] = fileStats->framesRead;
+    animfile["bytesRead"] = fileStats->bytesRead;
+    animfile["underruns"] = fileStats->underruns;
+    animfile["errors"] = fileStats->errors;
     
-    // Update sein state
-    if (leftActive && rightActive && !seinSettings.hazard) {
-        seinSettings.hazard = true;
-        seinSettings.direction = 'H';
-        stateManager.isSeining = true;
-        initializeSeinMode();
-    } else if (leftActive && !stateManager.isSeining) {
-        seinSettings.hazard = false;
-        seinSettings.direction = 'L';
-        stateManager.isSeining = true;
-        initializeSeinMode();
-    } else if (rightActive && !stateManager.isSeining) {
-        seinSettings.hazard = false;
-        seinSettings.direction = 'R';
-        stateManager.isSeining = true;
-        initializeSeinMode();
-    } else if (!leftActive && !rightActive && stateManager.isSeining) {
-        seinSettings.hazard = false;
-        seinSettings.direction = 'N';
-        stateManager.isSeining = false;
-        handlePriorityChange();
+    const SchedulerStats* schedStats = schedulerGetStats();
+    JsonObject scheduler = doc.createNestedObject("scheduler");
+    scheduler["frames"] = schedStats->frames;
+    scheduler["dispatches"] = schedStats->dispatches;
+    scheduler["overruns"] = schedStats->overruns;
+    scheduler["maxLateness"] = schedStats->maxLateness;
+    
+    const CompositorStats* compStats = compositorGetStats();
+    JsonObject compositor = doc.createNestedObject("compositor");
+    compositor["topLayer"] = compositorTopLayer();
+    compositor["composites"] = compStats->composites;
+    compositor["commits"] = compStats->commits;
+    compositor["unchangedCommits"] = compStats->unchangedCommits;
+    compositor["skippedRenders"] = compStats->skippedRenders;
+    
+    // Per lane: [posted, dropped, expired, maxLatency us]
+    JsonObject events = doc.createNestedObject("events");
+    const char* const laneNames[EVENT_LANE_COUNT] = { "low", "normal", "high", "critical" };
+    for (uint8_t lane = 0; lane < EVENT_LANE_COUNT; lane++) {
+        const EventLaneStats* laneStats = eventqueueGetStats((EventPriority)lane);
+        JsonArray entry = events.createNestedArray(laneNames[lane]);
+        entry.add(laneStats->posted);
+        entry.add(laneStats->dropped);
+        entry.add(laneStats->expired);
+        entry.add(laneStats->maxLatencyMicros);
     }
-}
-
-// Web Server Implementation
-void setupWebServer() {
-    server.on("/", HTTP_GET, handleRoot);
-    server.on("/settings", HTTP_GET, handleGetSettings);
-    server.on("/settings", HTTP_POST, handlePostSettings);
-    server.on("/animation", HTTP_GET, handleGetAnimation);
-    server.on("/animation", HTTP_POST, handlePostAnimation);
-    server.on("/brake", HTTP_GET, handleGetBrake);
-    server.on("/brake", HTTP_POST, handlePostBrake);
-    server.on("/sein", HTTP_GET, handleGetSein);
-    server.on("/sein", HTTP_POST, handlePostSein);
-    server.on("/reset", HTTP_POST, handleReset);
     
-    server.onNotFound(handleNotFound);
-    server.begin();
-}
-
-void handleRoot() {
-    if (!SPIFFS.exists("/index.html")) {
-        server.send(404, "text/plain", "File not found");
-        return;
+    const LiveStreamStats* liveStats = livestreamGetStats();
+    JsonObject live = doc.createNestedObject("livestream");
+    live["clients"] = livestreamClients();
+    live["subscribers"] = livestreamSubscribers();
+    live["fps"] = livestreamGetRate();
+    live["stateMessages"] = liveStats->stateMessages;
+    live["keyFrames"] = liveStats->keyFrames;
+    live["deltaFrames"] = liveStats->deltaFrames;
+    live["bytes"] = liveStats->bytes;
+    live["coalesced"] = liveStats->coalesced;
+    
+    const ConfigStoreStats* storeStats = configstoreGetStats();
+    JsonObject store = doc.createNestedObject("configstore");
+    store["sequence"] = storeStats->sequence;
+    store["sector"] = storeStats->sector;
+    store["slot"] = storeStats->slot;
+    store["pending"] = configstorePending();
+    store["saveRequests"] = storeStats->saveRequests;
+    store["writes"] = storeStats->writes;
+    store["unchanged"] = storeStats->unchanged;
+    store["erases"] = storeStats->erases;
+    store["corrupt"] = storeStats->corrupt;
+    store["verifyFailures"] = storeStats->verifyFailures;
+    
+    const TextStoreStats* textStats = textstoreGetStats();
+    JsonObject texts = doc.createNestedObject("textstore");
+    texts["writes"] = textStats->writes;
+    texts["reads"] = textStats->reads;
+    texts["removes"] = textStats->removes;
+    texts["errors"] = textStats->errors;
+    
+    const PresetStats* presetStats = presetGetStats();
+    JsonObject presets = doc.createNestedObject("preset");
+    presets["active"] = presetActive();
+    presets["switches"] = presetStats->switches;
+    presets["saves"] = presetStats->saves;
+    presets["errors"] = presetStats->errors;
+    presets["lastSwitchMicros"] = presetStats->lastSwitchMicros;
+    
+    const AnimUploadStats* uploadStats = animuploadGetStats();
+    JsonObject upload = doc.createNestedObject("upload");
+    upload["started"] = uploadStats->started;
+    upload["completed"] = uploadStats->completed;
+    upload["rejected"] = uploadStats->rejected;
+    upload["aborted"] = uploadStats->aborted;
+    upload["bytes"] = uploadStats->bytes;
+    upload["blocks"] = uploadStats->blocks;
+    upload["maxBlockMicros"] = uploadStats->maxBlockMicros;
+    upload["lastMicros"] = uploadStats->lastMicros;
+    upload["lastError"] = uploadStats->lastError;
+    
+    writeRecorderJson(doc.createNestedObject("recorder"));
+    writeSyncJson(doc.createNestedObject("sync"));
+    
+    const WebJsonStats* jsonStats = webjsonGetStats();
+    JsonObject web = doc.createNestedObject("web");
+    web["responses"] = jsonStats->responses;
+    web["notModified"] = jsonStats->notModified;
+    web["bytes"] = jsonStats->bytes;
+    
+    // Per asset: [requests, notModified, bytes, lastMicros, maxMicros]
+    JsonObject assetStats = web.createNestedObject("assets");
+    for (uint8_t i = 0; i < webassetsCount(); i++) {
+        const WebAsset* asset = webassetsGet(i);
+        JsonArray entry = assetStats.createNestedArray((const char*)asset->uri);
+        entry.add(asset->requests);
+        entry.add(asset->notModified);
+        entry.add(asset->bytes);
+        entry.add(asset->lastMicros);
+        entry.add(asset->maxMicros);
     }
     
-    File file = SPIFFS.open("/index.html", "r");
-    server.streamFile(file, "text/html");
-    file.close();
+    webjsonSend(server, 200, doc);
 }
 
-void handleGetSettings() {
-    StaticJsonDocument<512> doc;
+// Live State (WebSocket)
+// Nama field mengikuti updateUIState() di script.js
+static const char* const DISPLAY_MODE_NAMES[] = { "text", "animation", "both" };
+
+void writeLiveState(JsonObject payload) {
+    JsonObject general = payload.createNestedObject("general");
+    general["displayMode"] = DISPLAY_MODE_NAMES[settings.startupMode <= MODE_COMBINED ? settings.startupMode : MODE_TEXT];
+    general["gapDuration"] = COMBINED_SWITCH_INTERVAL;
     
-    doc["startupMode"] = settings.startupMode;
-    doc["brightness"] = settings.brightness;
-    doc["textSpeed"] = settings.textSpeed;
-    doc["animationSpeed"] = settings.animationSpeed;
-    doc["customText"] = settings.customText;
-    doc["wifiEnabled"] = settings.wifiEnabled;
+    JsonObject text = payload.createNestedObject("text");
+    text["text"] = textstoreResolve(settings.customText);
+    text["bold"] = false;
+    text["speed"] = settings.textSpeed;
     
-    String response;
-    serializeJson(doc, response);
-    server.send(200, "application/json", response);
-}
-
-void handlePostSettings() {
-    if (!server.hasArg("plain")) {
-        server.send(400, "text/plain", "Missing body");
-        return;
+    JsonObject idle = payload.createNestedObject("idle");
+    JsonArray effects = idle.createNestedArray("selectedEffects");
+    for (uint8_t i = 0; i < animSettings.patternCount; i++) {
+        effects.add(animSettings.selectedPatterns[i]);
     }
+    idle["duration"] = settings.animationSpeed;
     
-    StaticJsonDocument<512> doc;
-    DeserializationError error = deserializeJson(doc, server.arg("plain"));
+    JsonObject seinRem = payload.createNestedObject("seinRem");
+    seinRem["seinMode"] = seinSettings.mode;
+    seinRem["remMode"] = brakeSettings.mode;
+    seinRem["seinSpeed"] = seinSettings.speed;
+    seinRem["remSpeed"] = brakeSettings.progressive.delay;
     
-    if (error) {
-        server.send(400, "text/plain", "Invalid JSON");
-        return;
-    }
+    payload.createNestedObject("brightness")["brightness"] = settings.brightness;
     
-    // Update settings
-    if (doc.containsKey("startupMode")) {
-        settings.startupMode = doc["startupMode"];
+    JsonObject live = payload.createNestedObject("live");
+    live["priority"] = stateManager.currentPriority;
+    live["braking"] = stateManager.isBraking;
+    live["seining"] = stateManager.isSeining;
+    live["direction"] = String(seinSettings.direction);
+    
+    writePresetsJson(payload.createNestedObject("presets"));
+}
+
+// Perintah dari script.js: validasi sama dengan handler POST, commit lewat lane NORMAL
+const char* applyLiveCommand(const char* command, JsonVariant data, const char** error) {
+    if (!strcmp(command, "setGeneralSettings")) {
+        const char* mode = data["displayMode"] | "";
+        for (uint8_t i = 0; i <= MODE_COMBINED; i++) {
+            if (!strcmp(mode, DISPLAY_MODE_NAMES[i])) {
+                settings.startupMode = i;
+                postConfigChanged(CONFIG_SECTION_SETTINGS);
+                return "Pengaturan umum disimpan";
+            }
+        }
+        *error = "displayMode tidak valid";
+        return NULL;
     }
-    if (doc.containsKey("brightness")) {
-        settings.brightness = constrain(doc["brightness"], 0, MAX_BRIGHTNESS);
-        for (int i = 0; i < MATRIX_COUNT; i++) {
-            lc.setIntensity(i, settings.brightness);
+    if (!strcmp(command, "setTextSettings")) {
+        if (data.containsKey("text")) {
+            uint8_t result = setCustomText(data["text"] | "");
+            if (result == TEXTSTORE_ERR_TOO_LONG) {
+                *error = "Teks terlalu panjang";
+                return NULL;
+            }
+            if (result != TEXTSTORE_OK) {
+                *error = "Teks gagal disimpan";
+                return NULL;
+            }
+        }
+        if (data.containsKey("speed")) {
+            settings.textSpeed = constrain(data["speed"], MIN_SPEED, MAX_SPEED);
         }
+        postConfigChanged(CONFIG_SECTION_SETTINGS);
+        return "Teks disimpan";
     }
-    if (doc.containsKey("textSpeed")) {
-        settings.textSpeed = constrain(doc["textSpeed"], MIN_SPEED, MAX_SPEED);
+    if (!strcmp(command, "setIdleSettings")) {
+        uint8_t count = 0;
+        for (JsonVariant effect : data["selectedEffects"].as<JsonArray>()) {
+            uint8_t index = effect;
+            if (playlistEntryValid(index) && count < ANIMATION_COUNT) {
+                animSettings.selectedPatterns[count++] = index;
+            }
+        }
+        if (count > 0) {
+            animSettings.patternCount = count;
+            animSettings.currentPattern = 0;
+            animSettings.currentStep = 0;
+            animfileClose();
+        }
+        if (data.containsKey("duration")) {
+            settings.animationSpeed = constrain(data["duration"], MIN_SPEED, MAX_SPEED);
+        }
+        postConfigChanged(CONFIG_SECTION_ANIMATION);
+        return "Efek idle disimpan";
     }
-    if (doc.containsKey("animationSpeed")) {
-        settings.animationSpeed = constrain(doc["animationSpeed"], MIN_SPEED, MAX_SPEED);
+    if (!strcmp(command, "setSeinRemSettings")) {
+        if (data.containsKey("seinMode")) {
+            seinSettings.mode = constrain(data["seinMode"], SEIN_MODE_BASIC, SEIN_MODE_RUNNING);
+        }
+        if (data.containsKey("seinSpeed")) {
+            seinSettings.speed = constrain(data["seinSpeed"], MIN_SPEED, MAX_SPEED);
+        }
+        if (data.containsKey("remMode")) {
+            brakeSettings.mode = constrain(data["remMode"], BRAKE_MODE_FULL, BRAKE_MODE_STOP_TEXT);
+        }
+        if (data.containsKey("remSpeed")) {
+            brakeSettings.progressive.delay = constrain(data["remSpeed"], MIN_SPEED, MAX_SPEED);
+        }
+        // Satu event cukup: commit EEPROM menyimpan semua section
+        postConfigChanged(CONFIG_SECTION_SEIN);
+        return "Mode sein & rem disimpan";
     }
-    if (doc.containsKey("customText")) {
-        strlcpy(settings.customText, doc["customText"], MAX_TEXT_LENGTH);
+    if (!strcmp(command, "setBrightness")) {
+        if (!data.containsKey("brightness")) {
+            *error = "brightness tidak ada";
+            return NULL;
+        }
+        settings.brightness = constrain(data["brightness"], 0, MAX_BRIGHTNESS);
+        setIntensity(settings.brightness);
+        postConfigChanged(CONFIG_SECTION_SETTINGS);
+        return "Kecerahan disimpan";
     }
-    if (doc.containsKey("wifiEnabled")) {
-        settings.wifiEnabled = doc["wifiEnabled"];
+    if (!strcmp(command, "applyPreset")) {
+        if (!applyPreset(presetFind(data["name"] | ""))) {
+            *error = "Preset tidak ditemukan";
+            return NULL;
+        }
+        return "Preset aktif";
     }
-    
-    saveSettingsToEEPROM();
-    server.send(200, "text/plain", "Settings updated");
+    if (!strcmp(command, "setWiFi")) {
+        const char* ssid = data["ssid"] | "";
+        const char* password = data["password"] | "";
+        // softAP butuh password kosong atau minimal 8 karakter
+        if (!ssid[0] || (password[0] && strlen(password) < 8)) {
+            *error = "SSID/password tidak valid";
+            return NULL;
+        }
+        strlcpy(settings.wifiSSID, ssid, sizeof(settings.wifiSSID));
+        strlcpy(settings.wifiPass, password, sizeof(settings.wifiPass));
+        postConfigChanged(CONFIG_SECTION_SETTINGS);
+        return "WiFi disimpan, aktif setelah restart";
+    }
+    return NULL;
 }
 
 void handleReset() {
     server.send(200, "text/plain", "Resetting...");
-    delay(100);
     loadDefaultSettings();
     saveSettingsToEEPROM();
-    ESP.restart();
+    // Restart dari loop() setelah respons sempat terkirim
+    resetRequested = true;
+    resetRequestTime = millis();
 }
 
 void handleNotFound() {
@@ -1051,6 +2384,20 @@ void initializeWiFi() {
         return;
     }
     
+    // Unit join memakai jaringan soft-AP unit host; web interface di IP DHCP-nya
+    if (settings.syncRole == SYNC_ROLE_JOIN) {
+        WiFi.mode(WIFI_STA);
+        WiFi.begin(settings.wifiSSID, settings.wifiPass);
+        Serial.print("WiFi joining: ");
+        Serial.println(settings.wifiSSID);
+        
+        // Socket UDP tidak perlu menunggu DHCP, broadcast terbatas keluar lewat station
+        if (unitsyncBegin(ESP.getChipId(), IPAddress(255, 255, 255, 255))) {
+            Serial.printf("Unit sync: id %08X, port %u\n", ESP.getChipId(), UNITSYNC_PORT);
+        }
+        return;
+    }
+    
     WiFi.mode(WIFI_AP);
     WiFi.softAP(settings.wifiSSID, settings.wifiPass);
     
@@ -1059,10 +2406,19 @@ void initializeWiFi() {
     Serial.println(settings.wifiSSID);
     Serial.print("IP Address: ");
     Serial.println(WiFi.softAPIP());
+    
+    if (settings.syncRole == SYNC_ROLE_HOST) {
+        IPAddress ip = WiFi.softAPIP();
+        if (unitsyncBegin(ESP.getChipId(), IPAddress(ip[0], ip[1], ip[2], 255))) {
+            Serial.printf("Unit sync: id %08X, port %u\n", ESP.getChipId(), UNITSYNC_PORT);
+        }
+    }
 }
 
 // Pattern Font Definitions
-const uint8_t FONT_PATTERNS[128][8] = {
+// Glyph per kolom (bit 0 = baris atas); builder membuang kolom kosong
+// sehingga hanya font proporsional yang masuk ke flash (lihat textraster.h).
+constexpr uint8_t FONT_PATTERNS[FONT_GLYPH_COUNT][8] = {
     // Spasi
     {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // Space (32)
     
@@ -1140,8 +2496,22 @@ const uint8_t FONT_PATTERNS[128][8] = {
     {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}  // _ (95)
 };
 
+static const auto SCROLL_FONT_STORAGE PROGMEM =
+    textFontBuild<textFontSize(FONT_PATTERNS)>(FONT_PATTERNS);
+
+const TextFont scrollFont = {
+    FONT_FIRST_CHAR,
+    FONT_GLYPH_COUNT,
+    SCROLL_FONT_STORAGE.offset,
+    SCROLL_FONT_STORAGE.width,
+    SCROLL_FONT_STORAGE.columns
+};
+
 // 60 Pola Animasi
-const uint8_t ANIMATION_PATTERNS[60][64] = {
+// Sumber yang mudah dibaca; hanya dipakai encoder saat compile dan tidak masuk RAM.
+// Setiap pola adalah strip 64 baris (8 frame 8x8); pola dengan panjang berbeda bisa
+// memakai bentuk rows[] + frames[] dari animpack.h.
+constexpr uint8_t ANIMATION_PATTERNS[ANIMATION_COUNT][64] = {
     // 1. Wave Pattern
     {
         0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
@@ -1861,130 +3231,51 @@ const uint8_t ANIMATION_PATTERNS[60][64] = {
         0x3C, 0x7E, 0xFF, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C,
         0x18, 0x3C, 0x7E, 0xFF, 0xFF, 0x7E, 0x3C, 0x18
     }
+};
 
-    // Bagian 7 - Implementasi Detail Fungsi
+// Pola terkompresi (delta/run per frame) di flash
+static const auto ANIMATION_PACK_STORAGE PROGMEM =
+    animpackEncode<animpackEncodedSize(ANIMATION_PATTERNS)>(ANIMATION_PATTERNS);
 
-// Fungsi untuk lampu sein kiri
-void leftSignal() {
-    static uint8_t currentFrame = 0;
-    static uint32_t lastUpdate = 0;
-    const uint32_t interval = 500; // Interval kedipan 500ms
-    
-    if (millis() - lastUpdate >= interval) {
-        lastUpdate = millis();
-        currentFrame = !currentFrame;
-        
-        if (currentFrame) {
-            // Pola sein kiri menyala
-            uint8_t leftPattern[8] = {
-                0x00, 0x08, 0x1C, 0x3E, 0x7F, 0x3E, 0x1C, 0x08
-            };
-            displayPattern(leftPattern);
-        } else {
-            // Matikan display
-            clearDisplay();
-        }
-    }
-}
+const AnimationPack animationPack = {
+    ANIMATION_COUNT,
+    ANIMATION_PACK_STORAGE.index,
+    ANIMATION_PACK_STORAGE.data,
+    sizeof(ANIMATION_PACK_STORAGE.data)
+};
 
-// Fungsi untuk lampu sein kanan
-void rightSignal() {
-    static uint8_t currentFrame = 0;
-    static uint32_t lastUpdate = 0;
-    const uint32_t interval = 500; // Interval kedipan 500ms
-    
-    if (millis() - lastUpdate >= interval) {
-        lastUpdate = millis();
-        currentFrame = !currentFrame;
-        
-        if (currentFrame) {
-            // Pola sein kanan menyala
-            uint8_t rightPattern[8] = {
-                0x00, 0x10, 0x38, 0x7C, 0xFE, 0x7C, 0x38, 0x10
-            };
-            displayPattern(rightPattern);
-        } else {
-            // Matikan display
-            clearDisplay();
-        }
-    }
+// Bagian 7 - Implementasi Detail Fungsi
+
+// Efek lampu lama: satu baris di LIGHT_ANIMATIONS, dijalankan di layer yang sedang dirender
+void playLight(uint8_t light) {
+    static AnimationState lightAnimation;
+    AnimationParams params;
+    readAnimationParams(&params);
+    animationSelect(&lightAnimation, LIGHT_ANIMATIONS, LIGHT_COUNT, light);
+    renderAnimation(&lightAnimation, &params, TIMER_EFFECT, MAX_BRIGHTNESS, ANIM_SIDE_BOTH);
 }
 
-// Fungsi untuk lampu rem
+// Fungsi untuk lampu rem (berdenyut)
 void brakeLight() {
-    static uint8_t intensity = 0;
-    static uint32_t lastUpdate = 0;
-    const uint32_t interval = 50; // Update setiap 50ms
-    
-    if (millis() - lastUpdate >= interval) {
-        lastUpdate = millis();
-        
-        // Pola lampu rem dengan efek pulsing
-        uint8_t brakePattern[8] = {
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
-        };
-        
-        // Atur intensitas cahaya
-        setIntensity(intensity);
-        displayPattern(brakePattern);
-        
-        // Animasi pulsing
-        static bool increasing = true;
-        if (increasing) {
-            intensity = min(15, intensity + 1);
-            if (intensity >= 15) increasing = false;
-        } else {
-            intensity = max(5, intensity - 1);
-            if (intensity <= 5) increasing = true;
-        }
-    }
+    playLight(LIGHT_BRAKE_PULSE);
 }
 
 // Fungsi untuk lampu hazard
 void hazardLight() {
-    static uint8_t currentFrame = 0;
-    static uint32_t lastUpdate = 0;
-    const uint32_t interval = 500; // Interval kedipan 500ms
-    
-    if (millis() - lastUpdate >= interval) {
-        lastUpdate = millis();
-        currentFrame = !currentFrame;
-        
-        if (currentFrame) {
-            // Pola hazard menyala (kombinasi sein kiri dan kanan)
-            uint8_t hazardPattern[8] = {
-                0x00, 0x18, 0x3C, 0x7E, 0xFF, 0x7E, 0x3C, 0x18
-            };
-            displayPattern(hazardPattern);
-        } else {
-            // Matikan display
-            clearDisplay();
-        }
-    }
+    playLight(LIGHT_HAZARD);
 }
 
 // Fungsi untuk lampu parkir
 void parkingLight() {
-    static uint32_t lastUpdate = 0;
-    const uint32_t interval = 1000; // Update setiap 1 detik
-    
-    if (millis() - lastUpdate >= interval) {
-        lastUpdate = millis();
-        
-        // Pola lampu parkir (intensitas rendah)
-        uint8_t parkingPattern[8] = {
-            0x18, 0x24, 0x42, 0x81, 0x81, 0x42, 0x24, 0x18
-        };
-        
-        setIntensity(3); // Intensitas rendah
-        displayPattern(parkingPattern);
-    }
+    playLight(LIGHT_PARKING);
 }
 
 // Fungsi untuk mode custom pattern
 void customPattern(uint8_t patternIndex) {
-    if (patternIndex < NUM_PATTERNS) {
-        displayPattern(patterns[patternIndex]);
+    // Frame pertama pola, di-decode dari flash
+    AnimpackReader reader;
+    if (animpackReaderOpen(&reader, &animationPack, patternIndex) && animpackReaderNext(&reader)) {
+        displayPattern(reader.frame);
     }
 }
 
@@ -1995,150 +3286,70 @@ void setBrightness(uint8_t level) {
     }
 }
 
-// Fungsi untuk efek transisi antar pola
-void transitionEffect(uint8_t* oldPattern, uint8_t* newPattern) {
-    // Efek fade out
-    for (uint8_t i = 15; i > 0; i--) {
-        setIntensity(i);
-        displayPattern(oldPattern);
-        delay(30);
+// Fungsi fade intensitas (EFFECT_FADE_IN / EFFECT_FADE_OUT di display.h) untuk layer aktif.
+// Tidak blocking: fade dijalankan framebufferService() dari loop().
+void fadeTo(uint8_t targetLevel, uint16_t duration) {
+    if (targetLevel <= 15) {
+        compositorFadeIntensity(currentLayer, FB_LEVEL(targetLevel), duration);
     }
-    
-    // Efek fade in
-    for (uint8_t i = 0; i < 16; i++) {
-        setIntensity(i);
-        displayPattern(newPattern);
-        delay(30);
+}
+
+void fadeIn(uint16_t duration) {
+    compositorSetIntensity(currentLayer, 0);
+    fadeTo(settings.brightness, duration);
+}
+
+void fadeOut(uint16_t duration) {
+    compositorFadeIntensity(currentLayer, 0, duration);
+}
+
+// Fungsi untuk efek transisi antar pola
+// Dipanggil setiap frame sampai mengembalikan true: fade out pola lama,
+// ganti pola saat gelap, lalu fade in ke intensitas semula.
+bool transitionEffect(const uint8_t* oldPattern, const uint8_t* newPattern) {
+    static uint8_t phase = 0;
+    static uint16_t restoreLevel = 0;
+
+    switch (phase) {
+        case 0:
+            restoreLevel = compositorGetIntensity(currentLayer);
+            displayPattern(oldPattern);
+            compositorFadeIntensity(currentLayer, 0, TRANSITION_FADE_TIME);
+            phase = 1;
+            break;
+        case 1:
+            if (!compositorFading(currentLayer)) {
+                displayPattern(newPattern);
+                compositorFadeIntensity(currentLayer, restoreLevel, TRANSITION_FADE_TIME);
+                phase = 2;
+            }
+            break;
+        case 2:
+            if (!compositorFading(currentLayer)) {
+                phase = 0;
+                return true;
+            }
+            break;
     }
+    return false;
 }
 
 // Fungsi untuk mode polisi/emergency
 void policeMode() {
-    static uint8_t phase = 0;
-    static uint32_t lastUpdate = 0;
-    const uint32_t interval = 200; // Update setiap 200ms
-    
-    if (millis() - lastUpdate >= interval) {
-        lastUpdate = millis();
-        
-        switch(phase) {
-            case 0: // Biru
-                {
-                    uint8_t bluePattern[8] = {
-                        0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00
-                    };
-                    displayPattern(bluePattern);
-                }
-                break;
-                
-            case 1: // Merah
-                {
-                    uint8_t redPattern[8] = {
-                        0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF
-                    };
-                    displayPattern(redPattern);
-                }
-                break;
-                
-            case 2: // Gelap
-                clearDisplay();
-                break;
-        }
-        
-        phase = (phase + 1) % 3;
-    }
+    playLight(LIGHT_POLICE);
 }
 
 // Fungsi untuk mode running light
 void runningLight() {
-    static uint8_t position = 0;
-    static uint32_t lastUpdate = 0;
-    const uint32_t interval = 100; // Update setiap 100ms
-    
-    if (millis() - lastUpdate >= interval) {
-        lastUpdate = millis();
-        
-        uint8_t pattern[8] = {0};
-        pattern[position / 8] = (1 << (position % 8));
-        displayPattern(pattern);
-        
-        position = (position + 1) % 64; // 8x8 = 64 LED
-    }
+    playLight(LIGHT_RUNNING);
 }
 
 // Fungsi untuk mode night rider
 void nightRiderEffect() {
-    static uint8_t position = 0;
-    static bool direction = true; // true = right, false = left
-    static uint32_t lastUpdate = 0;
-    const uint32_t interval = 75; // Update setiap 75ms
-    
-    if (millis() - lastUpdate >= interval) {
-        lastUpdate = millis();
-        
-        uint8_t pattern[8] = {0};
-        for (uint8_t i = 0; i < 3; i++) { // 3 LED width
-            if ((position + i) < 8) {
-                pattern[7] |= (1 << (position + i));
-            }
-        }
-        displayPattern(pattern);
-        
-        if (direction) {
-            if (position >= 5) direction = false;
-            else position++;
-        } else {
-            if (position <= 0) direction = true;
-            else position--;
-        }
-    }
+    playLight(LIGHT_NIGHT_RIDER);
 }
 
 // Fungsi untuk mode strobo
 void strobeEffect() {
-    static bool state = false;
-    static uint32_t lastUpdate = 0;
-    const uint32_t interval = 50; // Update setiap 50ms
-    
-    if (millis() - lastUpdate >= interval) {
-        lastUpdate = millis();
-        state = !state;
-        
-        if (state) {
-            uint8_t pattern[8] = {
-                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
-            };
-            setIntensity(15); // Full brightness
-            displayPattern(pattern);
-        } else {
-            clearDisplay();
-        }
-    }
-}
-
-// Fungsi untuk mode animasi smooth
-void smoothAnimation(uint8_t* pattern1, uint8_t* pattern2, uint16_t duration) {
-    static uint32_t startTime = 0;
-    static uint32_t lastUpdate = 0;
-    const uint32_t updateInterval = 50; // Update setiap 50ms
-    
-    if (startTime == 0) startTime = millis();
-    
-    if (millis() - lastUpdate >= updateInterval) {
-        lastUpdate = millis();
-        
-        float progress = (float)(millis() - startTime) / duration;
-        if (progress > 1.0) progress = 1.0;
-        
-        uint8_t interpolatedPattern[8];
-        for (uint8_t i = 0; i < 8; i++) {
-            interpolatedPattern[i] = pattern1[i] + (pattern2[i] - pattern1[i]) * progress;
-        }
-        
-        displayPattern(interpolatedPattern);
-        
-        if (progress >= 1.0) {
-            startTime = 0; // Reset untuk animasi berikutnya
-        }
-    }
+    playLight(LIGHT_STROBE);
 }
@@ -1,266 +1,317 @@
 #include "animations.h"
+#include "bitplane.h"
 #include "settings.h"
 #include <Arduino.h>
 
 // Build Information
-#define ANIMATIONS_CPP_VERSION "1.0.0"
-#define ANIMATIONS_CPP_BUILD_DATE "2025-05-11 07:29:50"
+#define ANIMATIONS_CPP_VERSION "2.2.0"
+#define ANIMATIONS_CPP_BUILD_DATE "2026-10-18 10:26:13"
 #define ANIMATIONS_CPP_AUTHOR "Brodot23"
 
-// ===== IMPLEMENTASI FUNGSI INISIALISASI =====
-
-void initializeAnimation(AnimationState* state) {
-    state->type = ANIM_NONE;
-    state->direction = DIR_NONE;
-    state->effect = EFFECT_NONE;
-    state->currentFrame = 0;
-    state->totalFrames = 0;
-    state->delay = 0;
-    state->brightness = MAX_BRIGHTNESS;
-    state->isActive = false;
-    state->isReverse = false;
-    state->isLooping = false;
-    state->lastUpdate = 0;
-}
+// ===== SUMBER POLA =====
 
-void resetAnimation(AnimationState* state) {
-    state->currentFrame = 0;
-    state->lastUpdate = millis();
-}
+static constexpr uint8_t ARROW_GLYPH[8] = {
+    0b00011000,
+    0b00111100,
+    0b01111110,
+    0b11111111,
+    0b01111110,
+    0b00111100,
+    0b00011000,
+    0b00000000
+};
 
-// ===== IMPLEMENTASI FUNGSI KONTROL ANIMASI =====
-
-void startAnimation(AnimationState* state, AnimationType type) {
-    state->type = type;
-    state->currentFrame = 0;
-    state->totalFrames = getFrameCountForType(type);
-    state->delay = getDelayForType(type);
-    state->isActive = true;
-    state->lastUpdate = millis();
-    
-    // Set default direction based on type
-    switch(type) {
-        case ANIM_SEIN_LEFT_BASIC:
-            state->direction = DIR_LEFT;
-            break;
-        case ANIM_SEIN_RIGHT_BASIC:
-            state->direction = DIR_RIGHT;
-            break;
-        case ANIM_HAZARD_BASIC:
-        case ANIM_HAZARD_WARNING:
-            state->direction = DIR_BOTH;
-            break;
-        default:
-            state->direction = DIR_NONE;
-    }
-}
+static constexpr uint8_t DOUBLE_ARROW_GLYPH[8] = {
+    0b00010001,
+    0b00110011,
+    0b01110111,
+    0b11111111,
+    0b01110111,
+    0b00110011,
+    0b00010001,
+    0b00000000
+};
 
-void stopAnimation(AnimationState* state) {
-    state->isActive = false;
-    state->currentFrame = 0;
-}
+static constexpr uint8_t FULL_GLYPH[8] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+static constexpr uint8_t HAZARD_GLYPH[8] = { 0x00, 0x18, 0x3C, 0x7E, 0xFF, 0x7E, 0x3C, 0x18 };
+static constexpr uint8_t PARKING_GLYPH[8] = { 0x18, 0x24, 0x42, 0x81, 0x81, 0x42, 0x24, 0x18 };
 
-void pauseAnimation(AnimationState* state) {
-    state->isActive = false;
-}
+// "|| STOP!!! ||": 4 byte per modul, bar di modul paling luar berkedip
+static constexpr uint8_t STOP_TEXT[MATRIX_COUNT * 4] = {
+    0x66, 0x66, 0x66, 0x66,  // Left ||
+    0x7E, 0x7E, 0x60, 0x7E,  // S
+    0x7E, 0x18, 0x18, 0x7E,  // T
+    0x7E, 0x66, 0x66, 0x66,  // O
+    0x7E, 0x62, 0x62, 0x7E,  // P
+    0x00, 0x00, 0x00, 0x00,  // Space
+    0x21, 0x21, 0x21, 0x21,  // !!!
+    0x66, 0x66, 0x66, 0x66   // Right ||
+};
 
-void resumeAnimation(AnimationState* state) {
-    state->isActive = true;
-    state->lastUpdate = millis();
-}
+static constexpr uint8_t POLICE_FRAMES[3][8] = {
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00 },     // Biru
+    { 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF },     // Merah
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }      // Gelap
+};
 
-// ===== IMPLEMENTASI FUNGSI ANIMATION PROPERTIES =====
+// ===== TABEL FRAME (dibangkitkan saat compile) =====
 
-void setAnimationSpeed(AnimationState* state, uint16_t delay) {
-    state->delay = delay;
-}
+static const auto ARROW_BLINK PROGMEM = animBlinkFrames<1>(ARROW_GLYPH);
+static const auto ARROW PROGMEM = animGlyphFrames<1>(ARROW_GLYPH);
+static const auto ARROW_GROW PROGMEM = animGrowFrames<MATRIX_COUNT / 2>(ARROW_GLYPH);
+static const auto DOUBLE_ARROW_BLINK PROGMEM = animBlinkFrames<2>(DOUBLE_ARROW_GLYPH);
+static const auto EDGE_RAMP PROGMEM = animRampFrames();
+static const auto COLUMN_RUN PROGMEM = animColumnRunFrames<MATRIX_COUNT / 2>();
 
-void setAnimationDirection(AnimationState* state, AnimationDirection direction) {
-    state->direction = direction;
-    // Reset frame jika arah berubah
-    state->currentFrame = 0;
-}
+static const auto FULL PROGMEM = animGlyphFrames<1>(FULL_GLYPH);
+static const auto FULL_BLINK PROGMEM = animBlinkFrames<1>(FULL_GLYPH);
+static const auto FILL_LEVELS PROGMEM = animFillFrames();
+static const auto STOP_TEXT_BLINK PROGMEM =
+    animTextBlinkFrames<MATRIX_COUNT>(STOP_TEXT, 1UL | (1UL << (MATRIX_COUNT - 1)));
+
+static const auto HAZARD_BLINK PROGMEM = animBlinkFrames<1>(HAZARD_GLYPH);
+static const auto PARKING PROGMEM = animGlyphFrames<1>(PARKING_GLYPH);
+static const auto POLICE PROGMEM = animStaticFrames(POLICE_FRAMES);
+static const auto PIXEL_SCAN PROGMEM = animPixelScanFrames();
+static const auto NIGHT_RIDER PROGMEM = animBounceFrames<5>();
+
+// ===== TABEL DESCRIPTOR =====
+// source, frames/frameCount/modules, layout, steps, stepParam, timing, period, flags, effect, effectLevel
+
+const AnimationDescriptor SEIN_ANIMATIONS[SEIN_MODE_COUNT] PROGMEM = {
+    // SEIN_MODE_BASIC: panah berkedip di modul tepi
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(ARROW_BLINK), ANIM_LAYOUT_EDGE, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_SEIN_SPEED, 0, 0, ANIM_FX_NONE, 0 },
+    // SEIN_MODE_EDGE: ramp 16 langkah bergeser per baris
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(EDGE_RAMP), ANIM_LAYOUT_EDGE, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_SEIN_EDGE_SPEED, 0, 0, ANIM_FX_NONE, 0 },
+    // SEIN_MODE_PROGRESSIVE: panah bertambah dari tepi sebanyak progressive.steps modul
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(ARROW_GROW), ANIM_LAYOUT_EDGE, 0,
+      ANIM_PARAM_SEIN_STEPS, ANIM_PARAM_SEIN_STEP_DELAY, 0, ANIM_FLAG_GROW, ANIM_FX_NONE, 0 },
+    // SEIN_MODE_PULSE: panah tetap, intensitas naik-turun 16 langkah per periode sein
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(ARROW), ANIM_LAYOUT_EDGE, 16,
+      ANIM_PARAM_NONE, ANIM_PARAM_SEIN_SPEED, 0, ANIM_FLAG_CYCLE_PERIOD, ANIM_FX_PULSE, 0 },
+    // SEIN_MODE_DOUBLE: panah ganda berkedip di dua modul tepi
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(DOUBLE_ARROW_BLINK), ANIM_LAYOUT_EDGE, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_SEIN_SPEED, 0, 0, ANIM_FX_NONE, 0 },
+    // SEIN_MODE_RUNNING: satu kolom berjalan dari tengah ke arah sein
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(COLUMN_RUN), ANIM_LAYOUT_EDGE, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_SEIN_SPEED, 0, ANIM_FLAG_CYCLE_PERIOD | ANIM_FLAG_PIXEL_COVER, ANIM_FX_NONE, 0 },
+};
+
+const AnimationDescriptor BRAKE_ANIMATIONS[BRAKE_MODE_COUNT] PROGMEM = {
+    // BRAKE_MODE_FULL: semua menyala, statis
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(FULL), ANIM_LAYOUT_ALL, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_NONE, 0, 0, ANIM_FX_NONE, 0 },
+    // BRAKE_MODE_PROGRESSIVE: isi 1..8 kolom dalam progressive.steps langkah, lalu ditahan
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(FILL_LEVELS), ANIM_LAYOUT_ALL, 0,
+      ANIM_PARAM_BRAKE_STEPS, ANIM_PARAM_BRAKE_STEP_DELAY, 0, ANIM_FLAG_SCALED | ANIM_FLAG_HOLD, ANIM_FX_NONE, 0 },
+    // BRAKE_MODE_WARNING
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(FULL_BLINK), ANIM_LAYOUT_ALL, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_NONE, WARNING_BLINK_TIME, 0, ANIM_FX_NONE, 0 },
+    // BRAKE_MODE_EMERGENCY
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(FULL_BLINK), ANIM_LAYOUT_ALL, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_NONE, EMERGENCY_FLASH_TIME, 0, ANIM_FX_NONE, 0 },
+    // BRAKE_MODE_SMOOTH: penuh, fade dari gelap (di-dither framebufferService())
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(FULL), ANIM_LAYOUT_ALL, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_NONE, 0, 0, ANIM_FX_FADE_IN, 0 },
+    // BRAKE_MODE_STOP_TEXT
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(STOP_TEXT_BLINK), ANIM_LAYOUT_CHAIN, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_NONE, BLINK_INTERVAL, 0, ANIM_FX_NONE, 0 },
+};
 
-void setAnimationEffect(AnimationState* state, AnimationEffect effect) {
-    state->effect = effect;
-    // Reset frame jika efek berubah
-    state->currentFrame = 0;
+const AnimationDescriptor LIGHT_ANIMATIONS[LIGHT_COUNT] PROGMEM = {
+    // LIGHT_BRAKE_PULSE: penuh, intensitas 5..maksimum per detik
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(FULL), ANIM_LAYOUT_ALL, 20,
+      ANIM_PARAM_NONE, ANIM_PARAM_NONE, 50, 0, ANIM_FX_PULSE, 5 },
+    // LIGHT_HAZARD
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(HAZARD_BLINK), ANIM_LAYOUT_ALL, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_NONE, 500, 0, ANIM_FX_NONE, 0 },
+    // LIGHT_PARKING: intensitas rendah
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(PARKING), ANIM_LAYOUT_ALL, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_NONE, 0, 0, ANIM_FX_LEVEL, 3 },
+    // LIGHT_POLICE
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(POLICE), ANIM_LAYOUT_ALL, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_NONE, 200, 0, ANIM_FX_NONE, 0 },
+    // LIGHT_RUNNING: satu piksel menyapu 8x8
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(PIXEL_SCAN), ANIM_LAYOUT_ALL, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_NONE, 100, 0, ANIM_FX_NONE, 0 },
+    // LIGHT_NIGHT_RIDER
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(NIGHT_RIDER), ANIM_LAYOUT_ALL, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_NONE, 75, 0, ANIM_FX_NONE, 0 },
+    // LIGHT_STROBE: intensitas penuh
+    { ANIM_SOURCE_TABLE, ANIM_FRAMES(FULL_BLINK), ANIM_LAYOUT_ALL, 0,
+      ANIM_PARAM_NONE, ANIM_PARAM_NONE, 50, 0, ANIM_FX_LEVEL, MAX_BRIGHTNESS },
+};
+
+// ===== IMPLEMENTASI FUNGSI KONTROL =====
+
+// Descriptor disalin dari PROGMEM hanya saat mode berganti
+void animationSelect(AnimationState* state, const AnimationDescriptor* table, uint8_t count, uint8_t index) {
+    if (index >= count) index = 0;
+    if (state->table == table && state->index == index) return;
+
+    state->table = table;
+    state->index = index;
+    memcpy_P(&state->desc, &table[index], sizeof(AnimationDescriptor));
+    animationRestart(state);
 }
 
-void setAnimationBrightness(AnimationState* state, uint8_t brightness) {
-    state->brightness = constrain(brightness, MIN_BRIGHTNESS, MAX_BRIGHTNESS);
+void animationRestart(AnimationState* state) {
+    state->step = 0;
+    state->started = false;
 }
 
-void setAnimationLooping(AnimationState* state, bool looping) {
-    state->isLooping = looping;
+// Posisi setelah `steps` langkah dari awal (sama dengan animationAdvance berulang).
+// true jika langkahnya berubah.
+bool animationSeek(AnimationState* state, const AnimationParams* params, uint32_t steps) {
+    uint8_t count = animationSteps(state, params);
+    uint8_t step;
+    if (count == 0) {
+        return false;
+    } else if (state->desc.flags & ANIM_FLAG_HOLD) {
+        step = steps < count ? steps : count - 1;
+    } else {
+        step = steps % count;
+    }
+    if (step == state->step) return false;
+    state->step = step;
+    return true;
 }
 
-// ===== IMPLEMENTASI FUNGSI UPDATE ANIMASI =====
-
-void updateAnimation(AnimationState* state) {
-    if (!state->isActive) return;
-    
-    unsigned long currentTime = millis();
-    
-    if (currentTime - state->lastUpdate >= state->delay) {
-        state->lastUpdate = currentTime;
-        
-        // Update frame berdasarkan tipe animasi
-        switch(state->type) {
-            case ANIM_BRAKE_FULL:
-                // Brake tetap menyala
-                state->currentFrame = 0;
-                break;
-                
-            case ANIM_BRAKE_PROGRESSIVE:
-                updateProgressiveFrame(state);
-                break;
-                
-            case ANIM_SEIN_LEFT_BASIC:
-            case ANIM_SEIN_RIGHT_BASIC:
-                updateSeinFrame(state);
-                break;
-                
-            case ANIM_HAZARD_BASIC:
-            case ANIM_HAZARD_WARNING:
-                updateHazardFrame(state);
-                break;
-                
-            default:
-                updateDefaultFrame(state);
-        }
+// false = tidak ada frame baru (ANIM_FLAG_HOLD di langkah terakhir)
+bool animationAdvance(AnimationState* state, const AnimationParams* params) {
+    uint8_t steps = animationSteps(state, params);
+    if (state->step + 1 < steps) {
+        state->step++;
+        return true;
     }
+    if (state->desc.flags & ANIM_FLAG_HOLD) {
+        state->step = steps - 1;
+        return false;
+    }
+    state->step = 0;
+    return true;
 }
 
-// ===== IMPLEMENTASI FUNGSI UPDATE FRAME SPESIFIK =====
+// ===== IMPLEMENTASI FUNGSI PROPERTIES =====
 
-void updateProgressiveFrame(AnimationState* state) {
-    state->currentFrame++;
-    if (state->currentFrame >= BRAKE_PROGRESSIVE_FRAMES) {
-        if (state->isLooping) {
-            state->currentFrame = 0;
-        } else {
-            state->isActive = false;
-            state->currentFrame = BRAKE_PROGRESSIVE_FRAMES - 1;
+uint8_t animationSteps(const AnimationState* state, const AnimationParams* params) {
+    const AnimationDescriptor* desc = &state->desc;
+    if (desc->stepParam != ANIM_PARAM_NONE) {
+        uint16_t value = params->value[desc->stepParam];
+        if (desc->flags & ANIM_FLAG_GROW) {
+            return constrain(value, 1, desc->modules) + 1;
         }
+        return constrain(value, 1, desc->frameCount);
     }
+    return desc->steps ? desc->steps : desc->frameCount;
 }
 
-void updateSeinFrame(AnimationState* state) {
-    state->currentFrame++;
-    if (state->currentFrame >= SEIN_LEFT_FRAMES) {
-        state->currentFrame = 0; // Sein selalu looping
-    }
-}
+// 0 = statis, tidak perlu dijadwalkan
+uint16_t animationPeriod(const AnimationState* state, const AnimationParams* params) {
+    const AnimationDescriptor* desc = &state->desc;
+    if (animationSteps(state, params) <= 1) return 0;
 
-void updateHazardFrame(AnimationState* state) {
-    state->currentFrame++;
-    if (state->currentFrame >= HAZARD_FRAMES) {
-        state->currentFrame = 0; // Hazard selalu looping
+    uint16_t period = (desc->timing != ANIM_PARAM_NONE) ? params->value[desc->timing] : desc->period;
+    if (desc->flags & ANIM_FLAG_CYCLE_PERIOD) {
+        period /= animationSteps(state, params);
     }
+    return period ? period : 1;
 }
 
-void updateDefaultFrame(AnimationState* state) {
-    state->currentFrame++;
-    if (state->currentFrame >= state->totalFrames) {
-        if (state->isLooping) {
-            state->currentFrame = 0;
-        } else {
-            state->isActive = false;
-            state->currentFrame = state->totalFrames - 1;
-        }
-    }
+// Tanpa memilih mode, untuk pemeriksaan sebelum layer diaktifkan
+uint8_t animationEffect(const AnimationDescriptor* table, uint8_t count, uint8_t index) {
+    if (index >= count) index = 0;
+    return pgm_read_byte(&table[index].effect);
 }
 
-// ===== IMPLEMENTASI FUNGSI GETTER PATTERN =====
-
-const uint8_t* getPatternForType(AnimationType type) {
-    switch (type) {
-        // Brake Patterns
-        case ANIM_BRAKE_FULL:
-            return BRAKE_FULL_PATTERN;
-        case ANIM_BRAKE_PROGRESSIVE:
-            return BRAKE_PROGRESSIVE_PATTERN;
-        case ANIM_BRAKE_WARNING:
-            return BRAKE_WARNING_PATTERN;
-            
-        // Sein Patterns
-        case ANIM_SEIN_LEFT_BASIC:
-            return SEIN_LEFT_BASIC_PATTERN;
-        case ANIM_SEIN_RIGHT_BASIC:
-            return SEIN_RIGHT_BASIC_PATTERN;
-        case ANIM_SEIN_PROGRESSIVE:
-            return SEIN_PROGRESSIVE_PATTERN;
-            
-        // Hazard Patterns
-        case ANIM_HAZARD_BASIC:
-            return HAZARD_BASIC_PATTERN;
-        case ANIM_HAZARD_WARNING:
-            return HAZARD_WARNING_PATTERN;
-        case ANIM_HAZARD_PROGRESSIVE:
-            return HAZARD_PROGRESSIVE_PATTERN;
-            
-        default:
-            return nullptr;
+uint8_t animationLevel(const AnimationState* state, const AnimationParams* params, uint8_t maxLevel) {
+    const AnimationDescriptor* desc = &state->desc;
+    if (desc->effect == ANIM_FX_LEVEL) {
+        return desc->effectLevel;
     }
-}
-
-uint8_t getFrameCountForType(AnimationType type) {
-    switch (type) {
-        case ANIM_BRAKE_FULL:
-            return BRAKE_FRAMES;
-        case ANIM_BRAKE_PROGRESSIVE:
-            return BRAKE_PROGRESSIVE_FRAMES;
-        case ANIM_BRAKE_WARNING:
-            return BRAKE_WARNING_FRAMES;
-        case ANIM_SEIN_LEFT_BASIC:
-        case ANIM_SEIN_RIGHT_BASIC:
-            return SEIN_LEFT_FRAMES;
-        case ANIM_SEIN_PROGRESSIVE:
-            return SEIN_PROGRESSIVE_FRAMES;
-        case ANIM_HAZARD_BASIC:
-        case ANIM_HAZARD_WARNING:
-        case ANIM_HAZARD_PROGRESSIVE:
-            return HAZARD_FRAMES;
-        default:
-            return 0;
+    if (desc->effect != ANIM_FX_PULSE || maxLevel <= desc->effectLevel) {
+        return maxLevel;
     }
+
+    // Segitiga: naik selama setengah siklus pertama, turun di setengah kedua
+    uint8_t half = animationSteps(state, params) / 2;
+    if (half < 2) return maxLevel;
+    uint8_t rise = (state->step < half) ? state->step : 2 * half - 1 - state->step;
+    return desc->effectLevel + (uint16_t)rise * (maxLevel - desc->effectLevel) / (half - 1);
 }
 
-uint16_t getDelayForType(AnimationType type) {
-    switch (type) {
-        case ANIM_BRAKE_FULL:
-            return BRAKE_DELAY;
-        case ANIM_BRAKE_PROGRESSIVE:
-            return BRAKE_PROGRESSIVE_DELAY;
-        case ANIM_BRAKE_WARNING:
-            return BRAKE_WARNING_DELAY;
-        case ANIM_SEIN_LEFT_BASIC:
-        case ANIM_SEIN_RIGHT_BASIC:
-            return SEIN_DELAY;
-        case ANIM_SEIN_PROGRESSIVE:
-            return SEIN_PROGRESSIVE_DELAY;
-        case ANIM_HAZARD_BASIC:
-            return HAZARD_DELAY;
-        case ANIM_HAZARD_WARNING:
-            return HAZARD_WARNING_DELAY;
-        case ANIM_HAZARD_PROGRESSIVE:
-            return HAZARD_PROGRESSIVE_DELAY;
-        default:
-            return 0;
+// ===== IMPLEMENTASI FUNGSI RENDERING =====
+
+static uint8_t frameIndex(const AnimationState* state, const AnimationParams* params) {
+    const AnimationDescriptor* desc = &state->desc;
+    if (desc->flags & ANIM_FLAG_SCALED) {
+        uint8_t steps = animationSteps(state, params);
+        return (uint16_t)desc->frameCount * (state->step + 1) / steps - 1;
     }
+    return state->step % desc->frameCount;
 }
 
-// ===== IMPLEMENTASI FUNGSI STATUS CHECK =====
+// Seluruh frame ditulis, modul yang tidak dipakai layout menjadi gelap
+void animationRender(const AnimationState* state, const AnimationParams* params,
+                     uint8_t frame[][FB_ROWS], uint8_t devices, uint8_t sides) {
+    const AnimationDescriptor* desc = &state->desc;
+    const uint8_t* source = desc->frames + (size_t)frameIndex(state, params) * desc->modules * FB_ROWS;
+    memset(frame, 0, (size_t)devices * FB_ROWS);
 
-bool isAnimationComplete(AnimationState* state) {
-    return !state->isActive && state->currentFrame >= state->totalFrames - 1;
+    switch (desc->layout) {
+        case ANIM_LAYOUT_ALL: {
+            uint8_t rows[FB_ROWS];
+            memcpy_P(rows, source, FB_ROWS);
+            for (uint8_t d = 0; d < devices; d++) {
+                memcpy(frame[d], rows, FB_ROWS);
+            }
+            break;
+        }
+        case ANIM_LAYOUT_CHAIN:
+            memcpy_P(frame, source, (size_t)min(desc->modules, devices) * FB_ROWS);
+            break;
+        case ANIM_LAYOUT_EDGE: {
+            // Sisi kanan = cermin horizontal seluruh chain dari sisi kiri (bitplaneMirror):
+            // satu bit reverse 64-bit per baris, bukan reverse per byte per modul
+            if (!(sides & ANIM_SIDE_BOTH)) break;
+            memcpy_P(frame, source, (size_t)min(desc->modules, devices) * FB_ROWS);
+            if (sides & ANIM_SIDE_RIGHT) {
+                BitPlane left;
+                bitplanePack(&left, frame, devices);
+                BitPlane plane = left;
+                bitplaneMirror(&plane, true, false);
+                if (sides & ANIM_SIDE_LEFT) {
+                    for (uint8_t r = 0; r < FB_ROWS; r++) {
+                        plane.rows[r] |= left.rows[r];
+                    }
+                }
+                bitplaneUnpack(&plane, frame);
+            }
+            break;
+        }
+    }
 }
 
-bool isAnimationActive(AnimationState* state) {
-    return state->isActive;
-}
+// Modul yang ditutup layer (compositorSetCoverage); pixels = hanya piksel menyala
+uint16_t animationCoverage(const AnimationState* state, const AnimationParams* params,
+                           uint8_t devices, uint8_t sides, bool* pixels) {
+    const AnimationDescriptor* desc = &state->desc;
+    *pixels = (desc->flags & ANIM_FLAG_PIXEL_COVER) != 0;
+    if (*pixels) return 0;
+    if (desc->layout != ANIM_LAYOUT_EDGE) {
+        return (devices >= 16) ? 0xFFFF : (1U << devices) - 1;
+    }
 
-bool isAnimationPaused(AnimationState* state) {
-    return !state->isActive && state->currentFrame > 0;
-}
\ No newline at end of file
+    uint8_t span = min(desc->modules, devices);
+    if (desc->flags & ANIM_FLAG_GROW) {
+        span = min(span, (uint8_t)(animationSteps(state, params) - 1));
+    }
+    uint16_t mask = 0;
+    for (uint8_t i = 0; i < span; i++) {
+        if (sides & ANIM_SIDE_LEFT) mask |= 1 << i;
+        if (sides & ANIM_SIDE_RIGHT) mask |= 1 << (devices - 1 - i);
+    }
+    return mask;
+}
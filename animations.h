@@ -2,227 +2,237 @@
 #define ANIMATIONS_H
 
 #include "settings.h"
+#include "framebuffer.h"
 #include <stdint.h>
+#include <stddef.h>
 
 // Build Information
-#define ANIMATIONS_VERSION "1.0.0"
-#define ANIMATIONS_BUILD_DATE "2025-05-11 07:17:43"
+#define ANIMATIONS_VERSION "2.2.0"
+#define ANIMATIONS_BUILD_DATE "2026-10-18 10:26:13"
 #define ANIMATIONS_AUTHOR "Brodot23"
 
-// Animation Buffer Size
-#define MAX_ANIMATION_FRAMES 32
-#define MAX_ANIMATION_PATTERNS 16
-
-// ===== ANIMASI LAMPU REM =====
-// Pattern: Full Brake (Rem Penuh)
-const uint8_t BRAKE_FULL_PATTERN[] = {
-    B11111111,
-    B11111111,
-    B11111111,
-    B11111111,
-    B11111111,
-    B11111111,
-    B11111111,
-    B11111111
-};
-
-// Pattern: Progressive Brake (Rem Bertahap)
-const uint8_t BRAKE_PROGRESSIVE_PATTERN[] = {
-    B00000000, // Frame 1
-    B11111111,
-    B00000000,
-    B11111111,
-    B00000000,
-    B11111111,
-    B00000000,
-    B11111111  // Frame 8
-};
-
-// Pattern: Brake Warning (Peringatan Rem)
-const uint8_t BRAKE_WARNING_PATTERN[] = {
-    B10101010,
-    B01010101,
-    B10101010,
-    B01010101,
-    B10101010,
-    B01010101,
-    B10101010,
-    B01010101
-};
-
-// ===== ANIMASI LAMPU SEIN =====
-// Pattern: Left Sein Basic (Sein Kiri Dasar)
-const uint8_t SEIN_LEFT_BASIC_PATTERN[] = {
-    B10000000, // Frame 1
-    B11000000,
-    B11100000,
-    B11110000,
-    B11100000,
-    B11000000,
-    B10000000,
-    B00000000  // Frame 8
-};
-
-// Pattern: Right Sein Basic (Sein Kanan Dasar)
-const uint8_t SEIN_RIGHT_BASIC_PATTERN[] = {
-    B00000001, // Frame 1
-    B00000011,
-    B00000111,
-    B00001111,
-    B00000111,
-    B00000011,
-    B00000001,
-    B00000000  // Frame 8
-};
-
-// Pattern: Sein Progressive (Sein Bertahap)
-const uint8_t SEIN_PROGRESSIVE_PATTERN[] = {
-    B10000001, // Frame 1
-    B11000011,
-    B11100111,
-    B11111111,
-    B11100111,
-    B11000011,
-    B10000001,
-    B00000000  // Frame 8
-};
+// Setiap mode sein/rem (dan efek lampu lama) dideskripsikan oleh satu AnimationDescriptor:
+// sumber frame, jumlah frame, tata letak di chain, timing dan perilaku looping. Frame
+// dibangkitkan saat compile (builder di bawah) ke tabel PROGMEM; tidak ada switch per mode
+// dan tidak ada pembangkitan frame saat runtime. Mode baru = baris baru di tabel.
+
+// Frame Source
+#define ANIM_SOURCE_TABLE 0         // frames: frameCount x modules x 8 baris di PROGMEM
+
+// Layout: cara frame dipetakan ke chain
+#define ANIM_LAYOUT_ALL 0           // Frame 1 modul diulang di semua modul
+#define ANIM_LAYOUT_CHAIN 1         // Frame = modul 0..modules-1 apa adanya
+#define ANIM_LAYOUT_EDGE 2          // Modul i dihitung dari tepi: kiri di modul i, kanan
+                                    // dicerminkan di modul (devices - 1 - i)
+
+// Sisi untuk ANIM_LAYOUT_EDGE
+#define ANIM_SIDE_LEFT 0x01
+#define ANIM_SIDE_RIGHT 0x02
+#define ANIM_SIDE_BOTH (ANIM_SIDE_LEFT | ANIM_SIDE_RIGHT)
+
+// Flags
+#define ANIM_FLAG_HOLD 0x01         // Berhenti di langkah terakhir (default: loop)
+#define ANIM_FLAG_SCALED 0x02       // Langkah dipetakan ke seluruh tabel: frame = N*(step+1)/steps - 1
+#define ANIM_FLAG_GROW 0x04         // Frame k menyalakan k modul; steps = param + 1, coverage ikut steps
+#define ANIM_FLAG_CYCLE_PERIOD 0x08 // period = satu siklus penuh, dibagi rata ke setiap langkah
+#define ANIM_FLAG_PIXEL_COVER 0x10  // Layer hanya menutup piksel yang menyala
+
+// Parameter runtime dari setting sketch (AnimationParams)
+#define ANIM_PARAM_NONE 0           // Nilai tetap dari descriptor
+#define ANIM_PARAM_SEIN_SPEED 1
+#define ANIM_PARAM_SEIN_EDGE_SPEED 2
+#define ANIM_PARAM_SEIN_STEP_DELAY 3
+#define ANIM_PARAM_SEIN_STEPS 4
+#define ANIM_PARAM_BRAKE_STEP_DELAY 5
+#define ANIM_PARAM_BRAKE_STEPS 6
+#define ANIM_PARAM_COUNT 7
+
+// Efek intensitas, diterapkan sketch ke layer yang sedang dirender
+#define ANIM_FX_NONE 0
+#define ANIM_FX_LEVEL 1             // Intensitas tetap effectLevel
+#define ANIM_FX_PULSE 2             // Segitiga effectLevel..maksimum layer selama satu siklus
+#define ANIM_FX_FADE_IN 3           // Fade dari gelap ke intensitas layer saat mulai
+
+// Legacy Lights (dulu fungsi tulisan tangan di sketch)
+#define LIGHT_BRAKE_PULSE 0
+#define LIGHT_HAZARD 1
+#define LIGHT_PARKING 2
+#define LIGHT_POLICE 3
+#define LIGHT_RUNNING 4
+#define LIGHT_NIGHT_RIDER 5
+#define LIGHT_STROBE 6
+#define LIGHT_COUNT 7
 
-// ===== ANIMASI LAMPU HAZARD =====
-// Pattern: Hazard Basic (Hazard Dasar)
-const uint8_t HAZARD_BASIC_PATTERN[] = {
-    B11111111, // Frame 1
-    B01111110,
-    B00111100,
-    B00011000,
-    B00011000,
-    B00111100,
-    B01111110,
-    B11111111  // Frame 8
-};
-
-// Pattern: Hazard Warning (Peringatan Hazard)
-const uint8_t HAZARD_WARNING_PATTERN[] = {
-    B10101010, // Frame 1
-    B01010101,
-    B10101010,
-    B01010101,
-    B10101010,
-    B01010101,
-    B10101010,
-    B01010101  // Frame 8
-};
-
-// Pattern: Hazard Progressive (Hazard Bertahap)
-const uint8_t HAZARD_PROGRESSIVE_PATTERN[] = {
-    B11111111, // Frame 1
-    B00000000,
-    B11111111,
-    B00000000,
-    B11111111,
-    B00000000,
-    B11111111,
-    B00000000  // Frame 8
-};
+typedef struct {
+    uint8_t source;             // ANIM_SOURCE_*
+    const uint8_t* frames;      // PROGMEM
+    uint8_t frameCount;
+    uint8_t modules;            // Modul per frame
+    uint8_t layout;             // ANIM_LAYOUT_*
+    uint8_t steps;              // Langkah per siklus, 0 = frameCount
+    uint8_t stepParam;          // ANIM_PARAM_*: steps dari setting
+    uint8_t timing;             // ANIM_PARAM_*: ms per langkah dari setting
+    uint16_t period;            // ms per langkah jika timing = ANIM_PARAM_NONE (0 = statis)
+    uint8_t flags;              // ANIM_FLAG_*
+    uint8_t effect;             // ANIM_FX_*
+    uint8_t effectLevel;
+} AnimationDescriptor;
+
+// Nilai setting saat ini, diisi sketch sebelum animasi dijalankan
+typedef struct {
+    uint16_t value[ANIM_PARAM_COUNT];
+} AnimationParams;
 
-// Animation Frame Counts
-#define BRAKE_FRAMES 1
-#define BRAKE_PROGRESSIVE_FRAMES 8
-#define BRAKE_WARNING_FRAMES 8
-#define SEIN_LEFT_FRAMES 8
-#define SEIN_RIGHT_FRAMES 8
-#define SEIN_PROGRESSIVE_FRAMES 8
-#define HAZARD_FRAMES 8
-#define HAZARD_WARNING_FRAMES 8
-#define HAZARD_PROGRESSIVE_FRAMES 8
-
-// Animation Timing (in milliseconds)
-#define BRAKE_DELAY 100
-#define BRAKE_PROGRESSIVE_DELAY 50
-#define BRAKE_WARNING_DELAY 75
-#define SEIN_DELAY 500
-#define SEIN_PROGRESSIVE_DELAY 100
-#define HAZARD_DELAY 500
-#define HAZARD_WARNING_DELAY 75
-#define HAZARD_PROGRESSIVE_DELAY 100
-
-// Animation Types
-typedef enum {
-    ANIM_NONE,
-    // Brake Animations
-    ANIM_BRAKE_FULL,
-    ANIM_BRAKE_PROGRESSIVE,
-    ANIM_BRAKE_WARNING,
-    // Sein Animations
-    ANIM_SEIN_LEFT_BASIC,
-    ANIM_SEIN_RIGHT_BASIC,
-    ANIM_SEIN_PROGRESSIVE,
-    // Hazard Animations
-    ANIM_HAZARD_BASIC,
-    ANIM_HAZARD_WARNING,
-    ANIM_HAZARD_PROGRESSIVE
-} AnimationType;
-
-// Animation Direction
-typedef enum {
-    DIR_NONE,
-    DIR_LEFT,
-    DIR_RIGHT,
-    DIR_BOTH,
-    DIR_CENTER,
-    DIR_ALTERNATE
-} AnimationDirection;
-
-// Animation Effects
-typedef enum {
-    EFFECT_NONE,
-    EFFECT_FADE,
-    EFFECT_BLINK,
-    EFFECT_SLIDE,
-    EFFECT_PULSE
-} AnimationEffect;
-
-// Animation State Structure
+// Player: salinan descriptor (dari PROGMEM) + posisi
 typedef struct {
-    AnimationType type;
-    AnimationDirection direction;
-    AnimationEffect effect;
-    uint8_t currentFrame;
-    uint8_t totalFrames;
-    uint16_t delay;
-    uint8_t brightness;
-    bool isActive;
-    bool isReverse;
-    bool isLooping;
-    unsigned long lastUpdate;
+    const AnimationDescriptor* table;
+    uint8_t index;
+    AnimationDescriptor desc;
+    uint8_t step;
+    bool started;               // Frame pertama sudah dirender (ANIM_FX_FADE_IN)
 } AnimationState;
 
+// Descriptor Tables (PROGMEM)
+extern const AnimationDescriptor SEIN_ANIMATIONS[SEIN_MODE_COUNT];
+extern const AnimationDescriptor BRAKE_ANIMATIONS[BRAKE_MODE_COUNT];
+extern const AnimationDescriptor LIGHT_ANIMATIONS[LIGHT_COUNT];
+
 // Function Prototypes
-// Initialization
-void initializeAnimation(AnimationState* state);
-void resetAnimation(AnimationState* state);
-
-// Animation Control
-void startAnimation(AnimationState* state, AnimationType type);
-void stopAnimation(AnimationState* state);
-void pauseAnimation(AnimationState* state);
-void resumeAnimation(AnimationState* state);
-void updateAnimation(AnimationState* state);
-
-// Animation Properties
-void setAnimationSpeed(AnimationState* state, uint16_t delay);
-void setAnimationDirection(AnimationState* state, AnimationDirection direction);
-void setAnimationEffect(AnimationState* state, AnimationEffect effect);
-void setAnimationBrightness(AnimationState* state, uint8_t brightness);
-void setAnimationLooping(AnimationState* state, bool looping);
-
-// Status Checks
-bool isAnimationComplete(AnimationState* state);
-bool isAnimationActive(AnimationState* state);
-bool isAnimationPaused(AnimationState* state);
-
-// Pattern Management
-const uint8_t* getPatternForType(AnimationType type);
-uint8_t getFrameCountForType(AnimationType type);
-uint16_t getDelayForType(AnimationType type);
-
-#endif // ANIMATIONS_H
\ No newline at end of file
+// Control
+void animationSelect(AnimationState* state, const AnimationDescriptor* table, uint8_t count, uint8_t index);
+void animationRestart(AnimationState* state);
+bool animationSeek(AnimationState* state, const AnimationParams* params, uint32_t steps);
+bool animationAdvance(AnimationState* state, const AnimationParams* params);
+
+// Properties
+uint8_t animationSteps(const AnimationState* state, const AnimationParams* params);
+uint16_t animationPeriod(const AnimationState* state, const AnimationParams* params);
+uint8_t animationEffect(const AnimationDescriptor* table, uint8_t count, uint8_t index);
+uint8_t animationLevel(const AnimationState* state, const AnimationParams* params, uint8_t maxLevel);
+
+// Rendering
+void animationRender(const AnimationState* state, const AnimationParams* params,
+                     uint8_t frame[][FB_ROWS], uint8_t devices, uint8_t sides);
+uint16_t animationCoverage(const AnimationState* state, const AnimationParams* params,
+                           uint8_t devices, uint8_t sides, bool* pixels);
+
+// ===== FRAME BUILDER (compile-time) =====
+// Hasil builder disimpan sebagai `static const auto X PROGMEM = builder(...)`;
+// ANIM_FRAMES(X) mengisi field frames, frameCount dan modules descriptor.
+
+template<size_t Frames, size_t Modules>
+struct AnimationFrames {
+    uint8_t rows[Frames][Modules][8];
+};
+
+#define ANIM_FRAMES(storage) \
+    &(storage).rows[0][0][0], \
+    (uint8_t)(sizeof((storage).rows) / sizeof((storage).rows[0])), \
+    (uint8_t)(sizeof((storage).rows[0]) / 8)
+
+// Frame tetap (tabel literal)
+template<size_t Frames>
+constexpr AnimationFrames<Frames, 1> animStaticFrames(const uint8_t (&source)[Frames][8]) {
+    AnimationFrames<Frames, 1> frames = {};
+    for (size_t f = 0; f < Frames; f++) {
+        for (uint8_t r = 0; r < 8; r++) frames.rows[f][0][r] = source[f][r];
+    }
+    return frames;
+}
+
+// Satu frame: glyph di setiap modul
+template<size_t Modules>
+constexpr AnimationFrames<1, Modules> animGlyphFrames(const uint8_t (&glyph)[8]) {
+    AnimationFrames<1, Modules> frames = {};
+    for (size_t m = 0; m < Modules; m++) {
+        for (uint8_t r = 0; r < 8; r++) frames.rows[0][m][r] = glyph[r];
+    }
+    return frames;
+}
+
+// [glyph di setiap modul, gelap]
+template<size_t Modules>
+constexpr AnimationFrames<2, Modules> animBlinkFrames(const uint8_t (&glyph)[8]) {
+    AnimationFrames<2, Modules> frames = {};
+    for (size_t m = 0; m < Modules; m++) {
+        for (uint8_t r = 0; r < 8; r++) frames.rows[0][m][r] = glyph[r];
+    }
+    return frames;
+}
+
+// Frame k: glyph di modul 0..k-1 (k = 0..Modules)
+template<size_t Modules>
+constexpr AnimationFrames<Modules + 1, Modules> animGrowFrames(const uint8_t (&glyph)[8]) {
+    AnimationFrames<Modules + 1, Modules> frames = {};
+    for (size_t k = 0; k <= Modules; k++) {
+        for (size_t m = 0; m < k; m++) {
+            for (uint8_t r = 0; r < 8; r++) frames.rows[k][m][r] = glyph[r];
+        }
+    }
+    return frames;
+}
+
+// Ramp tepi 16 langkah (1..8 kolom lalu kembali), frame s baris r = ramp[(s + r) % 16]
+constexpr uint8_t animRamp(uint8_t i) {
+    return (uint8_t)(0xFF << (i < 8 ? 7 - i : i - 8));
+}
+
+constexpr AnimationFrames<16, 1> animRampFrames() {
+    AnimationFrames<16, 1> frames = {};
+    for (uint8_t s = 0; s < 16; s++) {
+        for (uint8_t r = 0; r < 8; r++) frames.rows[s][0][r] = animRamp((s + r) % 16);
+    }
+    return frames;
+}
+
+// Satu kolom berjalan dari modul terdalam (Modules - 1) ke tepi, bit 0 dulu
+template<size_t Modules>
+constexpr AnimationFrames<Modules * 8, Modules> animColumnRunFrames() {
+    AnimationFrames<Modules * 8, Modules> frames = {};
+    for (size_t s = 0; s < Modules * 8; s++) {
+        for (uint8_t r = 0; r < 8; r++) frames.rows[s][Modules - 1 - s / 8][r] = 1 << (s % 8);
+    }
+    return frames;
+}
+
+// Frame k: k + 1 bit bawah menyala di semua baris (isi bertahap 1..8 kolom)
+constexpr AnimationFrames<8, 1> animFillFrames() {
+    AnimationFrames<8, 1> frames = {};
+    for (uint8_t k = 0; k < 8; k++) {
+        for (uint8_t r = 0; r < 8; r++) frames.rows[k][0][r] = (uint8_t)((2u << k) - 1);
+    }
+    return frames;
+}
+
+// Satu piksel per frame menyapu 8x8 (baris s / 8, bit s % 8)
+constexpr AnimationFrames<64, 1> animPixelScanFrames() {
+    AnimationFrames<64, 1> frames = {};
+    for (uint8_t s = 0; s < 64; s++) frames.rows[s][0][s / 8] = 1 << (s % 8);
+    return frames;
+}
+
+// Bar 3 piksel di baris bawah bolak-balik posisi 0..Last, ujung ditahan satu frame
+template<size_t Last>
+constexpr AnimationFrames<2 * (Last + 1), 1> animBounceFrames() {
+    AnimationFrames<2 * (Last + 1), 1> frames = {};
+    for (size_t p = 0; p <= Last; p++) {
+        frames.rows[p][0][7] = (uint8_t)(0x07 << p);
+        frames.rows[2 * Last + 1 - p][0][7] = (uint8_t)(0x07 << p);
+    }
+    return frames;
+}
+
+// Teks 4 byte per modul (setiap byte 2 baris); frame 1 = modul di moduleMask gelap
+template<size_t Modules>
+constexpr AnimationFrames<2, Modules> animTextBlinkFrames(const uint8_t (&text)[Modules * 4], uint32_t moduleMask) {
+    AnimationFrames<2, Modules> frames = {};
+    for (size_t m = 0; m < Modules; m++) {
+        for (uint8_t r = 0; r < 8; r++) {
+            frames.rows[0][m][r] = text[m * 4 + r / 2];
+            frames.rows[1][m][r] = (moduleMask & (1UL << m)) ? 0 : text[m * 4 + r / 2];
+        }
+    }
+    return frames;
+}
+
+#endif // ANIMATIONS_H
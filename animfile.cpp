@@ -0,0 +1,170 @@
+#include "animfile.h"
+#include "settings.h"
+#include <Arduino.h>
+#include <FS.h>
+
+// Build Information
+#define ANIMFILE_CPP_VERSION "1.0.0"
+#define ANIMFILE_CPP_BUILD_DATE "2026-10-17 13:48:30"
+#define ANIMFILE_CPP_AUTHOR "Brodot23"
+
+// Satu file aktif, RAM tetap berapapun panjang animasinya
+static File animFile;
+static bool fileOpen = false;
+static uint8_t fileEntry = 0;
+static uint8_t fileDevices = 0;
+static uint16_t fileFrameCount = 0;
+static uint16_t fileFrameDelay = 0;
+
+// Ring dua frame: ringHead = frame berikutnya yang ditampilkan
+static uint8_t ring[ANIMFILE_RING_FRAMES][FB_MAX_DEVICES][FB_ROWS];
+static uint8_t ringHead = 0;
+static uint8_t ringFilled = 0;
+static uint16_t framesLoaded = 0;   // Frame yang sudah dibaca ke ring
+static uint16_t framesShown = 0;
+
+static AnimFileStats fileStats;
+
+// ===== IMPLEMENTASI FUNGSI PLAYLIST =====
+
+bool animfileIsPlaylistRef(uint8_t entry) {
+    return entry >= ANIMFILE_PLAYLIST_BASE;
+}
+
+void animfilePath(uint8_t entry, char* buffer, size_t size) {
+    snprintf(buffer, size, "%s/%u.anim", ANIMFILE_DIR, (unsigned)(entry - ANIMFILE_PLAYLIST_BASE));
+}
+
+bool animfileExists(uint8_t entry) {
+    if (!animfileIsPlaylistRef(entry)) return false;
+    char path[ANIMFILE_PATH_LENGTH];
+    animfilePath(entry, path, sizeof(path));
+    return SPIFFS.exists(path);
+}
+
+// ===== IMPLEMENTASI FUNGSI BACA =====
+
+static uint16_t readLe16(const uint8_t* p) {
+    return p[0] | (p[1] << 8);
+}
+
+// Baca satu frame ke slot kosong berikutnya di ring
+static bool loadFrame() {
+    if (!fileOpen || ringFilled >= ANIMFILE_RING_FRAMES || framesLoaded >= fileFrameCount) {
+        return false;
+    }
+
+    uint8_t slot = (ringHead + ringFilled) % ANIMFILE_RING_FRAMES;
+    size_t length = (size_t)fileDevices * FB_ROWS;
+    if (animFile.read(&ring[slot][0][0], length) != length) {
+        fileStats.errors++;
+        animfileClose();
+        return false;
+    }
+    if (fileDevices < FB_MAX_DEVICES) {
+        memset(ring[slot][fileDevices], 0, (FB_MAX_DEVICES - fileDevices) * FB_ROWS);
+    }
+
+    ringFilled++;
+    framesLoaded++;
+    fileStats.framesRead++;
+    fileStats.bytesRead += length;
+    return true;
+}
+
+// ===== IMPLEMENTASI FUNGSI PLAYBACK =====
+
+bool animfileOpen(uint8_t entry) {
+    animfileClose();
+    if (!animfileIsPlaylistRef(entry)) return false;
+
+    char path[ANIMFILE_PATH_LENGTH];
+    animfilePath(entry, path, sizeof(path));
+    animFile = SPIFFS.open(path, "r");
+    if (!animFile) {
+        fileStats.errors++;
+        return false;
+    }
+
+    uint8_t header[ANIMFILE_HEADER_SIZE];
+    if (animFile.read(header, sizeof(header)) != sizeof(header) ||
+        memcmp(header, ANIMFILE_MAGIC, 4) != 0 ||
+        header[4] != ANIMFILE_FORMAT_VERSION ||
+        header[5] == 0 || header[5] > FB_MAX_DEVICES ||
+        readLe16(&header[6]) == 0) {
+        animFile.close();
+        fileStats.errors++;
+        return false;
+    }
+
+    fileDevices = header[5];
+    fileFrameCount = readLe16(&header[6]);
+    fileFrameDelay = readLe16(&header[8]);
+    fileEntry = entry;
+    fileOpen = true;
+    ringHead = 0;
+    ringFilled = 0;
+    framesLoaded = 0;
+    framesShown = 0;
+    fileStats.opens++;
+
+    // Isi ring sekarang supaya frame pertama tidak menunggu flash
+    while (loadFrame()) {}
+    return fileOpen;
+}
+
+void animfileClose() {
+    if (fileOpen) {
+        animFile.close();
+    }
+    fileOpen = false;
+    ringFilled = 0;
+}
+
+bool animfileIsOpen() {
+    return fileOpen;
+}
+
+uint8_t animfileCurrentEntry() {
+    return fileEntry;
+}
+
+uint16_t animfileFrameDelay() {
+    return fileOpen ? fileFrameDelay : 0;
+}
+
+// Dipanggil dari loop() di antara render: mengisi ring sebelum deadline berikutnya
+bool animfilePrefetch() {
+    return loadFrame();
+}
+
+bool animfileNextFrame(uint8_t frame[][FB_ROWS], uint8_t devices) {
+    if (!fileOpen || framesShown >= fileFrameCount) return false;
+
+    if (ringFilled == 0) {
+        // Prefetch tertinggal: baca langsung (render menunggu flash)
+        fileStats.underruns++;
+        if (!loadFrame()) return false;
+    }
+
+    uint8_t count = devices < FB_MAX_DEVICES ? devices : FB_MAX_DEVICES;
+    memcpy(frame, ring[ringHead], (size_t)count * FB_ROWS);
+    ringHead = (ringHead + 1) % ANIMFILE_RING_FRAMES;
+    ringFilled--;
+    framesShown++;
+    return true;
+}
+
+bool animfileFinished() {
+    return !fileOpen || framesShown >= fileFrameCount;
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTIK =====
+
+const AnimFileStats* animfileGetStats() {
+    return &fileStats;
+}
+
+void animfileResetStats() {
+    memset(&fileStats, 0, sizeof(fileStats));
+}
@@ -0,0 +1,64 @@
+#ifndef ANIMFILE_H
+#define ANIMFILE_H
+
+#include "settings.h"
+#include "framebuffer.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// Build Information
+#define ANIMFILE_VERSION "1.0.0"
+#define ANIMFILE_BUILD_DATE "2026-10-17 13:48:30"
+#define ANIMFILE_AUTHOR "Brodot23"
+
+// Format file animasi di SPIFFS (little endian):
+//   0  magic "SANM"
+//   4  version (ANIMFILE_FORMAT_VERSION)
+//   5  devices     modul per frame (1..FB_MAX_DEVICES)
+//   6  frameCount  uint16
+//   8  frameDelay  uint16, ms per frame (0 = settings.animationSpeed)
+//   10 reserved    uint16
+//   12 frame data  frameCount x devices x 8 byte (modul 0 baris 0..7, modul 1, ...)
+#define ANIMFILE_MAGIC "SANM"
+#define ANIMFILE_FORMAT_VERSION 1
+#define ANIMFILE_HEADER_SIZE 12
+
+// Entry playlist (animSettings.selectedPatterns) >= ANIMFILE_PLAYLIST_BASE
+// merujuk ke file ANIMFILE_DIR "/<entry - base>.anim"
+#define ANIMFILE_DIR "/anim"
+#define ANIMFILE_PLAYLIST_BASE 128
+#define ANIMFILE_PATH_LENGTH 32
+
+// Frame yang dibaca di depan deadline render
+#define ANIMFILE_RING_FRAMES 2
+
+// Streaming Statistics
+typedef struct {
+    uint32_t opens;             // File yang berhasil dibuka
+    uint32_t framesRead;        // Frame yang dibaca dari flash
+    uint32_t bytesRead;
+    uint32_t underruns;         // Render yang harus menunggu baca flash (ring kosong)
+    uint32_t errors;            // Header tidak valid / file terpotong
+} AnimFileStats;
+
+// Function Prototypes
+// Playlist Helpers
+bool animfileIsPlaylistRef(uint8_t entry);
+void animfilePath(uint8_t entry, char* buffer, size_t size);
+bool animfileExists(uint8_t entry);
+
+// Playback
+bool animfileOpen(uint8_t entry);
+void animfileClose();
+bool animfileIsOpen();
+uint8_t animfileCurrentEntry();
+uint16_t animfileFrameDelay();
+bool animfilePrefetch();
+bool animfileNextFrame(uint8_t frame[][FB_ROWS], uint8_t devices);
+bool animfileFinished();
+
+// Statistics
+const AnimFileStats* animfileGetStats();
+void animfileResetStats();
+
+#endif // ANIMFILE_H
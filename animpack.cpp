@@ -0,0 +1,78 @@
+#include "animpack.h"
+#include "settings.h"
+#include <Arduino.h>
+
+// Build Information
+#define ANIMPACK_CPP_VERSION "1.0.0"
+#define ANIMPACK_CPP_BUILD_DATE "2026-10-17 13:02:16"
+#define ANIMPACK_CPP_AUTHOR "Brodot23"
+
+// ===== IMPLEMENTASI FUNGSI READER =====
+
+bool animpackReaderOpen(AnimpackReader* reader, const AnimationPack* pack, uint8_t pattern) {
+    if (!pack || pattern >= pack->count) {
+        reader->frameCount = 0;
+        reader->frameIndex = 0;
+        return false;
+    }
+
+    const uint8_t* start = pack->data + pgm_read_word(&pack->index[pattern]);
+    reader->frameCount = pgm_read_byte(start);
+    reader->typeBits = start + 1;
+    reader->cursor = reader->typeBits + (reader->frameCount + 7) / 8;
+    reader->frameIndex = 0;
+    memset(reader->frame, 0, sizeof(reader->frame));
+    return true;
+}
+
+// Decode frame berikutnya di atas frame sebelumnya (reader->frame)
+bool animpackReaderNext(AnimpackReader* reader) {
+    if (reader->frameIndex >= reader->frameCount) return false;
+
+    uint8_t f = reader->frameIndex;
+    bool run = pgm_read_byte(&reader->typeBits[f / 8]) & (1 << (f % 8));
+    uint8_t mask = pgm_read_byte(reader->cursor++);
+
+    for (uint8_t r = 0; r < FB_ROWS; r++) {
+        if (mask & (1 << r)) {
+            reader->frame[r] = pgm_read_byte(reader->cursor++);
+        } else if (run && r > 0) {
+            reader->frame[r] = reader->frame[r - 1];
+        }
+        // DELTA (atau baris 0 pada RUN): baris frame sebelumnya tetap
+    }
+
+    reader->frameIndex++;
+    return true;
+}
+
+// ===== IMPLEMENTASI FUNGSI RENDER =====
+
+uint8_t animpackFrameCount(const AnimationPack* pack, uint8_t pattern) {
+    if (!pack || pattern >= pack->count) return 0;
+    return pgm_read_byte(pack->data + pgm_read_word(&pack->index[pattern]));
+}
+
+// Pola diperlakukan sebagai strip vertikal frameCount * 8 baris yang berulang.
+// Posisi tampilan p (modul p / 8, baris p % 8) menampilkan baris strip (p + step),
+// setiap baris hasil decode langsung ditulis ke semua posisi yang memakainya.
+bool animpackRenderWindow(const AnimationPack* pack, uint8_t pattern, uint16_t step,
+                          uint8_t frame[][FB_ROWS], uint8_t devices) {
+    AnimpackReader reader;
+    if (!animpackReaderOpen(&reader, pack, pattern) || reader.frameCount == 0) return false;
+
+    uint16_t stripRows = reader.frameCount * FB_ROWS;
+    uint16_t windowRows = devices * FB_ROWS;
+    uint16_t shift = step % stripRows;
+
+    uint16_t stripRow = 0;
+    while (animpackReaderNext(&reader)) {
+        for (uint8_t r = 0; r < FB_ROWS; r++, stripRow++) {
+            uint16_t position = (stripRow + stripRows - shift) % stripRows;
+            for (; position < windowRows; position += stripRows) {
+                frame[position / FB_ROWS][position % FB_ROWS] = reader.frame[r];
+            }
+        }
+    }
+    return true;
+}
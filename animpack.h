@@ -0,0 +1,177 @@
+#ifndef ANIMPACK_H
+#define ANIMPACK_H
+
+#include "settings.h"
+#include "framebuffer.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// Build Information
+#define ANIMPACK_VERSION "1.1.0"
+#define ANIMPACK_BUILD_DATE "2026-10-18 14:20:37"
+#define ANIMPACK_AUTHOR "Brodot23"
+
+// Format PROGMEM per pola (satu frame = 8 baris = satu gambar 8x8):
+//   [frameCount] [typeBits: ceil(frameCount / 8) byte] [frame 0] [frame 1] ...
+// Setiap frame diawali satu byte mask, bit r = baris r ditulis literal:
+//   typeBits bit f = 0 (DELTA): baris tanpa bit = sama dengan baris r frame sebelumnya
+//   typeBits bit f = 1 (RUN):   baris tanpa bit = sama dengan baris r-1 frame ini
+//                               (baris 0 tanpa bit = baris 0 frame sebelumnya)
+// Frame sebelum frame 0 dianggap semua nol.
+#define ANIMPACK_FRAME_DELTA 0
+#define ANIMPACK_FRAME_RUN 1
+#define ANIMPACK_MAX_FRAMES 255
+
+// Descriptor kumpulan pola terkompresi (index dan data ada di PROGMEM)
+typedef struct {
+    uint8_t count;              // Jumlah pola
+    const uint16_t* index;      // Offset awal setiap pola di data
+    const uint8_t* data;
+    uint16_t size;              // Ukuran data terkompresi (byte)
+} AnimationPack;
+
+// Streaming reader: hanya menyimpan frame terakhir, tanpa alokasi
+typedef struct {
+    const uint8_t* cursor;      // Posisi frame berikutnya (PROGMEM)
+    const uint8_t* typeBits;    // (PROGMEM)
+    uint8_t frameCount;
+    uint8_t frameIndex;         // Frame yang sudah di-decode
+    uint8_t frame[FB_ROWS];     // Hasil decode frame terakhir
+} AnimpackReader;
+
+// Function Prototypes
+// Reader
+bool animpackReaderOpen(AnimpackReader* reader, const AnimationPack* pack, uint8_t pattern);
+bool animpackReaderNext(AnimpackReader* reader);
+
+// Rendering
+uint8_t animpackFrameCount(const AnimationPack* pack, uint8_t pattern);
+bool animpackRenderWindow(const AnimationPack* pack, uint8_t pattern, uint16_t step,
+                          uint8_t frame[][FB_ROWS], uint8_t devices);
+
+// ===== ENCODER (compile-time) =====
+// Sumber pola berupa strip baris (kelipatan 8) dengan jumlah frame sendiri per pola:
+//   - [Count][Rows]: semua pola sama panjang (Rows / 8 frame)
+//   - rows[] + frames[Count]: strip pola disambung berurutan, frames[p] = panjang pola p
+// Encoder dijalankan compiler lewat constexpr, sehingga hanya hasil kompresi yang
+// masuk ke flash.
+
+template<size_t Count, size_t Bytes>
+struct AnimpackStorage {
+    uint16_t index[Count];
+    uint8_t data[Bytes];
+};
+
+// Panjang encoding satu frame; out boleh nullptr (hanya menghitung)
+constexpr uint8_t animpackEncodeFrame(const uint8_t* rows, const uint8_t* prev, uint8_t* out, bool* isRun) {
+    uint8_t deltaMask = 0;
+    uint8_t deltaLength = 1;
+    uint8_t runMask = 0;
+    uint8_t runLength = 1;
+
+    for (uint8_t r = 0; r < FB_ROWS; r++) {
+        if (rows[r] != prev[r]) {
+            deltaMask |= (1 << r);
+            deltaLength++;
+        }
+        uint8_t above = (r == 0) ? prev[0] : rows[r - 1];
+        if (rows[r] != above) {
+            runMask |= (1 << r);
+            runLength++;
+        }
+    }
+
+    bool run = runLength < deltaLength;
+    uint8_t mask = run ? runMask : deltaMask;
+    if (isRun) *isRun = run;
+    if (out) {
+        uint8_t length = 0;
+        out[length++] = mask;
+        for (uint8_t r = 0; r < FB_ROWS; r++) {
+            if (mask & (1 << r)) out[length++] = rows[r];
+        }
+    }
+    return run ? runLength : deltaLength;
+}
+
+// Encode satu pola (rows = strip frames * 8 baris); out boleh nullptr (hanya menghitung)
+constexpr size_t animpackEncodePattern(const uint8_t* rows, size_t frames, uint8_t* out) {
+    uint8_t zero[FB_ROWS] = {};
+    size_t offset = 0;
+    if (out) out[offset] = frames;
+    offset++;
+
+    size_t typeOffset = offset;
+    offset += (frames + 7) / 8;
+    for (size_t f = 0; f < frames; f++) {
+        const uint8_t* prev = f ? &rows[(f - 1) * FB_ROWS] : zero;
+        bool run = false;
+        offset += animpackEncodeFrame(&rows[f * FB_ROWS], prev, out ? &out[offset] : nullptr, &run);
+        if (out && run) out[typeOffset + f / 8] |= (1 << (f % 8));
+    }
+    return offset;
+}
+
+// Jumlah baris yang dibutuhkan tabel frames[], untuk static_assert di sisi pemanggil
+template<size_t Count>
+constexpr size_t animpackTotalRows(const uint8_t (&frames)[Count]) {
+    size_t rows = 0;
+    for (size_t p = 0; p < Count; p++) {
+        rows += frames[p] * FB_ROWS;
+    }
+    return rows;
+}
+
+template<size_t Count, size_t Rows>
+constexpr size_t animpackEncodedSize(const uint8_t (&source)[Count][Rows]) {
+    static_assert(Rows % FB_ROWS == 0, "Pola harus kelipatan 8 baris");
+    static_assert(Rows / FB_ROWS <= ANIMPACK_MAX_FRAMES, "Pola terlalu panjang");
+
+    size_t size = 0;
+    for (size_t p = 0; p < Count; p++) {
+        size += animpackEncodePattern(source[p], Rows / FB_ROWS, nullptr);
+    }
+    return size;
+}
+
+template<size_t Count, size_t Rows>
+constexpr size_t animpackEncodedSize(const uint8_t (&rows)[Rows], const uint8_t (&frames)[Count]) {
+    size_t size = 0;
+    size_t start = 0;
+    for (size_t p = 0; p < Count; p++) {
+        size += animpackEncodePattern(&rows[start], frames[p], nullptr);
+        start += frames[p] * FB_ROWS;
+    }
+    return size;
+}
+
+template<size_t Bytes, size_t Count, size_t Rows>
+constexpr AnimpackStorage<Count, Bytes> animpackEncode(const uint8_t (&source)[Count][Rows]) {
+    static_assert(Bytes <= 0xFFFF, "Data terkompresi melebihi index 16-bit");
+
+    AnimpackStorage<Count, Bytes> storage = {};
+    size_t offset = 0;
+    for (size_t p = 0; p < Count; p++) {
+        storage.index[p] = offset;
+        offset += animpackEncodePattern(source[p], Rows / FB_ROWS, &storage.data[offset]);
+    }
+    return storage;
+}
+
+// frames[p] 1..ANIMPACK_MAX_FRAMES; pastikan animpackTotalRows(frames) == Rows
+template<size_t Bytes, size_t Count, size_t Rows>
+constexpr AnimpackStorage<Count, Bytes> animpackEncode(const uint8_t (&rows)[Rows], const uint8_t (&frames)[Count]) {
+    static_assert(Bytes <= 0xFFFF, "Data terkompresi melebihi index 16-bit");
+
+    AnimpackStorage<Count, Bytes> storage = {};
+    size_t offset = 0;
+    size_t start = 0;
+    for (size_t p = 0; p < Count; p++) {
+        storage.index[p] = offset;
+        offset += animpackEncodePattern(&rows[start], frames[p], &storage.data[offset]);
+        start += frames[p] * FB_ROWS;
+    }
+    return storage;
+}
+
+#endif // ANIMPACK_H
@@ -0,0 +1,261 @@
+#include "animupload.h"
+#include <Arduino.h>
+#include <FS.h>
+
+// Build Information
+#define ANIMUPLOAD_CPP_VERSION "1.0.0"
+#define ANIMUPLOAD_CPP_BUILD_DATE "2026-10-17 22:03:17"
+#define ANIMUPLOAD_CPP_AUTHOR "Brodot23"
+
+// Satu upload aktif; file ditulis ke .tmp dan baru menggantikan .anim setelah lengkap
+static File uploadFile;
+static bool sessionActive = false;
+static uint8_t sessionError = ANIMUPLOAD_OK;
+static uint8_t uploadSlot = 0;
+static uint32_t startMicros = 0;
+
+static uint8_t header[ANIMFILE_HEADER_SIZE];
+static uint8_t headerFilled = 0;
+static uint32_t expectedBytes = 0;  // Data frame menurut header
+static uint32_t receivedBytes = 0;  // Data frame yang sudah diterima
+
+static uint8_t block[ANIMUPLOAD_BLOCK_SIZE];
+static uint16_t blockFilled = 0;
+static uint32_t fileBytes = 0;      // Byte yang sudah ditulis ke flash
+
+static AnimUploadStats uploadStats;
+
+// ===== IMPLEMENTASI FUNGSI FILE =====
+
+static void tempPath(uint8_t slot, char* buffer, size_t size) {
+    snprintf(buffer, size, "%s/%u.tmp", ANIMFILE_DIR, (unsigned)slot);
+}
+
+static uint16_t readLe16(const uint8_t* p) {
+    return p[0] | (p[1] << 8);
+}
+
+// Tolak sisa upload: file sementara dibuang, potongan berikutnya hanya dihitung
+static bool fail(uint8_t error) {
+    if (sessionError == ANIMUPLOAD_OK) {
+        sessionError = error;
+        uploadStats.lastError = error;
+        if (uploadFile) {
+            uploadFile.close();
+        }
+        char path[ANIMFILE_PATH_LENGTH];
+        tempPath(uploadSlot, path, sizeof(path));
+        SPIFFS.remove(path);
+    }
+    return false;
+}
+
+static bool flushBlock() {
+    if (blockFilled == 0) return true;
+    uint32_t start = micros();
+    size_t written = uploadFile.write(block, blockFilled);
+    uint32_t elapsed = micros() - start;
+    if (written != blockFilled) {
+        return fail(ANIMUPLOAD_ERR_WRITE);
+    }
+    uploadStats.blocks++;
+    uploadStats.maxBlockMicros = max(uploadStats.maxBlockMicros, elapsed);
+    fileBytes += blockFilled;
+    blockFilled = 0;
+    return true;
+}
+
+static bool appendBlock(const uint8_t* data, size_t length) {
+    while (length > 0) {
+        size_t count = min(length, (size_t)(ANIMUPLOAD_BLOCK_SIZE - blockFilled));
+        memcpy(block + blockFilled, data, count);
+        blockFilled += count;
+        data += count;
+        length -= count;
+        if (blockFilled == ANIMUPLOAD_BLOCK_SIZE && !flushBlock()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ===== IMPLEMENTASI FUNGSI VALIDASI =====
+
+// Dipanggil sekali begitu header lengkap, sebelum satu byte pun ditulis ke flash
+static bool validateHeader() {
+    uint8_t devices = header[5];
+    uint16_t frameCount = readLe16(&header[6]);
+    uint16_t frameDelay = readLe16(&header[8]);
+
+    if (memcmp(header, ANIMFILE_MAGIC, 4) != 0 || header[4] != ANIMFILE_FORMAT_VERSION ||
+        (frameDelay != 0 && (frameDelay < ANIMUPLOAD_MIN_DELAY || frameDelay > ANIMUPLOAD_MAX_DELAY))) {
+        return fail(ANIMUPLOAD_ERR_HEADER);
+    }
+    if (devices == 0 || devices > FB_MAX_DEVICES) {
+        return fail(ANIMUPLOAD_ERR_DIMENSIONS);
+    }
+    if (frameCount == 0 || frameCount > ANIMUPLOAD_MAX_FRAMES) {
+        return fail(ANIMUPLOAD_ERR_FRAMES);
+    }
+    expectedBytes = (uint32_t)frameCount * devices * FB_ROWS;
+
+    // File lama tetap ada sampai rename, jadi file baru harus muat seluruhnya
+    FSInfo info;
+    if (SPIFFS.info(info) &&
+        ANIMFILE_HEADER_SIZE + expectedBytes + ANIMUPLOAD_FREE_RESERVE > info.totalBytes - info.usedBytes) {
+        return fail(ANIMUPLOAD_ERR_SPACE);
+    }
+
+    char path[ANIMFILE_PATH_LENGTH];
+    tempPath(uploadSlot, path, sizeof(path));
+    uploadFile = SPIFFS.open(path, "w");
+    if (!uploadFile) {
+        return fail(ANIMUPLOAD_ERR_WRITE);
+    }
+    return appendBlock(header, ANIMFILE_HEADER_SIZE);
+}
+
+// ===== IMPLEMENTASI FUNGSI SESSION =====
+
+bool animuploadBegin(uint8_t slot) {
+    animuploadAbort();
+    sessionActive = true;
+    sessionError = ANIMUPLOAD_OK;
+    uploadSlot = slot;
+    startMicros = micros();
+    headerFilled = 0;
+    expectedBytes = 0;
+    receivedBytes = 0;
+    blockFilled = 0;
+    fileBytes = 0;
+    uploadStats.started++;
+
+    if (slot >= ANIMUPLOAD_SLOT_COUNT) {
+        return fail(ANIMUPLOAD_ERR_SLOT);
+    }
+    return true;
+}
+
+bool animuploadWrite(const uint8_t* data, size_t length) {
+    if (!sessionActive) return false;
+    uploadStats.bytes += length;
+    if (sessionError != ANIMUPLOAD_OK) return false;
+
+    if (headerFilled < ANIMFILE_HEADER_SIZE) {
+        size_t count = min(length, (size_t)(ANIMFILE_HEADER_SIZE - headerFilled));
+        memcpy(header + headerFilled, data, count);
+        headerFilled += count;
+        data += count;
+        length -= count;
+        if (headerFilled == ANIMFILE_HEADER_SIZE && !validateHeader()) {
+            return false;
+        }
+    }
+    if (length == 0) return true;
+
+    if (receivedBytes + length > expectedBytes) {
+        return fail(ANIMUPLOAD_ERR_TOO_LONG);
+    }
+    receivedBytes += length;
+    return appendBlock(data, length);
+}
+
+bool animuploadFinish(AnimUploadResult* result) {
+    if (!sessionActive) return false;
+    sessionActive = false;
+
+    if (sessionError == ANIMUPLOAD_OK &&
+        (headerFilled < ANIMFILE_HEADER_SIZE || receivedBytes < expectedBytes)) {
+        fail(ANIMUPLOAD_ERR_TRUNCATED);
+    }
+    if (sessionError == ANIMUPLOAD_OK && flushBlock()) {
+        uploadFile.close();
+
+        // Entry yang sedang diputar ditutup dulu; displayAnimationFile() membuka file baru
+        uint8_t entry = ANIMFILE_PLAYLIST_BASE + uploadSlot;
+        if (animfileIsOpen() && animfileCurrentEntry() == entry) {
+            animfileClose();
+        }
+        char path[ANIMFILE_PATH_LENGTH];
+        char temp[ANIMFILE_PATH_LENGTH];
+        animfilePath(entry, path, sizeof(path));
+        tempPath(uploadSlot, temp, sizeof(temp));
+        bool replaced = SPIFFS.exists(path);
+        if (replaced) {
+            SPIFFS.remove(path);
+        }
+        if (SPIFFS.rename(temp, path)) {
+            if (result) {
+                result->entry = entry;
+                result->devices = header[5];
+                result->frameCount = readLe16(&header[6]);
+                result->frameDelay = readLe16(&header[8]);
+                result->bytes = fileBytes;
+                result->replaced = replaced;
+            }
+            uploadStats.completed++;
+            uploadStats.lastMicros = micros() - startMicros;
+            uploadStats.lastError = ANIMUPLOAD_OK;
+            return true;
+        }
+        fail(ANIMUPLOAD_ERR_WRITE);
+        SPIFFS.remove(temp);
+    }
+    uploadStats.rejected++;
+    return false;
+}
+
+void animuploadAbort() {
+    if (!sessionActive) return;
+    fail(ANIMUPLOAD_ERR_ABORTED);
+    sessionError = ANIMUPLOAD_ERR_ABORTED;
+    sessionActive = false;
+    uploadStats.aborted++;
+}
+
+bool animuploadActive() {
+    return sessionActive;
+}
+
+// ===== IMPLEMENTASI FUNGSI ERROR =====
+
+uint8_t animuploadError() {
+    return sessionError;
+}
+
+const char* animuploadErrorText(uint8_t error) {
+    switch (error) {
+        case ANIMUPLOAD_OK:             return "OK";
+        case ANIMUPLOAD_ERR_SLOT:       return "Invalid or no free pattern slot";
+        case ANIMUPLOAD_ERR_HEADER:     return "Invalid animation header";
+        case ANIMUPLOAD_ERR_DIMENSIONS: return "Invalid module count";
+        case ANIMUPLOAD_ERR_FRAMES:     return "Invalid frame count";
+        case ANIMUPLOAD_ERR_TOO_LONG:   return "More data than frameCount";
+        case ANIMUPLOAD_ERR_TRUNCATED:  return "Upload ended before last frame";
+        case ANIMUPLOAD_ERR_SPACE:      return "Not enough SPIFFS space";
+        case ANIMUPLOAD_ERR_WRITE:      return "Flash write failed";
+        case ANIMUPLOAD_ERR_ABORTED:    return "Upload aborted";
+        default:                        return "Unknown error";
+    }
+}
+
+// ===== IMPLEMENTASI FUNGSI SLOT =====
+
+uint8_t animuploadFreeSlot() {
+    for (uint8_t slot = 0; slot < ANIMUPLOAD_SLOT_COUNT; slot++) {
+        if (!animfileExists(ANIMFILE_PLAYLIST_BASE + slot)) {
+            return slot;
+        }
+    }
+    return ANIMUPLOAD_NONE;
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTIK =====
+
+const AnimUploadStats* animuploadGetStats() {
+    return &uploadStats;
+}
+
+void animuploadResetStats() {
+    memset(&uploadStats, 0, sizeof(uploadStats));
+}
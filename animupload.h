@@ -0,0 +1,81 @@
+#ifndef ANIMUPLOAD_H
+#define ANIMUPLOAD_H
+
+#include "settings.h"
+#include "framebuffer.h"
+#include "animfile.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// Build Information
+#define ANIMUPLOAD_VERSION "1.0.0"
+#define ANIMUPLOAD_BUILD_DATE "2026-10-17 22:03:17"
+#define ANIMUPLOAD_AUTHOR "Brodot23"
+
+// Upload pola kustom (file format animfile.h) yang di-stream langsung ke SPIFFS:
+// body diterima per potongan (HTTPUpload), header divalidasi begitu 12 byte pertama
+// lengkap, data frame dihitung terhadap header saat datang, dan flash ditulis per
+// blok tetap. RAM yang dipakai hanya satu blok, berapapun panjang animasinya.
+#define ANIMUPLOAD_BLOCK_SIZE 256       // Satu halaman SPIFFS per tulis
+#define ANIMUPLOAD_SLOT_COUNT 32        // Entry playlist ANIMFILE_PLAYLIST_BASE + 0..31
+#define ANIMUPLOAD_MAX_FRAMES 1024
+#define ANIMUPLOAD_MIN_DELAY 20         // ms per frame, 0 = settings.animationSpeed
+#define ANIMUPLOAD_MAX_DELAY 10000
+#define ANIMUPLOAD_FREE_RESERVE 8192    // Ruang SPIFFS yang disisakan untuk preset/web
+#define ANIMUPLOAD_NONE 0xFF
+
+// Error Codes
+#define ANIMUPLOAD_OK 0
+#define ANIMUPLOAD_ERR_SLOT 1           // Slot di luar jangkauan / tidak ada slot kosong
+#define ANIMUPLOAD_ERR_HEADER 2         // Magic, versi atau frameDelay tidak valid
+#define ANIMUPLOAD_ERR_DIMENSIONS 3     // devices 0 atau > FB_MAX_DEVICES
+#define ANIMUPLOAD_ERR_FRAMES 4         // frameCount 0 atau > ANIMUPLOAD_MAX_FRAMES
+#define ANIMUPLOAD_ERR_TOO_LONG 5       // Data melebihi frameCount x devices x 8
+#define ANIMUPLOAD_ERR_TRUNCATED 6      // Body berakhir sebelum frame terakhir
+#define ANIMUPLOAD_ERR_SPACE 7          // SPIFFS tidak cukup
+#define ANIMUPLOAD_ERR_WRITE 8          // Gagal buka/tulis/rename file
+#define ANIMUPLOAD_ERR_ABORTED 9        // Klien putus di tengah upload
+
+// Upload yang berhasil
+typedef struct {
+    uint8_t entry;              // Entry playlist (ANIMFILE_PLAYLIST_BASE + slot)
+    uint8_t devices;
+    uint16_t frameCount;
+    uint16_t frameDelay;
+    uint32_t bytes;             // Ukuran file termasuk header
+    bool replaced;              // Menimpa file yang sudah ada
+} AnimUploadResult;
+
+// Upload Statistics
+typedef struct {
+    uint32_t started;
+    uint32_t completed;
+    uint32_t rejected;          // Ditolak validasi / gagal tulis
+    uint32_t aborted;
+    uint32_t bytes;             // Byte body yang diterima
+    uint32_t blocks;            // Blok yang ditulis ke flash
+    uint32_t maxBlockMicros;    // Tulis blok terlama
+    uint32_t lastMicros;        // Durasi upload terakhir yang berhasil (begin..finish)
+    uint8_t lastError;
+} AnimUploadStats;
+
+// Function Prototypes
+// Session: begin -> write... -> finish, atau abort kapan saja
+bool animuploadBegin(uint8_t slot);
+bool animuploadWrite(const uint8_t* data, size_t length);
+bool animuploadFinish(AnimUploadResult* result);
+void animuploadAbort();
+bool animuploadActive();
+
+// Errors
+uint8_t animuploadError();
+const char* animuploadErrorText(uint8_t error);
+
+// Slots
+uint8_t animuploadFreeSlot();
+
+// Statistics
+const AnimUploadStats* animuploadGetStats();
+void animuploadResetStats();
+
+#endif // ANIMUPLOAD_H
@@ -0,0 +1,240 @@
+#include "bitplane.h"
+#include "settings.h"
+#include <Arduino.h>
+
+// Build Information
+#define BITPLANE_CPP_VERSION "1.0.0"
+#define BITPLANE_CPP_BUILD_DATE "2026-10-17 16:05:40"
+#define BITPLANE_CPP_AUTHOR "Brodot23"
+
+// Pack/unpack adalah transpose matriks byte 8x8 (modul x baris <-> baris x modul)
+static_assert(FB_MAX_DEVICES == 8 && FB_ROWS == 8, "bitplane mengasumsikan 8 modul x 8 baris");
+
+// ===== IMPLEMENTASI FUNGSI INTERNAL =====
+
+static inline uint64_t loadWord(const uint8_t* rows) {
+    uint64_t word;
+    memcpy(&word, rows, sizeof(word));
+    return word;
+}
+
+static inline void storeWord(uint8_t* rows, uint64_t word) {
+    memcpy(rows, &word, sizeof(word));
+}
+
+static inline uint64_t widthMask(uint8_t width) {
+    if (width == 0) return 0;
+    return (width >= BITPLANE_MAX_WIDTH) ? ~(uint64_t)0 : ~(uint64_t)0 << (BITPLANE_MAX_WIDTH - width);
+}
+
+// Tukar blok byte antar word: byte j+k word i <-> byte j word i+k (j & k == 0)
+#define SWAP_BYTE_BLOCK(a, i, k, mask) do { \
+        uint64_t t = (((a)[i] >> (8 * (k))) ^ (a)[(i) + (k)]) & (mask); \
+        (a)[(i) + (k)] ^= t; \
+        (a)[i] ^= t << (8 * (k)); \
+    } while (0)
+
+// Transpose byte 8x8: byte j word i <-> byte i word j, 3 tahap x 4 swap
+static inline void transposeBytes(uint64_t a[8]) {
+    const uint64_t m4 = 0x00000000FFFFFFFFULL;
+    const uint64_t m2 = 0x0000FFFF0000FFFFULL;
+    const uint64_t m1 = 0x00FF00FF00FF00FFULL;
+    SWAP_BYTE_BLOCK(a, 0, 4, m4); SWAP_BYTE_BLOCK(a, 1, 4, m4);
+    SWAP_BYTE_BLOCK(a, 2, 4, m4); SWAP_BYTE_BLOCK(a, 3, 4, m4);
+    SWAP_BYTE_BLOCK(a, 0, 2, m2); SWAP_BYTE_BLOCK(a, 1, 2, m2);
+    SWAP_BYTE_BLOCK(a, 4, 2, m2); SWAP_BYTE_BLOCK(a, 5, 2, m2);
+    SWAP_BYTE_BLOCK(a, 0, 1, m1); SWAP_BYTE_BLOCK(a, 2, 1, m1);
+    SWAP_BYTE_BLOCK(a, 4, 1, m1); SWAP_BYTE_BLOCK(a, 6, 1, m1);
+}
+
+// Baris bitplane (modul 0 di byte teratas) -> word per modul (byte r = baris r)
+static inline void rowsToModules(const uint64_t rows[8], uint64_t words[8]) {
+    for (uint8_t i = 0; i < 8; i++) {
+        words[i] = __builtin_bswap64(rows[i]);
+    }
+    transposeBytes(words);
+}
+
+static inline void modulesToRows(uint64_t words[8], uint64_t rows[8]) {
+    transposeBytes(words);
+    for (uint8_t i = 0; i < 8; i++) {
+        rows[i] = __builtin_bswap64(words[i]);
+    }
+}
+
+// ===== IMPLEMENTASI FUNGSI KONVERSI =====
+
+void bitplanePack(BitPlane* plane, const uint8_t frame[][FB_ROWS], uint8_t devices) {
+    devices = constrain(devices, 1, FB_MAX_DEVICES);
+    uint64_t words[FB_MAX_DEVICES];
+    for (uint8_t d = 0; d < FB_MAX_DEVICES; d++) {
+        words[d] = (d < devices) ? loadWord(frame[d]) : 0;
+    }
+    modulesToRows(words, plane->rows);
+    plane->width = devices * 8;
+}
+
+void bitplaneUnpack(const BitPlane* plane, uint8_t frame[][FB_ROWS]) {
+    uint64_t words[FB_MAX_DEVICES];
+    rowsToModules(plane->rows, words);
+    for (uint8_t d = 0; d < plane->width / 8; d++) {
+        storeWord(frame[d], words[d]);
+    }
+}
+
+void bitplaneClear(BitPlane* plane, uint8_t devices) {
+    memset(plane->rows, 0, sizeof(plane->rows));
+    plane->width = constrain(devices, 1, FB_MAX_DEVICES) * 8;
+}
+
+// ===== IMPLEMENTASI FUNGSI PIKSEL =====
+
+void bitplaneSetPixel(BitPlane* plane, uint8_t x, uint8_t y, bool state) {
+    if (x >= plane->width || y >= FB_ROWS) return;
+    uint64_t bit = (uint64_t)1 << (63 - x);
+    plane->rows[y] = state ? (plane->rows[y] | bit) : (plane->rows[y] & ~bit);
+}
+
+bool bitplaneGetPixel(const BitPlane* plane, uint8_t x, uint8_t y) {
+    if (x >= plane->width || y >= FB_ROWS) return false;
+    return (plane->rows[y] >> (63 - x)) & 1;
+}
+
+void bitplaneSetColumn(BitPlane* plane, uint8_t col, uint8_t value) {
+    if (col >= plane->width) return;
+    uint8_t shift = 63 - col;
+    for (uint8_t r = 0; r < FB_ROWS; r++) {
+        plane->rows[r] = (plane->rows[r] & ~((uint64_t)1 << shift)) | ((uint64_t)((value >> r) & 1) << shift);
+    }
+}
+
+uint8_t bitplaneGetColumn(const BitPlane* plane, uint8_t col) {
+    if (col >= plane->width) return 0;
+    uint8_t value = 0;
+    for (uint8_t r = 0; r < FB_ROWS; r++) {
+        value |= ((plane->rows[r] >> (63 - col)) & 1) << r;
+    }
+    return value;
+}
+
+// ===== IMPLEMENTASI FUNGSI TRANSFORM =====
+
+// Satu rotate per baris untuk seluruh chain, tidak ada carry antar modul
+void bitplaneScrollLeft(BitPlane* plane, uint8_t positions) {
+    uint8_t width = plane->width;
+    if (width == 0) return;
+    positions %= width;
+    if (positions == 0) return;
+
+    uint64_t mask = widthMask(width);
+    for (uint8_t r = 0; r < FB_ROWS; r++) {
+        uint64_t row = plane->rows[r];
+        plane->rows[r] = ((row << positions) | (row >> (width - positions))) & mask;
+    }
+}
+
+void bitplaneScrollRight(BitPlane* plane, uint8_t positions) {
+    if (plane->width == 0) return;
+    bitplaneScrollLeft(plane, plane->width - positions % plane->width);
+}
+
+void bitplaneShift(BitPlane* plane, int8_t x, int8_t y) {
+    uint64_t mask = widthMask(plane->width);
+    int16_t dx = x;
+    for (uint8_t r = 0; r < FB_ROWS; r++) {
+        uint64_t row = plane->rows[r];
+        if (dx >= plane->width || -dx >= plane->width) {
+            row = 0;
+        } else if (dx > 0) {
+            row = (row >> dx) & mask;
+        } else if (dx < 0) {
+            row <<= -dx;
+        }
+        plane->rows[r] = row;
+    }
+
+    if (y > 0) {
+        for (int8_t r = FB_ROWS - 1; r >= 0; r--) {
+            plane->rows[r] = (r >= y) ? plane->rows[r - y] : 0;
+        }
+    } else if (y < 0) {
+        for (int8_t r = 0; r < FB_ROWS; r++) {
+            plane->rows[r] = (r - y < FB_ROWS) ? plane->rows[r - y] : 0;
+        }
+    }
+}
+
+void bitplaneMirror(BitPlane* plane, bool horizontal, bool vertical) {
+    if (horizontal && plane->width) {
+        // Balik 64 bit (balik bit per byte + balik urutan byte), lalu rapatkan ke kiri
+        uint8_t unused = BITPLANE_MAX_WIDTH - plane->width;
+        for (uint8_t r = 0; r < FB_ROWS; r++) {
+            plane->rows[r] = __builtin_bswap64(bitplaneMirrorModule(plane->rows[r])) << unused;
+        }
+    }
+    if (vertical) {
+        for (uint8_t r = 0; r < FB_ROWS / 2; r++) {
+            uint64_t t = plane->rows[r];
+            plane->rows[r] = plane->rows[FB_ROWS - 1 - r];
+            plane->rows[FB_ROWS - 1 - r] = t;
+        }
+    }
+}
+
+void bitplaneRotate(BitPlane* plane, uint8_t quarterTurns) {
+    quarterTurns &= 3;
+    if (quarterTurns == BITPLANE_ROTATE_0) return;
+
+    uint64_t words[FB_MAX_DEVICES];
+    rowsToModules(plane->rows, words);
+    for (uint8_t d = 0; d < plane->width / 8; d++) {
+        words[d] = bitplaneRotateModule(words[d], quarterTurns);
+    }
+    modulesToRows(words, plane->rows);
+}
+
+void bitplaneInvert(BitPlane* plane) {
+    uint64_t mask = widthMask(plane->width);
+    for (uint8_t r = 0; r < FB_ROWS; r++) {
+        plane->rows[r] ^= mask;
+    }
+}
+
+// ===== IMPLEMENTASI KERNEL 8x8 =====
+
+// Transpose bit 8x8 (Hacker's Delight): bit 8i+j <-> bit 8j+i. Karena kolom c = bit 7-c,
+// hasilnya transpose terhadap anti-diagonal: baru(R, C) = lama(7-C, 7-R).
+uint64_t bitplaneTranspose8(uint64_t x) {
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x = x ^ t ^ (t << 28);
+    return x;
+}
+
+// Cermin kiri-kanan: reverseByte untuk 8 baris sekaligus
+uint64_t bitplaneMirrorModule(uint64_t x) {
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return x;
+}
+
+// Rotasi = transpose + cermin (atas-bawah = bswap, kiri-kanan = bitplaneMirrorModule)
+uint64_t bitplaneRotateModule(uint64_t module, uint8_t quarterTurns) {
+    switch (quarterTurns & 3) {
+        case BITPLANE_ROTATE_90:
+            // baru(R, C) = lama(7-C, R)
+            return __builtin_bswap64(bitplaneTranspose8(module));
+        case BITPLANE_ROTATE_180:
+            return __builtin_bswap64(bitplaneMirrorModule(module));
+        case BITPLANE_ROTATE_270:
+            // baru(R, C) = lama(C, 7-R)
+            return bitplaneMirrorModule(bitplaneTranspose8(module));
+        default:
+            return module;
+    }
+}
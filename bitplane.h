@@ -0,0 +1,55 @@
+#ifndef BITPLANE_H
+#define BITPLANE_H
+
+#include "settings.h"
+#include "framebuffer.h"
+#include <stdint.h>
+
+// Build Information
+#define BITPLANE_VERSION "1.0.0"
+#define BITPLANE_BUILD_DATE "2026-10-17 16:05:40"
+#define BITPLANE_AUTHOR "Brodot23"
+
+// Bitplane: satu word 64-bit per baris untuk seluruh lebar chain (maks FB_MAX_DEVICES x 8 kolom).
+// Bit 63 = kolom 0 (kiri), kolom c = bit 63-c, sehingga modul d = byte atas ke-d dari word
+// dan urutan bit dalam byte sama dengan baris MAX7219 (bit 7 = kolom kiri modul).
+// Kolom di luar lebar chain (bit bawah) selalu nol.
+#define BITPLANE_MAX_WIDTH (FB_MAX_DEVICES * 8)
+
+// Rotasi per modul 8x8 (kelipatan 90 derajat searah jarum jam)
+#define BITPLANE_ROTATE_0 0
+#define BITPLANE_ROTATE_90 1
+#define BITPLANE_ROTATE_180 2
+#define BITPLANE_ROTATE_270 3
+
+typedef struct {
+    uint64_t rows[FB_ROWS];
+    uint8_t width;              // Kolom terpakai (devices x 8)
+} BitPlane;
+
+// Function Prototypes
+// Conversion (frame [device][row] <-> bitplane)
+void bitplanePack(BitPlane* plane, const uint8_t frame[][FB_ROWS], uint8_t devices);
+void bitplaneUnpack(const BitPlane* plane, uint8_t frame[][FB_ROWS]);
+void bitplaneClear(BitPlane* plane, uint8_t devices);
+
+// Pixel Access
+void bitplaneSetPixel(BitPlane* plane, uint8_t x, uint8_t y, bool state);
+bool bitplaneGetPixel(const BitPlane* plane, uint8_t x, uint8_t y);
+void bitplaneSetColumn(BitPlane* plane, uint8_t col, uint8_t value);    // bit r = baris r
+uint8_t bitplaneGetColumn(const BitPlane* plane, uint8_t col);
+
+// Transforms (pengganti transform display.h; bitplaneMirror dipakai animationRender untuk sisi kanan)
+void bitplaneScrollLeft(BitPlane* plane, uint8_t positions);     // Wrap di dalam lebar chain
+void bitplaneScrollRight(BitPlane* plane, uint8_t positions);
+void bitplaneShift(BitPlane* plane, int8_t x, int8_t y);          // Isi nol, x > 0 ke kanan, y > 0 ke bawah
+void bitplaneMirror(BitPlane* plane, bool horizontal, bool vertical);
+void bitplaneRotate(BitPlane* plane, uint8_t quarterTurns);        // Setiap modul diputar di tempat
+void bitplaneInvert(BitPlane* plane);
+
+// 8x8 Kernels (word modul: byte r = baris r, bit 7 = kolom kiri)
+uint64_t bitplaneTranspose8(uint64_t module);     // Transpose terhadap anti-diagonal
+uint64_t bitplaneMirrorModule(uint64_t module);   // Balik bit di setiap byte
+uint64_t bitplaneRotateModule(uint64_t module, uint8_t quarterTurns);
+
+#endif // BITPLANE_H
@@ -0,0 +1,264 @@
+#include "compositor.h"
+#include "scheduler.h"
+#include "settings.h"
+#include <Arduino.h>
+
+// Build Information
+#define COMPOSITOR_CPP_VERSION "1.0.0"
+#define COMPOSITOR_CPP_BUILD_DATE "2026-10-17 15:40:27"
+#define COMPOSITOR_CPP_AUTHOR "Brodot23"
+
+typedef struct {
+    uint64_t pixels[FB_MAX_DEVICES];    // Isi layer, satu word per modul
+    uint64_t coverage[FB_MAX_DEVICES];  // Piksel yang menutupi layer di bawahnya
+    uint16_t moduleMask;                // Modul yang ditutup penuh
+    bool pixelCoverage;                 // Piksel menyala ikut menutupi (latar transparan)
+    bool enabled;
+    bool invalid;                       // Harus dirender ulang walau timer belum jatuh tempo
+    uint16_t intensity;                 // Target intensity channel (framebuffer.h)
+    bool fading;
+    uint32_t fadeEnd;                   // millis() saat fade layer selesai
+} CompositorLayer;
+
+static CompositorLayer layers[LAYER_COUNT];
+static uint8_t compDevices = 0;
+static bool composeDirty = false;       // Ada layer yang berubah sejak komposit terakhir
+static bool ownersDirty = false;        // Coverage/enable berubah, pemilik modul dihitung ulang
+
+// Layer teratas yang menutupi modul, menentukan intensity modul itu
+static uint8_t owner[FB_MAX_DEVICES];
+
+static CompositorStats compStats;
+
+// ===== IMPLEMENTASI FUNGSI INTERNAL =====
+
+static inline uint64_t loadWord(const uint8_t* rows) {
+    uint64_t word;
+    memcpy(&word, rows, sizeof(word));
+    return word;
+}
+
+static inline void storeWord(uint8_t* rows, uint64_t word) {
+    memcpy(rows, &word, sizeof(word));
+}
+
+static void updateCoverage(CompositorLayer* l) {
+    for (uint8_t d = 0; d < compDevices; d++) {
+        uint64_t full = (l->moduleMask & (1 << d)) ? ~(uint64_t)0 : 0;
+        l->coverage[d] = full | (l->pixelCoverage ? l->pixels[d] : 0);
+    }
+}
+
+static void applyOwnerIntensity(uint8_t device) {
+    const CompositorLayer* l = &layers[owner[device]];
+    uint32_t now = millis();
+    if (l->fading && (int32_t)(l->fadeEnd - now) > 0) {
+        framebufferFadeTo(device, l->intensity, l->fadeEnd - now);
+    } else {
+        framebufferSetIntensity(device, l->intensity);
+    }
+}
+
+// Layer di bawah yang baru terlihat lagi belum tentu punya isi terbaru
+static void invalidateBelow(uint8_t layer) {
+    for (uint8_t lower = 0; lower < layer; lower++) {
+        layers[lower].invalid = true;
+    }
+}
+
+static void updateOwners() {
+    if (!ownersDirty) return;
+    ownersDirty = false;
+
+    for (uint8_t d = 0; d < compDevices; d++) {
+        uint8_t top = LAYER_IDLE;
+        for (int8_t layer = LAYER_COUNT - 1; layer > LAYER_IDLE; layer--) {
+            if (layers[layer].enabled && layers[layer].coverage[d]) {
+                top = layer;
+                break;
+            }
+        }
+        if (owner[d] != top) {
+            owner[d] = top;
+            applyOwnerIntensity(d);
+        }
+    }
+}
+
+// ===== IMPLEMENTASI FUNGSI INISIALISASI =====
+
+void compositorInit(uint8_t devices) {
+    compDevices = constrain(devices, 1, FB_MAX_DEVICES);
+    memset(layers, 0, sizeof(layers));
+    for (uint8_t layer = 0; layer < LAYER_COUNT; layer++) {
+        layers[layer].intensity = FB_INTENSITY_MAX;
+    }
+    memset(owner, LAYER_IDLE, sizeof(owner));
+    layers[LAYER_IDLE].enabled = true;
+    layers[LAYER_IDLE].invalid = true;
+    composeDirty = true;
+    ownersDirty = true;
+    compositorResetStats();
+}
+
+// ===== IMPLEMENTASI FUNGSI LAYER =====
+
+void compositorEnable(uint8_t layer, bool enabled) {
+    if (layer >= LAYER_COUNT || layers[layer].enabled == enabled) return;
+    layers[layer].enabled = enabled;
+    layers[layer].invalid = enabled;
+    invalidateBelow(layer);
+    composeDirty = true;
+    ownersDirty = true;
+}
+
+bool compositorEnabled(uint8_t layer) {
+    return layer < LAYER_COUNT && layers[layer].enabled;
+}
+
+void compositorInvalidate(uint8_t layer) {
+    if (layer >= LAYER_COUNT) return;
+    layers[layer].invalid = true;
+}
+
+void compositorInvalidateAll() {
+    for (uint8_t layer = 0; layer < LAYER_COUNT; layer++) {
+        layers[layer].invalid = true;
+    }
+}
+
+void compositorSetCoverage(uint8_t layer, uint16_t moduleMask, bool pixelCoverage) {
+    if (layer >= LAYER_COUNT) return;
+    CompositorLayer* l = &layers[layer];
+    if (l->moduleMask == moduleMask && l->pixelCoverage == pixelCoverage) return;
+    l->moduleMask = moduleMask;
+    l->pixelCoverage = pixelCoverage;
+    updateCoverage(l);
+    invalidateBelow(layer);
+    composeDirty = true;
+    ownersDirty = true;
+}
+
+// Layer tidak terlihat sama sekali: gabungan coverage layer aktif di atasnya penuh
+bool compositorOccluded(uint8_t layer) {
+    for (uint8_t d = 0; d < compDevices; d++) {
+        uint64_t above = 0;
+        for (uint8_t upper = layer + 1; upper < LAYER_COUNT; upper++) {
+            if (layers[upper].enabled) above |= layers[upper].coverage[d];
+        }
+        if (above != ~(uint64_t)0) return false;
+    }
+    return true;
+}
+
+// Render hanya untuk layer terlihat yang baru diaktifkan/di-invalidate
+// atau yang salah satu timernya (bit = ID timer scheduler) jatuh tempo
+bool compositorNeedsRender(uint8_t layer, uint16_t timerMask) {
+    if (layer >= LAYER_COUNT || !layers[layer].enabled) return false;
+    if (!compositorOccluded(layer) &&
+        (layers[layer].invalid || schedulerAnyPending(timerMask))) {
+        return true;
+    }
+    compStats.skippedRenders++;
+    return false;
+}
+
+uint8_t compositorTopLayer() {
+    for (int8_t layer = LAYER_COUNT - 1; layer > LAYER_IDLE; layer--) {
+        if (layers[layer].enabled) return layer;
+    }
+    return LAYER_IDLE;
+}
+
+// ===== IMPLEMENTASI FUNGSI KONTEN =====
+
+bool compositorCommit(uint8_t layer, const uint8_t frame[][FB_ROWS]) {
+    if (layer >= LAYER_COUNT) return false;
+    CompositorLayer* l = &layers[layer];
+    l->invalid = false;
+
+    bool changed = false;
+    for (uint8_t d = 0; d < compDevices; d++) {
+        uint64_t word = loadWord(frame[d]);
+        if (word != l->pixels[d]) {
+            l->pixels[d] = word;
+            changed = true;
+        }
+    }
+
+    if (!changed) {
+        compStats.unchangedCommits++;
+        return false;
+    }
+    if (l->pixelCoverage) {
+        updateCoverage(l);
+        ownersDirty = true;
+    }
+    composeDirty = true;
+    compStats.commits++;
+    return true;
+}
+
+bool compositorCompose(uint8_t frame[][FB_ROWS]) {
+    updateOwners();
+    if (!composeDirty) return false;
+
+    for (uint8_t d = 0; d < compDevices; d++) {
+        uint64_t out = 0;
+        for (uint8_t layer = 0; layer < LAYER_COUNT; layer++) {
+            const CompositorLayer* l = &layers[layer];
+            if (!l->enabled) continue;
+            out = (out & ~l->coverage[d]) | (l->pixels[d] & l->coverage[d]);
+        }
+        storeWord(frame[d], out);
+    }
+
+    composeDirty = false;
+    compStats.composites++;
+    return true;
+}
+
+// ===== IMPLEMENTASI FUNGSI INTENSITY =====
+
+void compositorSetIntensity(uint8_t layer, uint16_t value) {
+    if (layer >= LAYER_COUNT) return;
+    updateOwners();
+    layers[layer].intensity = value;
+    layers[layer].fading = false;
+    for (uint8_t d = 0; d < compDevices; d++) {
+        if (owner[d] == layer) framebufferSetIntensity(d, value);
+    }
+}
+
+void compositorFadeIntensity(uint8_t layer, uint16_t target, uint16_t durationMs) {
+    if (layer >= LAYER_COUNT) return;
+    updateOwners();
+    layers[layer].intensity = target;
+    layers[layer].fading = durationMs > 0;
+    layers[layer].fadeEnd = millis() + durationMs;
+    for (uint8_t d = 0; d < compDevices; d++) {
+        if (owner[d] == layer) framebufferFadeTo(d, target, durationMs);
+    }
+}
+
+uint16_t compositorGetIntensity(uint8_t layer) {
+    return (layer < LAYER_COUNT) ? layers[layer].intensity : 0;
+}
+
+bool compositorFading(uint8_t layer) {
+    if (layer >= LAYER_COUNT || !layers[layer].fading) return false;
+    if ((int32_t)(layers[layer].fadeEnd - millis()) <= 0) {
+        layers[layer].fading = false;
+    }
+    return layers[layer].fading;
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTIK =====
+
+const CompositorStats* compositorGetStats() {
+    return &compStats;
+}
+
+void compositorResetStats() {
+    memset(&compStats, 0, sizeof(compStats));
+}
@@ -0,0 +1,59 @@
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include "settings.h"
+#include "framebuffer.h"
+#include <stdint.h>
+
+// Build Information
+#define COMPOSITOR_VERSION "1.0.0"
+#define COMPOSITOR_BUILD_DATE "2026-10-17 15:40:27"
+#define COMPOSITOR_AUTHOR "Brodot23"
+
+// Layer Stack (bawah ke atas)
+#define LAYER_IDLE 0
+#define LAYER_BRAKE 1
+#define LAYER_SEIN 2
+#define LAYER_COUNT 3
+
+// Satu modul = satu word 64-bit (byte r = baris r), komposit per word:
+//   out = (out & ~coverage) | (pixels & coverage)
+#define COMPOSITOR_ALL_MODULES 0xFFFF
+
+// Compositor Statistics
+typedef struct {
+    uint32_t composites;        // Frame hasil komposit yang dibuat
+    uint32_t commits;           // Isi layer yang berubah
+    uint32_t unchangedCommits;  // Render layer yang hasilnya sama (tidak memicu komposit)
+    uint32_t skippedRenders;    // Layer aktif yang tidak dirender (tidak jatuh tempo / tertutup)
+} CompositorStats;
+
+// Function Prototypes
+// Initialization
+void compositorInit(uint8_t devices);
+
+// Layer Control
+void compositorEnable(uint8_t layer, bool enabled);
+bool compositorEnabled(uint8_t layer);
+void compositorInvalidate(uint8_t layer);
+void compositorInvalidateAll();
+void compositorSetCoverage(uint8_t layer, uint16_t moduleMask, bool pixelCoverage);
+bool compositorOccluded(uint8_t layer);
+bool compositorNeedsRender(uint8_t layer, uint16_t timerMask);
+uint8_t compositorTopLayer();
+
+// Content
+bool compositorCommit(uint8_t layer, const uint8_t frame[][FB_ROWS]);
+bool compositorCompose(uint8_t frame[][FB_ROWS]);
+
+// Intensity per layer (diterapkan ke modul yang dimiliki layer teratas)
+void compositorSetIntensity(uint8_t layer, uint16_t value);
+void compositorFadeIntensity(uint8_t layer, uint16_t target, uint16_t durationMs);
+uint16_t compositorGetIntensity(uint8_t layer);
+bool compositorFading(uint8_t layer);
+
+// Statistics
+const CompositorStats* compositorGetStats();
+void compositorResetStats();
+
+#endif // COMPOSITOR_H
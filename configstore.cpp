@@ -0,0 +1,237 @@
+#include "configstore.h"
+#include "settings.h"
+#include <Arduino.h>
+
+// Build Information
+#define CONFIGSTORE_CPP_VERSION "1.1.0"
+#define CONFIGSTORE_CPP_BUILD_DATE "2026-10-18 09:41:05"
+#define CONFIGSTORE_CPP_AUTHOR "Brodot23"
+
+static_assert(CONFIGSTORE_SLOT_SIZE % 4 == 0, "slot harus rata 4 byte (spi_flash_write)");
+static_assert(CONFIGSTORE_SECTORS == 2, "record lama tetap ada saat menulis: sektor lain dihapus, bukan sektor aktif");
+
+// Sektor yang dicadangkan linker script untuk EEPROM
+extern "C" uint32_t _EEPROM_start;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t schema;
+    uint16_t length;
+    uint32_t sequence;
+    uint32_t crc;
+} RecordHeader;
+
+static_assert(sizeof(RecordHeader) == CONFIGSTORE_HEADER_SIZE, "layout header record");
+
+// Buffer rata 4 byte untuk ESP.flashRead/flashWrite
+static uint32_t slotBuffer[CONFIGSTORE_SLOT_SIZE / 4];
+
+static uint32_t storeSector = 0;    // Sektor EEPROM; sektor 1 = storeSector - 1
+static uint8_t activeSector = 0;
+static int8_t activeSlot = -1;
+static uint32_t activeSequence = 0;
+
+static bool saveRequested = false;
+static uint32_t firstRequestMillis = 0;
+static uint32_t lastRequestMillis = 0;
+
+static ConfigStoreStats storeStats;
+
+// ===== IMPLEMENTASI FUNGSI CRC =====
+
+// CRC-32 (IEEE, reflected) dengan tabel 16 entry: 64 byte flash, cukup cepat untuk 384 byte
+static const uint32_t CRC_NIBBLE_TABLE[16] PROGMEM = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+uint32_t configstoreCrc32(uint32_t crc, const void* data, size_t length) {
+    const uint8_t* p = (const uint8_t*)data;
+    crc = ~crc;
+    while (length--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ pgm_read_dword(&CRC_NIBBLE_TABLE[crc & 0x0F]);
+        crc = (crc >> 4) ^ pgm_read_dword(&CRC_NIBBLE_TABLE[crc & 0x0F]);
+    }
+    return ~crc;
+}
+
+static uint32_t recordCrc(const RecordHeader* header, const void* payload) {
+    uint32_t crc = configstoreCrc32(0, header, offsetof(RecordHeader, crc));
+    return configstoreCrc32(crc, payload, header->length);
+}
+
+// ===== IMPLEMENTASI FUNGSI FLASH =====
+
+static uint32_t flashSector(uint8_t sector) {
+    return storeSector - sector;
+}
+
+static uint32_t slotAddress(uint8_t sector, uint8_t slot) {
+    return flashSector(sector) * CONFIGSTORE_SECTOR_SIZE + (uint32_t)slot * CONFIGSTORE_SLOT_SIZE;
+}
+
+static bool readSlot(uint8_t sector, uint8_t slot) {
+    return ESP.flashRead(slotAddress(sector, slot), slotBuffer, CONFIGSTORE_SLOT_SIZE);
+}
+
+static bool slotErased() {
+    for (uint16_t i = 0; i < CONFIGSTORE_SLOT_SIZE / 4; i++) {
+        if (slotBuffer[i] != 0xFFFFFFFFUL) return false;
+    }
+    return true;
+}
+
+// Header + payload valid di slotBuffer
+static const RecordHeader* validRecord() {
+    const RecordHeader* header = (const RecordHeader*)slotBuffer;
+    if (header->magic != CONFIGSTORE_MAGIC || header->length > CONFIGSTORE_PAYLOAD_MAX) {
+        return NULL;
+    }
+    if (recordCrc(header, (const uint8_t*)slotBuffer + CONFIGSTORE_HEADER_SIZE) != header->crc) {
+        return NULL;
+    }
+    return header;
+}
+
+// ===== IMPLEMENTASI FUNGSI INISIALISASI =====
+
+void configstoreInit() {
+    storeSector = ((uint32_t)(uintptr_t)&_EEPROM_start - 0x40200000UL) / CONFIGSTORE_SECTOR_SIZE;
+    activeSector = 0;
+    activeSlot = -1;
+    activeSequence = 0;
+    saveRequested = false;
+    memset(&storeStats, 0, sizeof(storeStats));
+
+    for (uint8_t sector = 0; sector < CONFIGSTORE_SECTORS; sector++) {
+        for (uint8_t slot = 0; slot < CONFIGSTORE_SLOTS; slot++) {
+            if (!readSlot(sector, slot) || slotErased()) continue;
+
+            const RecordHeader* header = validRecord();
+            if (!header) {
+                storeStats.corrupt++;
+                continue;
+            }
+            // Sequence tidak pernah wrap dalam umur flash (~10^5 erase x 20 slot)
+            if (activeSlot < 0 || header->sequence > activeSequence) {
+                activeSector = sector;
+                activeSlot = slot;
+                activeSequence = header->sequence;
+            }
+        }
+    }
+
+    storeStats.sequence = activeSequence;
+    storeStats.sector = activeSector;
+    storeStats.slot = activeSlot < 0 ? 0xFF : activeSlot;
+}
+
+// ===== IMPLEMENTASI FUNGSI RECORD =====
+
+// Schema atau panjang berbeda = layout struct berubah, pemanggil memakai default
+bool configstoreLoad(void* payload, uint16_t length, uint16_t schema) {
+    if (activeSlot < 0 || !readSlot(activeSector, activeSlot)) return false;
+
+    const RecordHeader* header = validRecord();
+    if (!header || header->schema != schema || header->length != length) {
+        return false;
+    }
+    memcpy(payload, (const uint8_t*)slotBuffer + CONFIGSTORE_HEADER_SIZE, length);
+    return true;
+}
+
+bool configstoreWrite(const void* payload, uint16_t length, uint16_t schema) {
+    if (length > CONFIGSTORE_PAYLOAD_MAX) return false;
+
+    RecordHeader header;
+    header.magic = CONFIGSTORE_MAGIC;
+    header.schema = schema;
+    header.length = length;
+    header.sequence = activeSequence + 1;
+    header.crc = 0;
+
+    // CRC tanpa sequence: sama = isi tidak berubah sejak record terakhir, flash tidak disentuh
+    uint32_t contentCrc = configstoreCrc32(schema, payload, length);
+    if (activeSlot >= 0 && readSlot(activeSector, activeSlot)) {
+        const RecordHeader* current = validRecord();
+        if (current && current->schema == schema && current->length == length &&
+            configstoreCrc32(schema, (const uint8_t*)slotBuffer + CONFIGSTORE_HEADER_SIZE, length) == contentCrc) {
+            storeStats.unchanged++;
+            return true;
+        }
+    }
+
+    // Slot kosong berikutnya setelah record aktif. Sektor aktif penuh atau berisi data asing:
+    // pindah ke slot 0 sektor lain, yang dihapus dulu (hanya berisi record lama)
+    uint8_t sector = activeSector;
+    uint8_t slot = (activeSlot < 0) ? 0 : activeSlot + 1;
+    bool usable = slot < CONFIGSTORE_SLOTS && readSlot(sector, slot) && slotErased();
+    if (!usable) {
+        if (activeSlot >= 0) {
+            sector = (activeSector + 1) % CONFIGSTORE_SECTORS;
+        }
+        slot = 0;
+        if (!ESP.flashEraseSector(flashSector(sector))) return false;
+        storeStats.erases++;
+    }
+
+    memset(slotBuffer, 0xFF, sizeof(slotBuffer));
+    header.crc = recordCrc(&header, payload);
+    memcpy(slotBuffer, &header, CONFIGSTORE_HEADER_SIZE);
+    memcpy((uint8_t*)slotBuffer + CONFIGSTORE_HEADER_SIZE, payload, length);
+
+    uint16_t written = (CONFIGSTORE_HEADER_SIZE + length + 3) & ~3;
+    if (!ESP.flashWrite(slotAddress(sector, slot), slotBuffer, written)) return false;
+
+    // Baca ulang sebelum record baru dianggap aktif; gagal = record lama tetap berlaku,
+    // save berikutnya melewati slot ini (tidak kosong) ke sektor lain
+    if (!readSlot(sector, slot) || !validRecord()) {
+        storeStats.verifyFailures++;
+        return false;
+    }
+
+    activeSector = sector;
+    activeSlot = slot;
+    activeSequence = header.sequence;
+    storeStats.writes++;
+    storeStats.sequence = activeSequence;
+    storeStats.sector = sector;
+    storeStats.slot = slot;
+    return true;
+}
+
+// ===== IMPLEMENTASI FUNGSI DEFERRED COMMIT =====
+
+void configstoreRequestSave() {
+    uint32_t now = millis();
+    if (!saveRequested) {
+        saveRequested = true;
+        firstRequestMillis = now;
+    }
+    lastRequestMillis = now;
+    storeStats.saveRequests++;
+}
+
+// true sekali per batch: pemanggil langsung menulis snapshot config
+bool configstoreSaveDue() {
+    if (!saveRequested) return false;
+
+    uint32_t now = millis();
+    if (now - lastRequestMillis < CONFIGSTORE_QUIET_TIME &&
+        now - firstRequestMillis < CONFIGSTORE_MAX_DEFER) {
+        return false;
+    }
+    saveRequested = false;
+    return true;
+}
+
+bool configstorePending() {
+    return saveRequested;
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTIK =====
+
+const ConfigStoreStats* configstoreGetStats() {
+    return &storeStats;
+}
@@ -0,0 +1,82 @@
+#ifndef CONFIGSTORE_H
+#define CONFIGSTORE_H
+
+#include "settings.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// Build Information
+#define CONFIGSTORE_VERSION "1.1.0"
+#define CONFIGSTORE_BUILD_DATE "2026-10-18 09:41:05"
+#define CONFIGSTORE_AUTHOR "Brodot23"
+
+// Journal config di dua sektor flash (4 KB), ditulis langsung tanpa library EEPROM:
+// library EEPROM menghapus seluruh sektor di setiap commit, journal hanya saat sektor penuh.
+// Sektor dibagi CONFIGSTORE_SLOTS slot; setiap save menulis record baru ke slot kosong
+// berikutnya (flash terhapus = 0xFF, tulis hanya mengubah 1 -> 0). Saat load, record valid
+// dengan sequence tertinggi di kedua sektor yang dipakai; record terpotong (listrik mati
+// saat menulis) gagal CRC dan record sebelumnya tetap berlaku.
+//
+// Ping-pong: sektor penuh tidak pernah dihapus selagi berisi record aktif. Record berikutnya
+// ditulis ke slot 0 sektor lainnya (yang dihapus dulu, isinya hanya record lama) dan
+// diverifikasi; sektor lama baru dihapus saat giliran ditulis lagi. Listrik mati kapan pun
+// menyisakan minimal satu record valid.
+//
+// Sektor: EEPROM (_EEPROM_start) dan satu sektor di bawahnya. Di layout flash core ESP8266
+// partisi FS berakhir di _FS_end, minimal satu sektor sebelum _EEPROM_start (sektor itu
+// tidak dipakai FS maupun EEPROM).
+//
+// Record (little endian, rata 4 byte):
+//   0  magic   uint32 CONFIGSTORE_MAGIC
+//   4  schema  uint16 versi layout payload milik sketch
+//   6  length  uint16 byte payload
+//   8  sequence uint32, naik setiap save
+//   12 crc     uint32, CRC-32 byte 0..11 + payload
+//   16 payload
+#define CONFIGSTORE_MAGIC 0x43464753UL      // "SGFC"
+#define CONFIGSTORE_SECTOR_SIZE 4096
+#define CONFIGSTORE_SECTORS 2
+#define CONFIGSTORE_SLOT_SIZE 384
+#define CONFIGSTORE_SLOTS (CONFIGSTORE_SECTOR_SIZE / CONFIGSTORE_SLOT_SIZE)
+#define CONFIGSTORE_HEADER_SIZE 16
+#define CONFIGSTORE_PAYLOAD_MAX (CONFIGSTORE_SLOT_SIZE - CONFIGSTORE_HEADER_SIZE)
+
+// Write Coalescing
+// Perubahan beruntun (slider di web) digabung menjadi satu tulis setelah sepi
+// CONFIGSTORE_QUIET_TIME ms, paling lambat CONFIGSTORE_MAX_DEFER ms setelah perubahan pertama
+#define CONFIGSTORE_QUIET_TIME 2000
+#define CONFIGSTORE_MAX_DEFER 10000
+
+// Store Statistics
+typedef struct {
+    uint32_t saveRequests;      // configstoreRequestSave()
+    uint32_t writes;            // Record yang ditulis ke flash
+    uint32_t unchanged;         // Save dilewati karena payload sama dengan record terakhir
+    uint32_t erases;            // Sektor dihapus (giliran ping-pong atau isi asing)
+    uint32_t corrupt;           // Slot berisi data yang gagal magic/CRC saat scan
+    uint32_t verifyFailures;    // Record yang dibaca ulang setelah ditulis tidak valid
+    uint32_t sequence;          // Sequence record aktif
+    uint8_t sector;             // Sektor record aktif (0 = EEPROM, 1 = di bawahnya)
+    uint8_t slot;               // Slot record aktif (0xFF = belum ada)
+} ConfigStoreStats;
+
+// Function Prototypes
+// Initialization: scan sektor, cari record terbaru
+void configstoreInit();
+
+// Record
+bool configstoreLoad(void* payload, uint16_t length, uint16_t schema);
+bool configstoreWrite(const void* payload, uint16_t length, uint16_t schema);
+
+// Deferred Commit
+void configstoreRequestSave();
+bool configstoreSaveDue();
+bool configstorePending();
+
+// Utility
+uint32_t configstoreCrc32(uint32_t crc, const void* data, size_t length);
+
+// Statistics
+const ConfigStoreStats* configstoreGetStats();
+
+#endif // CONFIGSTORE_H
@@ -42,10 +42,10 @@ typedef enum {
     EFFECT_FADE_OUT,
     EFFECT_SCROLL_LEFT,
     EFFECT_SCROLL_RIGHT,
-    EFFECT_BLINK,
-    EFFECT_PULSE,
-    EFFECT_WAVE,
-    EFFECT_SPARKLE
+    EFFECT_BLINK,           // Kernel: EFFECT_KERNEL_BLINK (effects.h)
+    EFFECT_PULSE,           // Kernel: EFFECT_KERNEL_PULSE
+    EFFECT_WAVE,            // Kernel: EFFECT_KERNEL_WAVE
+    EFFECT_SPARKLE          // Kernel: EFFECT_KERNEL_SPARKLE
 } DisplayEffect;
 
 // Function Declarations
@@ -56,8 +56,7 @@ void resetDisplay();
 void clearDisplay();
 
 // Basic Display Control
-void setPixel(uint8_t x, uint8_t y, bool state);
-void setColumn(uint8_t col, uint8_t value);
+// setPixel/setColumn: bitplaneSetPixel/bitplaneSetColumn (bitplane.h)
 void setRow(uint8_t row, uint8_t value);
 void invertDisplay(bool invert);
 void enableDisplay(bool enable);
@@ -82,18 +81,14 @@ bool isEffectActive();
 void clearBuffer();
 void updateBuffer();
 void commitBuffer();
-void scrollBufferLeft(uint8_t positions);
-void scrollBufferRight(uint8_t positions);
 
 // Status Functions
 bool isDisplayEnabled();
 bool isDisplayInverted();
 DisplayEffect getCurrentEffect();
 
-// Utility Functions
-void rotateDisplay(uint8_t angle);
-void mirrorDisplay(bool horizontal, bool vertical);
-void shiftDisplay(int8_t x, int8_t y);
+// Transform (scroll, shift, mirror, rotate) ada di bitplane.h sebagai kernel SWAR
+// 64-bit per baris di atas frame [modul][baris] yang dipakai sketch
 
 // Test Patterns
 void displayTestPattern();
@@ -0,0 +1,198 @@
+#include "effects.h"
+#include <Arduino.h>
+
+// Build Information
+#define EFFECTS_CPP_VERSION "1.0.0"
+#define EFFECTS_CPP_BUILD_DATE "2026-10-17 21:14:05"
+#define EFFECTS_CPP_AUTHOR "Brodot23"
+
+// Seperempat gelombang sinus, 127 x sin(i x 2pi / 256) untuk i = 0..64
+static const int8_t SINE_QUARTER[65] PROGMEM = {
+      0,   3,   6,   9,  12,  16,  19,  22,  25,  28,  31,  34,  37,  40,  43,  46,
+     49,  51,  54,  57,  60,  63,  65,  68,  71,  73,  76,  78,  81,  83,  85,  88,
+     90,  92,  94,  96,  98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+    117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+    127,
+};
+
+// Urutan playlist: pelan/halus dulu, lalu yang lebih ramai
+const EffectPreset EFFECT_PRESETS[EFFECT_PRESET_COUNT] PROGMEM = {
+    { EFFECT_KERNEL_WAVE,    24,  40 },
+    { EFFECT_KERNEL_WAVE,    64, 128 },
+    { EFFECT_KERNEL_SPARKLE, 32,  40 },
+    { EFFECT_KERNEL_SPARKLE, 96, 110 },
+    { EFFECT_KERNEL_PULSE,   24,  64 },
+    { EFFECT_KERNEL_PULSE,   48, 160 },
+    { EFFECT_KERNEL_BLINK,   16, 128 },
+    { EFFECT_KERNEL_BLINK,   48,  40 },
+};
+
+#define EFFECT_PULSE_RING 96        // Lebar cincin PULSE dalam satuan sudut (dari 256)
+#define EFFECT_PULSE_MIN_LEVEL 64   // Intensitas relatif terendah saat bernapas
+
+// ===== IMPLEMENTASI FUNGSI MATEMATIKA =====
+
+int8_t effectSin8(uint8_t angle) {
+    uint8_t index = angle & 0x3F;
+    if (angle & 0x40) index = 64 - index;           // Kuadran 2 dan 4: cermin
+    int8_t value = (int8_t)pgm_read_byte(&SINE_QUARTER[index]);
+    return (angle & 0x80) ? -value : value;         // Setengah putaran kedua: negatif
+}
+
+uint64_t effectRandom(EffectState* state) {
+    uint64_t x = state->rng;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    state->rng = x;
+    return x;
+}
+
+// Bandingkan 64 bilangan acak 8-bit dengan density sekaligus (bit-sliced, MSB dulu).
+// Setelah bit 1 terendah density, lane yang masih sama tidak mungkin lebih kecil,
+// jadi density 128 cukup 1 word acak, 64 cukup 2.
+uint64_t effectRandomMask(EffectState* state, uint8_t density) {
+    if (density == 0) return 0;
+    uint8_t lowest = 0;
+    while (!(density & (1 << lowest))) lowest++;
+
+    uint64_t less = 0;
+    uint64_t equal = ~(uint64_t)0;
+    for (int8_t bit = 7; bit >= lowest; bit--) {
+        uint64_t random = effectRandom(state);
+        if (density & (1 << bit)) {
+            less |= equal & ~random;
+            equal &= random;
+        } else {
+            equal &= ~random;
+        }
+    }
+    return less;
+}
+
+// ===== IMPLEMENTASI KERNEL =====
+
+static uint64_t widthMask(const BitPlane* plane) {
+    return ~(uint64_t)0 << (BITPLANE_MAX_WIDTH - plane->width);
+}
+
+// Satu titik per kolom, kolom bertetangga disambung vertikal supaya garis tidak putus
+static void renderWave(EffectState* state) {
+    BitPlane* plane = &state->plane;
+    uint8_t base = state->phase >> 8;
+    int8_t previous = -1;
+
+    memset(plane->rows, 0, sizeof(plane->rows));
+    for (uint8_t x = 0; x < plane->width; x++) {
+        uint8_t angle = base + (uint8_t)((x * state->density) >> 2);
+        int8_t row = ((effectSin8(angle) + 127) * (FB_ROWS - 1) + 127) / 254;
+        int8_t low = row;
+        int8_t high = row;
+        if (previous >= 0 && previous < row) low = previous + 1;
+        if (previous > row) high = previous - 1;
+        previous = row;
+
+        uint64_t bit = (uint64_t)1 << (63 - x);
+        for (int8_t r = low; r <= high; r++) {
+            plane->rows[FB_ROWS - 1 - r] |= bit;
+        }
+    }
+}
+
+// Fase yang lewat sejak render terakhir menentukan fraksi piksel yang diacak ulang:
+// satu putaran penuh = semua piksel diacak ulang
+static void renderSparkle(EffectState* state) {
+    BitPlane* plane = &state->plane;
+    uint32_t advanced = state->advanced;
+    if (advanced < 256) return;
+
+    uint8_t reroll = advanced >= 0xFF00 ? 0xFF : advanced >> 8;
+    state->advanced = advanced >= 0xFF00 ? 0 : advanced & 0xFF;
+
+    uint64_t mask = widthMask(plane);
+    for (uint8_t r = 0; r < FB_ROWS; r++) {
+        uint64_t change = (reroll == 0xFF) ? ~(uint64_t)0 : effectRandomMask(state, reroll);
+        uint64_t fresh = effectRandomMask(state, state->density);
+        plane->rows[r] = ((plane->rows[r] & ~change) | (fresh & change)) & mask;
+    }
+}
+
+// Simetris kiri-kanan dan atas-bawah: hitung seperempat chain, sisanya dicerminkan
+static void renderPulse(EffectState* state) {
+    BitPlane* plane = &state->plane;
+    uint8_t base = state->phase >> 8;
+    uint8_t scale = (state->density >> 3) + 1;     // Sudut per piksel jarak dari tengah
+    uint8_t width = plane->width;
+
+    for (uint8_t y = 0; y < FB_ROWS / 2; y++) {
+        uint64_t row = 0;
+        uint8_t dy = (FB_ROWS - 1) - 2 * y;         // Jarak ke tengah x2 (ganjil)
+        for (uint8_t x = 0; x < width / 2; x++) {
+            uint8_t dx = (width - 1) - 2 * x;
+            uint8_t distance = (dx + dy) >> 1;
+            if ((uint8_t)(distance * scale - base) < EFFECT_PULSE_RING) {
+                row |= ((uint64_t)1 << (63 - x)) | ((uint64_t)1 << (64 - width + x));
+            }
+        }
+        plane->rows[y] = row;
+        plane->rows[FB_ROWS - 1 - y] = row;
+    }
+
+    uint16_t swing = effectSin8(base) + 127;
+    state->level = EFFECT_PULSE_MIN_LEVEL + swing * (EFFECT_LEVEL_MAX - EFFECT_PULSE_MIN_LEVEL) / 254;
+}
+
+static void renderBlink(EffectState* state) {
+    BitPlane* plane = &state->plane;
+    bool on = (uint8_t)(state->phase >> 8) < state->density;
+    uint64_t fill = on ? widthMask(plane) : 0;
+    for (uint8_t r = 0; r < FB_ROWS; r++) {
+        plane->rows[r] = fill;
+    }
+}
+
+// ===== IMPLEMENTASI FUNGSI EFEK =====
+
+void effectBegin(EffectState* state, uint8_t kernel, uint8_t speed, uint8_t density,
+                 uint8_t devices, uint32_t seed) {
+    memset(state, 0, sizeof(EffectState));
+    state->kernel = kernel < EFFECT_KERNEL_COUNT ? kernel : EFFECT_KERNEL_WAVE;
+    state->speed = speed;
+    state->density = density;
+    state->level = EFFECT_LEVEL_MAX;
+    state->advanced = 0x10000;                      // Frame SPARKLE pertama langsung penuh
+    state->rng = ((uint64_t)seed << 32 | 0x9E3779B9) * 0x2545F4914F6CDD1DULL;
+    if (state->rng == 0) state->rng = 0x2545F4914F6CDD1DULL;
+    bitplaneClear(&state->plane, devices);
+}
+
+void effectAdvance(EffectState* state, uint32_t elapsedMs) {
+    uint32_t delta = elapsedMs * state->speed * EFFECT_PHASE_PER_MS;
+    state->phase += delta;
+    state->advanced = min(state->advanced + delta, (uint32_t)0x10000);
+}
+
+void effectRender(EffectState* state, uint8_t frame[][FB_ROWS]) {
+    state->level = EFFECT_LEVEL_MAX;
+    switch (state->kernel) {
+        case EFFECT_KERNEL_WAVE:    renderWave(state);    break;
+        case EFFECT_KERNEL_SPARKLE: renderSparkle(state); break;
+        case EFFECT_KERNEL_PULSE:   renderPulse(state);   break;
+        case EFFECT_KERNEL_BLINK:   renderBlink(state);   break;
+    }
+    bitplaneUnpack(&state->plane, frame);
+}
+
+// ===== IMPLEMENTASI FUNGSI PLAYLIST =====
+
+bool effectIsPlaylistRef(uint8_t entry) {
+    return entry >= EFFECT_PLAYLIST_BASE && entry < EFFECT_PLAYLIST_BASE + EFFECT_PRESET_COUNT;
+}
+
+bool effectBeginPreset(EffectState* state, uint8_t entry, uint8_t devices, uint32_t seed) {
+    if (!effectIsPlaylistRef(entry)) return false;
+    EffectPreset preset;
+    memcpy_P(&preset, &EFFECT_PRESETS[entry - EFFECT_PLAYLIST_BASE], sizeof(preset));
+    effectBegin(state, preset.kernel, preset.speed, preset.density, devices, seed);
+    return true;
+}
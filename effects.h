@@ -0,0 +1,69 @@
+#ifndef EFFECTS_H
+#define EFFECTS_H
+
+#include "settings.h"
+#include "framebuffer.h"
+#include "bitplane.h"
+#include <stdint.h>
+
+// Build Information
+#define EFFECTS_VERSION "1.0.0"
+#define EFFECTS_BUILD_DATE "2026-10-17 21:14:05"
+#define EFFECTS_AUTHOR "Brodot23"
+
+// Kernel efek prosedural selebar chain (display.h: EFFECT_WAVE, EFFECT_SPARKLE,
+// EFFECT_PULSE, EFFECT_BLINK). Tanpa tabel frame: hanya sine seperempat gelombang
+// 64 byte di PROGMEM, PRNG xorshift64 dan akumulator fase fixed-point.
+#define EFFECT_KERNEL_WAVE 0        // Gelombang sinus berjalan, density = frekuensi spasial
+#define EFFECT_KERNEL_SPARKLE 1     // Piksel acak, density = fraksi piksel menyala
+#define EFFECT_KERNEL_PULSE 2       // Cincin dari tengah chain + intensitas bernapas, density = rapat cincin
+#define EFFECT_KERNEL_BLINK 3       // Seluruh chain on/off, density = duty cycle
+#define EFFECT_KERNEL_COUNT 4
+
+// Fase Q16: 65536 = satu putaran (satu gelombang / satu generasi sparkle / satu kedip).
+// Maju elapsedMs x speed x EFFECT_PHASE_PER_MS per render: speed 32 ~ 1 putaran/detik.
+#define EFFECT_PHASE_PER_MS 2
+#define EFFECT_LEVEL_MAX 255        // EffectState.level penuh
+
+// Entry playlist (animSettings.selectedPatterns) EFFECT_PLAYLIST_BASE..+EFFECT_PRESET_COUNT-1
+// menjalankan baris EFFECT_PRESETS, di antara pola bawaan (< ANIMATION_COUNT) dan file (animfile.h)
+#define EFFECT_PLAYLIST_BASE 96
+#define EFFECT_PRESET_COUNT 8
+#define EFFECT_FRAME_INTERVAL 40    // ms per frame di playlist (25 fps)
+
+typedef struct {
+    uint8_t kernel;
+    uint8_t speed;
+    uint8_t density;
+} EffectPreset;
+
+typedef struct {
+    uint8_t kernel;
+    uint8_t speed;              // 0 = diam
+    uint8_t density;
+    uint8_t level;              // Intensitas relatif 0..EFFECT_LEVEL_MAX untuk frame terakhir
+    uint32_t phase;             // Akumulator Q16, wrap bebas
+    uint32_t advanced;          // Fase yang belum dipakai SPARKLE sejak render terakhir
+    uint64_t rng;               // State xorshift64, tidak pernah 0
+    BitPlane plane;             // Frame terakhir; SPARKLE memperbarui sebagian saja
+} EffectState;
+
+extern const EffectPreset EFFECT_PRESETS[EFFECT_PRESET_COUNT];
+
+// Function Prototypes
+// Math Helpers
+int8_t effectSin8(uint8_t angle);               // 256 = satu putaran, hasil -127..127
+uint64_t effectRandom(EffectState* state);      // xorshift64
+uint64_t effectRandomMask(EffectState* state, uint8_t density); // Setiap bit 1 dengan peluang density/256
+
+// Kernels
+void effectBegin(EffectState* state, uint8_t kernel, uint8_t speed, uint8_t density,
+                 uint8_t devices, uint32_t seed);
+void effectAdvance(EffectState* state, uint32_t elapsedMs);
+void effectRender(EffectState* state, uint8_t frame[][FB_ROWS]);
+
+// Playlist Helpers
+bool effectIsPlaylistRef(uint8_t entry);
+bool effectBeginPreset(EffectState* state, uint8_t entry, uint8_t devices, uint32_t seed);
+
+#endif // EFFECTS_H
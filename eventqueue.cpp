@@ -0,0 +1,120 @@
+#include "eventqueue.h"
+#include "settings.h"
+#include <Arduino.h>
+
+// Build Information
+#define EVENTQUEUE_CPP_VERSION "1.0.0"
+#define EVENTQUEUE_CPP_BUILD_DATE "2026-10-17 16:48:12"
+#define EVENTQUEUE_CPP_AUTHOR "Brodot23"
+
+static_assert((EVENT_LANE_SLOTS & (EVENT_LANE_SLOTS - 1)) == 0, "EVENT_LANE_SLOTS harus pangkat dua");
+static_assert(EVENT_LANE_SLOTS < 256, "kedalaman lane disimpan di uint8_t");
+
+// Counter berjalan bebas (wrap 16-bit), isi lane = tail - head.
+// tail hanya ditulis producer, head hanya ditulis consumer; acquire/release menjamin
+// isi slot sudah lengkap sebelum counter terlihat oleh pihak lain (di ESP8266 cukup
+// sebagai compiler barrier, di host juga benar antar thread).
+typedef struct {
+    Event slots[EVENT_LANE_SLOTS];
+    uint16_t head;
+    uint16_t tail;
+} EventLane;
+
+static EventLane lanes[EVENT_LANE_COUNT];
+static EventLaneStats laneStats[EVENT_LANE_COUNT];
+
+// ===== IMPLEMENTASI FUNGSI INISIALISASI =====
+
+void eventqueueInit() {
+    memset(lanes, 0, sizeof(lanes));
+    eventqueueResetStats();
+}
+
+// ===== IMPLEMENTASI FUNGSI PRODUCER =====
+
+bool ICACHE_RAM_ATTR eventqueuePost(EventType type, EventPriority priority, const void* payload, uint8_t size) {
+    if ((uint8_t)priority >= EVENT_LANE_COUNT) return false;
+    EventLane* lane = &lanes[priority];
+    EventLaneStats* stats = &laneStats[priority];
+
+    uint16_t tail = lane->tail;
+    uint16_t head = __atomic_load_n(&lane->head, __ATOMIC_ACQUIRE);
+    uint16_t depth = (uint16_t)(tail - head);
+    if (depth >= EVENT_LANE_SLOTS) {
+        stats->dropped++;
+        return false;
+    }
+
+    Event* slot = &lane->slots[tail & (EVENT_LANE_SLOTS - 1)];
+    slot->type = type;
+    slot->priority = priority;
+    slot->size = (size < EVENT_PAYLOAD_SIZE) ? size : EVENT_PAYLOAD_SIZE;
+    slot->timestamp = micros();
+    if (payload && slot->size) {
+        memcpy(slot->payload, payload, slot->size);
+    }
+
+    __atomic_store_n(&lane->tail, (uint16_t)(tail + 1), __ATOMIC_RELEASE);
+
+    stats->posted++;
+    if (depth + 1 > stats->maxDepth) stats->maxDepth = depth + 1;
+    return true;
+}
+
+// ===== IMPLEMENTASI FUNGSI CONSUMER =====
+
+// Lane prioritas tertinggi yang berisi lebih dulu: event rem tidak pernah antre di belakang config
+bool eventqueueTake(Event* event, EventPriority minPriority) {
+    for (int8_t priority = EVENT_LANE_COUNT - 1; priority >= (int8_t)minPriority; priority--) {
+        EventLane* lane = &lanes[priority];
+        EventLaneStats* stats = &laneStats[priority];
+        uint16_t head = lane->head;
+        uint16_t tail = __atomic_load_n(&lane->tail, __ATOMIC_ACQUIRE);
+
+        while (head != tail) {
+            memcpy(event, &lane->slots[head & (EVENT_LANE_SLOTS - 1)], sizeof(Event));
+            head++;
+            __atomic_store_n(&lane->head, head, __ATOMIC_RELEASE);
+
+            uint32_t age = micros() - event->timestamp;
+            if (priority < EVENT_EXPIRE_BELOW && age > (uint32_t)EVENT_TIMEOUT * 1000) {
+                stats->expired++;
+                continue;
+            }
+            if (age > stats->maxLatencyMicros) stats->maxLatencyMicros = age;
+            stats->delivered++;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Hanya consumer: buang isi lane dengan memajukan head ke tail
+void eventqueueClear() {
+    for (uint8_t priority = 0; priority < EVENT_LANE_COUNT; priority++) {
+        uint16_t tail = __atomic_load_n(&lanes[priority].tail, __ATOMIC_ACQUIRE);
+        __atomic_store_n(&lanes[priority].head, tail, __ATOMIC_RELEASE);
+    }
+}
+
+uint8_t eventqueueSize() {
+    uint8_t size = 0;
+    for (uint8_t priority = 0; priority < EVENT_LANE_COUNT; priority++) {
+        size += (uint16_t)(__atomic_load_n(&lanes[priority].tail, __ATOMIC_ACQUIRE) - lanes[priority].head);
+    }
+    return size;
+}
+
+bool eventqueueEmpty() {
+    return eventqueueSize() == 0;
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTIK =====
+
+const EventLaneStats* eventqueueGetStats(EventPriority priority) {
+    return ((uint8_t)priority < EVENT_LANE_COUNT) ? &laneStats[priority] : NULL;
+}
+
+void eventqueueResetStats() {
+    memset(laneStats, 0, sizeof(laneStats));
+}
@@ -0,0 +1,121 @@
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+
+#include "settings.h"
+#include <stdint.h>
+
+// Build Information
+#define EVENTQUEUE_VERSION "1.0.0"
+#define EVENTQUEUE_BUILD_DATE "2026-10-17 16:48:12"
+#define EVENTQUEUE_AUTHOR "Brodot23"
+
+// Event Queue Configuration
+// Satu lane per prioritas, setiap lane ring SPSC lock-free: tepat satu konteks producer
+// (ISR pin untuk lane HIGH/CRITICAL, loop() untuk lane LOW/NORMAL) dan consumer loop().
+// Producer kedua di lane yang sama harus memanggil eventqueuePost dengan interrupt mati.
+#define EVENT_LANE_COUNT 4
+#define EVENT_LANE_SLOTS 8          // Harus pangkat dua (index = counter & (SLOTS - 1))
+#define EVENT_PAYLOAD_SIZE 8        // Payload disalin ke slot, pemanggil tidak perlu menjaga buffer
+#define EVENT_TIMEOUT 5000          // ms, event lebih tua dibuang saat diambil
+#define EVENT_EXPIRE_BELOW PRIORITY_HIGH    // Lane HIGH/CRITICAL (perubahan state input) tidak kedaluwarsa
+
+// Event Priority Levels (= index lane)
+typedef enum {
+    PRIORITY_LOW = 0,
+    PRIORITY_NORMAL = 1,
+    PRIORITY_HIGH = 2,
+    PRIORITY_CRITICAL = 3
+} EventPriority;
+
+// Event Types
+typedef enum {
+    // System Events
+    EVENT_SYSTEM_STARTUP,
+    EVENT_SYSTEM_SHUTDOWN,
+    EVENT_SYSTEM_RESET,
+    EVENT_SYSTEM_ERROR,
+
+    // Hardware Events
+    EVENT_BUTTON_PRESSED,
+    EVENT_BUTTON_RELEASED,
+    EVENT_BUTTON_LONG_PRESS,
+    EVENT_BUTTON_DOUBLE_PRESS,
+    EVENT_INPUT_EDGE,               // payload: [channel input.h]; level dari integrator, bukan pin saat ISR
+
+    // Animation Events
+    EVENT_ANIMATION_START,
+    EVENT_ANIMATION_STOP,
+    EVENT_ANIMATION_COMPLETE,
+    EVENT_ANIMATION_ERROR,
+
+    // Display Events
+    EVENT_DISPLAY_UPDATE,
+    EVENT_DISPLAY_CLEAR,
+    EVENT_DISPLAY_ERROR,
+
+    // Network Events
+    EVENT_WIFI_CONNECTED,
+    EVENT_WIFI_DISCONNECTED,
+    EVENT_WIFI_AP_START,
+    EVENT_WIFI_AP_STOP,
+
+    // Server Events
+    EVENT_SERVER_START,
+    EVENT_SERVER_STOP,
+    EVENT_CLIENT_CONNECTED,
+    EVENT_CLIENT_DISCONNECTED,
+
+    // Pattern Events
+    EVENT_PATTERN_CHANGE,
+    EVENT_PATTERN_COMPLETE,
+    EVENT_PATTERN_ERROR,
+
+    // Mode Events
+    EVENT_MODE_CHANGE,
+    EVENT_MODE_UPDATE,
+    EVENT_MODE_ERROR,
+
+    // Configuration Events
+    EVENT_CONFIG_CHANGED,           // payload: [CONFIG_SECTION_*]
+    EVENT_CONFIG_SAVED,
+    EVENT_CONFIG_RESET,
+    EVENT_CONFIG_ERROR
+} EventType;
+
+// Event Data Structure (16 byte per slot)
+typedef struct {
+    uint8_t type;                   // EventType
+    uint8_t priority;               // EventPriority
+    uint8_t size;                   // Byte payload yang terpakai
+    uint32_t timestamp;             // micros() saat di-post
+    uint8_t payload[EVENT_PAYLOAD_SIZE];
+} Event;
+
+// Queue Statistics (per lane)
+typedef struct {
+    uint32_t posted;
+    uint32_t dropped;               // Lane penuh saat post
+    uint32_t delivered;
+    uint32_t expired;               // Lebih tua dari EVENT_TIMEOUT saat diambil
+    uint32_t maxLatencyMicros;      // Post -> take terlama
+    uint8_t maxDepth;
+} EventLaneStats;
+
+// Function Prototypes
+// Initialization
+void eventqueueInit();
+
+// Producer (ISR-safe untuk lane milik konteks pemanggil)
+bool eventqueuePost(EventType type, EventPriority priority, const void* payload, uint8_t size);
+
+// Consumer (loop())
+bool eventqueueTake(Event* event, EventPriority minPriority = PRIORITY_LOW);
+void eventqueueClear();
+uint8_t eventqueueSize();
+bool eventqueueEmpty();
+
+// Statistics
+const EventLaneStats* eventqueueGetStats(EventPriority priority);
+void eventqueueResetStats();
+
+#endif // EVENTQUEUE_H
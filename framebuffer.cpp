@@ -0,0 +1,329 @@
+#include "framebuffer.h"
+#include "settings.h"
+#include <Arduino.h>
+
+// Build Information
+#define FRAMEBUFFER_CPP_VERSION "1.1.0"
+#define FRAMEBUFFER_CPP_BUILD_DATE "2026-10-17 14:55:12"
+#define FRAMEBUFFER_CPP_AUTHOR "Brodot23"
+
+// Salinan isi register yang sudah ter-latch di setiap MAX7219
+static uint8_t shadowBuffer[FB_MAX_DEVICES][FB_ROWS];
+static bool shadowValid = false;
+
+static uint8_t fbDataPin;
+static uint8_t fbClkPin;
+static uint8_t fbCsPin;
+static uint8_t fbDevices = 0;
+
+static bool syncRegisters(uint8_t phase);
+static uint8_t ditherPhase();
+
+// Intensity channel per modul dan fade linear yang sedang berjalan
+static uint16_t intensity[FB_MAX_DEVICES];
+static uint16_t fadeFrom[FB_MAX_DEVICES];
+static uint16_t fadeTarget[FB_MAX_DEVICES];
+static uint32_t fadeStart[FB_MAX_DEVICES];
+static uint16_t fadeDuration[FB_MAX_DEVICES];  // 0 = tidak sedang fade
+
+// Register intensity/shutdown yang sudah ter-latch
+static uint8_t shadowIntensity[FB_MAX_DEVICES];
+static bool shadowOn[FB_MAX_DEVICES];
+static bool registersValid = false;
+static bool intensityChanged = false;  // Channel diubah tanpa push frame sesudahnya
+static uint8_t lastPhase = 0xFF;
+
+// Crossfade: dua frame yang di-dither per baris
+static uint8_t blendFrom[FB_MAX_DEVICES][FB_ROWS];
+static uint8_t blendTo[FB_MAX_DEVICES][FB_ROWS];
+static uint8_t blendMix = 0;
+static bool blendActive = false;
+
+// Urutan ambang ordered dither (bit-reversal), fase berurutan menyebar merata
+static const uint8_t DITHER_ORDER[FB_DITHER_PHASES] = {
+    0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15
+};
+
+static FramebufferStats fbStats;
+
+// ===== IMPLEMENTASI FUNGSI TRANSPORT =====
+
+// Satu pulsa CS: data di-shift dari modul terjauh ke modul terdekat,
+// sama seperti urutan yang dipakai LedControl::spiTransfer
+static void framebufferTransfer(const uint8_t* data, uint8_t length) {
+    digitalWrite(fbCsPin, LOW);
+    for (uint8_t i = 0; i < length; i++) {
+        shiftOut(fbDataPin, fbClkPin, MSBFIRST, data[i]);
+    }
+    digitalWrite(fbCsPin, HIGH);
+
+    fbStats.transactions++;
+    fbStats.bytes += length;
+}
+
+// ===== IMPLEMENTASI FUNGSI INISIALISASI =====
+
+void framebufferInit(uint8_t dataPin, uint8_t clkPin, uint8_t csPin, uint8_t numDevices) {
+    fbDataPin = dataPin;
+    fbClkPin = clkPin;
+    fbCsPin = csPin;
+    fbDevices = constrain(numDevices, 1, FB_MAX_DEVICES);
+
+    pinMode(fbDataPin, OUTPUT);
+    pinMode(fbClkPin, OUTPUT);
+    pinMode(fbCsPin, OUTPUT);
+    digitalWrite(fbCsPin, HIGH);
+
+    for (uint8_t device = 0; device < FB_MAX_DEVICES; device++) {
+        intensity[device] = FB_INTENSITY_MAX;
+        fadeDuration[device] = 0;
+    }
+    blendActive = false;
+
+    framebufferInvalidate();
+    framebufferResetStats();
+}
+
+void framebufferInvalidate() {
+    // Isi modul tidak diketahui (mis. setelah lc.clearDisplay), push berikutnya kirim semua baris
+    shadowValid = false;
+    registersValid = false;
+}
+
+// ===== IMPLEMENTASI FUNGSI PUSH FRAME =====
+
+static uint8_t pushRows(const uint8_t frame[][FB_ROWS]) {
+    uint8_t packet[FB_MAX_DEVICES * 2];
+
+    fbStats.frames++;
+    fbStats.lastFrameTransactions = 0;
+    fbStats.lastFrameBytes = 0;
+
+    for (uint8_t row = 0; row < FB_ROWS; row++) {
+        bool rowDirty = false;
+        uint8_t length = 0;
+
+        // Modul terakhir di-shift lebih dulu
+        for (int8_t device = fbDevices - 1; device >= 0; device--) {
+            uint8_t value = frame[device][row];
+            if (!shadowValid || shadowBuffer[device][row] != value) {
+                packet[length++] = MAX7219_OP_DIGIT0 + row;
+                packet[length++] = value;
+                shadowBuffer[device][row] = value;
+                rowDirty = true;
+            } else {
+                packet[length++] = MAX7219_OP_NOOP;
+                packet[length++] = 0;
+            }
+        }
+
+        if (rowDirty) {
+            framebufferTransfer(packet, length);
+            fbStats.lastFrameTransactions++;
+            fbStats.lastFrameBytes += length;
+        } else {
+            fbStats.rowsSkipped++;
+        }
+    }
+
+    shadowValid = true;
+    return fbStats.lastFrameTransactions;
+}
+
+uint8_t framebufferPush(const uint8_t frame[][FB_ROWS]) {
+    // Frame biasa menggantikan crossfade yang sedang berjalan
+    blendActive = false;
+    // Intensity yang diubah sejak frame sebelumnya ikut ter-latch sebelum isi frame
+    syncRegisters(ditherPhase());
+    return pushRows(frame);
+}
+
+uint8_t framebufferGetLatchedRow(uint8_t device, uint8_t row) {
+    if (device >= fbDevices || row >= FB_ROWS) return 0;
+    return shadowBuffer[device][row];
+}
+
+// ===== IMPLEMENTASI FUNGSI INTENSITY =====
+
+void framebufferSetIntensity(uint8_t device, uint16_t value) {
+    if (device >= FB_MAX_DEVICES) return;
+    intensity[device] = min(value, (uint16_t)FB_INTENSITY_MAX);
+    fadeDuration[device] = 0;
+    intensityChanged = true;
+}
+
+void framebufferSetAllIntensity(uint16_t value) {
+    for (uint8_t device = 0; device < FB_MAX_DEVICES; device++) {
+        framebufferSetIntensity(device, value);
+    }
+}
+
+uint16_t framebufferGetIntensity(uint8_t device) {
+    return (device < FB_MAX_DEVICES) ? intensity[device] : 0;
+}
+
+// Fade dimulai dari nilai saat ini, dijalankan oleh framebufferService()
+void framebufferFadeTo(uint8_t device, uint16_t target, uint16_t durationMs) {
+    if (device >= FB_MAX_DEVICES) return;
+    target = min(target, (uint16_t)FB_INTENSITY_MAX);
+    if (durationMs == 0 || target == intensity[device]) {
+        framebufferSetIntensity(device, target);
+        return;
+    }
+    fadeFrom[device] = intensity[device];
+    fadeTarget[device] = target;
+    fadeStart[device] = millis();
+    fadeDuration[device] = durationMs;
+}
+
+void framebufferFadeAllTo(uint16_t target, uint16_t durationMs) {
+    for (uint8_t device = 0; device < FB_MAX_DEVICES; device++) {
+        framebufferFadeTo(device, target, durationMs);
+    }
+}
+
+bool framebufferFading() {
+    for (uint8_t device = 0; device < fbDevices; device++) {
+        if (fadeDuration[device]) return true;
+    }
+    return false;
+}
+
+// ===== IMPLEMENTASI FUNGSI CROSSFADE =====
+
+void framebufferBlend(const uint8_t from[][FB_ROWS], const uint8_t to[][FB_ROWS], uint8_t mix) {
+    if (mix == 0 || mix >= FB_BLEND_MAX) {
+        framebufferPush(mix ? to : from);
+        return;
+    }
+    memcpy(blendFrom, from, (size_t)fbDevices * FB_ROWS);
+    memcpy(blendTo, to, (size_t)fbDevices * FB_ROWS);
+    blendMix = mix;
+    blendActive = true;
+    lastPhase = 0xFF;   // Frame pertama dikirim pada service berikutnya
+}
+
+bool framebufferBlending() {
+    return blendActive;
+}
+
+// ===== IMPLEMENTASI FUNGSI DITHER =====
+
+// 0 = mati, n = register intensity n-1; pecahan dinaikkan satu level pada
+// sebagian fase sesuai ambang ordered dither
+static uint8_t ditherState(uint16_t value, uint8_t phase) {
+    uint8_t state = value / FB_INTENSITY_STEPS;
+    if ((value % FB_INTENSITY_STEPS) > DITHER_ORDER[phase]) {
+        state++;
+    }
+    return state;
+}
+
+// Register intensity dan shutdown masing-masing satu pulsa CS untuk seluruh chain,
+// modul yang tidak berubah mendapat no-op
+static bool writeRegisters(const uint8_t* states) {
+    uint8_t packet[FB_MAX_DEVICES * 2];
+    bool sent = false;
+
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        bool dirty = false;
+        uint8_t length = 0;
+
+        for (int8_t device = fbDevices - 1; device >= 0; device--) {
+            bool on = states[device] > 0;
+            if (pass == 0 && on && (!registersValid || shadowIntensity[device] != states[device] - 1)) {
+                packet[length++] = MAX7219_OP_INTENSITY;
+                packet[length++] = states[device] - 1;
+                shadowIntensity[device] = states[device] - 1;
+                dirty = true;
+            } else if (pass == 1 && (!registersValid || shadowOn[device] != on)) {
+                packet[length++] = MAX7219_OP_SHUTDOWN;
+                packet[length++] = on ? 1 : 0;
+                shadowOn[device] = on;
+                dirty = true;
+            } else {
+                packet[length++] = MAX7219_OP_NOOP;
+                packet[length++] = 0;
+            }
+        }
+
+        if (dirty) {
+            framebufferTransfer(packet, length);
+            fbStats.registerWrites++;
+            sent = true;
+        }
+    }
+    return sent;
+}
+
+static uint8_t ditherPhase() {
+    return (micros() / FB_DITHER_PERIOD_US) % FB_DITHER_PHASES;
+}
+
+static bool syncRegisters(uint8_t phase) {
+    uint8_t states[FB_MAX_DEVICES];
+    for (uint8_t device = 0; device < fbDevices; device++) {
+        states[device] = ditherState(intensity[device], phase);
+    }
+    bool sent = writeRegisters(states);
+    registersValid = true;
+    intensityChanged = false;
+    return sent;
+}
+
+bool framebufferService() {
+    if (fbDevices == 0) return false;
+
+    bool changed = !registersValid || intensityChanged;
+    bool dithering = blendActive;
+    uint32_t now = millis();
+    for (uint8_t device = 0; device < fbDevices; device++) {
+        if (intensity[device] % FB_INTENSITY_STEPS) dithering = true;
+        if (fadeDuration[device] == 0) continue;
+        uint32_t elapsed = now - fadeStart[device];
+        if (elapsed >= fadeDuration[device]) {
+            intensity[device] = fadeTarget[device];
+            fadeDuration[device] = 0;
+        } else {
+            int32_t delta = (int32_t)fadeTarget[device] - fadeFrom[device];
+            intensity[device] = fadeFrom[device] + delta * (int32_t)elapsed / fadeDuration[device];
+        }
+        changed = true;
+    }
+
+    // Level bulat tanpa crossfade: register sudah benar, tidak ada yang perlu dikirim
+    if (!changed && !dithering) return false;
+
+    // Satu fase per FB_DITHER_PERIOD_US; di antara fase tidak ada yang perlu dikirim
+    uint8_t phase = ditherPhase();
+    if (phase == lastPhase && !changed) return false;
+    lastPhase = phase;
+
+    bool sent = syncRegisters(phase);
+
+    if (blendActive) {
+        // Ambang berbeda per baris supaya baris tidak berkedip serempak
+        uint8_t frame[FB_MAX_DEVICES][FB_ROWS];
+        for (uint8_t row = 0; row < FB_ROWS; row++) {
+            bool useTo = blendMix > DITHER_ORDER[(phase + row) % FB_DITHER_PHASES];
+            for (uint8_t device = 0; device < fbDevices; device++) {
+                frame[device][row] = useTo ? blendTo[device][row] : blendFrom[device][row];
+            }
+        }
+        if (pushRows(frame)) {
+            fbStats.ditherPushes++;
+            sent = true;
+        }
+    }
+    return sent;
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTIK =====
+
+const FramebufferStats* framebufferGetStats() {
+    return &fbStats;
+}
+
+void framebufferResetStats() {
+    memset(&fbStats, 0, sizeof(fbStats));
+}
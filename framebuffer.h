@@ -0,0 +1,73 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include "settings.h"
+#include <stdint.h>
+
+// Build Information
+#define FRAMEBUFFER_VERSION "1.1.0"
+#define FRAMEBUFFER_BUILD_DATE "2026-10-17 14:55:12"
+#define FRAMEBUFFER_AUTHOR "Brodot23"
+
+// Framebuffer Configuration
+#define FB_MAX_DEVICES 8        // Jumlah maksimum MAX7219 dalam satu chain
+#define FB_ROWS 8               // Baris per modul (digit register MAX7219)
+
+// MAX7219 Register Opcodes
+#define MAX7219_OP_NOOP 0x00    // No-op, dipakai untuk modul yang tidak berubah
+#define MAX7219_OP_DIGIT0 0x01  // Digit 0..7 = opcode 1..8
+#define MAX7219_OP_INTENSITY 0x0A
+#define MAX7219_OP_SHUTDOWN 0x0C
+
+// Intensity Channel
+// Nilai per modul 0..FB_INTENSITY_MAX dalam langkah 1/FB_INTENSITY_STEPS level MAX7219:
+// 0 = mati (shutdown), FB_LEVEL(n) = register intensity n. Nilai di antara dua level
+// ditampilkan dengan temporal dithering (ordered, FB_DITHER_PHASES fase per siklus).
+#define FB_INTENSITY_STEPS 16
+#define FB_INTENSITY_MAX (16 * FB_INTENSITY_STEPS)
+#define FB_LEVEL(n) ((uint16_t)((n) + 1) * FB_INTENSITY_STEPS)
+#define FB_DITHER_PHASES 16
+#define FB_DITHER_PERIOD_US 1000    // Durasi satu fase dither
+#define FB_BLEND_MAX 16             // Crossfade: 0 = frame lama, 16 = frame baru
+
+// Transport Statistics
+typedef struct {
+    uint32_t frames;                // Jumlah frame yang di-push
+    uint32_t transactions;          // Total pulsa CS sejak reset
+    uint32_t bytes;                 // Total byte yang di-shift sejak reset
+    uint32_t rowsSkipped;           // Baris yang dilewati karena tidak berubah
+    uint16_t lastFrameTransactions; // Pulsa CS pada frame terakhir
+    uint16_t lastFrameBytes;        // Byte yang di-shift pada frame terakhir
+    uint32_t registerWrites;        // Pulsa CS untuk register intensity/shutdown
+    uint32_t ditherPushes;          // Frame crossfade yang dikirim oleh dither
+} FramebufferStats;
+
+// Function Prototypes
+// Initialization
+void framebufferInit(uint8_t dataPin, uint8_t clkPin, uint8_t csPin, uint8_t numDevices);
+void framebufferInvalidate();
+
+// Frame Push
+uint8_t framebufferPush(const uint8_t frame[][FB_ROWS]);
+uint8_t framebufferGetLatchedRow(uint8_t device, uint8_t row);
+
+// Intensity Channel & Fades
+void framebufferSetIntensity(uint8_t device, uint16_t value);
+void framebufferSetAllIntensity(uint16_t value);
+uint16_t framebufferGetIntensity(uint8_t device);
+void framebufferFadeTo(uint8_t device, uint16_t target, uint16_t durationMs);
+void framebufferFadeAllTo(uint16_t target, uint16_t durationMs);
+bool framebufferFading();
+
+// Crossfade (temporal dither antara dua frame)
+void framebufferBlend(const uint8_t from[][FB_ROWS], const uint8_t to[][FB_ROWS], uint8_t mix);
+bool framebufferBlending();
+
+// Dither & fade service, dipanggil dari loop()
+bool framebufferService();
+
+// Statistics
+const FramebufferStats* framebufferGetStats();
+void framebufferResetStats();
+
+#endif // FRAMEBUFFER_H
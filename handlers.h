@@ -7,87 +7,18 @@
 #include "display.h"
 #include "wifi.h"
 #include "webserver.h"
+#include "eventqueue.h"
 
 // Build Information
-#define HANDLERS_VERSION "1.0.0"
+#define HANDLERS_VERSION "1.1.0"
 #define HANDLERS_BUILD_DATE "2025-05-11 07:46:45"
 #define HANDLERS_AUTHOR "Brodot23"
 
 // Event Types and Constants
 #define MAX_EVENT_HANDLERS 20
-#define MAX_EVENT_QUEUE 50
-#define EVENT_TIMEOUT 5000  // 5 seconds in milliseconds
-
-// Event Priority Levels
-typedef enum {
-    PRIORITY_LOW = 0,
-    PRIORITY_NORMAL = 1,
-    PRIORITY_HIGH = 2,
-    PRIORITY_CRITICAL = 3
-} EventPriority;
-
-// Event Types
-typedef enum {
-    // System Events
-    EVENT_SYSTEM_STARTUP,
-    EVENT_SYSTEM_SHUTDOWN,
-    EVENT_SYSTEM_RESET,
-    EVENT_SYSTEM_ERROR,
-    
-    // Hardware Events
-    EVENT_BUTTON_PRESSED,
-    EVENT_BUTTON_RELEASED,
-    EVENT_BUTTON_LONG_PRESS,
-    EVENT_BUTTON_DOUBLE_PRESS,
-    
-    // Animation Events
-    EVENT_ANIMATION_START,
-    EVENT_ANIMATION_STOP,
-    EVENT_ANIMATION_COMPLETE,
-    EVENT_ANIMATION_ERROR,
-    
-    // Display Events
-    EVENT_DISPLAY_UPDATE,
-    EVENT_DISPLAY_CLEAR,
-    EVENT_DISPLAY_ERROR,
-    
-    // Network Events
-    EVENT_WIFI_CONNECTED,
-    EVENT_WIFI_DISCONNECTED,
-    EVENT_WIFI_AP_START,
-    EVENT_WIFI_AP_STOP,
-    
-    // Server Events
-    EVENT_SERVER_START,
-    EVENT_SERVER_STOP,
-    EVENT_CLIENT_CONNECTED,
-    EVENT_CLIENT_DISCONNECTED,
-    
-    // Pattern Events
-    EVENT_PATTERN_CHANGE,
-    EVENT_PATTERN_COMPLETE,
-    EVENT_PATTERN_ERROR,
-    
-    // Mode Events
-    EVENT_MODE_CHANGE,
-    EVENT_MODE_UPDATE,
-    EVENT_MODE_ERROR,
-    
-    // Configuration Events
-    EVENT_CONFIG_CHANGED,
-    EVENT_CONFIG_SAVED,
-    EVENT_CONFIG_RESET,
-    EVENT_CONFIG_ERROR
-} EventType;
-
-// Event Data Structure
-typedef struct {
-    EventType type;
-    EventPriority priority;
-    unsigned long timestamp;
-    void* data;
-    size_t dataSize;
-} Event;
+#define MAX_EVENT_QUEUE (EVENT_LANE_COUNT * EVENT_LANE_SLOTS)
+
+// Event Priority, EventType dan Event (payload inline) ada di eventqueue.h
 
 // Event Handler Function Type
 typedef void (*EventHandler)(const Event* event);
@@ -100,29 +31,18 @@ typedef struct {
     bool enabled;
 } HandlerRegistration;
 
-// Event Queue Structure
-typedef struct {
-    Event events[MAX_EVENT_QUEUE];
-    int head;
-    int tail;
-    int count;
-} EventQueue;
-
 // External Variables
-extern EventQueue eventQueue;
 extern HandlerRegistration handlers[MAX_EVENT_HANDLERS];
 extern volatile bool eventProcessingEnabled;
 
 // Function Declarations
 
-// Event Queue Management
-void initEventSystem();
-bool queueEvent(EventType type, EventPriority priority, void* data, size_t dataSize);
-bool dequeueEvent(Event* event);
-void clearEventQueue();
-bool isEventQueueFull();
-bool isEventQueueEmpty();
-int getEventQueueSize();
+// Event Queue Management (eventqueue.h: lane SPSC per prioritas, aman dari ISR)
+//   initEventSystem    -> eventqueueInit
+//   queueEvent         -> eventqueuePost (payload disalin, maks EVENT_PAYLOAD_SIZE byte)
+//   dequeueEvent       -> eventqueueTake (prioritas tertinggi dulu, EVENT_TIMEOUT dibuang)
+//   clearEventQueue    -> eventqueueClear
+//   getEventQueueSize  -> eventqueueSize
 
 // Event Handler Management
 bool registerEventHandler(EventType type, EventHandler handler, EventPriority priority);
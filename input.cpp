@@ -0,0 +1,292 @@
+#include "input.h"
+#include "settings.h"
+#include <Arduino.h>
+
+// Build Information
+#define INPUT_CPP_VERSION "1.3.0"
+#define INPUT_CPP_BUILD_DATE "2026-10-18 12:05:48"
+#define INPUT_CPP_AUTHOR "Brodot23"
+
+// Ditulis dari ISR
+static volatile uint32_t edgeMicros[INPUT_COUNT];
+static volatile bool edgeOpen[INPUT_COUNT];     // Edge belum sampai ke LED
+static volatile bool edgeQueued[INPUT_COUNT];   // EVENT_INPUT_EDGE channel ini masih di antrean
+
+static uint8_t inputPins[INPUT_COUNT];
+static bool inputPolled[INPUT_COUNT];
+static uint8_t polledLevel[INPUT_COUNT];
+
+// Window rem per sensitivity 1..5 dalam sampel: makin sensitif makin cepat, makin rentan bounce
+static const uint8_t BRAKE_WINDOWS[INPUT_SENSITIVITY_MAX] = { 16, 12, 8, 5, 3 };
+
+// Integrator: count naik saat sampel aktif, turun saat tidak, saturasi di [0, window].
+// Output baru berubah di rail, jadi pulsa lebih pendek dari window tidak pernah lolos.
+typedef struct {
+    uint8_t count;
+    uint8_t window;
+    bool output;            // Level stabil (true = aktif)
+    bool raw;               // Sampel terakhir
+    bool excursion;         // count sudah meninggalkan rail output
+} InputFilter;
+
+// Integrator dan hasilnya ditulis dari ISR timer1; sisi loop() membaca/mengosongkan
+// dengan interrupt mati
+static volatile InputFilter filters[INPUT_COUNT];
+static volatile uint8_t pendingChanges;
+
+// Timestamp injakan rem yang lolos debounce (ring), untuk deteksi pumping
+static uint32_t pressMillis[INPUT_HARD_BRAKE_PRESSES];
+static uint8_t pressHead;
+static uint8_t pressCount;
+static volatile bool hardBrakePending;
+static volatile uint32_t hardBrakeCount;
+
+static InputLatencyStats latencyStats[INPUT_COUNT];
+static InputFilterStats filterStats[INPUT_COUNT];
+
+static void onSampleTimer();
+
+// ===== IMPLEMENTASI ISR =====
+
+// Hanya edge pertama sejak latch terakhir yang dicatat, bounce tidak menggeser timestamp.
+// Selama event channel masih di antrean, edge berikutnya tidak di-post lagi. Event hanya
+// membangunkan lane input; level stabil datang dari integrator (inputTakeChanges), jadi
+// edge yang tidak di-post tetap terlihat lewat sampel timer berikutnya.
+static void ICACHE_RAM_ATTR recordEdge(uint8_t channel) {
+    if (!edgeOpen[channel]) {
+        edgeMicros[channel] = micros();
+        edgeOpen[channel] = true;
+    }
+    if (!edgeQueued[channel]) {
+        EventPriority priority = (channel == INPUT_BRAKE) ? INPUT_BRAKE_PRIORITY : INPUT_SEIN_PRIORITY;
+        edgeQueued[channel] = eventqueuePost(EVENT_INPUT_EDGE, priority, &channel, sizeof(channel));
+    }
+}
+
+static void ICACHE_RAM_ATTR onBrakeEdge() {
+    recordEdge(INPUT_BRAKE);
+}
+
+static void ICACHE_RAM_ATTR onSeinLeftEdge() {
+    recordEdge(INPUT_SEIN_LEFT);
+}
+
+static void ICACHE_RAM_ATTR onSeinRightEdge() {
+    recordEdge(INPUT_SEIN_RIGHT);
+}
+
+// ===== IMPLEMENTASI FUNGSI INISIALISASI =====
+
+void inputInit(uint8_t brakePin, uint8_t seinLeftPin, uint8_t seinRightPin) {
+    static void (* const handlers[INPUT_COUNT])() = { onBrakeEdge, onSeinLeftEdge, onSeinRightEdge };
+
+    inputPins[INPUT_BRAKE] = brakePin;
+    inputPins[INPUT_SEIN_LEFT] = seinLeftPin;
+    inputPins[INPUT_SEIN_RIGHT] = seinRightPin;
+
+    for (uint8_t channel = 0; channel < INPUT_COUNT; channel++) {
+        uint8_t pin = inputPins[channel];
+        pinMode(pin, INPUT_PULLUP);
+        edgeOpen[channel] = false;
+        edgeQueued[channel] = false;
+
+        // Level saat boot langsung dianggap stabil, tidak menunggu window
+        uint8_t level = digitalRead(pin);
+        volatile InputFilter* filter = &filters[channel];
+        filter->window = (channel == INPUT_BRAKE) ? BRAKE_WINDOWS[2] : INPUT_SEIN_WINDOW;
+        filter->output = (level == LOW);
+        filter->raw = filter->output;
+        filter->count = filter->output ? filter->window : 0;
+        filter->excursion = false;
+
+        inputPolled[channel] = (pin == INPUT_NO_INTERRUPT_PIN);
+        if (inputPolled[channel]) {
+            polledLevel[channel] = level;
+        } else {
+            attachInterrupt(digitalPinToInterrupt(pin), handlers[channel], CHANGE);
+        }
+    }
+
+    // Paksa handleInput() membaca level awal pada service pertama
+    pendingChanges = INPUT_EDGE_BRAKE | INPUT_EDGE_SEIN_LEFT | INPUT_EDGE_SEIN_RIGHT;
+    pressHead = 0;
+    pressCount = 0;
+    hardBrakePending = false;
+    hardBrakeCount = 0;
+    memset(filterStats, 0, sizeof(filterStats));
+    inputResetLatency();
+
+    timer1_attachInterrupt(onSampleTimer);
+    timer1_enable(TIM_DIV16, TIM_EDGE, TIM_LOOP);
+    timer1_write(INPUT_TIMER_TICKS);
+}
+
+void inputSetSensitivity(uint8_t sensitivity) {
+    sensitivity = constrain(sensitivity, INPUT_SENSITIVITY_MIN, INPUT_SENSITIVITY_MAX);
+    volatile InputFilter* filter = &filters[INPUT_BRAKE];
+    noInterrupts();
+    filter->window = BRAKE_WINDOWS[sensitivity - 1];
+    // Rail output ikut pindah, state stabil tidak berubah karena ganti window
+    if (filter->output || filter->count > filter->window) {
+        filter->count = filter->output ? filter->window : 0;
+    }
+    interrupts();
+}
+
+// ===== IMPLEMENTASI FUNGSI SAMPLING =====
+
+static void ICACHE_RAM_ATTR recordPress() {
+    uint32_t now = millis();
+    pressMillis[pressHead] = now;
+    pressHead = (pressHead + 1) % INPUT_HARD_BRAKE_PRESSES;
+    if (pressCount < INPUT_HARD_BRAKE_PRESSES) pressCount++;
+
+    // Setelah tulis, pressHead menunjuk injakan tertua di ring
+    if (pressCount == INPUT_HARD_BRAKE_PRESSES &&
+        now - pressMillis[pressHead] <= INPUT_HARD_BRAKE_WINDOW_MS) {
+        hardBrakePending = true;
+        hardBrakeCount++;
+        pressCount = 0;
+    }
+}
+
+static void ICACHE_RAM_ATTR sampleChannel(uint8_t channel) {
+    uint8_t level = digitalRead(inputPins[channel]);
+    bool active = (level == LOW);
+    volatile InputFilter* filter = &filters[channel];
+    InputFilterStats* stats = &filterStats[channel];
+
+    // Channel tanpa interrupt: edge dideteksi di sini, timestamp = saat terdeteksi.
+    // ISR timer dan ISR pin tidak saling menyela (level interrupt sama): tetap satu producer.
+    if (inputPolled[channel] && level != polledLevel[channel]) {
+        polledLevel[channel] = level;
+        recordEdge(channel);
+    }
+
+    if (active != filter->raw) {
+        filter->raw = active;
+        stats->rawTransitions++;
+    }
+
+    if (active) {
+        if (filter->count < filter->window) filter->count++;
+    } else if (filter->count > 0) {
+        filter->count--;
+    }
+
+    uint8_t rail = filter->output ? filter->window : 0;
+    if (filter->count != rail) {
+        uint8_t opposite = filter->output ? 0 : filter->window;
+        if (filter->count == opposite) {
+            filter->output = !filter->output;
+            filter->excursion = false;
+            stats->accepted++;
+            pendingChanges |= 1 << channel;
+            if (channel == INPUT_BRAKE && filter->output) recordPress();
+        } else {
+            filter->excursion = true;
+        }
+    } else if (filter->excursion) {
+        // Kembali ke rail tanpa berubah: bounce, timestamp edge-nya dibuang dari statistik latency
+        filter->excursion = false;
+        stats->filtered++;
+        edgeOpen[channel] = false;
+    }
+}
+
+// Satu sampel per INPUT_SAMPLE_INTERVAL_US dari timer1, jadi window debounce dan
+// penerimaan transisi tetap dalam milidetik walau loop() tertahan (web, simpan flash)
+static void ICACHE_RAM_ATTR onSampleTimer() {
+    for (uint8_t channel = 0; channel < INPUT_COUNT; channel++) {
+        sampleChannel(channel);
+    }
+}
+
+// ===== IMPLEMENTASI FUNGSI EDGE =====
+
+uint8_t inputTakeEdge(const Event* event) {
+    if (event->type != EVENT_INPUT_EDGE || event->size < 1 || event->payload[0] >= INPUT_COUNT) {
+        return 0;
+    }
+    uint8_t channel = event->payload[0];
+    edgeQueued[channel] = false;
+    return 1 << channel;
+}
+
+uint8_t inputTakeChanges() {
+    noInterrupts();
+    uint8_t changes = pendingChanges;
+    pendingChanges = 0;
+    interrupts();
+    return changes;
+}
+
+bool inputActive(uint8_t channel) {
+    return channel < INPUT_COUNT && filters[channel].output;
+}
+
+uint8_t inputGetLevels() {
+    uint8_t levels = 0;
+    for (uint8_t channel = 0; channel < INPUT_COUNT; channel++) {
+        if (filters[channel].raw) levels |= 1 << channel;
+        if (filters[channel].output) levels |= 1 << (channel + 4);
+    }
+    return levels;
+}
+
+bool inputTakeHardBrake() {
+    noInterrupts();
+    bool pending = hardBrakePending;
+    hardBrakePending = false;
+    interrupts();
+    return pending;
+}
+
+void inputMarkLatched(uint8_t edges) {
+    uint32_t now = micros();
+
+    for (uint8_t channel = 0; channel < INPUT_COUNT; channel++) {
+        if (!(edges & (1 << channel))) continue;
+
+        noInterrupts();
+        bool open = edgeOpen[channel];
+        uint32_t start = edgeMicros[channel];
+        edgeOpen[channel] = false;
+        interrupts();
+        if (!open) continue;
+
+        uint32_t latency = now - start;
+        InputLatencyStats* stats = &latencyStats[channel];
+        if (stats->count == 0 || latency < stats->minMicros) stats->minMicros = latency;
+        if (latency > stats->maxMicros) stats->maxMicros = latency;
+        stats->totalMicros += latency;
+        stats->count++;
+    }
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTIK =====
+
+const InputLatencyStats* inputGetLatency(uint8_t channel) {
+    return channel < INPUT_COUNT ? &latencyStats[channel] : NULL;
+}
+
+uint32_t inputGetAverageLatency(uint8_t channel) {
+    if (channel >= INPUT_COUNT || latencyStats[channel].count == 0) return 0;
+    return latencyStats[channel].totalMicros / latencyStats[channel].count;
+}
+
+void inputResetLatency() {
+    memset(latencyStats, 0, sizeof(latencyStats));
+}
+
+const InputFilterStats* inputGetFilterStats(uint8_t channel) {
+    return channel < INPUT_COUNT ? &filterStats[channel] : NULL;
+}
+
+uint8_t inputGetWindow(uint8_t channel) {
+    return channel < INPUT_COUNT ? filters[channel].window : 0;
+}
+
+uint32_t inputGetHardBrakes() {
+    return hardBrakeCount;
+}
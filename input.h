@@ -0,0 +1,82 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "settings.h"
+#include "eventqueue.h"
+#include <stdint.h>
+
+// Build Information
+#define INPUT_VERSION "1.3.0"
+#define INPUT_BUILD_DATE "2026-10-18 12:05:48"
+#define INPUT_AUTHOR "Brodot23"
+
+// Input Channels
+#define INPUT_BRAKE 0
+#define INPUT_SEIN_LEFT 1
+#define INPUT_SEIN_RIGHT 2
+#define INPUT_COUNT 3
+
+// Edge Flags (hasil inputTakeEdge)
+#define INPUT_EDGE_BRAKE (1 << INPUT_BRAKE)
+#define INPUT_EDGE_SEIN_LEFT (1 << INPUT_SEIN_LEFT)
+#define INPUT_EDGE_SEIN_RIGHT (1 << INPUT_SEIN_RIGHT)
+
+// GPIO16 pada ESP8266 tidak punya interrupt, channel ini di-poll
+#define INPUT_NO_INTERRUPT_PIN 16
+
+// Sampling fixed-rate + debounce integrator (1 sampel = 1 ms) dari ISR timer1:
+// window dalam milidetik sungguhan, tidak bergantung pada lama loop()
+#define INPUT_SAMPLE_INTERVAL_US 1000
+#define INPUT_TIMER_TICKS (INPUT_SAMPLE_INTERVAL_US * 5)   // TIM_DIV16: 5 tick per us
+#define INPUT_SEIN_WINDOW 10                // Sampel stabil sebelum sein berubah
+#define INPUT_SENSITIVITY_MIN 1             // brakeSettings.sensitivity, window rem lihat input.cpp
+#define INPUT_SENSITIVITY_MAX 5
+
+// Hard brake: rem diinjak berulang (pumping) INPUT_HARD_BRAKE_PRESSES kali dalam window
+#define INPUT_HARD_BRAKE_PRESSES 3
+#define INPUT_HARD_BRAKE_WINDOW_MS 1500
+
+// Lane event per channel: rem menyalip sein, keduanya menyalip event config
+#define INPUT_BRAKE_PRIORITY PRIORITY_CRITICAL
+#define INPUT_SEIN_PRIORITY PRIORITY_HIGH
+
+// Edge-to-latch latency (mikrodetik)
+typedef struct {
+    uint32_t count;         // Jumlah edge yang sudah sampai ke LED
+    uint32_t minMicros;
+    uint32_t maxMicros;
+    uint32_t totalMicros;   // Untuk rata-rata: totalMicros / count
+} InputLatencyStats;
+
+// Statistik integrator per channel
+typedef struct {
+    uint32_t rawTransitions;    // Perubahan level antar sampel (termasuk bounce)
+    uint32_t accepted;          // Transisi yang lolos window dan diteruskan ke handleInput
+    uint32_t filtered;          // Excursion yang kembali sebelum window penuh (bounce/glitch)
+} InputFilterStats;
+
+// Function Prototypes
+// Initialization
+void inputInit(uint8_t brakePin, uint8_t seinLeftPin, uint8_t seinRightPin);
+
+void inputSetSensitivity(uint8_t sensitivity);
+
+// Edge Handling
+// ISR pin hanya mencatat timestamp edge dan mem-post EVENT_INPUT_EDGE (maks satu per channel
+// di antrean); level yang dipakai sketch berasal dari integrator di ISR timer1.
+uint8_t inputTakeEdge(const Event* event);
+uint8_t inputTakeChanges();                 // INPUT_EDGE_* yang level stabilnya berubah
+bool inputActive(uint8_t channel);          // Level stabil, aktif LOW sudah dibalik
+bool inputTakeHardBrake();
+uint8_t inputGetLevels();                   // Bit channel = sampel mentah, bit 4 + channel = level stabil
+void inputMarkLatched(uint8_t edges);
+
+// Statistics
+const InputLatencyStats* inputGetLatency(uint8_t channel);
+uint32_t inputGetAverageLatency(uint8_t channel);
+void inputResetLatency();
+const InputFilterStats* inputGetFilterStats(uint8_t channel);
+uint8_t inputGetWindow(uint8_t channel);
+uint32_t inputGetHardBrakes();
+
+#endif // INPUT_H
@@ -0,0 +1,320 @@
+#include "livestream.h"
+#include "settings.h"
+#include <Arduino.h>
+#include <WebSocketsServer.h>
+
+// Build Information
+#define LIVESTREAM_CPP_VERSION "1.0.0"
+#define LIVESTREAM_CPP_BUILD_DATE "2026-10-17 17:32:08"
+#define LIVESTREAM_CPP_AUTHOR "Brodot23"
+
+static WebSocketsServer webSocket(LIVE_WS_PORT);
+
+static const uint8_t (*liveFrame)[FB_ROWS] = nullptr;   // Frame komposit milik sketch
+static uint8_t liveDevices = 0;
+static LiveStateWriter writeState = nullptr;
+static LiveCommandHandler runCommand = nullptr;
+
+// Bit n = klien WebSocket n
+static uint8_t connectedMask = 0;
+static uint8_t subscribedMask = 0;      // Berlangganan mirror
+static uint8_t keyPendingMask = 0;      // Baru berlangganan, menunggu keyframe
+static uint8_t statePendingMask = 0;    // Baru terhubung / getState
+
+static bool stateDirty = false;
+static uint32_t lastStateMillis = 0;
+
+// Semua pelanggan memegang frame referensi yang sama, jadi satu delta berlaku untuk semua
+static uint8_t reference[LIVE_FRAME_BYTES];
+static bool referenceValid = false;
+static uint8_t deltasSinceKey = 0;
+static uint8_t mirrorFps = LIVE_DEFAULT_FPS;
+static uint32_t lastFrameMillis = 0;
+static uint32_t lastPushCount = 0;      // framebufferGetStats()->frames saat frame terakhir dikirim
+
+static LiveStreamStats liveStats;
+
+// ===== IMPLEMENTASI FUNGSI ENCODING =====
+
+size_t livestreamEncodeKey(const uint8_t* frame, uint8_t devices, uint8_t* out) {
+    size_t bytes = (size_t)devices * FB_ROWS;
+    out[0] = LIVE_MSG_KEY;
+    out[1] = devices;
+    memcpy(out + 2, frame, bytes);
+    return 2 + bytes;
+}
+
+// 0 = frame sama dengan previous
+size_t livestreamEncodeDelta(const uint8_t* previous, const uint8_t* frame, uint8_t devices, uint8_t* out) {
+    out[0] = LIVE_MSG_DELTA;
+    out[1] = devices;
+    uint8_t* mask = out + 2;
+    size_t length = 2 + devices;
+    for (uint8_t d = 0; d < devices; d++) {
+        mask[d] = 0;
+        for (uint8_t r = 0; r < FB_ROWS; r++) {
+            uint8_t diff = previous[d * FB_ROWS + r] ^ frame[d * FB_ROWS + r];
+            if (diff) {
+                mask[d] |= 1 << r;
+                out[length++] = diff;
+            }
+        }
+    }
+    return (length == 2 + (size_t)devices) ? 0 : length;
+}
+
+// Terapkan satu pesan ke frame (format sama dengan decoder di script.js)
+bool livestreamDecode(const uint8_t* message, size_t length, uint8_t* frame) {
+    if (length < 2 || message[1] == 0 || message[1] > FB_MAX_DEVICES) return false;
+    uint8_t devices = message[1];
+    size_t bytes = (size_t)devices * FB_ROWS;
+
+    if (message[0] == LIVE_MSG_KEY) {
+        if (length != 2 + bytes) return false;
+        memcpy(frame, message + 2, bytes);
+        return true;
+    }
+    if (message[0] != LIVE_MSG_DELTA || length < 2 + (size_t)devices) return false;
+
+    const uint8_t* mask = message + 2;
+    const uint8_t* diff = mask + devices;
+    const uint8_t* end = message + length;
+    for (uint8_t d = 0; d < devices; d++) {
+        for (uint8_t r = 0; r < FB_ROWS; r++) {
+            if (!(mask[d] & (1 << r))) continue;
+            if (diff >= end) return false;
+            frame[d * FB_ROWS + r] ^= *diff++;
+        }
+    }
+    return diff == end;
+}
+
+// ===== IMPLEMENTASI FUNGSI PESAN =====
+
+static void sendResult(uint8_t client, const char* message, const char* error) {
+    StaticJsonDocument<256> doc;
+    doc["type"] = message ? "success" : "error";
+    doc["message"] = message ? message : error;
+    char buffer[192];
+    serializeJson(doc, buffer, sizeof(buffer));
+    webSocket.sendTXT(client, buffer);
+}
+
+static void sendState(uint8_t clients) {
+    StaticJsonDocument<1024> doc;
+    doc["type"] = "state";
+    JsonObject payload = doc.createNestedObject("payload");
+    if (writeState) {
+        writeState(payload);
+    }
+
+    String message;
+    serializeJson(doc, message);
+    if (clients == connectedMask) {
+        webSocket.broadcastTXT(message);
+    } else {
+        for (uint8_t client = 0; client < LIVE_MAX_CLIENTS; client++) {
+            if (clients & (1 << client)) webSocket.sendTXT(client, message);
+        }
+    }
+    liveStats.stateMessages++;
+}
+
+static void sendFrame(uint8_t clients, const uint8_t* message, size_t length) {
+    for (uint8_t client = 0; client < LIVE_MAX_CLIENTS; client++) {
+        if (!(clients & (1 << client))) continue;
+        webSocket.sendBIN(client, message, length);
+        liveStats.bytes += length;
+    }
+    if (message[0] == LIVE_MSG_KEY) liveStats.keyFrames++;
+    else liveStats.deltaFrames++;
+}
+
+// ===== IMPLEMENTASI FUNGSI PERINTAH =====
+
+static void handleCommand(uint8_t client, const uint8_t* payload, size_t length) {
+    StaticJsonDocument<512> doc;
+    if (deserializeJson(doc, (const char*)payload, length)) {
+        liveStats.rejected++;
+        sendResult(client, NULL, "JSON tidak valid");
+        return;
+    }
+
+    const char* command = doc["command"] | "";
+    JsonVariant data = doc["data"];
+    liveStats.commands++;
+
+    if (!strcmp(command, "getState")) {
+        statePendingMask |= 1 << client;
+        return;
+    }
+    if (!strcmp(command, "mirror")) {
+        bool enabled = data["enabled"] | true;
+        if (data.containsKey("fps")) {
+            livestreamSetRate(data["fps"]);
+        }
+        if (enabled) {
+            subscribedMask |= 1 << client;
+            keyPendingMask |= 1 << client;
+        } else {
+            subscribedMask &= ~(1 << client);
+            keyPendingMask &= ~(1 << client);
+        }
+        sendResult(client, enabled ? "Mirror aktif" : "Mirror berhenti", NULL);
+        return;
+    }
+
+    const char* error = "Perintah tidak dikenal";
+    const char* message = runCommand ? runCommand(command, data, &error) : NULL;
+    if (!message) {
+        liveStats.rejected++;
+    }
+    sendResult(client, message, error);
+}
+
+static void onWebSocketEvent(uint8_t client, WStype_t type, uint8_t* payload, size_t length) {
+    if (client >= LIVE_MAX_CLIENTS) return;
+    uint8_t bit = 1 << client;
+
+    switch (type) {
+        case WStype_CONNECTED:
+            connectedMask |= bit;
+            statePendingMask |= bit;
+            break;
+        case WStype_DISCONNECTED:
+            connectedMask &= ~bit;
+            subscribedMask &= ~bit;
+            keyPendingMask &= ~bit;
+            statePendingMask &= ~bit;
+            break;
+        case WStype_TEXT:
+            handleCommand(client, payload, length);
+            break;
+        default:
+            break;
+    }
+}
+
+// ===== IMPLEMENTASI FUNGSI INISIALISASI =====
+
+void livestreamBegin(const uint8_t (*frame)[FB_ROWS], uint8_t devices,
+                     LiveStateWriter stateWriter, LiveCommandHandler commandHandler) {
+    liveFrame = frame;
+    liveDevices = constrain(devices, 1, FB_MAX_DEVICES);
+    writeState = stateWriter;
+    runCommand = commandHandler;
+    referenceValid = false;
+    livestreamResetStats();
+
+    webSocket.begin();
+    webSocket.onEvent(onWebSocketEvent);
+}
+
+// ===== IMPLEMENTASI FUNGSI SERVICE =====
+
+static void serviceMirror(uint32_t now) {
+    const uint8_t* frame = &liveFrame[0][0];
+    size_t bytes = (size_t)liveDevices * FB_ROWS;
+    uint32_t pushes = framebufferGetStats()->frames;
+    uint8_t message[LIVE_MESSAGE_MAX];
+
+    if (keyPendingMask) {
+        // Pelanggan baru menerima referensi yang dipegang pelanggan lain
+        if (!referenceValid) {
+            memcpy(reference, frame, bytes);
+            referenceValid = true;
+            deltasSinceKey = 0;
+            lastPushCount = pushes;
+            lastFrameMillis = now;
+        }
+        sendFrame(keyPendingMask, message, livestreamEncodeKey(reference, liveDevices, message));
+        keyPendingMask = 0;
+        return;
+    }
+
+    // Batas fps: frame di antara dua kiriman digabung, hanya yang terbaru yang dikirim
+    if (now - lastFrameMillis < 1000 / mirrorFps || pushes == lastPushCount) return;
+
+    size_t length = 0;
+    if (deltasSinceKey < LIVE_KEYFRAME_INTERVAL) {
+        length = livestreamEncodeDelta(reference, frame, liveDevices, message);
+        if (length == 0) {
+            lastPushCount = pushes;
+            return;
+        }
+    }
+    if (length == 0 || length > 2 + bytes) {
+        length = livestreamEncodeKey(frame, liveDevices, message);
+    }
+
+    // framebufferResetStats() membuat counter mundur: anggap tidak ada frame yang dilewati
+    if (pushes > lastPushCount + 1) {
+        liveStats.coalesced += pushes - lastPushCount - 1;
+    }
+    lastPushCount = pushes;
+    lastFrameMillis = now;
+    memcpy(reference, frame, bytes);
+    deltasSinceKey = (message[0] == LIVE_MSG_KEY) ? 0 : deltasSinceKey + 1;
+    sendFrame(subscribedMask, message, length);
+}
+
+// Maksimal satu pesan keluar per panggilan supaya loop() cepat kembali ke renderer
+void livestreamService() {
+    webSocket.loop();
+    if (!connectedMask) return;
+
+    uint32_t now = millis();
+    if (stateDirty && now - lastStateMillis >= LIVE_STATE_INTERVAL) {
+        sendState(connectedMask);
+        stateDirty = false;
+        statePendingMask = 0;
+        lastStateMillis = now;
+        return;
+    }
+    if (statePendingMask) {
+        sendState(statePendingMask);
+        statePendingMask = 0;
+        return;
+    }
+    if (subscribedMask && liveFrame) {
+        serviceMirror(now);
+    }
+}
+
+// ===== IMPLEMENTASI FUNGSI STATE =====
+
+void livestreamNotifyState() {
+    stateDirty = true;
+}
+
+void livestreamSetRate(uint8_t fps) {
+    mirrorFps = constrain(fps, 1, LIVE_MAX_FPS);
+}
+
+uint8_t livestreamGetRate() {
+    return mirrorFps;
+}
+
+static uint8_t countBits(uint8_t mask) {
+    uint8_t count = 0;
+    for (; mask; mask &= mask - 1) count++;
+    return count;
+}
+
+uint8_t livestreamClients() {
+    return countBits(connectedMask);
+}
+
+uint8_t livestreamSubscribers() {
+    return countBits(subscribedMask);
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTIK =====
+
+const LiveStreamStats* livestreamGetStats() {
+    return &liveStats;
+}
+
+void livestreamResetStats() {
+    memset(&liveStats, 0, sizeof(liveStats));
+}
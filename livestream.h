@@ -0,0 +1,77 @@
+#ifndef LIVESTREAM_H
+#define LIVESTREAM_H
+
+#include "settings.h"
+#include "framebuffer.h"
+#include <ArduinoJson.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Build Information
+#define LIVESTREAM_VERSION "1.0.0"
+#define LIVESTREAM_BUILD_DATE "2026-10-17 17:32:08"
+#define LIVESTREAM_AUTHOR "Brodot23"
+
+// WebSocket Configuration (script.js: ws://<host>:81)
+#define LIVE_WS_PORT 81
+#define LIVE_MAX_CLIENTS 5          // = WEBSOCKETS_SERVER_CLIENT_MAX
+#define LIVE_STATE_INTERVAL 100     // ms minimum antar push state (perubahan digabung)
+#define LIVE_DEFAULT_FPS 10         // Mirror tampilan, dibatasi per detik
+#define LIVE_MAX_FPS 25
+#define LIVE_KEYFRAME_INTERVAL 100  // Delta berturut-turut sebelum keyframe dipaksa
+
+// Pesan teks (JSON):  {"type":"state","payload":{...}} | {"type":"success"|"error","message":"..."}
+// Perintah klien:     {"command":"...","data":{...}}, "getState" dan "mirror" ditangani di sini
+//
+// Pesan biner mirror (hanya klien yang berlangganan lewat "mirror"):
+//   KEY:   [LIVE_MSG_KEY][devices][devices x 8 byte, modul 0 dulu, byte r = baris r]
+//   DELTA: [LIVE_MSG_DELTA][devices][mask 1 byte per modul][XOR byte yang berubah]
+//          bit r mask modul d = baris r modul d berubah; XOR terhadap frame yang terakhir
+//          dikirim. Encoder memilih yang lebih kecil, frame sama tidak dikirim.
+#define LIVE_MSG_KEY 0x01
+#define LIVE_MSG_DELTA 0x02
+#define LIVE_FRAME_BYTES (FB_MAX_DEVICES * FB_ROWS)
+#define LIVE_DELTA_MASK_BYTES FB_MAX_DEVICES
+#define LIVE_MESSAGE_MAX (2 + LIVE_DELTA_MASK_BYTES + LIVE_FRAME_BYTES)
+
+// Callback sketch
+typedef void (*LiveStateWriter)(JsonObject payload);
+// Mengembalikan pesan sukses, atau NULL dengan error berisi alasan penolakan
+typedef const char* (*LiveCommandHandler)(const char* command, JsonVariant data, const char** error);
+
+// Live Stream Statistics
+typedef struct {
+    uint32_t stateMessages;     // Push state (broadcast + permintaan getState)
+    uint32_t keyFrames;
+    uint32_t deltaFrames;
+    uint32_t bytes;             // Byte biner per klien yang dikirim
+    uint32_t coalesced;         // Frame yang di-push ke chain tapi dilewati oleh batas fps
+    uint32_t commands;
+    uint32_t rejected;          // Perintah tidak dikenal / JSON rusak
+} LiveStreamStats;
+
+// Function Prototypes
+// Initialization
+void livestreamBegin(const uint8_t (*frame)[FB_ROWS], uint8_t devices,
+                     LiveStateWriter stateWriter, LiveCommandHandler commandHandler);
+
+// Service, dipanggil dari loop() setelah render: maksimal satu pesan keluar per panggilan
+void livestreamService();
+
+// State & Mirror
+void livestreamNotifyState();
+void livestreamSetRate(uint8_t fps);
+uint8_t livestreamGetRate();
+uint8_t livestreamClients();
+uint8_t livestreamSubscribers();
+
+// Frame Encoding (tanpa state, dipakai juga oleh tool host)
+size_t livestreamEncodeKey(const uint8_t* frame, uint8_t devices, uint8_t* out);
+size_t livestreamEncodeDelta(const uint8_t* previous, const uint8_t* frame, uint8_t devices, uint8_t* out);
+bool livestreamDecode(const uint8_t* message, size_t length, uint8_t* frame);
+
+// Statistics
+const LiveStreamStats* livestreamGetStats();
+void livestreamResetStats();
+
+#endif // LIVESTREAM_H
@@ -0,0 +1,199 @@
+#include "preset.h"
+#include "settings.h"
+#include <Arduino.h>
+#include <FS.h>
+
+// Build Information
+#define PRESET_CPP_VERSION "1.0.0"
+#define PRESET_CPP_BUILD_DATE "2026-10-17 19:58:41"
+#define PRESET_CPP_AUTHOR "Brodot23"
+
+// Snapshot di RAM, rata 4 byte supaya pemanggil bisa langsung cast ke struct-nya
+typedef struct {
+    char name[PRESET_NAME_LENGTH];
+    bool used;
+    uint32_t data[(PRESET_DATA_MAX + 3) / 4];
+} PresetSlot;
+
+static PresetSlot slots[PRESET_COUNT];
+static uint16_t dataLength = 0;
+static uint16_t dataSchema = 0;
+static uint8_t activeIndex = PRESET_NONE;
+
+static PresetStats presetStats;
+
+// ===== IMPLEMENTASI FUNGSI FILE =====
+
+static void presetPath(uint8_t index, const char* extension, char* buffer, size_t size) {
+    snprintf(buffer, size, PRESET_DIR "/%u.%s", index, extension);
+}
+
+static uint32_t slotCrc(const PresetSlot* slot) {
+    uint32_t crc = configstoreCrc32(0, slot->name, PRESET_NAME_LENGTH);
+    return configstoreCrc32(crc, slot->data, dataLength);
+}
+
+static bool loadSlot(uint8_t index) {
+    char path[PRESET_PATH_LENGTH];
+    presetPath(index, "cfg", path, sizeof(path));
+    if (!SPIFFS.exists(path)) return false;
+
+    File file = SPIFFS.open(path, "r");
+    if (!file) return false;
+
+    PresetSlot* slot = &slots[index];
+    uint8_t header[12];
+    bool valid = file.read(header, sizeof(header)) == sizeof(header) &&
+                 memcmp(header, PRESET_MAGIC, 4) == 0 &&
+                 (header[4] | header[5] << 8) == dataSchema &&
+                 (header[6] | header[7] << 8) == dataLength &&
+                 file.read((uint8_t*)slot->name, PRESET_NAME_LENGTH) == PRESET_NAME_LENGTH &&
+                 file.read((uint8_t*)slot->data, dataLength) == dataLength;
+    file.close();
+
+    uint32_t crc = (uint32_t)header[8] | (uint32_t)header[9] << 8 |
+                   (uint32_t)header[10] << 16 | (uint32_t)header[11] << 24;
+    if (!valid || slotCrc(slot) != crc) {
+        // Schema lama atau file terpotong: slot dianggap kosong, file ditimpa saat disimpan
+        presetStats.errors++;
+        memset(slot, 0, sizeof(PresetSlot));
+        return false;
+    }
+    slot->name[PRESET_NAME_LENGTH - 1] = '\0';
+    slot->used = true;
+    return true;
+}
+
+// Tulis ke .tmp lalu rename: file lama tetap utuh kalau listrik mati di tengah tulis
+static bool writeSlot(uint8_t index) {
+    char path[PRESET_PATH_LENGTH];
+    char temp[PRESET_PATH_LENGTH];
+    presetPath(index, "cfg", path, sizeof(path));
+    presetPath(index, "tmp", temp, sizeof(temp));
+
+    const PresetSlot* slot = &slots[index];
+    uint32_t crc = slotCrc(slot);
+    uint8_t header[12];
+    memcpy(header, PRESET_MAGIC, 4);
+    header[4] = dataSchema & 0xFF;
+    header[5] = dataSchema >> 8;
+    header[6] = dataLength & 0xFF;
+    header[7] = dataLength >> 8;
+    for (uint8_t i = 0; i < 4; i++) {
+        header[8 + i] = crc >> (8 * i);
+    }
+
+    File file = SPIFFS.open(temp, "w");
+    if (!file) return false;
+    bool ok = file.write(header, sizeof(header)) == sizeof(header) &&
+              file.write((const uint8_t*)slot->name, PRESET_NAME_LENGTH) == PRESET_NAME_LENGTH &&
+              file.write((const uint8_t*)slot->data, dataLength) == dataLength;
+    file.close();
+
+    if (ok) {
+        SPIFFS.remove(path);
+        ok = SPIFFS.rename(temp, path);
+    }
+    if (!ok) {
+        SPIFFS.remove(temp);
+    }
+    return ok;
+}
+
+// ===== IMPLEMENTASI FUNGSI INISIALISASI =====
+
+void presetBegin(uint16_t length, uint16_t schema) {
+    dataLength = min(length, (uint16_t)PRESET_DATA_MAX);
+    dataSchema = schema;
+    activeIndex = PRESET_NONE;
+    memset(slots, 0, sizeof(slots));
+    memset(&presetStats, 0, sizeof(presetStats));
+
+    for (uint8_t i = 0; i < PRESET_COUNT; i++) {
+        loadSlot(i);
+    }
+}
+
+// ===== IMPLEMENTASI FUNGSI STORAGE =====
+
+bool presetSave(uint8_t index, const char* name, const void* data) {
+    if (index >= PRESET_COUNT || !name || !name[0]) return false;
+
+    PresetSlot* slot = &slots[index];
+    PresetSlot previous = *slot;
+    memset(slot->name, 0, PRESET_NAME_LENGTH);
+    strlcpy(slot->name, name, PRESET_NAME_LENGTH);
+    memcpy(slot->data, data, dataLength);
+    slot->used = true;
+
+    if (!writeSlot(index)) {
+        *slot = previous;
+        presetStats.errors++;
+        return false;
+    }
+    // Preset yang baru disimpan sama dengan config yang sedang tampil
+    activeIndex = index;
+    presetStats.saves++;
+    return true;
+}
+
+bool presetRemove(uint8_t index) {
+    if (index >= PRESET_COUNT || !slots[index].used) return false;
+
+    char path[PRESET_PATH_LENGTH];
+    presetPath(index, "cfg", path, sizeof(path));
+    SPIFFS.remove(path);
+    memset(&slots[index], 0, sizeof(PresetSlot));
+    if (activeIndex == index) {
+        activeIndex = PRESET_NONE;
+    }
+    return true;
+}
+
+// ===== IMPLEMENTASI FUNGSI LOOKUP =====
+
+const void* presetGet(uint8_t index) {
+    return (index < PRESET_COUNT && slots[index].used) ? slots[index].data : NULL;
+}
+
+const char* presetName(uint8_t index) {
+    return (index < PRESET_COUNT && slots[index].used) ? slots[index].name : NULL;
+}
+
+uint8_t presetFind(const char* name) {
+    for (uint8_t i = 0; i < PRESET_COUNT; i++) {
+        if (slots[i].used && !strncmp(slots[i].name, name, PRESET_NAME_LENGTH)) return i;
+    }
+    return PRESET_NONE;
+}
+
+uint8_t presetFreeSlot() {
+    for (uint8_t i = 0; i < PRESET_COUNT; i++) {
+        if (!slots[i].used) return i;
+    }
+    return PRESET_NONE;
+}
+
+// ===== IMPLEMENTASI FUNGSI PRESET AKTIF =====
+
+void presetSetActive(uint8_t index, uint32_t applyMicros) {
+    if (!presetGet(index)) return;
+    activeIndex = index;
+    presetStats.switches++;
+    presetStats.lastSwitchMicros = applyMicros;
+}
+
+uint8_t presetActive() {
+    return activeIndex;
+}
+
+// Config diubah setelah preset dipilih: tampilan tidak lagi sama dengan preset
+void presetClearActive() {
+    activeIndex = PRESET_NONE;
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTIK =====
+
+const PresetStats* presetGetStats() {
+    return &presetStats;
+}
@@ -0,0 +1,64 @@
+#ifndef PRESET_H
+#define PRESET_H
+
+#include "settings.h"
+#include "configstore.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// Build Information
+#define PRESET_VERSION "1.0.0"
+#define PRESET_BUILD_DATE "2026-10-17 19:58:41"
+#define PRESET_AUTHOR "Brodot23"
+
+// Preset bernama (siang, malam, show): snapshot config lengkap milik sketch.
+// Semua preset dibaca ke RAM saat boot, jadi pindah preset tidak membaca atau
+// menulis flash; flash hanya ditulis saat preset disimpan/dihapus.
+#define PRESET_COUNT 4
+#define PRESET_NAME_LENGTH 16
+#define PRESET_DATA_MAX CONFIGSTORE_PAYLOAD_MAX     // Sama dengan record configstore
+
+// File SPIFFS per preset PRESET_DIR "/<index>.cfg" (little endian):
+//   0  magic "SPRE"
+//   4  schema  uint16, versi layout data milik sketch
+//   6  length  uint16
+//   8  crc     uint32, configstoreCrc32() atas name + data
+//   12 name    PRESET_NAME_LENGTH byte, diakhiri 0
+//   28 data    length byte
+#define PRESET_MAGIC "SPRE"
+#define PRESET_DIR "/preset"
+#define PRESET_HEADER_SIZE (12 + PRESET_NAME_LENGTH)
+#define PRESET_PATH_LENGTH 24
+#define PRESET_NONE 0xFF
+
+// Preset Statistics
+typedef struct {
+    uint32_t switches;          // presetSetActive() ke preset yang ada
+    uint32_t saves;             // File preset yang ditulis
+    uint32_t errors;            // File rusak saat boot / gagal tulis
+    uint32_t lastSwitchMicros;  // Waktu pindah preset terakhir (apply di sketch)
+} PresetStats;
+
+// Function Prototypes
+// Initialization: baca semua file preset ke RAM
+void presetBegin(uint16_t length, uint16_t schema);
+
+// Storage
+bool presetSave(uint8_t index, const char* name, const void* data);
+bool presetRemove(uint8_t index);
+
+// Lookup (RAM)
+const void* presetGet(uint8_t index);
+const char* presetName(uint8_t index);
+uint8_t presetFind(const char* name);
+uint8_t presetFreeSlot();
+
+// Active Preset
+void presetSetActive(uint8_t index, uint32_t applyMicros);
+uint8_t presetActive();
+void presetClearActive();
+
+// Statistics
+const PresetStats* presetGetStats();
+
+#endif // PRESET_H
@@ -0,0 +1,183 @@
+#include "profiler.h"
+#include <Arduino.h>
+#ifdef SIM_BUILD
+#include <chrono>
+#endif
+
+// Build Information
+#define PROFILER_CPP_VERSION "1.0.0"
+#define PROFILER_CPP_BUILD_DATE "2026-10-17 22:41:30"
+#define PROFILER_CPP_AUTHOR "Brodot23"
+
+static const char* const SECTION_NAMES[PROFILE_COUNT] = {
+    "web", "input", "render_sein", "render_brake", "render_idle",
+    "push", "livestream", "config_save", "loop"
+};
+
+static const uint16_t BUCKET_US[PROFILE_BUCKET_COUNT] = PROFILE_BUCKETS_US;
+
+static ProfileHistogram histograms[PROFILE_COUNT];
+static uint32_t bucketTicks[PROFILE_BUCKET_COUNT];  // BUCKET_US dalam tick, dihitung sekali
+static uint32_t budgetTicks = 0;
+static uint32_t ticksPerMicro = 1;
+static uint32_t minFreeHeap = 0xFFFFFFFF;
+static uint32_t minMaxBlock = 0xFFFFFFFF;
+
+// ===== IMPLEMENTASI FUNGSI INISIALISASI =====
+
+void profilerBegin() {
+#ifdef SIM_BUILD
+    // Jam virtual simulasi tidak maju selama kode berjalan: pakai jam host (ns)
+    ticksPerMicro = 1000;
+#else
+    ticksPerMicro = ESP.getCpuFreqMHz();
+#endif
+    for (uint8_t i = 0; i < PROFILE_BUCKET_COUNT; i++) {
+        bucketTicks[i] = (uint32_t)BUCKET_US[i] * ticksPerMicro;
+    }
+    budgetTicks = (uint32_t)PROFILE_FRAME_BUDGET_US * ticksPerMicro;
+    profilerReset();
+}
+
+void profilerReset() {
+    memset(histograms, 0, sizeof(histograms));
+    minFreeHeap = 0xFFFFFFFF;
+    minMaxBlock = 0xFFFFFFFF;
+}
+
+// ===== IMPLEMENTASI FUNGSI SAMPLING =====
+
+uint32_t profilerNow() {
+#ifdef SIM_BUILD
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+    return ESP.getCycleCount();
+#endif
+}
+
+// Selisih uint32 tetap benar saat counter wrap (26 detik pada 160 MHz)
+void profilerRecord(uint8_t section, uint32_t startTicks) {
+    uint32_t ticks = profilerNow() - startTicks;
+    ProfileHistogram* histogram = &histograms[section];
+    histogram->count++;
+    histogram->sumTicks += ticks;
+    if (ticks > histogram->maxTicks) histogram->maxTicks = ticks;
+    if (ticks > budgetTicks) histogram->overBudget++;
+
+    for (uint8_t i = 0; i < PROFILE_BUCKET_COUNT; i++) {
+        if (ticks <= bucketTicks[i]) {
+            histogram->buckets[i]++;
+            return;
+        }
+    }
+}
+
+void profilerSampleHeap() {
+    uint32_t freeHeap = ESP.getFreeHeap();
+    uint32_t maxBlock = ESP.getMaxFreeBlockSize();
+    if (freeHeap < minFreeHeap) minFreeHeap = freeHeap;
+    if (maxBlock < minMaxBlock) minMaxBlock = maxBlock;
+}
+
+// ===== IMPLEMENTASI FUNGSI EKSPOR =====
+
+const ProfileHistogram* profilerGet(uint8_t section) {
+    return section < PROFILE_COUNT ? &histograms[section] : NULL;
+}
+
+const char* profilerName(uint8_t section) {
+    return section < PROFILE_COUNT ? SECTION_NAMES[section] : "";
+}
+
+uint32_t profilerTicksPerMicro() {
+    return ticksPerMicro;
+}
+
+static void printSeconds(Print& out, uint64_t ticks) {
+    out.print((double)ticks / ticksPerMicro / 1000000.0, 6);
+}
+
+static void printSample(Print& out, const char* metric, const char* section, const char* suffix) {
+    out.print(metric);
+    out.print(suffix);
+    out.print("{section=\"");
+    out.print(section);
+    out.print("\"");
+}
+
+static void printGauge(Print& out, const char* metric, const char* help, uint32_t value) {
+    out.print("# HELP ");
+    out.print(metric);
+    out.print(" ");
+    out.print(help);
+    out.print("\n# TYPE ");
+    out.print(metric);
+    out.print(" gauge\n");
+    out.print(metric);
+    out.print(" ");
+    out.print((unsigned long)value);
+    out.print("\n");
+}
+
+void profilerWriteMetrics(Print& out) {
+    out.print("# HELP stoplamp_section_duration_seconds Waktu per subsystem per panggilan\n"
+              "# TYPE stoplamp_section_duration_seconds histogram\n");
+    for (uint8_t s = 0; s < PROFILE_COUNT; s++) {
+        const ProfileHistogram* histogram = &histograms[s];
+        uint32_t cumulative = 0;
+        for (uint8_t i = 0; i < PROFILE_BUCKET_COUNT; i++) {
+            cumulative += histogram->buckets[i];
+            printSample(out, "stoplamp_section_duration_seconds", SECTION_NAMES[s], "_bucket");
+            out.print(",le=\"");
+            out.print((double)BUCKET_US[i] / 1000000.0, 5);
+            out.print("\"} ");
+            out.print((unsigned long)cumulative);
+            out.print("\n");
+        }
+        printSample(out, "stoplamp_section_duration_seconds", SECTION_NAMES[s], "_bucket");
+        out.print(",le=\"+Inf\"} ");
+        out.print((unsigned long)histogram->count);
+        out.print("\n");
+        printSample(out, "stoplamp_section_duration_seconds", SECTION_NAMES[s], "_sum");
+        out.print("} ");
+        printSeconds(out, histogram->sumTicks);
+        out.print("\n");
+        printSample(out, "stoplamp_section_duration_seconds", SECTION_NAMES[s], "_count");
+        out.print("} ");
+        out.print((unsigned long)histogram->count);
+        out.print("\n");
+    }
+
+    out.print("# HELP stoplamp_section_duration_max_seconds Panggilan terlama sejak reset\n"
+              "# TYPE stoplamp_section_duration_max_seconds gauge\n");
+    for (uint8_t s = 0; s < PROFILE_COUNT; s++) {
+        printSample(out, "stoplamp_section_duration_max_seconds", SECTION_NAMES[s], "");
+        out.print("} ");
+        printSeconds(out, histograms[s].maxTicks);
+        out.print("\n");
+    }
+
+    out.print("# HELP stoplamp_section_over_budget_total Panggilan lebih lama dari frame budget\n"
+              "# TYPE stoplamp_section_over_budget_total counter\n");
+    for (uint8_t s = 0; s < PROFILE_COUNT; s++) {
+        printSample(out, "stoplamp_section_over_budget", SECTION_NAMES[s], "_total");
+        out.print("} ");
+        out.print((unsigned long)histograms[s].overBudget);
+        out.print("\n");
+    }
+
+    out.print("# HELP stoplamp_frame_budget_seconds Batas over_budget\n"
+              "# TYPE stoplamp_frame_budget_seconds gauge\n"
+              "stoplamp_frame_budget_seconds ");
+    out.print((double)PROFILE_FRAME_BUDGET_US / 1000000.0, 6);
+    out.print("\n");
+
+    // Sampel ulang di sini: buffer handler yang sedang aktif ikut dihitung, jadi min <= nilai sekarang
+    profilerSampleHeap();
+    printGauge(out, "stoplamp_heap_free_bytes", "ESP.getFreeHeap()", ESP.getFreeHeap());
+    printGauge(out, "stoplamp_heap_max_block_bytes", "ESP.getMaxFreeBlockSize()", ESP.getMaxFreeBlockSize());
+    printGauge(out, "stoplamp_heap_free_min_bytes", "Heap bebas terendah sejak reset", minFreeHeap);
+    printGauge(out, "stoplamp_heap_max_block_min_bytes", "Blok bebas terbesar, nilai terendah sejak reset", minMaxBlock);
+    printGauge(out, "stoplamp_uptime_seconds", "millis() / 1000", millis() / 1000);
+}
@@ -0,0 +1,63 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "settings.h"
+#include <Print.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Build Information
+#define PROFILER_VERSION "1.0.0"
+#define PROFILER_BUILD_DATE "2026-10-17 22:41:30"
+#define PROFILER_AUTHOR "Brodot23"
+
+// Profiler per subsystem: durasi diukur dengan ESP.getCycleCount() (host: steady clock)
+// dan dimasukkan ke histogram bucket tetap. Overhead per sample: dua baca counter dan
+// paling banyak PROFILE_BUCKET_COUNT perbandingan, tanpa pembagian.
+#define PROFILE_WEB 0               // server.handleClient()
+#define PROFILE_INPUT 1             // serviceInput(): poll, edge ISR, handleInput()
+#define PROFILE_RENDER_SEIN 2       // updateSeinDisplay()
+#define PROFILE_RENDER_BRAKE 3      // updateBrakeDisplay()
+#define PROFILE_RENDER_IDLE 4       // renderIdleFrame(): teks / animasi / efek
+#define PROFILE_PUSH 5              // pushComposite(): komposit + transport ke rantai MAX7219
+#define PROFILE_LIVESTREAM 6        // livestreamService()
+#define PROFILE_CONFIG_SAVE 7       // saveSettingsToEEPROM(): tulis journal flash
+#define PROFILE_LOOP 8              // Satu iterasi loop() penuh
+#define PROFILE_COUNT 9
+
+// Batas atas bucket dalam mikrodetik (le=), bucket terakhir +Inf = count
+#define PROFILE_BUCKET_COUNT 11
+#define PROFILE_BUCKETS_US { 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000 }
+
+// Satu sample lebih lama dari ini menunda edge rem/sein berikutnya lebih dari 10 ms
+#define PROFILE_FRAME_BUDGET_US 10000
+
+// Perintah Serial (satu karakter)
+#define PROFILE_SERIAL_DUMP 'm'     // Cetak /metrics ke Serial
+#define PROFILE_SERIAL_RESET 'r'    // Nolkan histogram
+
+typedef struct {
+    uint32_t count;
+    uint32_t overBudget;                        // Sample > PROFILE_FRAME_BUDGET_US
+    uint32_t maxTicks;
+    uint64_t sumTicks;
+    uint32_t buckets[PROFILE_BUCKET_COUNT];     // Tidak kumulatif, dijumlah saat ekspor
+} ProfileHistogram;
+
+// Function Prototypes
+// Initialization
+void profilerBegin();
+void profilerReset();
+
+// Sampling: uint32_t start = profilerNow(); ...; profilerRecord(PROFILE_X, start);
+uint32_t profilerNow();
+void profilerRecord(uint8_t section, uint32_t startTicks);
+void profilerSampleHeap();                      // Sekali per loop(): titik terendah heap
+
+// Export
+const ProfileHistogram* profilerGet(uint8_t section);
+const char* profilerName(uint8_t section);
+uint32_t profilerTicksPerMicro();
+void profilerWriteMetrics(Print& out);          // Format teks Prometheus 0.0.4
+
+#endif // PROFILER_H
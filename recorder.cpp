@@ -0,0 +1,400 @@
+#include "recorder.h"
+#include <Arduino.h>
+#include <FS.h>
+
+// Build Information
+#define RECORDER_CPP_VERSION "1.0.0"
+#define RECORDER_CPP_BUILD_DATE "2026-10-17 23:41:06"
+#define RECORDER_CPP_AUTHOR "Brodot23"
+
+// Record terbesar: type + dt + 2 varint transport + rowMask + semua baris
+#define RECORDER_MAX_RECORD (1 + 5 + 5 + 5 + FB_MAX_DEVICES + FB_MAX_DEVICES * FB_ROWS)
+#define RECORDER_SEGMENT_COUNT 2
+
+static bool sessionActive = false;
+static RecorderSink sessionSink = NULL;    // NULL = ring SPIFFS
+static RecorderInfo sessionInfo;
+static File segmentFile;
+static uint8_t activeSegment = 0;
+static uint32_t segmentBytes = 0;          // Sudah ditulis ke segmen aktif
+
+static uint8_t buffer[RECORDER_BUFFER_SIZE];
+static uint16_t bufferFilled = 0;
+static uint32_t lastFlushMillis = 0;
+
+// State terakhir yang sudah direkam, record berikutnya hanya berisi selisihnya
+static bool needKeyframe = true;
+static uint32_t lastRecordMillis = 0;
+static uint8_t lastInputs = 0;
+static uint8_t lastFrame[FB_MAX_DEVICES][FB_ROWS];
+static uint16_t lastIntensity[FB_MAX_DEVICES];
+static uint32_t lastTransactions = 0;
+static uint32_t lastBytes = 0;
+
+static RecorderStats recorderStats;
+
+// ===== IMPLEMENTASI FUNGSI ENCODING =====
+
+static uint8_t putVarint(uint8_t* out, uint32_t value) {
+    uint8_t length = 0;
+    while (value >= 0x80) {
+        out[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[length++] = (uint8_t)value;
+    return length;
+}
+
+static bool getVarint(RecorderReader* reader, uint32_t* value) {
+    uint32_t result = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+        if (reader->pos >= reader->length) return false;
+        uint8_t byte = reader->data[reader->pos++];
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void putLe32(uint8_t* out, uint32_t value) {
+    out[0] = value;
+    out[1] = value >> 8;
+    out[2] = value >> 16;
+    out[3] = value >> 24;
+}
+
+// ===== IMPLEMENTASI FUNGSI SEGMEN =====
+
+static void segmentPath(uint8_t segment, char* path) {
+    snprintf(path, RECORDER_PATH_LENGTH, "%s/%u.bin", RECORDER_DIR, (unsigned)segment);
+}
+
+static bool writeOut(const uint8_t* data, size_t length) {
+    if (sessionSink) {
+        return sessionSink(data, length);
+    }
+    if (!segmentFile) {
+        return false;
+    }
+    bool ok = segmentFile.write(data, length) == length;
+    segmentFile.flush();
+    return ok;
+}
+
+static void flushBuffer() {
+    if (bufferFilled == 0) return;
+    uint32_t start = micros();
+    if (writeOut(buffer, bufferFilled)) {
+        segmentBytes += bufferFilled;
+        recorderStats.bytes += bufferFilled;
+    } else {
+        recorderStats.dropped++;
+    }
+    uint32_t elapsed = micros() - start;
+    if (elapsed > recorderStats.maxFlushMicros) recorderStats.maxFlushMicros = elapsed;
+    recorderStats.flushes++;
+    bufferFilled = 0;
+    lastFlushMillis = millis();
+}
+
+static void append(const uint8_t* data, uint16_t length) {
+    if (bufferFilled + length > RECORDER_BUFFER_SIZE) {
+        flushBuffer();
+    }
+    memcpy(buffer + bufferFilled, data, length);
+    bufferFilled += length;
+}
+
+// Header segmen baru; record berikutnya wajib keyframe supaya segmen bisa dibaca sendiri
+static void startSegment() {
+    uint32_t now = millis();
+    uint8_t header[RECORDER_HEADER_SIZE];
+    memset(header, 0, sizeof(header));
+    memcpy(header, RECORDER_MAGIC, 4);
+    header[4] = RECORDER_FORMAT;
+    header[5] = sessionInfo.devices;
+    header[6] = sessionInfo.startupMode;
+    header[7] = sessionInfo.seinMode;
+    header[8] = sessionInfo.brakeMode;
+    putLe32(header + 12, now);
+
+    append(header, sizeof(header));
+    lastRecordMillis = now;
+    needKeyframe = true;
+}
+
+// Ring: segmen aktif penuh -> tutup, segmen lain dikosongkan dan menjadi aktif
+static void rotateSegment() {
+    flushBuffer();
+    segmentFile.close();
+    activeSegment = (activeSegment + 1) % RECORDER_SEGMENT_COUNT;
+    char path[RECORDER_PATH_LENGTH];
+    segmentPath(activeSegment, path);
+    segmentFile = SPIFFS.open(path, "w");
+    segmentBytes = 0;
+    recorderStats.segments++;
+    startSegment();
+}
+
+static void putRecordHead(uint8_t* record, uint8_t* length, uint8_t type, uint32_t now) {
+    record[0] = type;
+    *length = 1 + putVarint(record + 1, now - lastRecordMillis);
+    lastRecordMillis = now;
+    recorderStats.records++;
+}
+
+// ===== IMPLEMENTASI FUNGSI SESSION =====
+
+bool recorderBegin(const RecorderInfo* info, RecorderSink sink) {
+    recorderStop();
+    if (!info || info->devices == 0 || info->devices > FB_MAX_DEVICES) {
+        return false;
+    }
+
+    sessionInfo = *info;
+    sessionSink = sink;
+    bufferFilled = 0;
+    segmentBytes = 0;
+    memset(&recorderStats, 0, sizeof(recorderStats));
+
+    if (!sink) {
+        // Sesi baru membuang rekaman lama, kedua segmen selalu dari sesi yang sama
+        char path[RECORDER_PATH_LENGTH];
+        for (uint8_t segment = 0; segment < RECORDER_SEGMENT_COUNT; segment++) {
+            segmentPath(segment, path);
+            SPIFFS.remove(path);
+        }
+        activeSegment = 0;
+        segmentPath(activeSegment, path);
+        segmentFile = SPIFFS.open(path, "w");
+        if (!segmentFile) {
+            return false;
+        }
+    }
+
+    const FramebufferStats* stats = framebufferGetStats();
+    lastTransactions = stats->transactions;
+    lastBytes = stats->bytes;
+    sessionActive = true;
+    startSegment();
+    return true;
+}
+
+void recorderStop() {
+    if (!sessionActive) return;
+    flushBuffer();
+    if (segmentFile) {
+        segmentFile.close();
+    }
+    sessionActive = false;
+    sessionSink = NULL;
+}
+
+bool recorderActive() {
+    return sessionActive;
+}
+
+// ===== IMPLEMENTASI FUNGSI CAPTURE =====
+
+void recorderCapture(const uint8_t frame[][FB_ROWS], uint8_t inputs) {
+    if (!sessionActive) return;
+
+    if (!sessionSink && segmentBytes + bufferFilled + 3 * RECORDER_MAX_RECORD > RECORDER_SEGMENT_SIZE) {
+        rotateSegment();
+    }
+
+    uint32_t now = millis();
+    uint8_t devices = sessionInfo.devices;
+    bool key = needKeyframe;
+    uint8_t record[RECORDER_MAX_RECORD];
+    uint8_t length;
+
+    if (key || inputs != lastInputs) {
+        putRecordHead(record, &length, REC_INPUT, now);
+        record[length++] = inputs;
+        append(record, length);
+        lastInputs = inputs;
+    }
+
+    uint8_t rowMask[FB_MAX_DEVICES];
+    bool frameChanged = false;
+    for (uint8_t device = 0; device < devices; device++) {
+        rowMask[device] = 0;
+        for (uint8_t row = 0; row < FB_ROWS; row++) {
+            if (key || frame[device][row] != lastFrame[device][row]) {
+                rowMask[device] |= 1 << row;
+            }
+        }
+        frameChanged |= rowMask[device] != 0;
+    }
+    if (frameChanged) {
+        const FramebufferStats* stats = framebufferGetStats();
+        putRecordHead(record, &length, REC_FRAME, now);
+        length += putVarint(record + length, stats->transactions - lastTransactions);
+        length += putVarint(record + length, stats->bytes - lastBytes);
+        memcpy(record + length, rowMask, devices);
+        length += devices;
+        for (uint8_t device = 0; device < devices; device++) {
+            for (uint8_t row = 0; row < FB_ROWS; row++) {
+                if (rowMask[device] & (1 << row)) {
+                    record[length++] = frame[device][row];
+                    lastFrame[device][row] = frame[device][row];
+                }
+            }
+        }
+        append(record, length);
+        lastTransactions = stats->transactions;
+        lastBytes = stats->bytes;
+        recorderStats.frames++;
+    }
+
+    uint8_t deviceMask = 0;
+    uint16_t levels[FB_MAX_DEVICES];
+    for (uint8_t device = 0; device < devices; device++) {
+        levels[device] = framebufferGetIntensity(device);
+        if (key || levels[device] != lastIntensity[device]) {
+            deviceMask |= 1 << device;
+        }
+    }
+    if (deviceMask) {
+        putRecordHead(record, &length, REC_INTENSITY, now);
+        record[length++] = deviceMask;
+        for (uint8_t device = 0; device < devices; device++) {
+            if (deviceMask & (1 << device)) {
+                record[length++] = levels[device];
+                record[length++] = levels[device] >> 8;
+                lastIntensity[device] = levels[device];
+            }
+        }
+        append(record, length);
+    }
+
+    needKeyframe = false;
+}
+
+// Buffer sebagian ditulis berkala supaya rekaman tetap terbaca kalau device mati
+void recorderService() {
+    if (sessionActive && bufferFilled > 0 && millis() - lastFlushMillis >= RECORDER_FLUSH_MS) {
+        flushBuffer();
+    }
+}
+
+void recorderFlush() {
+    if (sessionActive) {
+        flushBuffer();
+    }
+}
+
+// Kedua segmen berasal dari sesi yang sama, jadi urutannya mengikuti startMillis di header
+uint8_t recorderSegmentPaths(char paths[][RECORDER_PATH_LENGTH]) {
+    uint32_t starts[RECORDER_SEGMENT_COUNT];
+    uint8_t count = 0;
+    for (uint8_t segment = 0; segment < RECORDER_SEGMENT_COUNT; segment++) {
+        char path[RECORDER_PATH_LENGTH];
+        segmentPath(segment, path);
+        File file = SPIFFS.open(path, "r");
+        uint8_t header[RECORDER_HEADER_SIZE];
+        if (!file || file.read(header, sizeof(header)) != sizeof(header) ||
+            memcmp(header, RECORDER_MAGIC, 4) != 0) {
+            continue;
+        }
+        uint32_t start = header[12] | (header[13] << 8) | ((uint32_t)header[14] << 16) | ((uint32_t)header[15] << 24);
+        uint8_t index = count;
+        while (index > 0 && (int32_t)(starts[index - 1] - start) > 0) {
+            starts[index] = starts[index - 1];
+            memcpy(paths[index], paths[index - 1], RECORDER_PATH_LENGTH);
+            index--;
+        }
+        starts[index] = start;
+        memcpy(paths[index], path, RECORDER_PATH_LENGTH);
+        count++;
+    }
+    return count;
+}
+
+// ===== IMPLEMENTASI FUNGSI READER =====
+
+void recorderReaderInit(RecorderReader* reader, const uint8_t* data, size_t length) {
+    memset(reader, 0, sizeof(RecorderReader));
+    reader->data = data;
+    reader->length = length;
+}
+
+uint8_t recorderReaderNext(RecorderReader* reader) {
+    if (reader->pos >= reader->length) {
+        return REC_END;
+    }
+
+    const uint8_t* p = reader->data + reader->pos;
+    size_t remaining = reader->length - reader->pos;
+    if (remaining >= 4 && memcmp(p, RECORDER_MAGIC, 4) == 0) {
+        if (remaining < RECORDER_HEADER_SIZE || p[4] != RECORDER_FORMAT ||
+            p[5] == 0 || p[5] > FB_MAX_DEVICES) {
+            return REC_ERROR;
+        }
+        reader->info.devices = p[5];
+        reader->info.startupMode = p[6];
+        reader->info.seinMode = p[7];
+        reader->info.brakeMode = p[8];
+        reader->timeMs = p[12] | (p[13] << 8) | ((uint32_t)p[14] << 16) | ((uint32_t)p[15] << 24);
+        reader->pos += RECORDER_HEADER_SIZE;
+        return REC_HEADER;
+    }
+    if (reader->info.devices == 0) {
+        return REC_ERROR;
+    }
+
+    uint8_t type = reader->data[reader->pos++];
+    uint32_t dt;
+    if (!getVarint(reader, &dt)) return REC_ERROR;
+    reader->timeMs += dt;
+    uint8_t devices = reader->info.devices;
+
+    switch (type) {
+        case REC_INPUT:
+            if (reader->pos + 1 > reader->length) return REC_ERROR;
+            reader->inputs = reader->data[reader->pos++];
+            return type;
+
+        case REC_FRAME: {
+            if (!getVarint(reader, &reader->transactions) || !getVarint(reader, &reader->bytes)) {
+                return REC_ERROR;
+            }
+            if (reader->pos + devices > reader->length) return REC_ERROR;
+            const uint8_t* rowMask = reader->data + reader->pos;
+            reader->pos += devices;
+            for (uint8_t device = 0; device < devices; device++) {
+                for (uint8_t row = 0; row < FB_ROWS; row++) {
+                    if (!(rowMask[device] & (1 << row))) continue;
+                    if (reader->pos >= reader->length) return REC_ERROR;
+                    reader->frame[device][row] = reader->data[reader->pos++];
+                }
+            }
+            return type;
+        }
+
+        case REC_INTENSITY: {
+            if (reader->pos + 1 > reader->length) return REC_ERROR;
+            uint8_t deviceMask = reader->data[reader->pos++];
+            for (uint8_t device = 0; device < devices; device++) {
+                if (!(deviceMask & (1 << device))) continue;
+                if (reader->pos + 2 > reader->length) return REC_ERROR;
+                reader->intensity[device] = reader->data[reader->pos] | (reader->data[reader->pos + 1] << 8);
+                reader->pos += 2;
+            }
+            return type;
+        }
+
+        default:
+            return REC_ERROR;
+    }
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTIK =====
+
+const RecorderStats* recorderGetStats() {
+    return &recorderStats;
+}
@@ -0,0 +1,102 @@
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include "settings.h"
+#include "framebuffer.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// Build Information
+#define RECORDER_VERSION "1.0.0"
+#define RECORDER_BUILD_DATE "2026-10-17 23:41:06"
+#define RECORDER_AUTHOR "Brodot23"
+
+// Perekam biner: perubahan input dan isi framebuffer (frame komposit + intensitas per
+// modul) dengan timestamp, hanya saat berubah. Di device ditulis ke ring dua segmen di
+// SPIFFS, di host ke sink apa saja (file) - format sama, jadi rekaman device bisa
+// di-replay dan di-diff di simulasi (sim/replay.cpp).
+//
+// Format (little endian):
+//   Header 16 byte: "SLRC", format, devices, startupMode, seinMode, brakeMode,
+//                   3 byte reserved, startMillis (u32)
+//   Record: type (u8), dt ms sejak record sebelumnya (varint), payload
+//     REC_INPUT      mask (u8): bit 0..2 sampel mentah, bit 4..6 level stabil (input.h)
+//     REC_FRAME      dTransactions, dBytes (varint, transport sejak frame sebelumnya),
+//                    rowMask per modul (devices byte), lalu baris yang berubah
+//     REC_INTENSITY  deviceMask (u8), lalu u16 per modul yang berubah
+// Setiap segmen dimulai dengan header dan keyframe (semua baris/intensitas + input),
+// segmen yang disambung (download ring) dibaca berurutan.
+#define RECORDER_MAGIC "SLRC"
+#define RECORDER_FORMAT 1
+#define RECORDER_HEADER_SIZE 16
+#define RECORDER_BUFFER_SIZE 256        // Satu halaman SPIFFS per flush
+#define RECORDER_SEGMENT_SIZE 32768     // Ring = 2 segmen
+#define RECORDER_FLUSH_MS 1000          // Buffer sebagian ditulis paling lambat setelah ini
+#define RECORDER_DIR "/rec"
+#define RECORDER_PATH_LENGTH 16
+
+// Record Types
+#define REC_END 0
+#define REC_INPUT 1
+#define REC_FRAME 2
+#define REC_INTENSITY 3
+#define REC_HEADER 4                    // Hanya dari reader: header segmen baru
+#define REC_ERROR 0xFF                  // Hanya dari reader: data rusak / terpotong
+
+// Sink host: NULL saat recorderBegin = ring SPIFFS
+typedef bool (*RecorderSink)(const uint8_t* data, size_t length);
+
+typedef struct {
+    uint8_t devices;
+    uint8_t startupMode;
+    uint8_t seinMode;
+    uint8_t brakeMode;
+} RecorderInfo;
+
+// Recorder Statistics
+typedef struct {
+    uint32_t records;
+    uint32_t frames;
+    uint32_t bytes;             // Termasuk header segmen
+    uint32_t flushes;
+    uint32_t segments;          // Rotasi ring
+    uint32_t dropped;           // Flush yang gagal ditulis
+    uint32_t maxFlushMicros;
+} RecorderStats;
+
+// Reader: state tampilan setelah record terakhir
+typedef struct {
+    const uint8_t* data;
+    size_t length;
+    size_t pos;
+    RecorderInfo info;
+    uint32_t timeMs;
+    uint8_t inputs;
+    uint8_t frame[FB_MAX_DEVICES][FB_ROWS];
+    uint16_t intensity[FB_MAX_DEVICES];
+    uint32_t transactions;      // Transport record REC_FRAME terakhir
+    uint32_t bytes;
+} RecorderReader;
+
+// Function Prototypes
+// Session
+bool recorderBegin(const RecorderInfo* info, RecorderSink sink);
+void recorderStop();
+bool recorderActive();
+
+// Capture, dipanggil sekali per loop() setelah frame di-push
+void recorderCapture(const uint8_t frame[][FB_ROWS], uint8_t inputs);
+void recorderService();
+void recorderFlush();
+
+// Ring SPIFFS: segmen lama lalu segmen aktif, kosong jika tidak ada
+uint8_t recorderSegmentPaths(char paths[][RECORDER_PATH_LENGTH]);
+
+// Reader
+void recorderReaderInit(RecorderReader* reader, const uint8_t* data, size_t length);
+uint8_t recorderReaderNext(RecorderReader* reader);
+
+// Statistics
+const RecorderStats* recorderGetStats();
+
+#endif // RECORDER_H
@@ -0,0 +1,219 @@
+#include "scheduler.h"
+#include "settings.h"
+#include <Arduino.h>
+
+// Build Information
+#define SCHEDULER_CPP_VERSION "1.2.0"
+#define SCHEDULER_CPP_BUILD_DATE "2026-10-18 01:12:40"
+#define SCHEDULER_CPP_AUTHOR "Brodot23"
+
+typedef struct {
+    uint32_t deadline;      // Absolut, dalam millis()
+    uint32_t period;
+    int8_t heapIndex;       // Posisi di heap, -1 = tidak aktif
+} SchedulerTimer;
+
+static SchedulerTimer timers[SCHED_MAX_TIMERS];
+
+// Min-heap ID timer, diurutkan berdasarkan deadline
+static uint8_t heap[SCHED_MAX_TIMERS];
+static uint8_t heapSize = 0;
+
+static bool kicked = false;
+static SchedulerStats schedStats;
+
+// ===== IMPLEMENTASI FUNGSI HEAP =====
+
+// Perbandingan aman terhadap overflow millis() (~49 hari)
+static bool deadlineBefore(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+static bool deadlineReached(uint32_t deadline, uint32_t now) {
+    return (int32_t)(now - deadline) >= 0;
+}
+
+static void heapSwap(uint8_t a, uint8_t b) {
+    uint8_t tmp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = tmp;
+    timers[heap[a]].heapIndex = a;
+    timers[heap[b]].heapIndex = b;
+}
+
+static void heapSiftUp(uint8_t index) {
+    while (index > 0) {
+        uint8_t parent = (index - 1) / 2;
+        if (!deadlineBefore(timers[heap[index]].deadline, timers[heap[parent]].deadline)) break;
+        heapSwap(index, parent);
+        index = parent;
+    }
+}
+
+static void heapSiftDown(uint8_t index) {
+    while (true) {
+        uint8_t left = index * 2 + 1;
+        uint8_t right = left + 1;
+        uint8_t smallest = index;
+        if (left < heapSize && deadlineBefore(timers[heap[left]].deadline, timers[heap[smallest]].deadline)) {
+            smallest = left;
+        }
+        if (right < heapSize && deadlineBefore(timers[heap[right]].deadline, timers[heap[smallest]].deadline)) {
+            smallest = right;
+        }
+        if (smallest == index) break;
+        heapSwap(index, smallest);
+        index = smallest;
+    }
+}
+
+static void heapRemove(uint8_t timer) {
+    int8_t index = timers[timer].heapIndex;
+    if (index < 0) return;
+
+    timers[timer].heapIndex = -1;
+    heapSize--;
+    if (index == heapSize) return;
+
+    uint8_t moved = heap[heapSize];
+    heap[index] = moved;
+    timers[moved].heapIndex = index;
+    heapSiftUp(index);
+    heapSiftDown(timers[moved].heapIndex);
+}
+
+// ===== IMPLEMENTASI FUNGSI INISIALISASI =====
+
+void schedulerInit() {
+    for (uint8_t i = 0; i < SCHED_MAX_TIMERS; i++) {
+        timers[i].heapIndex = -1;
+    }
+    heapSize = 0;
+    kicked = true;  // Frame pertama langsung dirender
+    schedulerResetStats();
+}
+
+// ===== IMPLEMENTASI FUNGSI TIMER =====
+
+void schedulerStart(uint8_t timer, uint32_t periodMs) {
+    schedulerStartAt(timer, periodMs, millis() + (periodMs ? periodMs : 1));
+}
+
+// Deadline pertama absolut, mis. batas periode berikutnya dari origin fase unit lain
+void schedulerStartAt(uint8_t timer, uint32_t periodMs, uint32_t deadline) {
+    if (timer >= SCHED_MAX_TIMERS) return;
+
+    SchedulerTimer* t = &timers[timer];
+    t->period = periodMs ? periodMs : 1;
+    t->deadline = deadline;
+
+    if (t->heapIndex < 0) {
+        t->heapIndex = heapSize;
+        heap[heapSize++] = timer;
+        heapSiftUp(t->heapIndex);
+    } else {
+        heapSiftUp(t->heapIndex);
+        heapSiftDown(t->heapIndex);
+    }
+}
+
+void schedulerStop(uint8_t timer) {
+    if (timer >= SCHED_MAX_TIMERS) return;
+    heapRemove(timer);
+}
+
+void schedulerStopAll() {
+    for (uint8_t i = 0; i < heapSize; i++) {
+        timers[heap[i]].heapIndex = -1;
+    }
+    heapSize = 0;
+}
+
+bool schedulerActive(uint8_t timer) {
+    return timer < SCHED_MAX_TIMERS && timers[timer].heapIndex >= 0;
+}
+
+// Deadline sudah lewat tapi belum dilayani (tanpa dispatch)
+bool schedulerPending(uint8_t timer) {
+    return schedulerActive(timer) && deadlineReached(timers[timer].deadline, millis());
+}
+
+bool schedulerAnyPending(uint16_t timerMask) {
+    for (uint8_t i = 0; i < SCHED_MAX_TIMERS; i++) {
+        if ((timerMask & (1 << i)) && schedulerPending(i)) return true;
+    }
+    return false;
+}
+
+// Pengganti pola "if (millis() - lastX >= period) { ...; lastX = millis(); }".
+// Timer yang belum aktif dipasang dengan deadline satu periode dari sekarang.
+bool schedulerDue(uint8_t timer, uint32_t periodMs) {
+    if (timer >= SCHED_MAX_TIMERS) return false;
+
+    SchedulerTimer* t = &timers[timer];
+    if (t->heapIndex < 0) {
+        schedulerStart(timer, periodMs);
+        return false;
+    }
+
+    uint32_t now = millis();
+    if (!deadlineReached(t->deadline, now)) return false;
+
+    // Periode baru berlaku mulai deadline berikutnya
+    t->period = periodMs ? periodMs : 1;
+
+    // Deadline maju satu periode dari deadline lama (bukan dari now), jadi tidak drift.
+    // Kalau satu periode penuh atau lebih terlewat, frame itu di-skip dan dihitung overrun.
+    uint32_t lateness = now - t->deadline;
+    uint32_t missed = lateness / t->period;
+    t->deadline += (missed + 1) * t->period;
+
+    schedStats.dispatches++;
+    schedStats.overruns += missed;
+    if (lateness > schedStats.maxLateness) schedStats.maxLateness = lateness;
+
+    heapSiftDown(t->heapIndex);
+    return true;
+}
+
+// ===== IMPLEMENTASI FUNGSI FRAME =====
+
+// Minta render pada loop berikutnya (mis. setelah setting berubah lewat web)
+void schedulerKick() {
+    kicked = true;
+}
+
+bool schedulerFrameDue() {
+    return kicked || (heapSize > 0 && deadlineReached(timers[heap[0]].deadline, millis()));
+}
+
+void schedulerFrameDone() {
+    kicked = false;
+    schedStats.frames++;
+
+    // Timer yang masih jatuh tempo setelah render tidak dipakai mode yang aktif
+    uint32_t now = millis();
+    while (heapSize > 0 && deadlineReached(timers[heap[0]].deadline, now)) {
+        heapRemove(heap[0]);
+        schedStats.retired++;
+    }
+}
+
+uint32_t schedulerMillisUntilNext() {
+    if (kicked) return 0;
+    if (heapSize == 0) return UINT32_MAX;
+
+    uint32_t now = millis();
+    uint32_t deadline = timers[heap[0]].deadline;
+    return deadlineReached(deadline, now) ? 0 : deadline - now;
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTIK =====
+
+const SchedulerStats* schedulerGetStats() {
+    return &schedStats;
+}
+
+void schedulerResetStats() {
+    memset(&schedStats, 0, sizeof(schedStats));
+}
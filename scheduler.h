@@ -0,0 +1,48 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "settings.h"
+#include <stdint.h>
+
+// Build Information
+#define SCHEDULER_VERSION "1.2.0"
+#define SCHEDULER_BUILD_DATE "2026-10-18 01:12:40"
+#define SCHEDULER_AUTHOR "Brodot23"
+
+// Scheduler Configuration
+#define SCHED_MAX_TIMERS 8      // Jumlah timer render (ID 0..SCHED_MAX_TIMERS-1)
+
+// Statistik gabungan semua timer
+typedef struct {
+    uint32_t dispatches;        // Deadline yang sudah dilayani
+    uint32_t overruns;          // Periode yang terlewat seluruhnya (frame di-skip)
+    uint32_t maxLateness;       // Keterlambatan terbesar saat dilayani (ms)
+    uint32_t frames;            // Render yang dipicu scheduler
+    uint32_t retired;           // Timer yang jatuh tempo tapi tidak lagi dipakai mode aktif
+} SchedulerStats;
+
+// Function Prototypes
+// Initialization
+void schedulerInit();
+
+// Timer Control
+void schedulerStart(uint8_t timer, uint32_t periodMs);
+void schedulerStartAt(uint8_t timer, uint32_t periodMs, uint32_t deadline);
+void schedulerStop(uint8_t timer);
+void schedulerStopAll();
+bool schedulerDue(uint8_t timer, uint32_t periodMs);
+bool schedulerActive(uint8_t timer);
+bool schedulerPending(uint8_t timer);
+bool schedulerAnyPending(uint16_t timerMask);
+
+// Frame Control
+void schedulerKick();
+bool schedulerFrameDue();
+void schedulerFrameDone();
+uint32_t schedulerMillisUntilNext();
+
+// Statistics
+const SchedulerStats* schedulerGetStats();
+void schedulerResetStats();
+
+#endif // SCHEDULER_H
@@ -8,18 +8,20 @@ let reconnectTimeout;
 // Constants
 const TOAST_DURATION = 3000;
 const RECONNECT_DELAY = 2000;
-const API_ENDPOINTS = {
-    GENERAL: '/api/general-settings',
-    TEXT: '/api/text-settings',
-    IDLE: '/api/idle-settings',
-    SEIN_REM: '/api/sein-rem-settings',
-    BRIGHTNESS: '/api/brightness',
-    WIFI: '/api/wifi-settings'
-};
+
+// Mirror tampilan (livestream.h): frame biner KEY/DELTA, 8 byte per modul
+const MIRROR_MSG_KEY = 0x01;
+const MIRROR_MSG_DELTA = 0x02;
+const MIRROR_ROWS = 8;
+let mirrorFrame = new Uint8Array(0);
+const CONFIG_ENDPOINT = '/api/config';
+const DISPLAY_MODES = ['text', 'animation', 'both'];
+let configEtag = null;
 
 // WebSocket Connection Management
 function initializeWebSocket() {
     ws = new WebSocket(serverUrl);
+    ws.binaryType = 'arraybuffer';
     
     ws.onopen = () => {
         console.log('WebSocket Connected');
@@ -62,8 +64,20 @@ function updateConnectionStatus(isConnected) {
     }
 }
 
+function requestInitialState() {
+    sendWebSocketMessage('getState', {});
+    if (document.getElementById('displayMirror')) {
+        setMirror(true);
+    }
+}
+
 // WebSocket Message Handler
 function handleWebSocketMessage(event) {
+    if (event.data instanceof ArrayBuffer) {
+        applyMirrorMessage(new Uint8Array(event.data));
+        return;
+    }
+    
     try {
         const data = JSON.parse(event.data);
         
@@ -85,6 +99,63 @@ function handleWebSocketMessage(event) {
     }
 }
 
+// Display Mirror
+function setMirror(enabled, fps) {
+    const data = { enabled };
+    if (fps) {
+        data.fps = fps;
+    }
+    sendWebSocketMessage('mirror', data);
+}
+
+function applyMirrorMessage(message) {
+    const devices = message[1];
+    const bytes = devices * MIRROR_ROWS;
+    
+    if (message[0] === MIRROR_MSG_KEY) {
+        mirrorFrame = message.slice(2, 2 + bytes);
+    } else if (message[0] === MIRROR_MSG_DELTA && mirrorFrame.length === bytes) {
+        // Satu byte mask per modul (bit r = baris r), diikuti XOR baris yang berubah
+        let offset = 2 + devices;
+        for (let device = 0; device < devices; device++) {
+            const mask = message[2 + device];
+            for (let row = 0; row < MIRROR_ROWS; row++) {
+                if (mask & (1 << row)) {
+                    mirrorFrame[device * MIRROR_ROWS + row] ^= message[offset++];
+                }
+            }
+        }
+    } else {
+        return;
+    }
+    drawMirror(devices);
+}
+
+function drawMirror(devices) {
+    const canvas = document.getElementById('displayMirror');
+    if (!canvas) {
+        return;
+    }
+    
+    const ctx = canvas.getContext('2d');
+    const scale = Math.floor(canvas.width / (devices * 8)) || 1;
+    ctx.fillStyle = '#111';
+    ctx.fillRect(0, 0, canvas.width, canvas.height);
+    ctx.fillStyle = '#f22';
+    
+    // Modul 0 paling kiri, bit 7 = kolom kiri
+    for (let device = 0; device < devices; device++) {
+        for (let row = 0; row < MIRROR_ROWS; row++) {
+            const bits = mirrorFrame[device * MIRROR_ROWS + row];
+            for (let col = 0; col < 8; col++) {
+                if (bits & (0x80 >> col)) {
+                    ctx.fillRect((device * 8 + col) * scale, row * scale, scale - 1, scale - 1);
+                }
+            }
+        }
+    }
+}
+
 // Settings Management
 function saveGeneralSettings() {
     const displayMode = document.getElementById('displayMode').value;
@@ -95,8 +166,9 @@ function saveGeneralSettings() {
         gapDuration
     };
     
-    sendWebSocketMessage('setGeneralSettings', data);
-    saveToAPI(API_ENDPOINTS.GENERAL, data);
+    saveSettings('setGeneralSettings', data, {
+        settings: { startupMode: DISPLAY_MODES.indexOf(displayMode) }
+    });
 }
 
 function saveTextSettings() {
@@ -110,8 +182,9 @@ function saveTextSettings() {
         speed
     };
     
-    sendWebSocketMessage('setTextSettings', data);
-    saveToAPI(API_ENDPOINTS.TEXT, data);
+    saveSettings('setTextSettings', data, {
+        settings: { customText: text, textSpeed: speed }
+    });
 }
 
 function saveIdleSettings() {
@@ -126,8 +199,9 @@ function saveIdleSettings() {
         duration
     };
     
-    sendWebSocketMessage('setIdleSettings', data);
-    saveToAPI(API_ENDPOINTS.IDLE, data);
+    saveSettings('setIdleSettings', data, {
+        animation: { selectedPatterns: selectedEffects, animationSpeed: duration }
+    });
 }
 
 function saveSeinRemSettings() {
@@ -138,14 +212,17 @@ function saveSeinRemSettings() {
         remSpeed: parseInt(document.getElementById('remSpeed').value)
     };
     
-    sendWebSocketMessage('setSeinRemSettings', data);
-    saveToAPI(API_ENDPOINTS.SEIN_REM, data);
+    saveSettings('setSeinRemSettings', data, {
+        sein: { mode: data.seinMode, speed: data.seinSpeed },
+        brake: { mode: data.remMode, delay: data.remSpeed }
+    });
 }
 
 function saveBrightness() {
     const brightness = parseInt(document.getElementById('brightness').value);
-    sendWebSocketMessage('setBrightness', { brightness });
-    saveToAPI(API_ENDPOINTS.BRIGHTNESS, { brightness });
+    saveSettings('setBrightness', { brightness }, {
+        settings: { brightness }
+    });
 }
 
 function saveWiFi() {
@@ -157,66 +234,99 @@ function saveWiFi() {
         return;
     }
     
-    const data = { ssid, password };
-    sendWebSocketMessage('setWiFi', data);
-    saveToAPI(API_ENDPOINTS.WIFI, data);
+    // Kredensial WiFi tidak ada di /api/config, hanya lewat WebSocket
+    sendWebSocketMessage('setWiFi', { ssid, password });
 }
 
 // API Communication
-async function saveToAPI(endpoint, data) {
+// WebSocket dipakai saat terhubung (respons success/error datang dari perangkat),
+// PATCH /api/config sebagai cadangan
+function saveSettings(command, data, patch) {
+    if (ws && ws.readyState === WebSocket.OPEN) {
+        sendWebSocketMessage(command, data);
+    } else {
+        patchConfig(patch);
+    }
+}
+
+async function patchConfig(patch) {
     try {
-        const response = await fetch(endpoint, {
-            method: 'POST',
+        const response = await fetch(CONFIG_ENDPOINT, {
+            method: 'PATCH',
             headers: {
                 'Content-Type': 'application/json'
             },
-            body: JSON.stringify(data)
+            body: JSON.stringify(patch)
         });
         
         if (!response.ok) {
             throw new Error('Network response was not ok');
         }
         
-        const result = await response.json();
-        showToast(result.message || 'Pengaturan berhasil disimpan!', 'success');
+        // Respons berisi config baru, ETag-nya dipakai untuk refresh berikutnya
+        configEtag = response.headers.get('ETag');
+        updateUIState(configToUIState(await response.json()));
+        showToast('Pengaturan berhasil disimpan!', 'success');
     } catch (error) {
         console.error('Error saving settings:', error);
         showToast('Gagal menyimpan pengaturan!', 'error');
     }
 }
 
+// 304 = config sama dengan yang sudah tampil, form tidak disentuh
 async function loadSavedSettings() {
     try {
-        const responses = await Promise.all([
-            fetch(API_ENDPOINTS.GENERAL),
-            fetch(API_ENDPOINTS.TEXT),
-            fetch(API_ENDPOINTS.IDLE),
-            fetch(API_ENDPOINTS.SEIN_REM),
-            fetch(API_ENDPOINTS.BRIGHTNESS)
-        ]);
+        const headers = configEtag ? { 'If-None-Match': configEtag } : {};
+        const response = await fetch(CONFIG_ENDPOINT, { headers, cache: 'no-store' });
         
-        const [general, text, idle, seinRem, brightness] = await Promise.all(
-            responses.map(response => response.json())
-        );
+        if (response.status === 304) {
+            return;
+        }
+        if (!response.ok) {
+            throw new Error('Network response was not ok');
+        }
         
-        updateUIState({
-            general,
-            text,
-            idle,
-            seinRem,
-            brightness
-        });
+        configEtag = response.headers.get('ETag');
+        updateUIState(configToUIState(await response.json()));
     } catch (error) {
         console.error('Error loading settings:', error);
         showToast('Gagal memuat pengaturan!', 'error');
     }
 }
 
+function configToUIState(config) {
+    return {
+        general: {
+            displayMode: DISPLAY_MODES[config.settings.startupMode] || DISPLAY_MODES[0]
+        },
+        text: {
+            text: config.settings.customText,
+            bold: false,
+            speed: config.settings.textSpeed
+        },
+        idle: {
+            selectedEffects: config.animation.selectedPatterns,
+            duration: config.animation.animationSpeed
+        },
+        seinRem: {
+            seinMode: config.sein.mode,
+            remMode: config.brake.mode,
+            seinSpeed: config.sein.speed,
+            remSpeed: config.brake.delay
+        },
+        brightness: {
+            brightness: config.settings.brightness
+        }
+    };
+}
+
 // UI Update Functions
 function updateUIState(state) {
     if (state.general) {
         document.getElementById('displayMode').value = state.general.displayMode;
-        document.getElementById('gapDuration').value = state.general.gapDuration;
+        if (state.general.gapDuration !== undefined) {
+            document.getElementById('gapDuration').value = state.general.gapDuration;
+        }
     }
     
     if (state.text) {
@@ -293,4 +403,5 @@ window.saveTextSettings = saveTextSettings;
 window.saveIdleSettings = saveIdleSettings;
 window.saveSeinRemSettings = saveSeinRemSettings;
 window.saveBrightness = saveBrightness;
+window.setMirror = setMirror;
 window.saveWiFi = saveWiFi;
\ No newline at end of file
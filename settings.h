@@ -35,7 +35,8 @@
 #define MIN_BRIGHTNESS 0
 #define MAX_SPEED 1000
 #define MIN_SPEED 50
-#define SETTINGS_SIGNATURE 0xBD230205  // BRODOT23 signature
+#define SETTINGS_SCHEMA 4              // Versi layout PersistedConfig, naikkan saat struct berubah
+#define CONFIG_JSON_CAPACITY 2048      // /api/config: 4 section + 60 selectedPatterns
 
 // Timing Constants
 #define DEFAULT_SCROLL_SPEED 100
@@ -44,8 +45,15 @@
 #define DEFAULT_BRAKE_SPEED 150
 #define BLINK_INTERVAL 150
 #define FADE_STEP_TIME 50
+#define TRANSITION_FADE_TIME 450
+#define STARTUP_FADE_STEP 50
+#define STARTUP_HOLD_TIME 1000
+#define RESET_RESTART_DELAY 100
 #define EMERGENCY_FLASH_TIME 75
 #define PROGRESSIVE_STEP_TIME 100
+#define WARNING_BLINK_TIME 200
+#define COMBINED_SWITCH_INTERVAL 5000
+#define AUTO_HAZARD_TIME 5000          // Hazard otomatis bertahan sekian ms setelah rem dilepas
 
 // Display Modes
 #define MODE_TEXT 0
@@ -59,6 +67,7 @@
 #define BRAKE_MODE_EMERGENCY 3
 #define BRAKE_MODE_SMOOTH 4
 #define BRAKE_MODE_STOP_TEXT 5
+#define BRAKE_MODE_COUNT 6
 
 // Sein Modes
 #define SEIN_MODE_BASIC 0
@@ -67,6 +76,7 @@
 #define SEIN_MODE_PULSE 3
 #define SEIN_MODE_DOUBLE 4
 #define SEIN_MODE_RUNNING 5
+#define SEIN_MODE_COUNT 6
 
 // Definisi interval waktu
 #define SEIN_INTERVAL 500
@@ -100,18 +110,35 @@
 #define PRIORITY_BRAKE 1
 #define PRIORITY_SEIN 2
 
-// EEPROM Addresses
-#define SETTINGS_BASE_ADDR 0
-#define ANIMATION_ADDR 32
-#define SEIN_SETTINGS_ADDR 64
-#define BRAKE_SETTINGS_ADDR 96
-#define CUSTOM_TEXT_ADDR 128
+// Idle Compositor Phases (transisi di layer idle, bisa di-preempt rem/sein)
+#define IDLE_RUNNING 0
+#define IDLE_STARTUP 1      // Teks startup fade in lalu ditahan
+#define IDLE_FADE_OUT 2     // MODE_COMBINED: mode lama fade out
+#define IDLE_FADE_IN 3      // MODE_COMBINED: mode baru fade in
+
+// Sync Roles (Settings.syncRole, lihat unitsync.h)
+#define SYNC_ROLE_OFF 0
+#define SYNC_ROLE_HOST 1    // Membuka soft-AP seperti biasa, unit lain join ke sini
+#define SYNC_ROLE_JOIN 2    // Join ke soft-AP unit host (SSID/password sama) sebagai station
+#define SYNC_ROLE_COUNT 3
+
+// Config Sections (payload EVENT_CONFIG_CHANGED)
+#define CONFIG_SECTION_SETTINGS 0
+#define CONFIG_SECTION_ANIMATION 1
+#define CONFIG_SECTION_BRAKE 2
+#define CONFIG_SECTION_SEIN 3
+#define CONFIG_SECTION_ALL 0xFF       // PATCH /api/config, beberapa section sekaligus
+
+// Penyimpanan config: satu record PersistedConfig di journal configstore.h
+// (alamat tetap lama 0/32/64/96 tumpang tindih karena Settings > 200 byte)
 
 // Matrix Constants
 #define MATRIX_COUNT 8
 #define MATRIX_ROWS 8
 #define MATRIX_COLS 32
 #define CHAR_WIDTH 8
+#define FONT_FIRST_CHAR 32
+#define FONT_GLYPH_COUNT 64
 
 // Animation Direction
 #define DIRECTION_LEFT 0
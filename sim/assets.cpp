@@ -0,0 +1,208 @@
+// Build step bundle web: index.html, script.js dan style.css dikompres gzip (level 9) dan
+// diberi nama berisi hash isi ke <out>/w/, plus manifest webassets.h untuk firmware.
+// Referensi "script.js"/"style.css" di HTML ditulis ulang ke URI ber-hash sebelum HTML
+// sendiri di-hash, jadi perubahan asset mana pun mengganti URI yang di-cache browser.
+// Output: satu baris CSV per asset di stdout, ringkasan di stderr.
+#include <zlib.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "webassets.h"
+
+namespace fs = std::filesystem;
+
+typedef struct {
+    const char* source;         // File di direktori sketch
+    const char* uri;            // URI logis
+    const char* type;
+} AssetSource;
+
+// HTML terakhir: referensinya ke asset lain ditulis ulang dulu
+static const AssetSource SOURCES[] = {
+    { "script.js",  "/script.js", "application/javascript" },
+    { "style.css",  "/style.css", "text/css" },
+    { "index.html", "/",          "text/html" },
+};
+
+typedef struct {
+    AssetSource source;
+    std::string path;           // Nama file gzip di SPIFFS
+    uint32_t hash;
+    uint32_t rawSize;
+    uint32_t gzipSize;
+} PackedAsset;
+
+static uint32_t fnv1a(const std::string& data) {
+    uint32_t hash = 2166136261UL;
+    for (unsigned char c : data) {
+        hash = (hash ^ c) * 16777619UL;
+    }
+    return hash;
+}
+
+static bool readFile(const fs::path& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    out = buffer.str();
+    return true;
+}
+
+// Header gzip tanpa nama/mtime: output sama untuk input sama
+static bool gzipCompress(const std::string& input, std::string& output) {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (deflateInit2(&stream, 9, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK) return false;
+
+    output.resize(deflateBound(&stream, input.size()) + 32);
+    stream.next_in = (Bytef*)input.data();
+    stream.avail_in = input.size();
+    stream.next_out = (Bytef*)&output[0];
+    stream.avail_out = output.size();
+    int result = deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+    return result == Z_STREAM_END;
+}
+
+static void replaceAll(std::string& text, const std::string& from, const std::string& to) {
+    for (size_t pos = text.find(from); pos != std::string::npos; pos = text.find(from, pos + to.size())) {
+        text.replace(pos, from.size(), to);
+    }
+}
+
+// "script.js" -> "/w/script.1a2b3c4d.js"
+static std::string hashedName(const char* source, uint32_t hash) {
+    std::string name = source;
+    size_t dot = name.rfind('.');
+    char tag[10];
+    snprintf(tag, sizeof(tag), ".%08x", hash);
+    return std::string(WEBASSETS_DIR) + "/" + name.substr(0, dot) + tag + name.substr(dot);
+}
+
+static void putField(std::string& out, const std::string& value, size_t size) {
+    std::string field = value.substr(0, size - 1);
+    field.resize(size, '\0');
+    out += field;
+}
+
+static void putLe32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out += (char)((value >> (8 * i)) & 0xFF);
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr, "usage: %s [--src DIR] [--out DIR]\n", argv0);
+}
+
+int main(int argc, char** argv) {
+    fs::path src = SIM_SKETCH_DIR;
+    fs::path out = fs::path(SIM_SKETCH_DIR) / "data";
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--src") && i + 1 < argc) {
+            src = argv[++i];
+        } else if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+            out = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    fs::path dir = out / fs::path(WEBASSETS_DIR).relative_path();
+    fs::create_directories(dir);
+
+    std::vector<PackedAsset> packed;
+    std::set<std::string> written;
+    for (const AssetSource& source : SOURCES) {
+        std::string content;
+        if (!readFile(src / source.source, content)) {
+            fprintf(stderr, "skip %s: not found\n", source.source);
+            continue;
+        }
+        if (!strcmp(source.type, "text/html")) {
+            for (const PackedAsset& asset : packed) {
+                std::string hashed = asset.path.substr(0, asset.path.size() - 3);
+                for (const char* quote : { "\"", "'" }) {
+                    replaceAll(content, quote + std::string(asset.source.source) + quote, quote + hashed + quote);
+                    replaceAll(content, quote + std::string(asset.source.uri) + quote, quote + hashed + quote);
+                }
+            }
+        }
+
+        PackedAsset asset;
+        asset.source = source;
+        asset.hash = fnv1a(content);
+        asset.rawSize = content.size();
+        asset.path = hashedName(source.source, asset.hash) + ".gz";
+
+        std::string gz;
+        if (!gzipCompress(content, gz)) {
+            fprintf(stderr, "gzip failed for %s\n", source.source);
+            return 1;
+        }
+        asset.gzipSize = gz.size();
+        if (asset.path.size() >= WEBASSETS_PATH_LENGTH) {
+            fprintf(stderr, "name too long for SPIFFS: %s\n", asset.path.c_str());
+            return 1;
+        }
+
+        std::ofstream file(out / asset.path.substr(1), std::ios::binary);
+        file.write(gz.data(), gz.size());
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", asset.path.c_str());
+            return 1;
+        }
+        written.insert(fs::path(asset.path).filename().string());
+        packed.push_back(asset);
+    }
+    if (packed.empty() || packed.size() > WEBASSETS_MAX) {
+        fprintf(stderr, "nothing to pack\n");
+        return 1;
+    }
+
+    // Manifest (format di webassets.h)
+    std::string manifest(WEBASSETS_MAGIC);
+    manifest += (char)WEBASSETS_FORMAT_VERSION;
+    manifest += (char)packed.size();
+    manifest += std::string(2, '\0');
+    for (const PackedAsset& asset : packed) {
+        putField(manifest, asset.source.uri, WEBASSETS_URI_LENGTH);
+        putField(manifest, asset.path, WEBASSETS_PATH_LENGTH);
+        putField(manifest, asset.source.type, WEBASSETS_TYPE_LENGTH);
+        putLe32(manifest, asset.hash);
+        putLe32(manifest, asset.rawSize);
+        putLe32(manifest, asset.gzipSize);
+    }
+    std::ofstream index(out / fs::path(WEBASSETS_MANIFEST).relative_path(), std::ios::binary);
+    index.write(manifest.data(), manifest.size());
+    written.insert(fs::path(WEBASSETS_MANIFEST).filename().string());
+
+    // Bundle lama dengan hash berbeda tidak ikut di-upload ke SPIFFS
+    uint32_t removed = 0;
+    for (const fs::directory_entry& entry : fs::directory_iterator(dir)) {
+        if (entry.path().extension() == ".gz" && !written.count(entry.path().filename().string())) {
+            fs::remove(entry.path());
+            removed++;
+        }
+    }
+
+    uint32_t rawTotal = 0;
+    uint32_t gzipTotal = 0;
+    printf("asset,raw_bytes,gzip_bytes,ratio,hash,path\n");
+    for (const PackedAsset& asset : packed) {
+        printf("%s,%u,%u,%.3f,%08x,%s\n", asset.source.source, asset.rawSize, asset.gzipSize,
+               (double)asset.gzipSize / asset.rawSize, asset.hash, asset.path.c_str());
+        rawTotal += asset.rawSize;
+        gzipTotal += asset.gzipSize;
+    }
+    fprintf(stderr, "%zu assets, %u -> %u bytes, manifest %zu bytes, %u stale removed, output %s\n",
+            packed.size(), rawTotal, gzipTotal, manifest.size(), removed, out.c_str());
+    return 0;
+}
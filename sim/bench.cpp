@@ -0,0 +1,194 @@
+// Benchmark loop() end-to-end untuk setiap kombinasi startupMode x SEIN_MODE x BRAKE_MODE.
+// Output: satu baris CSV per kombinasi di stdout, ringkasan di stderr.
+#include <Arduino.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "settings.h"
+#include "sim_core.h"
+#include "sim_arduino.h"
+#include "sim_sketch.h"
+
+// Bench Constants
+#define BENCH_DEFAULT_PHASE_MS 1500
+#define BENCH_SETTLE_MS 200
+
+static const char* const STARTUP_MODE_NAMES[] = { "TEXT", "ANIMATION", "COMBINED" };
+static const char* const SEIN_MODE_NAMES[] = { "BASIC", "EDGE", "PROGRESSIVE", "PULSE", "DOUBLE", "RUNNING" };
+static const char* const BRAKE_MODE_NAMES[] = { "FULL", "PROGRESSIVE", "WARNING", "EMERGENCY", "SMOOTH", "STOP_TEXT" };
+
+// Skenario per kombinasi: idle -> rem -> sein kiri (rem tetap) -> hazard
+typedef struct {
+    const char* name;
+    bool brake;
+    bool left;
+    bool right;
+} BenchPhase;
+
+static const BenchPhase PHASES[] = {
+    { "idle",   false, false, false },
+    { "brake",  true,  false, false },
+    { "sein",   true,  true,  false },
+    { "hazard", false, true,  true  },
+};
+
+typedef struct {
+    std::vector<uint32_t> iterationNs;
+    std::vector<uint32_t> renderNs;     // Iterasi yang me-latch frame baru
+    uint64_t maxBlockedMicros;          // Waktu virtual terpanjang di dalam satu loop() (delay)
+    uint32_t bytes;
+    uint32_t transactions;
+    long heapDelta;
+    long heapPeakDelta;
+} BenchResult;
+
+static uint32_t percentile(std::vector<uint32_t>& samples, uint8_t pct) {
+    if (samples.empty()) return 0;
+    size_t index = (samples.size() - 1) * pct / 100;
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+static uint32_t maxOf(const std::vector<uint32_t>& samples) {
+    return samples.empty() ? 0 : *std::max_element(samples.begin(), samples.end());
+}
+
+static void setInputs(bool brake, bool left, bool right) {
+    simSetInput(BRAKE_PIN, brake ? LOW : HIGH);
+    simSetInput(SEIN_LEFT_PIN, left ? LOW : HIGH);
+    simSetInput(SEIN_RIGHT_PIN, right ? LOW : HIGH);
+}
+
+static void runFor(uint32_t ms, uint32_t stepMicros, BenchResult* result) {
+    uint64_t end = simNowMicros() + (uint64_t)ms * 1000;
+    while (simNowMicros() < end) {
+        uint32_t frameBefore = simChainFrameVersion();
+        uint64_t virtualBefore = simNowMicros();
+
+        auto start = std::chrono::steady_clock::now();
+        simSketchLoop();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        if (result) {
+            uint32_t ns = (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+            result->iterationNs.push_back(ns);
+            if (simChainFrameVersion() != frameBefore) result->renderNs.push_back(ns);
+            uint64_t blocked = simNowMicros() - virtualBefore;
+            if (blocked > result->maxBlockedMicros) result->maxBlockedMicros = blocked;
+        }
+        simAdvanceMicros(stepMicros);
+    }
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --phase-ms MS        virtual time per phase (idle, brake, sein, hazard; default %d)\n"
+        "  --step US            virtual time per loop() iteration (default 1000)\n"
+        "  --startup-mode N     only benchmark this startupMode\n"
+        "  --sein-mode N        only benchmark this SEIN_MODE\n"
+        "  --brake-mode N       only benchmark this BRAKE_MODE\n",
+        argv0, BENCH_DEFAULT_PHASE_MS);
+}
+
+int main(int argc, char** argv) {
+    uint32_t phaseMs = BENCH_DEFAULT_PHASE_MS;
+    uint32_t stepMicros = 1000;
+    int onlyStartup = -1;
+    int onlySein = -1;
+    int onlyBrake = -1;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--phase-ms" && hasValue) phaseMs = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--step" && hasValue) stepMicros = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--startup-mode" && hasValue) onlyStartup = atoi(argv[++i]);
+        else if (arg == "--sein-mode" && hasValue) onlySein = atoi(argv[++i]);
+        else if (arg == "--brake-mode" && hasValue) onlyBrake = atoi(argv[++i]);
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (stepMicros == 0) stepMicros = 1;
+
+    simPinsReset();
+    simClockReset();
+    simEepromErase();
+    simSketchSetup();
+
+    printf("startup_mode,sein_mode,brake_mode,iterations,iter_p50_ns,iter_p99_ns,iter_max_ns,"
+           "render_frames,render_p50_ns,render_p99_ns,render_max_ns,blocked_max_us,"
+           "transport_bytes,cs_pulses,bytes_per_frame,heap_delta,heap_peak_delta\n");
+
+    uint32_t combinations = 0;
+    uint32_t worstNs = 0;
+    std::string worstName;
+    auto hostStart = std::chrono::steady_clock::now();
+
+    for (int startup = MODE_TEXT; startup <= MODE_COMBINED; startup++) {
+        if (onlyStartup >= 0 && startup != onlyStartup) continue;
+        for (int sein = SEIN_MODE_BASIC; sein <= SEIN_MODE_RUNNING; sein++) {
+            if (onlySein >= 0 && sein != onlySein) continue;
+            for (int brake = BRAKE_MODE_FULL; brake <= BRAKE_MODE_STOP_TEXT; brake++) {
+                if (onlyBrake >= 0 && brake != onlyBrake) continue;
+
+                // Kembali ke idle dan biarkan state lama selesai sebelum mengukur
+                setInputs(false, false, false);
+                simSketchSetModes(startup, sein, brake);
+                runFor(BENCH_SETTLE_MS, stepMicros, nullptr);
+
+                // Kapasitas sampel dipesan di depan supaya vector tidak ikut terhitung di heap delta
+                BenchResult result = {};
+                size_t maxSamples = (sizeof(PHASES) / sizeof(PHASES[0])) * ((uint64_t)phaseMs * 1000 / stepMicros + 1);
+                result.iterationNs.reserve(maxSamples);
+                result.renderNs.reserve(maxSamples);
+                simChainResetStats();
+                simHeapResetPeak();
+                size_t heapStart = simHeapUsed();
+
+                for (const BenchPhase& phase : PHASES) {
+                    setInputs(phase.brake, phase.left, phase.right);
+                    runFor(phaseMs, stepMicros, &result);
+                }
+
+                const SimChainStats* stats = simChainStats();
+                result.bytes = stats->bytes;
+                result.transactions = stats->transactions;
+                result.heapDelta = (long)simHeapUsed() - (long)heapStart;
+                result.heapPeakDelta = (long)simHeapPeak() - (long)heapStart;
+
+                uint32_t iterations = result.iterationNs.size();
+                uint32_t frames = result.renderNs.size();
+                uint32_t iterMax = maxOf(result.iterationNs);
+                uint32_t renderMax = maxOf(result.renderNs);
+                uint32_t iterP50 = percentile(result.iterationNs, 50);
+                uint32_t iterP99 = percentile(result.iterationNs, 99);
+                uint32_t renderP50 = percentile(result.renderNs, 50);
+                uint32_t renderP99 = percentile(result.renderNs, 99);
+
+                printf("%s,%s,%s,%u,%u,%u,%u,%u,%u,%u,%u,%llu,%u,%u,%u,%ld,%ld\n",
+                       STARTUP_MODE_NAMES[startup], SEIN_MODE_NAMES[sein], BRAKE_MODE_NAMES[brake],
+                       iterations, iterP50, iterP99, iterMax,
+                       frames, renderP50, renderP99, renderMax,
+                       (unsigned long long)result.maxBlockedMicros,
+                       result.bytes, result.transactions, frames ? result.bytes / frames : 0,
+                       result.heapDelta, result.heapPeakDelta);
+
+                if (iterP99 > worstNs) {
+                    worstNs = iterP99;
+                    worstName = std::string(STARTUP_MODE_NAMES[startup]) + "/" +
+                                SEIN_MODE_NAMES[sein] + "/" + BRAKE_MODE_NAMES[brake];
+                }
+                combinations++;
+            }
+        }
+    }
+
+    double hostMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - hostStart).count();
+    fprintf(stderr, "%u combinations in %.0f ms host time, worst iter p99 %u ns (%s)\n",
+            combinations, hostMs, worstNs, worstName.c_str());
+    return 0;
+}
@@ -0,0 +1,152 @@
+// Benchmark kernel efek prosedural (effects.h) dalam frame per detik host.
+// Sebelum timing: effectSin8 dibanding sin(), fraksi effectRandomMask dibanding density,
+// dan tidak ada piksel di luar lebar chain.
+// Output: satu baris CSV per kernel x speed x density di stdout, ringkasan di stderr.
+#include <Arduino.h>
+#include <chrono>
+#include <math.h>
+#include <string.h>
+#include "settings.h"
+#include "framebuffer.h"
+#include "effects.h"
+
+// Bench Constants
+#define EFFECTBENCH_DEFAULT_FRAMES 20000
+#define EFFECTBENCH_MASK_SAMPLES 4000       // Word 64-bit per density saat cek fraksi
+#define EFFECTBENCH_MASK_TOLERANCE 0.01     // Selisih fraksi maksimum
+#define EFFECTBENCH_FRAME_MS EFFECT_FRAME_INTERVAL
+
+static const char* const KERNEL_NAMES[EFFECT_KERNEL_COUNT] = { "WAVE", "SPARKLE", "PULSE", "BLINK" };
+static const uint8_t SPEEDS[] = { 16, 64, 255 };
+static const uint8_t DENSITIES[] = { 16, 64, 128, 240 };
+
+typedef uint8_t Frame[FB_MAX_DEVICES][FB_ROWS];
+
+static uint8_t countBits(uint8_t value) {
+    uint8_t count = 0;
+    for (; value; value &= value - 1) count++;
+    return count;
+}
+
+// ===== IMPLEMENTASI VERIFIKASI =====
+
+static bool verifySine() {
+    for (uint16_t angle = 0; angle < 256; angle++) {
+        double expected = 127.0 * sin(angle * 2.0 * M_PI / 256.0);
+        if (fabs(effectSin8(angle) - expected) > 1.0) {
+            fprintf(stderr, "MISMATCH sin8(%u) = %d, expected %.2f\n", angle, effectSin8(angle), expected);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool verifyMask() {
+    EffectState state;
+    effectBegin(&state, EFFECT_KERNEL_SPARKLE, 0, 0, 1, 1);
+    for (uint16_t density = 0; density < 256; density++) {
+        uint64_t set = 0;
+        for (uint32_t i = 0; i < EFFECTBENCH_MASK_SAMPLES; i++) {
+            set += __builtin_popcountll(effectRandomMask(&state, density));
+        }
+        double fraction = (double)set / (EFFECTBENCH_MASK_SAMPLES * 64.0);
+        if (fabs(fraction - density / 256.0) > EFFECTBENCH_MASK_TOLERANCE) {
+            fprintf(stderr, "MISMATCH randomMask(%u) fraction %.4f\n", density, fraction);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Kolom di luar chain harus tetap nol (bitplaneUnpack membuangnya, plane tidak boleh bocor)
+static bool verifyWidth(uint8_t kernel) {
+    for (uint8_t devices = 1; devices <= FB_MAX_DEVICES; devices++) {
+        EffectState state;
+        effectBegin(&state, kernel, 200, 200, devices, devices);
+        uint64_t outside = devices < FB_MAX_DEVICES ? ~(uint64_t)0 >> (devices * 8) : 0;
+        for (uint32_t i = 0; i < 500; i++) {
+            Frame frame;
+            effectAdvance(&state, EFFECTBENCH_FRAME_MS);
+            effectRender(&state, frame);
+            for (uint8_t r = 0; r < FB_ROWS; r++) {
+                if (state.plane.rows[r] & outside) {
+                    fprintf(stderr, "MISMATCH %s devices=%u draws outside chain\n", KERNEL_NAMES[kernel], devices);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// ===== IMPLEMENTASI TIMING =====
+
+static void usage(const char* argv0) {
+    fprintf(stderr, "usage: %s [--frames N] [--devices N]\n", argv0);
+}
+
+int main(int argc, char** argv) {
+    uint32_t frames = EFFECTBENCH_DEFAULT_FRAMES;
+    uint8_t devices = MATRIX_COUNT;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc) {
+            frames = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--devices") && i + 1 < argc) {
+            devices = constrain(atoi(argv[++i]), 1, FB_MAX_DEVICES);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (frames == 0) frames = 1;
+
+    uint32_t failures = 0;
+    if (!verifySine()) failures++;
+    if (!verifyMask()) failures++;
+    for (uint8_t kernel = 0; kernel < EFFECT_KERNEL_COUNT; kernel++) {
+        if (!verifyWidth(kernel)) failures++;
+    }
+
+    printf("kernel,devices,speed,density,ns_per_frame,fps,lit_pct,mean_level\n");
+    uint8_t sink = 0;
+    for (uint8_t kernel = 0; kernel < EFFECT_KERNEL_COUNT; kernel++) {
+        for (uint8_t speed : SPEEDS) {
+            for (uint8_t density : DENSITIES) {
+                EffectState state;
+                Frame frame;
+                effectBegin(&state, kernel, speed, density, devices, 1);
+                uint64_t lit = 0;
+                uint64_t level = 0;
+
+                // Satu frame = fase maju EFFECT_FRAME_INTERVAL + render + unpack, seperti di playlist
+                auto start = std::chrono::steady_clock::now();
+                for (uint32_t i = 0; i < frames; i++) {
+                    effectAdvance(&state, EFFECTBENCH_FRAME_MS);
+                    effectRender(&state, frame);
+                    sink ^= frame[i % devices][i % FB_ROWS];
+                    level += state.level;
+                }
+                auto elapsed = std::chrono::steady_clock::now() - start;
+                double ns = std::chrono::duration<double, std::nano>(elapsed).count() / frames;
+
+                // Kepadatan piksel diukur terpisah supaya tidak masuk timing
+                effectBegin(&state, kernel, speed, density, devices, 1);
+                for (uint32_t i = 0; i < 1000; i++) {
+                    effectAdvance(&state, EFFECTBENCH_FRAME_MS);
+                    effectRender(&state, frame);
+                    for (uint8_t d = 0; d < devices; d++) {
+                        for (uint8_t r = 0; r < FB_ROWS; r++) lit += countBits(frame[d][r]);
+                    }
+                }
+
+                printf("%s,%u,%u,%u,%.1f,%.0f,%.1f,%.0f\n", KERNEL_NAMES[kernel], devices, speed, density,
+                       ns, 1e9 / ns, 100.0 * lit / (1000.0 * devices * 64), (double)level / frames);
+            }
+        }
+    }
+
+    fprintf(stderr, "%u kernels, %u devices, %u frames, verify %s (sink %02x)\n",
+            EFFECT_KERNEL_COUNT, devices, frames, failures ? "FAILED" : "OK", sink);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,225 @@
+// Benchmark eventqueue.h: throughput dan latency post -> take per lane.
+// Satu thread producer per lane (seperti ISR pin untuk lane CRITICAL/HIGH dan loop() untuk
+// lane NORMAL/LOW) dan satu thread consumer, sesuai kontrak SPSC per lane.
+// Semantik (urutan prioritas, lane penuh, EVENT_TIMEOUT) diperiksa dulu dengan jam virtual.
+// Output: satu baris CSV per skenario x lane di stdout, ringkasan di stderr.
+#include <Arduino.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string.h>
+#include "settings.h"
+#include "eventqueue.h"
+#include "sim_core.h"
+
+// Bench Constants
+#define EVENTS_DEFAULT_COUNT 200000     // Iterasi post+take single-thread
+#define EVENTS_DEFAULT_DURATION_MS 200  // Durasi setiap skenario multi-thread
+#define EVENTS_CRITICAL_PERIOD_NS 20000 // Producer CRITICAL: satu event per 20 us (edge rem)
+
+static const char* const LANE_NAMES[EVENT_LANE_COUNT] = { "low", "normal", "high", "critical" };
+
+typedef struct {
+    const char* name;
+    bool lanes[EVENT_LANE_COUNT];       // Lane yang punya producer
+    bool paced[EVENT_LANE_COUNT];       // Producer dibatasi EVENTS_CRITICAL_PERIOD_NS, sisanya flood
+} Scenario;
+
+static const Scenario SCENARIOS[] = {
+    { "spsc_flood",          { false, false, false, true }, { false, false, false, false } },
+    { "critical_paced",      { false, false, false, true }, { false, false, false, true } },
+    { "critical_vs_flood",   { true,  true,  false, true }, { false, false, false, true } },
+    { "all_lanes_flood",     { true,  true,  true,  true }, { false, false, false, false } },
+};
+
+static inline uint64_t hostNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static uint64_t percentile(std::vector<uint64_t>& samples, uint8_t pct) {
+    if (samples.empty()) return 0;
+    size_t index = (samples.size() - 1) * pct / 100;
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+// ===== IMPLEMENTASI PEMERIKSAAN SEMANTIK =====
+
+static uint32_t failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        fprintf(stderr, "FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void checkSemantics() {
+    simClockReset();
+    eventqueueInit();
+    Event event;
+
+    // Lane lebih tinggi menyalip event yang sudah lebih dulu antre, FIFO di dalam lane
+    for (uint8_t i = 0; i < 3; i++) {
+        check(eventqueuePost(EVENT_CONFIG_CHANGED, PRIORITY_NORMAL, &i, 1), "post normal");
+    }
+    uint8_t channel = 0;
+    check(eventqueuePost(EVENT_INPUT_EDGE, PRIORITY_CRITICAL, &channel, 1), "post critical");
+    check(eventqueueSize() == 4, "size");
+    check(eventqueueTake(&event) && event.priority == PRIORITY_CRITICAL, "critical first");
+    check(!eventqueueTake(&event, PRIORITY_HIGH), "minPriority skips normal lane");
+    for (uint8_t i = 0; i < 3; i++) {
+        check(eventqueueTake(&event) && event.payload[0] == i, "fifo within lane");
+    }
+    check(eventqueueEmpty(), "empty");
+
+    // Payload disalin: buffer pemanggil boleh langsung dipakai ulang
+    uint8_t payload[EVENT_PAYLOAD_SIZE + 4];
+    memset(payload, 0xA5, sizeof(payload));
+    eventqueuePost(EVENT_SYSTEM_ERROR, PRIORITY_LOW, payload, sizeof(payload));
+    memset(payload, 0, sizeof(payload));
+    check(eventqueueTake(&event) && event.size == EVENT_PAYLOAD_SIZE && event.payload[0] == 0xA5, "inline payload");
+
+    // Lane penuh: event terbaru ditolak dan dihitung
+    for (uint8_t i = 0; i < EVENT_LANE_SLOTS; i++) {
+        eventqueuePost(EVENT_CONFIG_CHANGED, PRIORITY_NORMAL, NULL, 0);
+    }
+    check(!eventqueuePost(EVENT_CONFIG_CHANGED, PRIORITY_NORMAL, NULL, 0), "full lane rejects");
+    check(eventqueueGetStats(PRIORITY_NORMAL)->dropped == 1, "dropped counted");
+    eventqueueClear();
+    check(eventqueueEmpty(), "clear");
+
+    // EVENT_TIMEOUT: lane NORMAL kedaluwarsa, lane CRITICAL tidak
+    eventqueuePost(EVENT_CONFIG_CHANGED, PRIORITY_NORMAL, NULL, 0);
+    eventqueuePost(EVENT_INPUT_EDGE, PRIORITY_CRITICAL, &channel, 1);
+    simAdvanceMillis(EVENT_TIMEOUT + 1);
+    check(eventqueueTake(&event) && event.priority == PRIORITY_CRITICAL, "critical never expires");
+    check(!eventqueueTake(&event), "stale normal dropped");
+    check(eventqueueGetStats(PRIORITY_NORMAL)->expired == 1, "expired counted");
+
+    // Counter 16-bit wrap
+    eventqueueInit();
+    for (uint32_t i = 0; i < 70000; i++) {
+        eventqueuePost(EVENT_DISPLAY_UPDATE, PRIORITY_HIGH, NULL, 0);
+        if (!eventqueueTake(&event)) {
+            check(false, "wraparound");
+            break;
+        }
+    }
+}
+
+// ===== IMPLEMENTASI BENCHMARK =====
+
+static void singleThread(uint32_t count) {
+    eventqueueInit();
+    Event event;
+    uint64_t sink = 0;
+    uint64_t start = hostNanos();
+    for (uint32_t i = 0; i < count; i++) {
+        eventqueuePost(EVENT_CONFIG_CHANGED, (EventPriority)(i & 3), &i, sizeof(i));
+        if (eventqueueTake(&event)) sink += event.payload[0];
+    }
+    double ns = (double)(hostNanos() - start) / count;
+    printf("single_thread,all,%u,0,%.3f,%.1f,%.1f,%.1f\n", count, 1000.0 / ns, ns, ns, ns);
+    if (sink == 1) fprintf(stderr, " ");
+}
+
+static void runScenario(const Scenario* scenario, uint32_t durationMs) {
+    eventqueueInit();
+    std::atomic<uint8_t> producersDone(0);
+    uint8_t producers = 0;
+    std::vector<std::thread> threads;
+
+    for (uint8_t lane = 0; lane < EVENT_LANE_COUNT; lane++) {
+        if (!scenario->lanes[lane]) continue;
+        producers++;
+        bool paced = scenario->paced[lane];
+        threads.emplace_back([lane, paced, durationMs, &producersDone]() {
+            uint64_t next = hostNanos();
+            uint64_t end = next + (uint64_t)durationMs * 1000000;
+            while (hostNanos() < end) {
+                if (paced) {
+                    while (hostNanos() < next) std::this_thread::yield();
+                    next += EVENTS_CRITICAL_PERIOD_NS;
+                }
+                uint64_t stamp = hostNanos();
+                // Lane penuh dihitung di stats; beri consumer giliran sebelum mencoba lagi
+                if (!eventqueuePost(EVENT_DISPLAY_UPDATE, (EventPriority)lane, &stamp, sizeof(stamp))) {
+                    std::this_thread::yield();
+                }
+            }
+            producersDone++;
+        });
+    }
+
+    std::vector<uint64_t> latency[EVENT_LANE_COUNT];
+    for (uint8_t lane = 0; lane < EVENT_LANE_COUNT; lane++) {
+        latency[lane].reserve(1 << 20);
+    }
+
+    uint64_t start = hostNanos();
+    Event event;
+    while (true) {
+        if (eventqueueTake(&event)) {
+            uint64_t stamp;
+            memcpy(&stamp, event.payload, sizeof(stamp));
+            latency[event.priority].push_back(hostNanos() - stamp);
+        } else if (producersDone.load() == producers && eventqueueEmpty()) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    uint64_t elapsed = hostNanos() - start;
+    for (std::thread& t : threads) t.join();
+
+    for (uint8_t lane = 0; lane < EVENT_LANE_COUNT; lane++) {
+        if (!scenario->lanes[lane]) continue;
+        const EventLaneStats* stats = eventqueueGetStats((EventPriority)lane);
+        std::vector<uint64_t>& samples = latency[lane];
+        uint64_t maxNs = samples.empty() ? 0 : *std::max_element(samples.begin(), samples.end());
+        printf("%s,%s,%u,%u,%.3f,%llu,%llu,%llu\n", scenario->name, LANE_NAMES[lane],
+               (unsigned)samples.size(), stats->dropped, samples.size() * 1000.0 / elapsed,
+               (unsigned long long)percentile(samples, 50), (unsigned long long)percentile(samples, 99),
+               (unsigned long long)maxNs);
+        check(stats->delivered == samples.size() && stats->posted == samples.size(), "delivered == posted");
+    }
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr, "usage: %s [--count N] [--duration-ms MS]\n", argv0);
+}
+
+int main(int argc, char** argv) {
+    uint32_t count = EVENTS_DEFAULT_COUNT;
+    uint32_t durationMs = EVENTS_DEFAULT_DURATION_MS;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--count") && i + 1 < argc) {
+            count = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--duration-ms") && i + 1 < argc) {
+            durationMs = strtoul(argv[++i], nullptr, 10);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (count == 0) count = 1;
+
+    checkSemantics();
+    if (std::thread::hardware_concurrency() < 2) {
+        fprintf(stderr, "note: 1 CPU, latency multi-thread dibatasi time slice scheduler OS\n");
+    }
+
+    printf("scenario,lane,delivered,dropped,throughput_meps,lat_p50_ns,lat_p99_ns,lat_max_ns\n");
+    singleThread(count);
+    for (const Scenario& scenario : SCENARIOS) {
+        runScenario(&scenario, durationMs);
+    }
+
+    fprintf(stderr, "%u ms per scenario, %u lanes x %u slots, semantics %s\n",
+            durationMs, EVENT_LANE_COUNT, EVENT_LANE_SLOTS, failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
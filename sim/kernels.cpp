@@ -0,0 +1,247 @@
+// Microbenchmark kernel bitplane.h (SWAR, satu word 64-bit per baris) dibanding
+// loop naif byte-per-baris [modul][baris] seperti yang dipakai sketch (reverseByte, per piksel).
+// Setiap kernel diverifikasi dulu terhadap versi naif pada frame acak.
+// Output: satu baris CSV per kernel di stdout, ringkasan di stderr.
+#include <Arduino.h>
+#include <chrono>
+#include <string.h>
+#include "settings.h"
+#include "framebuffer.h"
+#include "bitplane.h"
+
+// Bench Constants
+#define KERNELS_DEFAULT_ITERATIONS 200000
+#define KERNELS_VERIFY_FRAMES 2000
+#define KERNELS_FRAME_POOL 64    // Frame input berputar supaya hasil tidak bisa dilipat compiler
+
+typedef uint8_t Frame[FB_MAX_DEVICES][FB_ROWS];
+
+static uint32_t rngState = 0x2545F491;
+
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static void randomFrame(Frame frame) {
+    for (uint8_t d = 0; d < FB_MAX_DEVICES; d++) {
+        for (uint8_t r = 0; r < FB_ROWS; r++) {
+            frame[d][r] = nextRandom() & 0xFF;
+        }
+    }
+}
+
+// ===== IMPLEMENTASI KERNEL NAIF =====
+
+static inline bool naiveGet(const Frame frame, uint8_t x, uint8_t y) {
+    return frame[x / 8][y] & (0x80 >> (x % 8));
+}
+
+static inline void naiveSet(Frame frame, uint8_t x, uint8_t y, bool state) {
+    if (state) frame[x / 8][y] |= 0x80 >> (x % 8);
+    else frame[x / 8][y] &= ~(0x80 >> (x % 8));
+}
+
+static uint8_t reverseByte(uint8_t b) {
+    b = (b & 0xF0) >> 4 | (b & 0x0F) << 4;
+    b = (b & 0xCC) >> 2 | (b & 0x33) << 2;
+    b = (b & 0xAA) >> 1 | (b & 0x55) << 1;
+    return b;
+}
+
+static void naiveScrollLeft(Frame frame, uint8_t devices, uint8_t positions) {
+    uint8_t width = devices * 8;
+    Frame out = {};
+    for (uint8_t y = 0; y < FB_ROWS; y++) {
+        for (uint8_t x = 0; x < width; x++) {
+            naiveSet(out, x, y, naiveGet(frame, (x + positions) % width, y));
+        }
+    }
+    memcpy(frame, out, (size_t)devices * FB_ROWS);
+}
+
+static void naiveShift(Frame frame, uint8_t devices, int8_t dx, int8_t dy) {
+    int16_t width = devices * 8;
+    Frame out = {};
+    for (int16_t y = 0; y < FB_ROWS; y++) {
+        for (int16_t x = 0; x < width; x++) {
+            int16_t sx = x - dx;
+            int16_t sy = y - dy;
+            if (sx >= 0 && sx < width && sy >= 0 && sy < FB_ROWS) {
+                naiveSet(out, x, y, naiveGet(frame, sx, sy));
+            }
+        }
+    }
+    memcpy(frame, out, (size_t)devices * FB_ROWS);
+}
+
+static void naiveMirror(Frame frame, uint8_t devices, bool horizontal, bool vertical) {
+    Frame out;
+    for (uint8_t d = 0; d < devices; d++) {
+        for (uint8_t r = 0; r < FB_ROWS; r++) {
+            uint8_t sd = horizontal ? devices - 1 - d : d;
+            uint8_t sr = vertical ? FB_ROWS - 1 - r : r;
+            out[d][r] = horizontal ? reverseByte(frame[sd][sr]) : frame[sd][sr];
+        }
+    }
+    memcpy(frame, out, (size_t)devices * FB_ROWS);
+}
+
+static void naiveRotate(Frame frame, uint8_t devices, uint8_t quarterTurns) {
+    Frame out = {};
+    for (uint8_t d = 0; d < devices; d++) {
+        for (uint8_t r = 0; r < FB_ROWS; r++) {
+            for (uint8_t c = 0; c < 8; c++) {
+                uint8_t sr = r, sc = c;
+                switch (quarterTurns & 3) {
+                    case BITPLANE_ROTATE_90:  sr = 7 - c; sc = r;     break;
+                    case BITPLANE_ROTATE_180: sr = 7 - r; sc = 7 - c; break;
+                    case BITPLANE_ROTATE_270: sr = c;     sc = 7 - r; break;
+                }
+                if (frame[d][sr] & (0x80 >> sc)) {
+                    out[d][r] |= 0x80 >> c;
+                }
+            }
+        }
+    }
+    memcpy(frame, out, (size_t)devices * FB_ROWS);
+}
+
+static void naiveInvert(Frame frame, uint8_t devices) {
+    for (uint8_t d = 0; d < devices; d++) {
+        for (uint8_t r = 0; r < FB_ROWS; r++) {
+            frame[d][r] = ~frame[d][r];
+        }
+    }
+}
+
+// ===== DAFTAR KERNEL =====
+
+typedef struct {
+    const char* name;
+    void (*naive)(Frame frame, uint8_t devices);
+    void (*swar)(BitPlane* plane);
+} Kernel;
+
+#define KERNEL(name, naiveCall, swarCall) \
+    { name, [](Frame f, uint8_t n) { naiveCall; }, [](BitPlane* p) { swarCall; } }
+
+static const Kernel KERNELS[] = {
+    KERNEL("scroll_left_1",  naiveScrollLeft(f, n, 1),               bitplaneScrollLeft(p, 1)),
+    KERNEL("scroll_left_13", naiveScrollLeft(f, n, 13),              bitplaneScrollLeft(p, 13)),
+    KERNEL("scroll_right_1", naiveScrollLeft(f, n, n * 8 - 1),       bitplaneScrollRight(p, 1)),
+    KERNEL("shift_3_-2",     naiveShift(f, n, 3, -2),                bitplaneShift(p, 3, -2)),
+    KERNEL("shift_-9_1",     naiveShift(f, n, -9, 1),                bitplaneShift(p, -9, 1)),
+    KERNEL("mirror_h",       naiveMirror(f, n, true, false),         bitplaneMirror(p, true, false)),
+    KERNEL("mirror_v",       naiveMirror(f, n, false, true),         bitplaneMirror(p, false, true)),
+    KERNEL("mirror_hv",      naiveMirror(f, n, true, true),          bitplaneMirror(p, true, true)),
+    KERNEL("rotate_90",      naiveRotate(f, n, BITPLANE_ROTATE_90),  bitplaneRotate(p, BITPLANE_ROTATE_90)),
+    KERNEL("rotate_180",     naiveRotate(f, n, BITPLANE_ROTATE_180), bitplaneRotate(p, BITPLANE_ROTATE_180)),
+    KERNEL("rotate_270",     naiveRotate(f, n, BITPLANE_ROTATE_270), bitplaneRotate(p, BITPLANE_ROTATE_270)),
+    KERNEL("invert",         naiveInvert(f, n),                      bitplaneInvert(p)),
+};
+
+// ===== IMPLEMENTASI VERIFIKASI & TIMING =====
+
+static bool verify(const Kernel* kernel, uint8_t devices) {
+    for (uint32_t i = 0; i < KERNELS_VERIFY_FRAMES; i++) {
+        Frame input, expected, actual = {};
+        randomFrame(input);
+        memcpy(expected, input, sizeof(Frame));
+        kernel->naive(expected, devices);
+
+        BitPlane plane;
+        bitplanePack(&plane, input, devices);
+        kernel->swar(&plane);
+        bitplaneUnpack(&plane, actual);
+        if (memcmp(expected, actual, (size_t)devices * FB_ROWS) != 0) {
+            fprintf(stderr, "MISMATCH %s devices=%u\n", kernel->name, devices);
+            return false;
+        }
+    }
+    return true;
+}
+
+static double nsPerOp(std::chrono::steady_clock::time_point start, uint32_t iterations) {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr, "usage: %s [--iterations N] [--devices N]\n", argv0);
+}
+
+int main(int argc, char** argv) {
+    uint32_t iterations = KERNELS_DEFAULT_ITERATIONS;
+    uint8_t devices = MATRIX_COUNT;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--iterations") && i + 1 < argc) {
+            iterations = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--devices") && i + 1 < argc) {
+            devices = constrain(atoi(argv[++i]), 1, FB_MAX_DEVICES);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (iterations == 0) iterations = 1;
+
+    // Kebenaran dulu, untuk semua panjang chain
+    uint32_t failures = 0;
+    for (const Kernel& kernel : KERNELS) {
+        for (uint8_t n = 1; n <= FB_MAX_DEVICES; n++) {
+            if (!verify(&kernel, n)) failures++;
+        }
+    }
+
+    static Frame pool[KERNELS_FRAME_POOL];
+    static BitPlane planes[KERNELS_FRAME_POOL];
+    for (uint32_t i = 0; i < KERNELS_FRAME_POOL; i++) {
+        randomFrame(pool[i]);
+        bitplanePack(&planes[i], pool[i], devices);
+    }
+
+    printf("kernel,devices,naive_ns,swar_ns,swar_roundtrip_ns,speedup,roundtrip_speedup\n");
+    uint8_t sink = 0;
+    for (const Kernel& kernel : KERNELS) {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            Frame* frame = &pool[i % KERNELS_FRAME_POOL];
+            kernel.naive(*frame, devices);
+            sink ^= (*frame)[0][0];
+        }
+        double naiveNs = nsPerOp(start, iterations);
+
+        // Kernel saja: data tetap dalam bentuk bitplane di antara operasi
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            BitPlane* plane = &planes[i % KERNELS_FRAME_POOL];
+            kernel.swar(plane);
+            sink ^= (uint8_t)plane->rows[0];
+        }
+        double swarNs = nsPerOp(start, iterations);
+
+        // Termasuk konversi dari/ke frame [modul][baris]
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            Frame* frame = &pool[i % KERNELS_FRAME_POOL];
+            BitPlane plane;
+            bitplanePack(&plane, *frame, devices);
+            kernel.swar(&plane);
+            bitplaneUnpack(&plane, *frame);
+            sink ^= (*frame)[0][0];
+        }
+        double roundtripNs = nsPerOp(start, iterations);
+
+        printf("%s,%u,%.1f,%.1f,%.1f,%.1f,%.1f\n", kernel.name, devices, naiveNs, swarNs, roundtripNs,
+               naiveNs / swarNs, naiveNs / roundtripNs);
+    }
+
+    fprintf(stderr, "%u kernels, %u devices, %u iterations, verify %s (sink %02x)\n",
+            (unsigned)(sizeof(KERNELS) / sizeof(KERNELS[0])), devices, iterations,
+            failures ? "FAILED" : "OK", sink);
+    return failures ? 1 : 0;
+}
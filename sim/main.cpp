@@ -0,0 +1,309 @@
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+#include <WebSocketsServer.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "sim_core.h"
+#include "sim_arduino.h"
+#include "sim_sketch.h"
+#include "livestream.h"
+
+extern ESP8266WebServer server;
+
+static FILE* recordFile = nullptr;
+
+static bool writeRecord(const uint8_t* data, size_t length) {
+    return fwrite(data, 1, length, recordFile) == length;
+}
+
+typedef struct {
+    uint32_t timeMs;
+    SimHttpRequest request;
+} TimedRequest;
+
+// Event klien WebSocket: connect, close, atau pesan teks
+typedef struct {
+    uint32_t timeMs;
+    uint8_t client;
+    std::string action;
+} TimedSocketEvent;
+
+// Input Serial Monitor, mis. "m" untuk dump profiler
+typedef struct {
+    uint32_t timeMs;
+    std::string text;
+} TimedSerialInput;
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --duration MS        virtual time to simulate after setup() (default 10000)\n"
+        "  --step US            virtual time per loop() iteration (default 1000)\n"
+        "  --trace FILE         scripted BRAKE/SEIN pin trace\n"
+        "  --startup-mode N     override settings.startupMode\n"
+        "  --sein-mode N        override seinSettings.mode\n"
+        "  --brake-mode N       override brakeSettings.mode\n"
+        "  --ascii              print every changed frame as ASCII\n"
+        "  --ppm DIR            write every changed frame as DIR/frame_NNNNNN.ppm\n"
+        "  --scale N            PPM pixel scale (default 8)\n"
+        "  --http \"MS METHOD URI [Name:value ...] [BODY]\"  inject an HTTP request at MS\n"
+        "                       BODY @FILE uploads FILE as multipart, @FILE#N drops the client after N bytes\n"
+        "  --ws \"MS CLIENT connect|close|TEXT\"  inject a WebSocket client event at MS\n"
+        "  --fs-root DIR        directory backing SPIFFS (default: sketch dir)\n"
+        "  --record FILE        write a recorder.h recording (inputs + frames) to FILE\n"
+        "  --serial             echo Serial output to stderr\n"
+        "  --serial-in \"MS TEXT\" feed TEXT to Serial.read() at MS\n",
+        argv0);
+}
+
+static bool parseRequest(const char* spec, TimedRequest& out) {
+    char method[16];
+    char uri[256];
+    int consumed = 0;
+    unsigned long timeMs;
+    if (sscanf(spec, "%lu %15s %255s %n", &timeMs, method, uri, &consumed) < 3) return false;
+
+    std::string m = method;
+    if (m == "GET") out.request.method = HTTP_GET;
+    else if (m == "POST") out.request.method = HTTP_POST;
+    else if (m == "PUT") out.request.method = HTTP_PUT;
+    else if (m == "PATCH") out.request.method = HTTP_PATCH;
+    else if (m == "DELETE") out.request.method = HTTP_DELETE;
+    else return false;
+
+    out.timeMs = timeMs;
+    out.request.uri = uri;
+
+    // Header "Name:value" (tanpa spasi) sebelum body, mis. If-None-Match:"1a2b3c4d"
+    const char* rest = consumed ? spec + consumed : "";
+    while (isalpha((unsigned char)*rest)) {
+        const char* name = rest;
+        while (isalnum((unsigned char)*rest) || *rest == '-') rest++;
+        if (*rest != ':') {
+            rest = name;
+            break;
+        }
+        const char* value = ++rest;
+        while (*rest && *rest != ' ') rest++;
+        out.request.headers.push_back(std::make_pair(String(std::string(name, value - 1 - name)),
+                                                     String(std::string(value, rest - value))));
+        while (*rest == ' ') rest++;
+    }
+    out.request.body = rest;
+
+    // "@FILE" = upload multipart isi file host, "@FILE#N" = klien putus setelah N byte
+    if (*rest == '@') {
+        std::string path = rest + 1;
+        size_t hash = path.rfind('#');
+        if (hash != std::string::npos) {
+            out.request.abortAfter = strtoul(path.c_str() + hash + 1, nullptr, 10);
+            path.resize(hash);
+        }
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file) return false;
+        std::string data;
+        char buffer[4096];
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) data.append(buffer, n);
+        fclose(file);
+        out.request.body = String(data);
+        out.request.isUpload = true;
+    }
+    return true;
+}
+
+static bool parseSocketEvent(const char* spec, TimedSocketEvent& out) {
+    unsigned long timeMs;
+    unsigned client;
+    int consumed = 0;
+    if (sscanf(spec, "%lu %u %n", &timeMs, &client, &consumed) < 2 || !consumed || !spec[consumed]) return false;
+    out.timeMs = timeMs;
+    out.client = client;
+    out.action = spec + consumed;
+    return true;
+}
+
+static bool parseSerialInput(const char* spec, TimedSerialInput& out) {
+    unsigned long timeMs;
+    int consumed = 0;
+    if (sscanf(spec, "%lu %n", &timeMs, &consumed) < 1 || !consumed || !spec[consumed]) return false;
+    out.timeMs = timeMs;
+    out.text = spec + consumed;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint32_t durationMs = 10000;
+    uint32_t stepMicros = 1000;
+    const char* tracePath = nullptr;
+    const char* ppmDir = nullptr;
+    const char* recordPath = nullptr;
+    int startupMode = -1;
+    int seinMode = -1;
+    int brakeMode = -1;
+    bool ascii = false;
+    uint8_t scale = 8;
+    std::vector<TimedRequest> requests;
+    std::vector<TimedSocketEvent> socketEvents;
+    std::vector<TimedSerialInput> serialInputs;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--duration" && hasValue) durationMs = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--step" && hasValue) stepMicros = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--trace" && hasValue) tracePath = argv[++i];
+        else if (arg == "--startup-mode" && hasValue) startupMode = atoi(argv[++i]);
+        else if (arg == "--sein-mode" && hasValue) seinMode = atoi(argv[++i]);
+        else if (arg == "--brake-mode" && hasValue) brakeMode = atoi(argv[++i]);
+        else if (arg == "--ascii") ascii = true;
+        else if (arg == "--ppm" && hasValue) ppmDir = argv[++i];
+        else if (arg == "--scale" && hasValue) scale = atoi(argv[++i]);
+        else if (arg == "--fs-root" && hasValue) simSetFsRoot(argv[++i]);
+        else if (arg == "--record" && hasValue) recordPath = argv[++i];
+        else if (arg == "--serial") simSerialEnable(stderr);
+        else if (arg == "--http" && hasValue) {
+            TimedRequest request;
+            if (!parseRequest(argv[++i], request)) {
+                fprintf(stderr, "invalid --http spec: %s\n", argv[i]);
+                return 2;
+            }
+            requests.push_back(request);
+        } else if (arg == "--ws" && hasValue) {
+            TimedSocketEvent event;
+            if (!parseSocketEvent(argv[++i], event)) {
+                fprintf(stderr, "invalid --ws spec: %s\n", argv[i]);
+                return 2;
+            }
+            socketEvents.push_back(event);
+        } else if (arg == "--serial-in" && hasValue) {
+            TimedSerialInput input;
+            if (!parseSerialInput(argv[++i], input)) {
+                fprintf(stderr, "invalid --serial-in spec: %s\n", argv[i]);
+                return 2;
+            }
+            serialInputs.push_back(input);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (stepMicros == 0) stepMicros = 1;
+
+    simPinsReset();
+    simClockReset();
+    simEepromErase();
+    if (tracePath && !simTraceLoad(tracePath)) {
+        fprintf(stderr, "cannot load trace %s\n", tracePath);
+        return 2;
+    }
+
+    server.simSetResponseHook([](const SimHttpRequest& request, const SimHttpResponse& response) {
+        std::string headers;
+        bool compressed = false;
+        for (const auto& header : response.headers) {
+            headers += "[" + std::string(header.first.c_str()) + ": " + header.second.c_str() + "] ";
+            compressed |= header.first == "Content-Encoding";
+        }
+        // Body gzip tidak dicetak, hanya ukurannya
+        std::string body = compressed ? "<" + std::to_string(response.body.length()) + " bytes>" : response.body.c_str();
+        fprintf(stderr, "[%8lu ms] HTTP %s -> %d %s%s\n", millis(), request.uri.c_str(),
+                response.code, headers.c_str(), body.c_str());
+    });
+
+    // Teks dicetak utuh, frame biner mirror sebagai jenis + panjang
+    WebSocketsServer* socket = WebSocketsServer::instance();
+    if (socket) {
+        socket->simSetSendHook([](uint8_t num, WStype_t type, const uint8_t* payload, size_t length) {
+            if (type == WStype_TEXT) {
+                fprintf(stderr, "[%8lu ms] WS %u <- %.*s\n", millis(), num, (int)length, (const char*)payload);
+            } else {
+                fprintf(stderr, "[%8lu ms] WS %u <- %s %u bytes\n", millis(), num,
+                        payload[0] == LIVE_MSG_KEY ? "key" : "delta", (unsigned)length);
+            }
+        });
+    }
+
+    auto hostStart = std::chrono::steady_clock::now();
+
+    simSketchSetup();
+    simSketchSetModes(startupMode, seinMode, brakeMode);
+    if (recordPath) {
+        recordFile = fopen(recordPath, "wb");
+        if (!recordFile || !simSketchStartRecorder(writeRecord)) {
+            fprintf(stderr, "cannot record to %s\n", recordPath);
+            return 1;
+        }
+    }
+
+    uint64_t endMicros = simNowMicros() + (uint64_t)durationMs * 1000;
+    uint32_t lastFrame = simChainFrameVersion();
+    uint32_t framesWritten = 0;
+    uint32_t iterations = 0;
+    size_t nextRequest = 0;
+    size_t nextSocketEvent = 0;
+    size_t nextSerialInput = 0;
+
+    while (simNowMicros() < endMicros) {
+        while (nextRequest < requests.size() && requests[nextRequest].timeMs <= millis()) {
+            server.simQueueRequest(requests[nextRequest++].request);
+        }
+        while (socket && nextSocketEvent < socketEvents.size() && socketEvents[nextSocketEvent].timeMs <= millis()) {
+            const TimedSocketEvent& event = socketEvents[nextSocketEvent++];
+            if (event.action == "connect") socket->simConnect(event.client);
+            else if (event.action == "close") socket->simDisconnect(event.client);
+            else socket->simReceiveText(event.client, event.action);
+        }
+
+        while (nextSerialInput < serialInputs.size() && serialInputs[nextSerialInput].timeMs <= millis()) {
+            simSerialInject(serialInputs[nextSerialInput++].text.c_str());
+        }
+
+        simSketchLoop();
+        iterations++;
+
+        if (simChainFrameVersion() != lastFrame) {
+            lastFrame = simChainFrameVersion();
+            if (ascii) {
+                const SimMax7219* first = simChainDevice(0);
+                printf("t=%lu ms priority=%u intensity=%u%s\n", millis(), simSketchPriority(),
+                       first->intensity, first->shutdown ? " (shutdown)" : "");
+                simRenderAscii(stdout);
+                printf("\n");
+            }
+            if (ppmDir) {
+                char path[512];
+                snprintf(path, sizeof(path), "%s/frame_%06u.ppm", ppmDir, framesWritten);
+                if (!simRenderPpm(path, scale)) {
+                    fprintf(stderr, "cannot write %s\n", path);
+                    return 1;
+                }
+            }
+            framesWritten++;
+        }
+
+        simAdvanceMicros(stepMicros);
+    }
+
+    if (recordFile) {
+        recorderStop();
+        fclose(recordFile);
+        const RecorderStats* recorded = recorderGetStats();
+        fprintf(stderr, "recorded %u records, %u frames, %u bytes to %s\n",
+                recorded->records, recorded->frames, recorded->bytes, recordPath);
+    }
+
+    double hostMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - hostStart).count();
+    const SimChainStats* stats = simChainStats();
+    const SimFlashStats* flash = simFlashGetStats();
+    fprintf(stderr,
+        "simulated %lu ms in %.1f ms host time (%.0fx), %u loop() iterations\n"
+        "frames changed %u, CS pulses %u, bytes shifted %u, register writes %u\n"
+        "flash writes %u (%u bytes), sector erases %u\n",
+        millis(), hostMs, hostMs > 0 ? millis() / hostMs : 0.0, iterations,
+        framesWritten, stats->transactions, stats->bytes, stats->registerWrites,
+        flash->writes, flash->bytesWritten, flash->erases);
+
+    return 0;
+}
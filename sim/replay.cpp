@@ -0,0 +1,385 @@
+// Replay dan golden-frame regression untuk rekaman recorder.h.
+//   --golden DIR [--update]  jalankan traces/golden.trace untuk setiap SEIN_MODE dan BRAKE_MODE,
+//                            bandingkan dengan DIR/<mode>.rec (--update menulis ulang golden)
+//   --diff A B               bandingkan dua rekaman frame demi frame
+//   --replay FILE            input mentah dari rekaman (mis. dari device) diumpankan ke sketch
+//                            simulasi dengan mode dari header, hasilnya di-diff dengan FILE
+// Setiap run sketch berjalan di proses anak (fork) supaya state global selalu dari nol.
+#include <Arduino.h>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "settings.h"
+#include "recorder.h"
+#include "sim_core.h"
+#include "sim_arduino.h"
+#include "sim_sketch.h"
+
+// Replay Constants
+#define REPLAY_DEFAULT_TRACE "traces/golden.trace"
+#define REPLAY_DEFAULT_DURATION_MS 7500
+#define REPLAY_FS_ROOT "build/replay_fs"
+#define REPLAY_REPORT_LIMIT 5           // Selisih yang dicetak per pasangan rekaman
+
+static const char* const SEIN_MODE_NAMES[] = { "BASIC", "EDGE", "PROGRESSIVE", "PULSE", "DOUBLE", "RUNNING" };
+static const char* const BRAKE_MODE_NAMES[] = { "FULL", "PROGRESSIVE", "WARNING", "EMERGENCY", "SMOOTH", "STOP_TEXT" };
+static const uint8_t INPUT_PINS[] = { BRAKE_PIN, SEIN_LEFT_PIN, SEIN_RIGHT_PIN };
+
+// Isi tampilan setelah satu capture (frame + intensitas dari record dengan timestamp sama)
+typedef struct {
+    uint32_t timeMs;                    // Relatif terhadap header pertama
+    uint8_t frame[FB_MAX_DEVICES][FB_ROWS];
+    uint16_t intensity[FB_MAX_DEVICES];
+} ReplayState;
+
+typedef struct {
+    RecorderInfo info;
+    std::vector<ReplayState> states;
+    std::vector<SimTraceEvent> inputs;  // Perubahan sampel mentah, relatif terhadap header pertama
+    uint32_t frames;
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t durationMs;
+} Recording;
+
+static FILE* recordOut = nullptr;
+
+static bool writeRecord(const uint8_t* data, size_t length) {
+    return fwrite(data, 1, length, recordOut) == length;
+}
+
+static bool loadFile(const char* path, std::vector<uint8_t>& data) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    uint8_t block[4096];
+    size_t n;
+    data.clear();
+    while ((n = fread(block, 1, sizeof(block), file)) > 0) {
+        data.insert(data.end(), block, block + n);
+    }
+    fclose(file);
+    return true;
+}
+
+static bool parseRecording(const std::vector<uint8_t>& data, Recording& out) {
+    RecorderReader reader;
+    recorderReaderInit(&reader, data.data(), data.size());
+    out = Recording();
+
+    bool started = false;
+    uint32_t baseMs = 0;
+    uint8_t lastInputs = 0;
+    uint8_t type;
+    while ((type = recorderReaderNext(&reader)) != REC_END) {
+        if (type == REC_ERROR) return false;
+        if (type == REC_HEADER) {
+            if (!started) {
+                out.info = reader.info;
+                baseMs = reader.timeMs;
+                started = true;
+            }
+            continue;
+        }
+
+        uint32_t timeMs = reader.timeMs - baseMs;
+        out.durationMs = timeMs;
+        if (type == REC_INPUT) {
+            for (uint8_t channel = 0; channel < sizeof(INPUT_PINS); channel++) {
+                uint8_t bit = 1 << channel;
+                if (out.inputs.empty() || ((reader.inputs ^ lastInputs) & bit)) {
+                    // Input aktif LOW: bit mentah 1 = ditekan = level 0
+                    out.inputs.push_back({ timeMs, INPUT_PINS[channel], (uint8_t)((reader.inputs & bit) ? LOW : HIGH) });
+                }
+            }
+            lastInputs = reader.inputs;
+            continue;
+        }
+
+        if (type == REC_FRAME) {
+            out.frames++;
+            out.transactions += reader.transactions;
+            out.bytes += reader.bytes;
+        }
+        if (out.states.empty() || out.states.back().timeMs != timeMs) {
+            out.states.push_back(ReplayState());
+        }
+        ReplayState& state = out.states.back();
+        state.timeMs = timeMs;
+        memcpy(state.frame, reader.frame, sizeof(state.frame));
+        memcpy(state.intensity, reader.intensity, sizeof(state.intensity));
+    }
+    return started;
+}
+
+// ===== Run sketch =====
+
+// Proses anak: setup, mode, rekam selama durationMs, tulis ke outPath
+static bool runSketch(int seinMode, int brakeMode, int startupMode, const char* tracePath,
+                      const std::vector<SimTraceEvent>* inputs, uint32_t durationMs, const char* outPath) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) return false;
+    if (pid == 0) {
+        mkdir(REPLAY_FS_ROOT, 0755);
+        simSetFsRoot(REPLAY_FS_ROOT);
+        simPinsReset();
+        simClockReset();
+        simEepromErase();
+        if (tracePath && !simTraceLoad(tracePath)) {
+            fprintf(stderr, "cannot load trace %s\n", tracePath);
+            _exit(2);
+        }
+        simSketchSetup();
+        simSketchSetModes(startupMode, seinMode, brakeMode);
+
+        // Input rekaman relatif terhadap awal rekaman, yang di sini = sekarang
+        uint32_t startMs = millis();
+        if (inputs) {
+            for (const SimTraceEvent& event : *inputs) {
+                if (event.timeMs == 0) simSetInput(event.pin, event.level);
+                else simTraceAdd(startMs + event.timeMs, event.pin, event.level);
+            }
+        }
+
+        recordOut = fopen(outPath, "wb");
+        if (!recordOut || !simSketchStartRecorder(writeRecord)) {
+            fprintf(stderr, "cannot record to %s\n", outPath);
+            _exit(2);
+        }
+        uint64_t end = simNowMicros() + (uint64_t)durationMs * 1000;
+        while (simNowMicros() < end) {
+            simSketchLoop();
+            simAdvanceMicros(1000);
+        }
+        recorderStop();
+        fclose(recordOut);
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// ===== Diff =====
+
+typedef struct {
+    uint32_t compared;
+    uint32_t contentDiffs;      // Isi frame/intensitas berbeda
+    uint32_t timingDiffs;       // Isi sama, timestamp berbeda
+} DiffResult;
+
+static void printStateDiff(const char* label, const ReplayState& a, const ReplayState& b, uint8_t devices, size_t index) {
+    printf("  %s state %zu: t=%u ms vs t=%u ms", label, index, a.timeMs, b.timeMs);
+    for (uint8_t device = 0; device < devices; device++) {
+        uint8_t rows = 0;
+        for (uint8_t row = 0; row < FB_ROWS; row++) {
+            if (a.frame[device][row] != b.frame[device][row]) rows |= 1 << row;
+        }
+        if (rows) printf(" dev%u rows=0x%02x", device, rows);
+        if (a.intensity[device] != b.intensity[device]) {
+            printf(" dev%u intensity %u->%u", device, a.intensity[device], b.intensity[device]);
+        }
+    }
+    printf("\n");
+}
+
+static DiffResult diffRecordings(const Recording& a, const Recording& b, bool verbose) {
+    DiffResult result = {};
+    uint8_t devices = a.info.devices < b.info.devices ? a.info.devices : b.info.devices;
+    size_t count = a.states.size() < b.states.size() ? a.states.size() : b.states.size();
+    uint32_t reported = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const ReplayState& sa = a.states[i];
+        const ReplayState& sb = b.states[i];
+        bool sameContent = memcmp(sa.frame, sb.frame, sizeof(sa.frame)) == 0 &&
+                           memcmp(sa.intensity, sb.intensity, sizeof(sa.intensity)) == 0;
+        result.compared++;
+        if (!sameContent) {
+            result.contentDiffs++;
+            if (verbose && reported++ < REPLAY_REPORT_LIMIT) printStateDiff("content", sa, sb, devices, i);
+        } else if (sa.timeMs != sb.timeMs) {
+            result.timingDiffs++;
+            if (verbose && reported++ < REPLAY_REPORT_LIMIT) printStateDiff("timing", sa, sb, devices, i);
+        }
+    }
+    return result;
+}
+
+static bool identical(const Recording& a, const Recording& b, const DiffResult& diff) {
+    return diff.contentDiffs == 0 && diff.timingDiffs == 0 && a.states.size() == b.states.size() &&
+           a.info.devices == b.info.devices;
+}
+
+static void printSummary(const char* label, const Recording& r) {
+    printf("%-8s states %5zu  frames %5u  duration %6u ms  transport %7u bytes %6u CS pulses  %.1f bytes/frame\n",
+           label, r.states.size(), r.frames, r.durationMs, r.bytes, r.transactions,
+           r.frames ? (double)r.bytes / r.frames : 0.0);
+}
+
+// Ringkasan sebelum/sesudah + selisih frame; exit code 0 hanya jika identik
+static int reportDiff(const char* labelA, const Recording& a, const char* labelB, const Recording& b) {
+    DiffResult diff = diffRecordings(a, b, true);
+    printSummary(labelA, a);
+    printSummary(labelB, b);
+    printf("compared %u states: %u content diffs, %u timing diffs, state count %zu vs %zu\n",
+           diff.compared, diff.contentDiffs, diff.timingDiffs, a.states.size(), b.states.size());
+    return identical(a, b, diff) ? 0 : 1;
+}
+
+static bool loadRecording(const char* path, Recording& out) {
+    std::vector<uint8_t> data;
+    if (!loadFile(path, data)) {
+        fprintf(stderr, "cannot read %s\n", path);
+        return false;
+    }
+    if (!parseRecording(data, out)) {
+        fprintf(stderr, "%s is not a valid recording\n", path);
+        return false;
+    }
+    return true;
+}
+
+// ===== Golden =====
+
+static int runGolden(const char* dir, bool update, const char* tracePath, uint32_t durationMs) {
+    mkdir("build", 0755);
+    if (update) mkdir(dir, 0755);
+
+    printf("case,states,frames,transport_bytes,cs_pulses,golden_states,content_diffs,timing_diffs,result\n");
+    uint32_t failures = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        int count = pass == 0 ? SEIN_MODE_COUNT : BRAKE_MODE_COUNT;
+        for (int mode = 0; mode < count; mode++) {
+            // Mode sein dengan rem FULL, mode rem dengan sein BASIC
+            int sein = pass == 0 ? mode : SEIN_MODE_BASIC;
+            int brake = pass == 0 ? BRAKE_MODE_FULL : mode;
+            std::string name = pass == 0 ? std::string("sein_") + SEIN_MODE_NAMES[mode]
+                                         : std::string("brake_") + BRAKE_MODE_NAMES[mode];
+            std::string outPath = "build/" + name + ".rec";
+            std::string goldenPath = std::string(dir) + "/" + name + ".rec";
+
+            Recording actual;
+            if (!runSketch(sein, brake, -1, tracePath, nullptr, durationMs, outPath.c_str()) ||
+                !loadRecording(outPath.c_str(), actual)) {
+                printf("%s,,,,,,,,error\n", name.c_str());
+                failures++;
+                continue;
+            }
+
+            if (update) {
+                std::vector<uint8_t> data;
+                loadFile(outPath.c_str(), data);
+                FILE* file = fopen(goldenPath.c_str(), "wb");
+                bool ok = file && fwrite(data.data(), 1, data.size(), file) == data.size();
+                if (file) fclose(file);
+                printf("%s,%zu,%u,%u,%u,,,,%s\n", name.c_str(), actual.states.size(), actual.frames,
+                       actual.bytes, actual.transactions, ok ? "updated" : "error");
+                failures += !ok;
+                continue;
+            }
+
+            Recording golden;
+            if (!loadRecording(goldenPath.c_str(), golden)) {
+                printf("%s,%zu,%u,%u,%u,,,,missing\n", name.c_str(), actual.states.size(), actual.frames,
+                       actual.bytes, actual.transactions);
+                failures++;
+                continue;
+            }
+            DiffResult diff = diffRecordings(golden, actual, false);
+            bool matched = identical(golden, actual, diff);
+            printf("%s,%zu,%u,%u,%u,%zu,%u,%u,%s\n", name.c_str(), actual.states.size(), actual.frames,
+                   actual.bytes, actual.transactions, golden.states.size(),
+                   diff.contentDiffs, diff.timingDiffs, matched ? "ok" : "FAIL");
+            if (!matched) {
+                fflush(stdout);
+                fprintf(stderr, "%s differs from %s:\n", name.c_str(), goldenPath.c_str());
+                fflush(stderr);
+                reportDiff("golden", golden, "actual", actual);
+                failures++;
+            }
+        }
+    }
+
+    fflush(stdout);
+    fprintf(stderr, "%u golden case(s) %s\n", failures, update ? "failed to update" : "failed");
+    return failures ? 1 : 0;
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+        "Usage: %s --golden DIR [--update] [--trace FILE] [--duration MS]\n"
+        "       %s --diff A.rec B.rec\n"
+        "       %s --replay FILE [--out FILE]\n"
+        "  --golden DIR     run every SEIN_MODE and BRAKE_MODE against DIR/<mode>.rec\n"
+        "  --update         rewrite the golden recordings instead of comparing\n"
+        "  --trace FILE     input trace for --golden (default %s)\n"
+        "  --duration MS    virtual time per case (default %d)\n"
+        "  --diff A B       compare two recordings frame by frame (A = before, B = after)\n"
+        "  --replay FILE    feed FILE's raw inputs to the simulated sketch and diff the frames\n"
+        "  --out FILE       where --replay writes the simulated recording (default build/replay.rec)\n",
+        argv0, argv0, argv0, REPLAY_DEFAULT_TRACE, REPLAY_DEFAULT_DURATION_MS);
+}
+
+int main(int argc, char** argv) {
+    const char* goldenDir = nullptr;
+    const char* tracePath = REPLAY_DEFAULT_TRACE;
+    const char* diffA = nullptr;
+    const char* diffB = nullptr;
+    const char* replayPath = nullptr;
+    const char* outPath = "build/replay.rec";
+    uint32_t durationMs = REPLAY_DEFAULT_DURATION_MS;
+    bool update = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--golden" && hasValue) goldenDir = argv[++i];
+        else if (arg == "--update") update = true;
+        else if (arg == "--trace" && hasValue) tracePath = argv[++i];
+        else if (arg == "--duration" && hasValue) durationMs = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--diff" && i + 2 < argc) {
+            diffA = argv[++i];
+            diffB = argv[++i];
+        }
+        else if (arg == "--replay" && hasValue) replayPath = argv[++i];
+        else if (arg == "--out" && hasValue) outPath = argv[++i];
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (goldenDir) {
+        return runGolden(goldenDir, update, tracePath, durationMs);
+    }
+
+    if (diffA) {
+        Recording a;
+        Recording b;
+        if (!loadRecording(diffA, a) || !loadRecording(diffB, b)) return 2;
+        return reportDiff("before", a, "after", b);
+    }
+
+    if (replayPath) {
+        Recording original;
+        if (!loadRecording(replayPath, original)) return 2;
+        printf("replaying %zu input changes, sein mode %u, brake mode %u, startup mode %u\n",
+               original.inputs.size(), original.info.seinMode, original.info.brakeMode, original.info.startupMode);
+
+        Recording replayed;
+        if (!runSketch(original.info.seinMode, original.info.brakeMode, original.info.startupMode, nullptr,
+                       &original.inputs, original.durationMs + 1, outPath) ||
+            !loadRecording(outPath, replayed)) {
+            fprintf(stderr, "replay failed\n");
+            return 2;
+        }
+        return reportDiff("recorded", original, "replayed", replayed);
+    }
+
+    usage(argv[0]);
+    return 2;
+}
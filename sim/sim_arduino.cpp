@@ -0,0 +1,682 @@
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <FS.h>
+#include <ESP8266WiFi.h>
+#include <ESP8266WebServer.h>
+#include <WiFiUdp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <malloc.h>
+#include <map>
+#include <new>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "sim_core.h"
+#include "sim_arduino.h"
+
+// Partisi SPIFFS layout 4M1M
+#define SIM_SPIFFS_SIZE (1000 * 1024)
+
+// ===== State =====
+
+HardwareSerial Serial;
+EspClass ESP;
+EEPROMClass EEPROM;
+FS SPIFFS;
+ESP8266WiFiClass WiFi;
+
+static FILE* serialOut = nullptr;
+static std::string serialIn;             // byte yang menunggu Serial.read()
+// SPIFFS berlapis: baca dari fsWriteRoot lalu fsRoot, tulis hanya ke fsWriteRoot.
+// Default direktori sketch read-only (asset web) dan tulisan sim masuk ke sim/build.
+static std::string fsRoot = SIM_SKETCH_DIR;
+static std::string fsWriteRoot = SIM_FS_WRITE_DIR;
+static uint32_t randomState = 2463534242u;
+static bool restartRequested = false;
+static uint32_t chipId = 0x00B0D023;
+static bool udpEnabled = false;
+static uint8_t udpLossPercent = 0;
+static uint32_t udpLossState = 0x9E3779B9u;
+
+// Flash virtual: hanya sektor yang pernah disentuh, sektor baru berisi 0xFF
+static std::map<uint32_t, std::vector<uint8_t>> flashSectors;
+static SimFlashStats flashStats;
+
+// Alamat host, jadi nomor sektor hasil (&_EEPROM_start - 0x40200000) sembarang tapi tetap
+extern "C" uint32_t _EEPROM_start;
+uint32_t _EEPROM_start;
+
+// Heap virtual: kapasitas kira-kira heap bebas ESP8266 setelah WiFi aktif
+static size_t heapUsed = 0;
+static size_t heapPeak = 0;
+
+// ===== IMPLEMENTASI HOOK SIMULASI =====
+
+void simSerialEnable(FILE* out) {
+    serialOut = out;
+}
+
+void simSerialInject(const char* text) {
+    serialIn += text;
+}
+
+void simSetFsRoot(const char* path) {
+    fsRoot = path;
+    fsWriteRoot = path;
+}
+
+const char* simGetFsRoot() {
+    return fsRoot.c_str();
+}
+
+size_t simHeapUsed() {
+    return heapUsed;
+}
+
+size_t simHeapPeak() {
+    return heapPeak;
+}
+
+void simHeapResetPeak() {
+    heapPeak = heapUsed;
+}
+
+bool simRestartRequested() {
+    return restartRequested;
+}
+
+void simEepromErase() {
+    EEPROM.simErase();
+    flashSectors.clear();
+    memset(&flashStats, 0, sizeof(flashStats));
+}
+
+void simSetChipId(uint32_t id) {
+    chipId = id;
+}
+
+void simUdpEnable(uint8_t lossPercent) {
+    udpEnabled = true;
+    udpLossPercent = lossPercent;
+    udpLossState ^= chipId;
+}
+
+const SimFlashStats* simFlashGetStats() {
+    return &flashStats;
+}
+
+// ===== IMPLEMENTASI HEAP TRACKING =====
+
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void* operator new(size_t size) {
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    heapUsed += malloc_usable_size(p);
+    if (heapUsed > heapPeak) heapPeak = heapUsed;
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    heapUsed -= malloc_usable_size(p);
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    operator delete(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    operator delete(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    operator delete(p);
+}
+
+// ===== IMPLEMENTASI WAKTU & GPIO =====
+
+unsigned long millis() {
+    return (unsigned long)(simNowMicros() / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)simNowMicros();
+}
+
+void delay(unsigned long ms) {
+    simAdvanceMillis(ms);
+}
+
+void delayMicroseconds(unsigned int us) {
+    simAdvanceMicros(us);
+}
+
+void yield() {
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    simPinMode(pin, mode);
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    simPinWrite(pin, value);
+}
+
+int digitalRead(uint8_t pin) {
+    return simGetPinLevel(pin);
+}
+
+void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t value) {
+    if (bitOrder == LSBFIRST) {
+        uint8_t reversed = 0;
+        for (int i = 0; i < 8; i++) {
+            if (value & (1 << i)) reversed |= 0x80 >> i;
+        }
+        value = reversed;
+    }
+    simChainShift(dataPin, clockPin, value);
+}
+
+void attachInterrupt(uint8_t interrupt, std::function<void(void)> callback, int mode) {
+    simAttachInterrupt(interrupt, callback, mode);
+}
+
+void detachInterrupt(uint8_t interrupt) {
+    simDetachInterrupt(interrupt);
+}
+
+void noInterrupts() {
+}
+
+// Timer1: periode = ticks / (80 MHz / divider), dimulai saat timer1_write
+static timercallback timer1Callback = nullptr;
+static uint8_t timer1Divider = TIM_DIV1;
+static bool timer1Reload = false;
+static bool timer1Enabled = false;
+
+void timer1_attachInterrupt(timercallback userFunc) {
+    timer1Callback = userFunc;
+}
+
+void timer1_detachInterrupt() {
+    timer1Callback = nullptr;
+    simTimerStop();
+}
+
+void timer1_enable(uint8_t divider, uint8_t intType, uint8_t reload) {
+    (void)intType;
+    timer1Divider = divider;
+    timer1Reload = reload == TIM_LOOP;
+    timer1Enabled = true;
+}
+
+void timer1_disable() {
+    timer1Enabled = false;
+    simTimerStop();
+}
+
+void timer1_write(uint32_t ticks) {
+    if (!timer1Enabled || !timer1Callback) return;
+    static const uint16_t DIVIDERS[4] = { 1, 16, 16, 256 };
+    uint64_t periodMicros = (uint64_t)ticks * DIVIDERS[timer1Divider & 3] / 80;
+    simTimerStart(timer1Callback, periodMicros ? periodMicros : 1, timer1Reload);
+}
+
+void interrupts() {
+}
+
+long random(long max) {
+    return max > 0 ? random(0, max) : 0;
+}
+
+long random(long min, long max) {
+    if (max <= min) return min;
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return min + (long)(randomState % (uint32_t)(max - min));
+}
+
+void randomSeed(unsigned long seed) {
+    randomState = seed ? seed : 2463534242u;
+}
+
+#if !defined(__GLIBC__) || !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t length = strlen(src);
+    if (size > 0) {
+        size_t n = length < size - 1 ? length : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return length;
+}
+#endif
+
+// ===== IMPLEMENTASI SERIAL & ESP =====
+
+int HardwareSerial::available() {
+    return (int)serialIn.size();
+}
+
+int HardwareSerial::read() {
+    if (serialIn.empty()) return -1;
+    uint8_t c = (uint8_t)serialIn[0];
+    serialIn.erase(0, 1);
+    return c;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (serialOut) fputc(c, serialOut);
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    if (serialOut) fwrite(buffer, 1, size, serialOut);
+    return size;
+}
+
+uint32_t EspClass::getFreeHeap() {
+    return heapUsed < SIM_HEAP_SIZE ? SIM_HEAP_SIZE - heapUsed : 0;
+}
+
+uint32_t EspClass::getMaxFreeBlockSize() {
+    return getFreeHeap();
+}
+
+uint32_t EspClass::getCycleCount() {
+    // 80 MHz: 80 siklus per mikrodetik virtual
+    return (uint32_t)(simNowMicros() * 80);
+}
+
+uint32_t EspClass::getChipId() {
+    return chipId;
+}
+
+void EspClass::restart() {
+    restartRequested = true;
+}
+
+static std::vector<uint8_t>& flashSector(uint32_t sector) {
+    std::vector<uint8_t>& data = flashSectors[sector];
+    if (data.empty()) data.assign(SPI_FLASH_SEC_SIZE, 0xFF);
+    return data;
+}
+
+bool EspClass::flashEraseSector(uint32_t sector) {
+    flashSector(sector).assign(SPI_FLASH_SEC_SIZE, 0xFF);
+    flashStats.erases++;
+    return true;
+}
+
+// Seperti spi_flash_write: alamat dan panjang rata 4 byte, tidak melewati batas sektor
+bool EspClass::flashWrite(uint32_t address, const uint32_t* data, size_t size) {
+    if ((address | size) & 3) return false;
+    uint32_t offset = address % SPI_FLASH_SEC_SIZE;
+    if (offset + size > SPI_FLASH_SEC_SIZE) return false;
+
+    std::vector<uint8_t>& sector = flashSector(address / SPI_FLASH_SEC_SIZE);
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++) {
+        sector[offset + i] &= bytes[i];
+    }
+    flashStats.writes++;
+    flashStats.bytesWritten += size;
+    return true;
+}
+
+bool EspClass::flashRead(uint32_t address, uint32_t* data, size_t size) {
+    if ((address | size) & 3) return false;
+    uint32_t offset = address % SPI_FLASH_SEC_SIZE;
+    if (offset + size > SPI_FLASH_SEC_SIZE) return false;
+
+    std::vector<uint8_t>& sector = flashSector(address / SPI_FLASH_SEC_SIZE);
+    memcpy(data, sector.data() + offset, size);
+    return true;
+}
+
+// ===== IMPLEMENTASI EEPROM =====
+
+void EEPROMClass::begin(size_t requested) {
+    static bool flashInitialized = false;
+    if (!flashInitialized) {
+        memset(flash, 0xFF, sizeof(flash));
+        flashInitialized = true;
+    }
+    size = requested < SIM_EEPROM_MAX_SIZE ? requested : SIM_EEPROM_MAX_SIZE;
+    memcpy(data, flash, size);
+    dirty = false;
+}
+
+bool EEPROMClass::commit() {
+    if (!size) return false;
+    if (!dirty) return true;
+    memcpy(flash, data, size);
+    dirty = false;
+    commitCount++;
+    return true;
+}
+
+bool EEPROMClass::end() {
+    bool ok = commit();
+    size = 0;
+    return ok;
+}
+
+void EEPROMClass::simErase() {
+    memset(flash, 0xFF, sizeof(flash));
+    memset(data, 0xFF, sizeof(data));
+    dirty = false;
+    commitCount = 0;
+}
+
+// ===== IMPLEMENTASI SPIFFS =====
+
+static std::string hostPath(const std::string& root, const char* path) {
+    std::string p = path ? path : "";
+    if (p.empty() || p[0] != '/') p = "/" + p;
+    return root + p;
+}
+
+static bool hostFileExists(const std::string& host) {
+    struct stat st;
+    return stat(host.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+// File di lapisan tulis menutupi file sketch dengan nama sama
+static std::string readPath(const char* path) {
+    std::string written = hostPath(fsWriteRoot, path);
+    return hostFileExists(written) ? written : hostPath(fsRoot, path);
+}
+
+static std::string writePath(const char* path) {
+    return hostPath(fsWriteRoot, path);
+}
+
+bool FS::begin() {
+    struct stat st;
+    return stat(fsRoot.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+bool FS::format() {
+    return false;
+}
+
+bool FS::exists(const char* path) {
+    return hostFileExists(readPath(path));
+}
+
+File FS::open(const char* path, const char* mode) {
+    std::string m = mode ? mode : "r";
+    if (m.find('b') == std::string::npos) m += "b";
+    // SPIFFS tidak punya direktori: "/preset/0.cfg" selalu bisa dibuat,
+    // termasuk lapisan tulis yang belum ada (build/spiffs setelah make clean)
+    bool writing = m[0] != 'r' || m.find('+') != std::string::npos;
+    std::string host = writing ? writePath(path) : readPath(path);
+    if (writing) {
+        for (size_t slash = host.find('/', 1); slash != std::string::npos; slash = host.find('/', slash + 1)) {
+            mkdir(host.substr(0, slash).c_str(), 0755);
+        }
+    }
+    FILE* handle = fopen(host.c_str(), m.c_str());
+    return handle ? File(handle, path) : File();
+}
+
+// Hanya lapisan tulis yang diubah, file sketch tetap utuh
+bool FS::remove(const char* path) {
+    return ::remove(writePath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char* from, const char* to) {
+    return ::rename(writePath(from).c_str(), writePath(to).c_str()) == 0;
+}
+
+bool FS::info(FSInfo& info) {
+    info.totalBytes = SIM_SPIFFS_SIZE;
+    info.usedBytes = 0;
+    info.blockSize = 8192;
+    info.pageSize = 256;
+    info.maxOpenFiles = 5;
+    info.maxPathLength = 32;
+    return true;
+}
+
+// ===== IMPLEMENTASI UDP =====
+
+uint8_t WiFiUDP::begin(uint16_t port) {
+    stop();
+    localPort = port;
+    opened = true;
+    if (!udpEnabled) return 1;
+
+    socketFd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (socketFd < 0) return 0;
+    int one = 1;
+    setsockopt(socketFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    setsockopt(socketFd, SOL_SOCKET, SO_BROADCAST, &one, sizeof(one));
+    fcntl(socketFd, F_SETFL, O_NONBLOCK);
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(socketFd, (sockaddr*)&address, sizeof(address)) < 0) {
+        close(socketFd);
+        socketFd = -1;
+        opened = false;
+        return 0;
+    }
+    return 1;
+}
+
+void WiFiUDP::stop() {
+    if (socketFd >= 0) close(socketFd);
+    socketFd = -1;
+    opened = false;
+    rxBuffer.clear();
+    rxPos = 0;
+}
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port) {
+    (void)ip;   // Semua tujuan = broadcast loopback
+    txBuffer.clear();
+    sendPort = port;
+    return opened ? 1 : 0;
+}
+
+int WiFiUDP::endPacket() {
+    if (!opened) return 0;
+    if (socketFd < 0) return 1;
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(sendPort);
+    address.sin_addr.s_addr = htonl(0x7FFFFFFF);   // 127.255.255.255
+    ssize_t sent = sendto(socketFd, txBuffer.data(), txBuffer.size(), 0, (sockaddr*)&address, sizeof(address));
+    return sent == (ssize_t)txBuffer.size() ? 1 : 0;
+}
+
+size_t WiFiUDP::write(uint8_t c) {
+    txBuffer.push_back((char)c);
+    return 1;
+}
+
+size_t WiFiUDP::write(const uint8_t* buffer, size_t size) {
+    txBuffer.append((const char*)buffer, size);
+    return size;
+}
+
+int WiFiUDP::parsePacket() {
+    rxBuffer.clear();
+    rxPos = 0;
+    if (socketFd < 0) return 0;
+
+    char buffer[1500];
+    while (true) {
+        sockaddr_in address = {};
+        socklen_t addressLength = sizeof(address);
+        ssize_t length = recvfrom(socketFd, buffer, sizeof(buffer), 0, (sockaddr*)&address, &addressLength);
+        if (length <= 0) return 0;
+
+        // xorshift: pola loss sama untuk ID unit yang sama
+        udpLossState ^= udpLossState << 13;
+        udpLossState ^= udpLossState >> 17;
+        udpLossState ^= udpLossState << 5;
+        if (udpLossPercent && udpLossState % 100 < udpLossPercent) continue;
+
+        uint32_t ip = ntohl(address.sin_addr.s_addr);
+        remote = IPAddress(ip >> 24, ip >> 16, ip >> 8, ip);
+        remotePortNumber = ntohs(address.sin_port);
+        rxBuffer.assign(buffer, length);
+        return (int)length;
+    }
+}
+
+int WiFiUDP::available() {
+    return (int)(rxBuffer.size() - rxPos);
+}
+
+int WiFiUDP::read() {
+    if (rxPos >= rxBuffer.size()) return -1;
+    return (uint8_t)rxBuffer[rxPos++];
+}
+
+int WiFiUDP::read(uint8_t* buffer, size_t length) {
+    size_t n = std::min(length, rxBuffer.size() - rxPos);
+    memcpy(buffer, rxBuffer.data() + rxPos, n);
+    rxPos += n;
+    return (int)n;
+}
+
+// ===== IMPLEMENTASI WEB SERVER =====
+
+static bool uriMatches(const String& route, const String& uri) {
+    return route == uri;
+}
+
+void ESP8266WebServer::handleClient() {
+    if (!running || pending.empty()) return;
+
+    current = pending.front();
+    pending.pop_front();
+    response = SimHttpResponse();
+    contentLength = CONTENT_LENGTH_NOT_SET;
+    responded = false;
+
+    // Query string "?a=1&b=2" menjadi args, tanpa URL decoding
+    int query = current.uri.indexOf('?');
+    if (query >= 0) {
+        String args = current.uri.substring(query + 1);
+        current.uri = current.uri.substring(0, query);
+        while (args.length() > 0) {
+            int amp = args.indexOf('&');
+            String pair = amp >= 0 ? args.substring(0, amp) : args;
+            args = amp >= 0 ? args.substring(amp + 1) : String();
+            int eq = pair.indexOf('=');
+            current.args.push_back(std::make_pair(eq >= 0 ? pair.substring(0, eq) : pair,
+                                                  eq >= 0 ? pair.substring(eq + 1) : String()));
+        }
+    }
+
+    bool handled = false;
+    for (const Route& route : routes) {
+        if ((route.method == HTTP_ANY || route.method == current.method) && uriMatches(route.uri, current.uri)) {
+            if (current.isUpload && route.uploadHandler) {
+                // Body multipart: START, WRITE per HTTP_UPLOAD_BUFLEN, END (atau ABORTED lalu koneksi ditutup)
+                const char* data = current.body.c_str();
+                size_t length = current.body.length();
+                size_t limit = current.abortAfter ? min(current.abortAfter, length) : length;
+                currentUpload.status = UPLOAD_FILE_START;
+                currentUpload.filename = "upload.anim";
+                currentUpload.name = "file";
+                currentUpload.type = "application/octet-stream";
+                currentUpload.totalSize = 0;
+                currentUpload.currentSize = 0;
+                currentUpload.contentLength = length;
+                route.uploadHandler();
+                for (size_t offset = 0; offset < limit; offset += HTTP_UPLOAD_BUFLEN) {
+                    currentUpload.status = UPLOAD_FILE_WRITE;
+                    currentUpload.currentSize = min((size_t)HTTP_UPLOAD_BUFLEN, limit - offset);
+                    memcpy(currentUpload.buf, data + offset, currentUpload.currentSize);
+                    currentUpload.totalSize += currentUpload.currentSize;
+                    route.uploadHandler();
+                }
+                if (current.abortAfter) {
+                    currentUpload.status = UPLOAD_FILE_ABORTED;
+                    route.uploadHandler();
+                    handled = true;
+                    break;
+                }
+                currentUpload.status = UPLOAD_FILE_END;
+                currentUpload.currentSize = 0;
+                route.uploadHandler();
+            }
+            route.handler();
+            handled = true;
+            break;
+        }
+    }
+    if (!handled) {
+        if (notFoundHandler) {
+            notFoundHandler();
+        } else {
+            send(404, "text/plain", "Not found");
+        }
+    }
+
+    if (responseHook) responseHook(current, response);
+}
+
+String ESP8266WebServer::arg(const String& name) const {
+    if (name == "plain") return current.body;
+    for (const auto& a : current.args) {
+        if (a.first == name) return a.second;
+    }
+    return String();
+}
+
+bool ESP8266WebServer::hasArg(const String& name) const {
+    if (name == "plain") return current.body.length() > 0;
+    for (const auto& a : current.args) {
+        if (a.first == name) return true;
+    }
+    return false;
+}
+
+String ESP8266WebServer::header(const String& name) const {
+    for (const auto& h : current.headers) {
+        if (h.first == name) return h.second;
+    }
+    return String();
+}
+
+bool ESP8266WebServer::hasHeader(const String& name) const {
+    for (const auto& h : current.headers) {
+        if (h.first == name) return true;
+    }
+    return false;
+}
+
+void ESP8266WebServer::send(int code, const char* contentType, const String& content) {
+    response.code = code;
+    response.contentType = contentType ? contentType : "";
+    response.body += content;
+    responded = true;
+}
+
+void ESP8266WebServer::sendHeader(const String& name, const String& value, bool first) {
+    if (first) {
+        response.headers.insert(response.headers.begin(), std::make_pair(name, value));
+    } else {
+        response.headers.push_back(std::make_pair(name, value));
+    }
+}
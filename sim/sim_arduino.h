@@ -0,0 +1,36 @@
+#ifndef SIM_ARDUINO_HOOKS_H
+#define SIM_ARDUINO_HOOKS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Perkiraan heap bebas ESP8266 setelah WiFi soft-AP aktif
+#define SIM_HEAP_SIZE (48 * 1024)
+
+// Hook untuk stand-in Arduino core (Serial, SPIFFS, heap, ESP)
+void simSerialEnable(FILE* out);
+void simSerialInject(const char* text);
+void simSetFsRoot(const char* path);
+const char* simGetFsRoot();
+size_t simHeapUsed();
+size_t simHeapPeak();
+void simHeapResetPeak();
+bool simRestartRequested();
+void simEepromErase();
+void simSetChipId(uint32_t id);         // Beberapa unit sim: ID unik per proses
+
+// UDP (WiFiUdp.h): mati secara default; aktif = broadcast loopback antar proses sim.
+// lossPercent membuang paket masuk secara acak (broadcast WiFi tanpa ACK).
+void simUdpEnable(uint8_t lossPercent);
+
+// Flash virtual (ESP.flashWrite/flashEraseSector): counter untuk uji wear
+typedef struct {
+    uint32_t erases;
+    uint32_t writes;
+    uint32_t bytesWritten;
+} SimFlashStats;
+
+const SimFlashStats* simFlashGetStats();
+
+#endif // SIM_ARDUINO_HOOKS_H
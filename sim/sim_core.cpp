@@ -0,0 +1,385 @@
+#include "sim_core.h"
+#include "../settings.h"
+#include <Arduino.h>
+#include <algorithm>
+#include <vector>
+
+// ===== Virtual clock =====
+
+static uint64_t nowMicros = 0;
+
+// ===== Pin model =====
+
+typedef struct {
+    uint8_t mode;
+    uint8_t outputLevel;    // Level yang ditulis sketch (OUTPUT)
+    uint8_t drive;          // Level dari luar: 0 = tidak di-drive, 1 = LOW, 2 = HIGH
+    int interruptMode;      // 0 = tidak ada interrupt
+} SimPin;
+
+static SimPin pins[SIM_MAX_PINS];
+static std::function<void(void)> pinInterrupts[SIM_MAX_PINS];
+
+// ===== Hardware timer =====
+
+static std::function<void(void)> timerCallback;
+static uint64_t timerNextMicros = 0;
+static uint32_t timerPeriodMicros = 0;     // 0 = berhenti
+static bool timerReload = false;
+
+// ===== Trace =====
+
+static std::vector<SimTraceEvent> traceEvents;
+static size_t traceCursor = 0;
+
+// ===== Chain (default mengikuti pin di settings.h) =====
+
+static uint8_t chainDin = DIN_PIN;
+static uint8_t chainClk = CLK_PIN;
+static uint8_t chainCs = CS_PIN;
+static uint8_t chainDevices = MATRIX_COUNT;
+static uint8_t shiftRegister[SIM_MAX_DEVICES * 2];
+static SimMax7219 devices[SIM_MAX_DEVICES];
+static SimChainStats chainStats;
+static uint32_t frameVersion = 0;
+static std::function<void(void)> latchHook;
+
+static void simChainLatch();
+
+// ===== IMPLEMENTASI VIRTUAL CLOCK =====
+
+void simClockReset(uint64_t startMicros) {
+    nowMicros = startMicros;
+    traceCursor = 0;
+}
+
+uint64_t simNowMicros() {
+    return nowMicros;
+}
+
+void simAdvanceMicros(uint64_t micros) {
+    uint64_t target = nowMicros + micros;
+
+    // Event trace dan tick timer dijalankan tepat pada waktunya, termasuk di tengah delay().
+    // Pada waktu yang sama event trace lebih dulu: pin sudah berubah saat timer menyampel.
+    for (;;) {
+        bool traceDue = traceCursor < traceEvents.size() &&
+                        (uint64_t)traceEvents[traceCursor].timeMs * 1000 <= target;
+        bool timerDue = timerPeriodMicros && timerNextMicros <= target;
+        if (!traceDue && !timerDue) break;
+
+        uint64_t traceMicros = traceDue ? (uint64_t)traceEvents[traceCursor].timeMs * 1000 : UINT64_MAX;
+        if (traceDue && traceMicros <= (timerDue ? timerNextMicros : UINT64_MAX)) {
+            const SimTraceEvent& event = traceEvents[traceCursor++];
+            if (traceMicros > nowMicros) {
+                nowMicros = traceMicros;
+            }
+            simSetInput(event.pin, event.level);
+        } else {
+            nowMicros = std::max(nowMicros, timerNextMicros);
+            timerNextMicros += timerPeriodMicros;
+            if (!timerReload) timerPeriodMicros = 0;
+            if (timerCallback) timerCallback();
+        }
+    }
+
+    nowMicros = target;
+}
+
+void simAdvanceMillis(uint32_t ms) {
+    simAdvanceMicros((uint64_t)ms * 1000);
+}
+
+// ===== IMPLEMENTASI PIN MODEL =====
+
+void simPinsReset() {
+    // Mode pin tetap (LedControl global sudah memanggil pinMode sebelum main)
+    for (int i = 0; i < SIM_MAX_PINS; i++) {
+        pins[i].drive = 0;
+        pins[i].interruptMode = 0;
+        pinInterrupts[i] = nullptr;
+    }
+}
+
+static uint8_t pinLevel(uint8_t pin) {
+    const SimPin& p = pins[pin];
+    if (p.mode == OUTPUT) return p.outputLevel;
+    if (p.drive) return p.drive == 2 ? HIGH : LOW;
+    return (p.mode == INPUT_PULLUP) ? HIGH : LOW;
+}
+
+static void setPinDrive(uint8_t pin, uint8_t drive) {
+    if (pin >= SIM_MAX_PINS) return;
+    uint8_t before = pinLevel(pin);
+    pins[pin].drive = drive;
+    uint8_t after = pinLevel(pin);
+
+    if (before == after || !pinInterrupts[pin]) return;
+
+    int mode = pins[pin].interruptMode;
+    if (mode == CHANGE ||
+        (mode == RISING && after == HIGH) ||
+        (mode == FALLING && after == LOW)) {
+        pinInterrupts[pin]();
+    }
+}
+
+void simSetInput(uint8_t pin, uint8_t level) {
+    setPinDrive(pin, level ? 2 : 1);
+}
+
+void simReleaseInput(uint8_t pin) {
+    setPinDrive(pin, 0);
+}
+
+uint8_t simGetPinLevel(uint8_t pin) {
+    return pin < SIM_MAX_PINS ? pinLevel(pin) : LOW;
+}
+
+uint8_t simGetPinMode(uint8_t pin) {
+    return pin < SIM_MAX_PINS ? pins[pin].mode : INPUT;
+}
+
+void simPinMode(uint8_t pin, uint8_t mode) {
+    if (pin >= SIM_MAX_PINS) return;
+    pins[pin].mode = mode;
+}
+
+void simPinWrite(uint8_t pin, uint8_t value) {
+    if (pin >= SIM_MAX_PINS) return;
+    uint8_t before = pins[pin].outputLevel;
+    pins[pin].outputLevel = value ? HIGH : LOW;
+
+    // MAX7219 me-latch shift register pada sisi naik LOAD/CS
+    if (pin == chainCs && before == LOW && pins[pin].outputLevel == HIGH) {
+        simChainLatch();
+    }
+}
+
+void simAttachInterrupt(uint8_t pin, std::function<void(void)> callback, int mode) {
+    if (pin >= SIM_MAX_PINS) return;
+    pinInterrupts[pin] = callback;
+    pins[pin].interruptMode = mode;
+}
+
+void simDetachInterrupt(uint8_t pin) {
+    if (pin >= SIM_MAX_PINS) return;
+    pinInterrupts[pin] = nullptr;
+    pins[pin].interruptMode = 0;
+}
+
+// ===== IMPLEMENTASI HARDWARE TIMER =====
+
+void simTimerStart(std::function<void(void)> callback, uint32_t periodMicros, bool reload) {
+    timerCallback = callback;
+    timerPeriodMicros = periodMicros;
+    timerReload = reload;
+    timerNextMicros = nowMicros + periodMicros;
+}
+
+void simTimerStop() {
+    timerPeriodMicros = 0;
+}
+
+// ===== IMPLEMENTASI TRACE =====
+
+int simPinByName(const char* name) {
+    if (strcmp(name, "BRAKE") == 0) return BRAKE_PIN;
+    if (strcmp(name, "SEIN_LEFT") == 0) return SEIN_LEFT_PIN;
+    if (strcmp(name, "SEIN_RIGHT") == 0) return SEIN_RIGHT_PIN;
+
+    char* end;
+    long pin = strtol(name, &end, 10);
+    if (*end != '\0' || pin < 0 || pin >= SIM_MAX_PINS) return -1;
+    return (int)pin;
+}
+
+bool simTraceLoad(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) return false;
+
+    char line[128];
+    int lineNumber = 0;
+    bool ok = true;
+    while (fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        char* comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        unsigned long timeMs;
+        char pinName[32];
+        int level;
+        int fields = sscanf(line, "%lu %31s %d", &timeMs, pinName, &level);
+        if (fields <= 0) continue;
+
+        int pin = (fields == 3) ? simPinByName(pinName) : -1;
+        if (pin < 0 || !simTraceAdd(timeMs, pin, level)) {
+            fprintf(stderr, "%s:%d: invalid trace line\n", path, lineNumber);
+            ok = false;
+            break;
+        }
+    }
+    fclose(file);
+    return ok;
+}
+
+void simTraceClear() {
+    traceEvents.clear();
+    traceCursor = 0;
+}
+
+bool simTraceAdd(uint32_t timeMs, uint8_t pin, uint8_t level) {
+    if (traceEvents.size() >= SIM_MAX_TRACE_EVENTS || pin >= SIM_MAX_PINS) return false;
+
+    SimTraceEvent event = {timeMs, pin, (uint8_t)(level ? HIGH : LOW)};
+    auto position = std::upper_bound(traceEvents.begin(), traceEvents.end(), event,
+        [](const SimTraceEvent& a, const SimTraceEvent& b) { return a.timeMs < b.timeMs; });
+    traceEvents.insert(position, event);
+    return true;
+}
+
+uint16_t simTraceCount() {
+    return traceEvents.size();
+}
+
+const SimTraceEvent* simTraceGet(uint16_t index) {
+    return index < traceEvents.size() ? &traceEvents[index] : nullptr;
+}
+
+// ===== IMPLEMENTASI VIRTUAL CHAIN =====
+
+void simChainConfigure(uint8_t dinPin, uint8_t clkPin, uint8_t csPin, uint8_t numDevices) {
+    chainDin = dinPin;
+    chainClk = clkPin;
+    chainCs = csPin;
+    chainDevices = std::min<uint8_t>(numDevices, SIM_MAX_DEVICES);
+    memset(shiftRegister, 0, sizeof(shiftRegister));
+    memset(devices, 0, sizeof(devices));
+    frameVersion = 0;
+    simChainResetStats();
+}
+
+void simChainShift(uint8_t dataPin, uint8_t clockPin, uint8_t value) {
+    if (dataPin != chainDin || clockPin != chainClk) return;
+
+    // Byte baru masuk ke modul 0, isi lama terdorong ke modul berikutnya
+    memmove(shiftRegister + 1, shiftRegister, chainDevices * 2 - 1);
+    shiftRegister[0] = value;
+    chainStats.bytes++;
+}
+
+static void simChainLatch() {
+    bool changed = false;
+
+    for (uint8_t d = 0; d < chainDevices; d++) {
+        uint8_t opcode = shiftRegister[d * 2 + 1] & 0x0F;
+        uint8_t data = shiftRegister[d * 2];
+        SimMax7219& device = devices[d];
+        uint8_t* target = nullptr;
+
+        switch (opcode) {
+            case 0x00: break;
+            case 0x09: target = &device.decodeMode; break;
+            case 0x0A: target = &device.intensity; data &= 0x0F; break;
+            case 0x0B: target = &device.scanLimit; data &= 0x07; break;
+            case 0x0C:
+                if (device.shutdown != !(data & 0x01)) changed = true;
+                device.shutdown = !(data & 0x01);
+                break;
+            case 0x0F:
+                if (device.displayTest != (data & 0x01)) changed = true;
+                device.displayTest = data & 0x01;
+                break;
+            default:
+                if (opcode >= 0x01 && opcode <= 0x08) target = &device.digits[opcode - 1];
+                break;
+        }
+
+        if (opcode != 0x00) chainStats.registerWrites++;
+        if (target && *target != data) {
+            *target = data;
+            changed = true;
+        }
+    }
+
+    chainStats.transactions++;
+    if (changed) {
+        frameVersion++;
+        chainStats.frameChanges++;
+    }
+    if (latchHook) latchHook();
+}
+
+uint8_t simChainDeviceCount() {
+    return chainDevices;
+}
+
+const SimMax7219* simChainDevice(uint8_t index) {
+    return index < chainDevices ? &devices[index] : nullptr;
+}
+
+const SimChainStats* simChainStats() {
+    return &chainStats;
+}
+
+void simChainResetStats() {
+    memset(&chainStats, 0, sizeof(chainStats));
+}
+
+uint32_t simChainFrameVersion() {
+    return frameVersion;
+}
+
+void simChainSetLatchHook(std::function<void(void)> hook) {
+    latchHook = hook;
+}
+
+bool simChainPixel(uint16_t x, uint8_t y) {
+    uint8_t d = x / 8;
+    if (d >= chainDevices || y >= 8) return false;
+    const SimMax7219& device = devices[d];
+    if (device.displayTest) return true;
+    if (device.shutdown || y > device.scanLimit) return false;
+    // Sama seperti LedControl::setLed: bit 7 = kolom 0
+    return device.digits[y] & (0x80 >> (x % 8));
+}
+
+// ===== IMPLEMENTASI RENDERING =====
+
+void simRenderAscii(FILE* out) {
+    uint16_t width = chainDevices * 8;
+    for (uint8_t y = 0; y < 8; y++) {
+        for (uint16_t x = 0; x < width; x++) {
+            if (x > 0 && x % 8 == 0) fputc(' ', out);
+            fputc(simChainPixel(x, y) ? '#' : '.', out);
+        }
+        fputc('\n', out);
+    }
+}
+
+bool simRenderPpm(const char* path, uint8_t scale) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+
+    if (scale == 0) scale = 1;
+    uint16_t width = chainDevices * 8;
+    fprintf(file, "P6\n%u %u\n255\n", width * scale, 8 * scale);
+
+    for (uint16_t y = 0; y < 8 * scale; y++) {
+        for (uint16_t x = 0; x < width * scale; x++) {
+            uint16_t px = x / scale;
+            uint8_t py = y / scale;
+            uint8_t rgb[3] = {24, 0, 0};
+            if (simChainPixel(px, py)) {
+                // Duty cycle MAX7219: (2 * intensity + 1) / 32
+                uint8_t intensity = devices[px / 8].intensity;
+                rgb[0] = 55 + (200 * (2 * intensity + 1)) / 31;
+                rgb[1] = rgb[0] / 8;
+            }
+            fwrite(rgb, 1, 3, file);
+        }
+    }
+
+    fclose(file);
+    return true;
+}
@@ -0,0 +1,90 @@
+#ifndef SIM_CORE_H
+#define SIM_CORE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <functional>
+
+// Build Information
+#define SIM_VERSION "1.0.0"
+#define SIM_BUILD_DATE "2026-10-17 10:02:41"
+#define SIM_AUTHOR "Brodot23"
+
+// Simulation Constants
+#define SIM_MAX_PINS 32
+#define SIM_MAX_DEVICES 8
+#define SIM_MAX_TRACE_EVENTS 4096
+
+// Virtual MAX7219
+typedef struct {
+    uint8_t digits[8];      // Register digit 0..7 (= baris)
+    uint8_t intensity;      // 0-15
+    uint8_t scanLimit;
+    uint8_t decodeMode;
+    bool shutdown;
+    bool displayTest;
+} SimMax7219;
+
+// Statistik transport chain
+typedef struct {
+    uint32_t transactions;  // Pulsa CS (latch)
+    uint32_t bytes;         // Byte yang di-shift
+    uint32_t registerWrites;// Perintah non-noop yang dieksekusi modul
+    uint32_t frameChanges;  // Berapa kali isi tampilan berubah
+} SimChainStats;
+
+// Scripted input event
+typedef struct {
+    uint32_t timeMs;
+    uint8_t pin;
+    uint8_t level;
+} SimTraceEvent;
+
+// ===== Virtual clock =====
+void simClockReset(uint64_t startMicros = 0);
+uint64_t simNowMicros();
+void simAdvanceMicros(uint64_t micros);
+void simAdvanceMillis(uint32_t ms);
+
+// ===== Pin model =====
+void simPinsReset();
+void simSetInput(uint8_t pin, uint8_t level);
+void simReleaseInput(uint8_t pin);
+uint8_t simGetPinLevel(uint8_t pin);
+uint8_t simGetPinMode(uint8_t pin);
+void simPinWrite(uint8_t pin, uint8_t value);
+void simPinMode(uint8_t pin, uint8_t mode);
+void simAttachInterrupt(uint8_t pin, std::function<void(void)> callback, int mode);
+void simDetachInterrupt(uint8_t pin);
+
+// ===== Hardware timer =====
+// Callback periodik di waktu virtual, diselingi event trace sesuai urutan waktunya
+void simTimerStart(std::function<void(void)> callback, uint32_t periodMicros, bool reload);
+void simTimerStop();
+
+// ===== Input trace =====
+// Format per baris: "<ms> <BRAKE|SEIN_LEFT|SEIN_RIGHT|pin> <0|1>", '#' = komentar.
+// Input aktif LOW (pull-up), jadi 0 = ditekan.
+bool simTraceLoad(const char* path);
+void simTraceClear();
+bool simTraceAdd(uint32_t timeMs, uint8_t pin, uint8_t level);
+uint16_t simTraceCount();
+const SimTraceEvent* simTraceGet(uint16_t index);
+int simPinByName(const char* name);
+
+// ===== Virtual LED chain =====
+void simChainConfigure(uint8_t dinPin, uint8_t clkPin, uint8_t csPin, uint8_t devices);
+void simChainShift(uint8_t dataPin, uint8_t clockPin, uint8_t value);
+uint8_t simChainDeviceCount();
+const SimMax7219* simChainDevice(uint8_t index);
+const SimChainStats* simChainStats();
+void simChainResetStats();
+uint32_t simChainFrameVersion();
+void simChainSetLatchHook(std::function<void(void)> hook);
+bool simChainPixel(uint16_t x, uint8_t y);
+
+// ===== Rendering =====
+void simRenderAscii(FILE* out);
+bool simRenderPpm(const char* path, uint8_t scale);
+
+#endif // SIM_CORE_H
@@ -0,0 +1,360 @@
+#include <ArduinoJson.h>
+
+// ===== IMPLEMENTASI SERIALIZER =====
+
+namespace SimJson {
+
+static void writeString(const std::string& s, std::string& out) {
+    out += '"';
+    for (unsigned char c : s) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default:
+                if (c < 0x20) {
+                    char buffer[8];
+                    snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    out += buffer;
+                } else {
+                    out += (char)c;
+                }
+        }
+    }
+    out += '"';
+}
+
+static void newline(std::string& out, bool pretty, int indent) {
+    if (!pretty) return;
+    out += "\r\n";
+    out.append(indent * 2, ' ');
+}
+
+void serialize(const Node* node, std::string& out, bool pretty, int indent) {
+    if (!node) {
+        out += "null";
+        return;
+    }
+
+    char buffer[32];
+    switch (node->type) {
+        case Node::Null:
+            out += "null";
+            break;
+        case Node::Bool:
+            out += node->b ? "true" : "false";
+            break;
+        case Node::Int:
+            snprintf(buffer, sizeof(buffer), "%lld", node->i);
+            out += buffer;
+            break;
+        case Node::Float:
+            snprintf(buffer, sizeof(buffer), "%.9g", node->f);
+            out += buffer;
+            break;
+        case Node::Str:
+            writeString(node->s, out);
+            break;
+        case Node::Object:
+            out += '{';
+            for (size_t n = 0; n < node->children.size(); n++) {
+                if (n) out += ',';
+                newline(out, pretty, indent + 1);
+                writeString(node->keys[n], out);
+                out += pretty ? ": " : ":";
+                serialize(node->children[n].get(), out, pretty, indent + 1);
+            }
+            if (!node->children.empty()) newline(out, pretty, indent);
+            out += '}';
+            break;
+        case Node::Array:
+            out += '[';
+            for (size_t n = 0; n < node->children.size(); n++) {
+                if (n) out += ',';
+                newline(out, pretty, indent + 1);
+                serialize(node->children[n].get(), out, pretty, indent + 1);
+            }
+            if (!node->children.empty()) newline(out, pretty, indent);
+            out += ']';
+            break;
+    }
+}
+
+// ===== IMPLEMENTASI PARSER =====
+
+class Parser {
+public:
+    Parser(const char* input, size_t length) : p(input), end(input + length) {}
+
+    int parse(Node& root) {
+        skipSpace();
+        if (p >= end) return DeserializationError::EmptyInput;
+        int error = parseValue(root, 0);
+        return error;
+    }
+
+private:
+    void skipSpace() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+    }
+
+    bool literal(const char* word) {
+        size_t n = strlen(word);
+        if ((size_t)(end - p) < n || strncmp(p, word, n) != 0) return false;
+        p += n;
+        return true;
+    }
+
+    int parseString(std::string& out) {
+        p++; // "
+        while (p < end && *p != '"') {
+            if (*p == '\\') {
+                if (++p >= end) return DeserializationError::IncompleteInput;
+                switch (*p) {
+                    case 'n': out += '\n'; break;
+                    case 'r': out += '\r'; break;
+                    case 't': out += '\t'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'u': {
+                        if (end - p < 5) return DeserializationError::IncompleteInput;
+                        unsigned code = strtoul(std::string(p + 1, 4).c_str(), nullptr, 16);
+                        if (code < 0x80) {
+                            out += (char)code;
+                        } else if (code < 0x800) {
+                            out += (char)(0xC0 | (code >> 6));
+                            out += (char)(0x80 | (code & 0x3F));
+                        } else {
+                            out += (char)(0xE0 | (code >> 12));
+                            out += (char)(0x80 | ((code >> 6) & 0x3F));
+                            out += (char)(0x80 | (code & 0x3F));
+                        }
+                        p += 4;
+                        break;
+                    }
+                    default: out += *p; break;
+                }
+                p++;
+            } else {
+                out += *p++;
+            }
+        }
+        if (p >= end) return DeserializationError::IncompleteInput;
+        p++; // "
+        return DeserializationError::Ok;
+    }
+
+    int parseValue(Node& node, int depth) {
+        if (depth > 10) return DeserializationError::TooDeep;
+        skipSpace();
+        if (p >= end) return DeserializationError::IncompleteInput;
+
+        node.clear();
+        if (*p == '{') {
+            node.type = Node::Object;
+            p++;
+            skipSpace();
+            if (p < end && *p == '}') { p++; return DeserializationError::Ok; }
+            while (true) {
+                skipSpace();
+                if (p >= end) return DeserializationError::IncompleteInput;
+                if (*p != '"') return DeserializationError::InvalidInput;
+                std::string key;
+                int error = parseString(key);
+                if (error) return error;
+                skipSpace();
+                if (p >= end) return DeserializationError::IncompleteInput;
+                if (*p++ != ':') return DeserializationError::InvalidInput;
+                error = parseValue(*node.member(key), depth + 1);
+                if (error) return error;
+                skipSpace();
+                if (p >= end) return DeserializationError::IncompleteInput;
+                if (*p == ',') { p++; continue; }
+                if (*p == '}') { p++; return DeserializationError::Ok; }
+                return DeserializationError::InvalidInput;
+            }
+        }
+        if (*p == '[') {
+            node.type = Node::Array;
+            p++;
+            skipSpace();
+            if (p < end && *p == ']') { p++; return DeserializationError::Ok; }
+            while (true) {
+                int error = parseValue(*node.append(), depth + 1);
+                if (error) return error;
+                skipSpace();
+                if (p >= end) return DeserializationError::IncompleteInput;
+                if (*p == ',') { p++; continue; }
+                if (*p == ']') { p++; return DeserializationError::Ok; }
+                return DeserializationError::InvalidInput;
+            }
+        }
+        if (*p == '"') {
+            node.type = Node::Str;
+            return parseString(node.s);
+        }
+        if (literal("true")) { node.type = Node::Bool; node.b = true; return DeserializationError::Ok; }
+        if (literal("false")) { node.type = Node::Bool; node.b = false; return DeserializationError::Ok; }
+        if (literal("null")) { return DeserializationError::Ok; }
+
+        const char* start = p;
+        bool isFloat = false;
+        if (p < end && (*p == '-' || *p == '+')) p++;
+        while (p < end && ((*p >= '0' && *p <= '9') || *p == '.' || *p == 'e' || *p == 'E' || *p == '-' || *p == '+')) {
+            if (*p == '.' || *p == 'e' || *p == 'E') isFloat = true;
+            p++;
+        }
+        if (p == start) return DeserializationError::InvalidInput;
+        std::string number(start, p - start);
+        if (isFloat) {
+            node.type = Node::Float;
+            node.f = strtod(number.c_str(), nullptr);
+        } else {
+            node.type = Node::Int;
+            node.i = strtoll(number.c_str(), nullptr, 10);
+        }
+        return DeserializationError::Ok;
+    }
+
+    const char* p;
+    const char* end;
+};
+
+bool parse(Node& root, const char* input, size_t length, int& errorCode) {
+    Parser parser(input, length);
+    errorCode = parser.parse(root);
+    return errorCode == DeserializationError::Ok;
+}
+
+} // namespace SimJson
+
+// ===== IMPLEMENTASI JsonVariant =====
+
+SimJson::Node* JsonVariant::resolve(bool create) const {
+    if (node_ || !create || !isMember_) return node_;
+
+    SimJson::Node* parent = owner_ ? owner_->resolve(true) : nullptr;
+    if (!parent) return nullptr;
+    JsonVariant* self = const_cast<JsonVariant*>(this);
+    self->node_ = parent->member(key_);
+    return node_;
+}
+
+JsonVariant JsonVariant::operator[](const char* key) const {
+    JsonVariant member;
+    member.owner_ = std::make_shared<JsonVariant>(*this);
+    member.key_ = key ? key : "";
+    member.isMember_ = true;
+    member.node_ = node() ? node()->find(member.key_) : nullptr;
+    return member;
+}
+
+JsonVariant JsonVariant::operator[](int index) const {
+    const SimJson::Node* n = node();
+    if (!n || n->type != SimJson::Node::Array || index < 0 || (size_t)index >= n->children.size()) {
+        return JsonVariant();
+    }
+    return JsonVariant(n->children[index].get());
+}
+
+void JsonVariant::remove(const char* key) {
+    SimJson::Node* n = node();
+    if (!n || n->type != SimJson::Node::Object) return;
+    for (size_t i = 0; i < n->keys.size(); i++) {
+        if (n->keys[i] == key) {
+            n->keys.erase(n->keys.begin() + i);
+            n->children.erase(n->children.begin() + i);
+            return;
+        }
+    }
+}
+
+JsonObject JsonVariant::createNestedObject(const char* key) {
+    SimJson::Node* n = resolve(true);
+    if (!n) return JsonObject();
+    SimJson::Node* child = n->member(key);
+    child->clear();
+    child->type = SimJson::Node::Object;
+    return JsonObject(child);
+}
+
+JsonArray JsonVariant::createNestedArray(const char* key) {
+    SimJson::Node* n = resolve(true);
+    if (!n) return JsonArray();
+    SimJson::Node* child = n->member(key);
+    child->clear();
+    child->type = SimJson::Node::Array;
+    return JsonArray(child);
+}
+
+JsonObject JsonVariant::createNestedObject() {
+    SimJson::Node* n = resolve(true);
+    if (!n) return JsonObject();
+    SimJson::Node* child = n->append();
+    child->type = SimJson::Node::Object;
+    return JsonObject(child);
+}
+
+JsonArray JsonVariant::createNestedArray() {
+    SimJson::Node* n = resolve(true);
+    if (!n) return JsonArray();
+    SimJson::Node* child = n->append();
+    child->type = SimJson::Node::Array;
+    return JsonArray(child);
+}
+
+// ===== IMPLEMENTASI FUNGSI GLOBAL =====
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, size_t length) {
+    doc.clear();
+    if (!input || length == 0) return DeserializationError::EmptyInput;
+    int error;
+    SimJson::parse(*doc.node(), input, length, error);
+    return DeserializationError((DeserializationError::Code)error);
+}
+
+size_t serializeJson(const JsonVariant& source, String& output) {
+    std::string out;
+    SimJson::serialize(source.node(), out, false, 0);
+    output = String(out);
+    return out.size();
+}
+
+size_t serializeJson(const JsonVariant& source, Print& output) {
+    std::string out;
+    SimJson::serialize(source.node(), out, false, 0);
+    return output.write((const uint8_t*)out.data(), out.size());
+}
+
+size_t serializeJson(const JsonVariant& source, char* output, size_t size) {
+    std::string out;
+    SimJson::serialize(source.node(), out, false, 0);
+    if (size == 0) return 0;
+    size_t n = out.size() < size - 1 ? out.size() : size - 1;
+    memcpy(output, out.data(), n);
+    output[n] = '\0';
+    return n;
+}
+
+size_t serializeJsonPretty(const JsonVariant& source, String& output) {
+    std::string out;
+    SimJson::serialize(source.node(), out, true, 0);
+    output = String(out);
+    return out.size();
+}
+
+size_t serializeJsonPretty(const JsonVariant& source, Print& output) {
+    std::string out;
+    SimJson::serialize(source.node(), out, true, 0);
+    return output.write((const uint8_t*)out.data(), out.size());
+}
+
+size_t measureJson(const JsonVariant& source) {
+    std::string out;
+    SimJson::serialize(source.node(), out, false, 0);
+    return out.size();
+}
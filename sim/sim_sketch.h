@@ -0,0 +1,15 @@
+#ifndef SIM_SKETCH_H
+#define SIM_SKETCH_H
+
+#include <stdint.h>
+#include "recorder.h"
+
+// Glue antara harness dan 60animasi.ino (dikompilasi di sketch.cpp)
+void simSketchSetup();
+void simSketchLoop();
+void simSketchSetModes(int startupMode, int seinMode, int brakeMode);
+uint8_t simSketchPriority();
+char simSketchSeinDirection();                    // 'L', 'R', 'H' atau 'N'
+bool simSketchStartRecorder(RecorderSink sink);   // Header diisi dari mode sketch saat ini
+
+#endif // SIM_SKETCH_H
@@ -0,0 +1,41 @@
+// Translation unit untuk sketch: .ino dikompilasi apa adanya terhadap stand-in di stubs/
+#include "../60animasi.ino"
+#include "sim_sketch.h"
+
+void simSketchSetup() {
+    setup();
+}
+
+void simSketchLoop() {
+    loop();
+}
+
+void simSketchSetModes(int startupMode, int seinMode, int brakeMode) {
+    if (startupMode >= 0) {
+        settings.startupMode = startupMode;
+        stateManager.startupMode = startupMode;
+    }
+    if (seinMode >= 0) {
+        seinSettings.mode = seinMode;
+    }
+    if (brakeMode >= 0) {
+        brakeSettings.mode = brakeMode;
+    }
+}
+
+uint8_t simSketchPriority() {
+    return stateManager.currentPriority;
+}
+
+char simSketchSeinDirection() {
+    return stateManager.isSeining ? seinSettings.direction : 'N';
+}
+
+bool simSketchStartRecorder(RecorderSink sink) {
+    RecorderInfo info;
+    info.devices = MATRIX_COUNT;
+    info.startupMode = settings.startupMode;
+    info.seinMode = seinSettings.mode;
+    info.brakeMode = brakeSettings.mode;
+    return recorderBegin(&info, sink);
+}
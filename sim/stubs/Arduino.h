@@ -0,0 +1,148 @@
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+// Stand-in Arduino core untuk build simulasi host (lihat sim/README.md)
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+#include "binary.h"
+#include "WString.h"
+#include "Print.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// Pin levels & modes
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x00
+#define OUTPUT 0x01
+#define INPUT_PULLUP 0x02
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+// Interrupt modes
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+// Atribut khusus ESP8266 tidak berarti apa-apa di host
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (s)
+#define FPSTR(p) (p)
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+template<typename T, typename U>
+inline auto min(const T& a, const U& b) -> typename std::common_type<T, U>::type {
+    return (b < a) ? b : a;
+}
+
+template<typename T, typename U>
+inline auto max(const T& a, const U& b) -> typename std::common_type<T, U>::type {
+    return (a < b) ? b : a;
+}
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+#if !defined(__GLIBC__) || !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char* dst, const char* src, size_t size);
+#endif
+
+// Waktu (virtual clock, lihat sim_core.h)
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// GPIO
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t value);
+
+// Interrupt
+#define digitalPinToInterrupt(pin) (pin)
+void attachInterrupt(uint8_t interrupt, std::function<void(void)> callback, int mode);
+void detachInterrupt(uint8_t interrupt);
+void noInterrupts();
+void interrupts();
+
+// Timer1 (hardware timer ESP8266): callback dipanggil tepat pada waktu virtual setiap periode
+#define TIM_DIV1 0                  // 80 MHz
+#define TIM_DIV16 1                 // 5 MHz
+#define TIM_DIV256 3                // 312.5 kHz
+#define TIM_EDGE 0
+#define TIM_LEVEL 1
+#define TIM_SINGLE 0
+#define TIM_LOOP 1
+typedef void (*timercallback)(void);
+void timer1_attachInterrupt(timercallback userFunc);
+void timer1_detachInterrupt();
+void timer1_enable(uint8_t divider, uint8_t intType, uint8_t reload);
+void timer1_disable();
+void timer1_write(uint32_t ticks);
+
+// Random
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+// Serial & ESP
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    int available();
+    int read();
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+};
+
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+    uint32_t getFreeHeap();
+    uint32_t getMaxFreeBlockSize();
+    uint32_t getCycleCount();
+    uint32_t getCpuFreqMHz() { return 80; }
+    uint32_t getChipId();
+    void restart();
+
+    // Flash SPI (raw, tanpa cache): erase sektor ke 0xFF, tulis hanya 1 -> 0
+    bool flashEraseSector(uint32_t sector);
+    bool flashWrite(uint32_t address, const uint32_t* data, size_t size);
+    bool flashRead(uint32_t address, uint32_t* data, size_t size);
+};
+
+#define SPI_FLASH_SEC_SIZE 4096
+
+// Simbol linker script: awal sektor EEPROM di flash yang dipetakan ke 0x40200000
+extern "C" uint32_t _EEPROM_start;
+
+extern EspClass ESP;
+
+#endif // SIM_ARDUINO_H
@@ -0,0 +1,403 @@
+#ifndef SIM_ARDUINOJSON_H
+#define SIM_ARDUINOJSON_H
+
+// Subset API ArduinoJson 6 yang dipakai sketch, cukup untuk simulasi host.
+// Bukan pengganti library aslinya: kapasitas dokumen tidak dibatasi.
+
+#include <Arduino.h>
+#include <memory>
+#include <vector>
+
+namespace SimJson {
+
+struct Node {
+    enum Type { Null, Bool, Int, Float, Str, Object, Array };
+
+    Type type = Null;
+    bool b = false;
+    long long i = 0;
+    double f = 0;
+    std::string s;
+    std::vector<std::string> keys;
+    std::vector<std::unique_ptr<Node>> children;
+
+    void clear() {
+        type = Null;
+        s.clear();
+        keys.clear();
+        children.clear();
+    }
+
+    Node* find(const std::string& key) const {
+        if (type != Object) return nullptr;
+        for (size_t n = 0; n < keys.size(); n++) {
+            if (keys[n] == key) return children[n].get();
+        }
+        return nullptr;
+    }
+
+    Node* member(const std::string& key) {
+        if (type != Object) { clear(); type = Object; }
+        Node* existing = find(key);
+        if (existing) return existing;
+        keys.push_back(key);
+        children.emplace_back(new Node());
+        return children.back().get();
+    }
+
+    Node* append() {
+        if (type != Array) { clear(); type = Array; }
+        children.emplace_back(new Node());
+        return children.back().get();
+    }
+
+    void copyFrom(const Node& other) {
+        clear();
+        type = other.type;
+        b = other.b;
+        i = other.i;
+        f = other.f;
+        s = other.s;
+        keys = other.keys;
+        for (const auto& child : other.children) {
+            children.emplace_back(new Node());
+            children.back()->copyFrom(*child);
+        }
+    }
+};
+
+void serialize(const Node* node, std::string& out, bool pretty, int indent);
+bool parse(Node& root, const char* input, size_t length, int& errorCode);
+
+} // namespace SimJson
+
+class JsonObject;
+class JsonArray;
+class JsonVariant;
+
+template<typename T>
+struct IsJsonVariant : std::is_base_of<JsonVariant, T> {};
+
+class JsonVariant {
+public:
+    JsonVariant() {}
+    explicit JsonVariant(SimJson::Node* node) : node_(node) {}
+
+    bool isNull() const { return !node() || node()->type == SimJson::Node::Null; }
+    size_t size() const { return node() ? node()->children.size() : 0; }
+    size_t memoryUsage() const { return 0; }
+
+    template<typename T>
+    bool is() const {
+        const SimJson::Node* n = node();
+        if (!n) return false;
+        if (std::is_same<T, bool>::value) return n->type == SimJson::Node::Bool;
+        if (std::is_integral<T>::value) return n->type == SimJson::Node::Int;
+        if (std::is_floating_point<T>::value) return n->type == SimJson::Node::Int || n->type == SimJson::Node::Float;
+        if (std::is_same<T, const char*>::value || std::is_same<T, String>::value) return n->type == SimJson::Node::Str;
+        if (std::is_same<T, JsonObject>::value) return n->type == SimJson::Node::Object;
+        if (std::is_same<T, JsonArray>::value) return n->type == SimJson::Node::Array;
+        return false;
+    }
+
+    template<typename T>
+    T as() const { return convert<T>(); }
+
+    template<typename T, typename = typename std::enable_if<!IsJsonVariant<T>::value>::type>
+    operator T() const { return convert<T>(); }
+
+    template<typename T>
+    JsonVariant& operator=(const T& value) {
+        set(value);
+        return *this;
+    }
+
+    JsonVariant& operator=(const JsonVariant& other) {
+        if (this != &other) {
+            if (isMember_ && !node_) {
+                set(other);
+            } else {
+                node_ = other.node_;
+                owner_ = other.owner_;
+                key_ = other.key_;
+                isMember_ = other.isMember_;
+            }
+        }
+        return *this;
+    }
+    JsonVariant(const JsonVariant&) = default;
+
+    template<typename T>
+    bool set(const T& value) {
+        SimJson::Node* n = resolve(true);
+        if (!n) return false;
+        assign(*n, value);
+        return true;
+    }
+
+    JsonVariant operator[](const char* key) const;
+    JsonVariant operator[](const String& key) const { return (*this)[key.c_str()]; }
+    JsonVariant operator[](int index) const;
+
+    bool containsKey(const char* key) const { return node() && node()->find(key) != nullptr; }
+    bool containsKey(const String& key) const { return containsKey(key.c_str()); }
+    void remove(const char* key);
+
+    JsonObject createNestedObject(const char* key);
+    JsonArray createNestedArray(const char* key);
+    JsonObject createNestedObject();
+    JsonArray createNestedArray();
+
+    template<typename T>
+    bool add(const T& value) {
+        SimJson::Node* n = resolve(true);
+        if (!n) return false;
+        assign(*n->append(), value);
+        return true;
+    }
+
+    class iterator {
+    public:
+        iterator(const SimJson::Node* parent, size_t index) : parent(parent), index(index) {}
+        JsonVariant operator*() const { return JsonVariant(parent->children[index].get()); }
+        iterator& operator++() { index++; return *this; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+
+    private:
+        const SimJson::Node* parent;
+        size_t index;
+    };
+
+    iterator begin() const { return iterator(node(), 0); }
+    iterator end() const { return iterator(node(), size()); }
+
+    SimJson::Node* node() const { return node_; }
+
+protected:
+    SimJson::Node* resolve(bool create) const;
+
+    template<typename T>
+    static void assign(SimJson::Node& n, const T& value) {
+        typedef typename std::decay<T>::type V;
+        if constexpr (IsJsonVariant<V>::value) {
+            if (value.node()) n.copyFrom(*value.node());
+            else n.clear();
+        } else if constexpr (std::is_same<V, bool>::value) {
+            n.clear(); n.type = SimJson::Node::Bool; n.b = value;
+        } else if constexpr (std::is_integral<V>::value) {
+            n.clear(); n.type = SimJson::Node::Int; n.i = (long long)value;
+        } else if constexpr (std::is_floating_point<V>::value) {
+            n.clear(); n.type = SimJson::Node::Float; n.f = value;
+        } else if constexpr (std::is_same<V, String>::value) {
+            n.clear(); n.type = SimJson::Node::Str; n.s = value.c_str();
+        } else if constexpr (std::is_same<V, std::nullptr_t>::value) {
+            n.clear();
+        } else if constexpr (std::is_array<T>::value) {
+            n.clear(); n.type = SimJson::Node::Str; n.s = value;
+        } else {
+            n.clear();
+            if (value) { n.type = SimJson::Node::Str; n.s = (const char*)value; }
+        }
+    }
+
+    template<typename T>
+    T convert() const {
+        const SimJson::Node* n = node();
+        if constexpr (std::is_same<T, bool>::value) {
+            if (!n) return false;
+            if (n->type == SimJson::Node::Bool) return n->b;
+            if (n->type == SimJson::Node::Int) return n->i != 0;
+            if (n->type == SimJson::Node::Float) return n->f != 0;
+            return false;
+        } else if constexpr (std::is_integral<T>::value || std::is_enum<T>::value) {
+            if (!n) return T();
+            if (n->type == SimJson::Node::Int) return (T)n->i;
+            if (n->type == SimJson::Node::Float) return (T)(long long)n->f;
+            if (n->type == SimJson::Node::Bool) return (T)n->b;
+            return T();
+        } else if constexpr (std::is_floating_point<T>::value) {
+            if (!n) return 0;
+            if (n->type == SimJson::Node::Int) return (T)n->i;
+            if (n->type == SimJson::Node::Float) return (T)n->f;
+            return 0;
+        } else if constexpr (std::is_same<T, const char*>::value) {
+            return (n && n->type == SimJson::Node::Str) ? n->s.c_str() : nullptr;
+        } else if constexpr (std::is_same<T, String>::value) {
+            if (!n || n->type == SimJson::Node::Null) return String("null");
+            if (n->type == SimJson::Node::Str) return String(n->s);
+            std::string out;
+            SimJson::serialize(n, out, false, 0);
+            return String(out);
+        } else {
+            return T(node_);
+        }
+    }
+
+    SimJson::Node* node_ = nullptr;
+    std::shared_ptr<JsonVariant> owner_;
+    std::string key_;
+    bool isMember_ = false;
+};
+
+template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+inline bool operator<(const JsonVariant& v, T x) { return v.as<T>() < x; }
+template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+inline bool operator>(const JsonVariant& v, T x) { return v.as<T>() > x; }
+template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+inline bool operator<(T x, const JsonVariant& v) { return x < v.as<T>(); }
+template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+inline bool operator>(T x, const JsonVariant& v) { return x > v.as<T>(); }
+template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+inline bool operator==(const JsonVariant& v, T x) { return v.as<T>() == x; }
+inline bool operator==(const JsonVariant& v, const char* x) {
+    const char* s = v.as<const char*>();
+    return s && x && strcmp(s, x) == 0;
+}
+// Nilai default bila key tidak ada atau bukan string (seperti ArduinoJson 6)
+inline const char* operator|(const JsonVariant& v, const char* fallback) {
+    return v.is<const char*>() ? v.as<const char*>() : fallback;
+}
+template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+inline T operator|(const JsonVariant& v, T fallback) {
+    return v.is<T>() ? v.as<T>() : fallback;
+}
+
+typedef JsonVariant JsonVariantConst;
+
+class JsonString {
+public:
+    JsonString(const char* s) : s(s) {}
+    const char* c_str() const { return s; }
+    operator const char*() const { return s; }
+
+private:
+    const char* s;
+};
+
+class JsonPair {
+public:
+    JsonPair(const char* key, SimJson::Node* value) : k(key), v(value) {}
+    JsonString key() const { return k; }
+    JsonVariant value() const { return v; }
+
+private:
+    JsonString k;
+    JsonVariant v;
+};
+
+class JsonObject : public JsonVariant {
+public:
+    JsonObject() {}
+    explicit JsonObject(SimJson::Node* node) : JsonVariant(node) {}
+    JsonObject(const JsonVariant& v) : JsonVariant(v) {}
+
+    class iterator {
+    public:
+        iterator(SimJson::Node* parent, size_t index) : parent(parent), index(index) {}
+        JsonPair operator*() const { return JsonPair(parent->keys[index].c_str(), parent->children[index].get()); }
+        iterator& operator++() { index++; return *this; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+
+    private:
+        SimJson::Node* parent;
+        size_t index;
+    };
+
+    iterator begin() const { return iterator(node(), 0); }
+    iterator end() const { return iterator(node(), (node() && node()->type == SimJson::Node::Object) ? node()->keys.size() : 0); }
+};
+
+class JsonArray : public JsonVariant {
+public:
+    JsonArray() {}
+    explicit JsonArray(SimJson::Node* node) : JsonVariant(node) {}
+    JsonArray(const JsonVariant& v) : JsonVariant(v) {}
+};
+
+typedef JsonObject JsonObjectConst;
+typedef JsonArray JsonArrayConst;
+
+class JsonDocument : public JsonVariant {
+public:
+    JsonDocument(size_t capacity) : JsonVariant(nullptr), root(new SimJson::Node()), cap(capacity) {
+        node_ = root.get();
+    }
+    JsonDocument(const JsonDocument&) = delete;
+    JsonDocument& operator=(const JsonDocument&) = delete;
+
+    void clear() { root->clear(); }
+    size_t capacity() const { return cap; }
+    bool overflowed() const { return false; }
+
+    template<typename T>
+    T to() {
+        root->clear();
+        root->type = std::is_same<T, JsonArray>::value ? SimJson::Node::Array : SimJson::Node::Object;
+        return T(root.get());
+    }
+
+    using JsonVariant::operator[];
+    using JsonVariant::operator=;
+
+private:
+    std::unique_ptr<SimJson::Node> root;
+    size_t cap;
+};
+
+template<size_t N>
+class StaticJsonDocument : public JsonDocument {
+public:
+    StaticJsonDocument() : JsonDocument(N) {}
+    using JsonDocument::operator=;
+};
+
+class DynamicJsonDocument : public JsonDocument {
+public:
+    explicit DynamicJsonDocument(size_t capacity) : JsonDocument(capacity) {}
+    using JsonDocument::operator=;
+};
+
+#define JSON_OBJECT_SIZE(n) ((n) * 16)
+#define JSON_ARRAY_SIZE(n) ((n) * 8)
+
+class DeserializationError {
+public:
+    enum Code {
+        Ok,
+        EmptyInput,
+        IncompleteInput,
+        InvalidInput,
+        NoMemory,
+        TooDeep
+    };
+
+    DeserializationError(Code code = Ok) : c(code) {}
+    explicit operator bool() const { return c != Ok; }
+    bool operator==(Code other) const { return c == other; }
+    bool operator!=(Code other) const { return c != other; }
+    Code code() const { return c; }
+    const char* c_str() const {
+        static const char* names[] = {"Ok", "EmptyInput", "IncompleteInput", "InvalidInput", "NoMemory", "TooDeep"};
+        return names[c];
+    }
+
+private:
+    Code c;
+};
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, size_t length);
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* input) {
+    return deserializeJson(doc, input, input ? strlen(input) : 0);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const String& input) {
+    return deserializeJson(doc, input.c_str(), input.length());
+}
+
+size_t serializeJson(const JsonVariant& source, String& output);
+size_t serializeJson(const JsonVariant& source, Print& output);
+size_t serializeJson(const JsonVariant& source, char* output, size_t size);
+size_t serializeJsonPretty(const JsonVariant& source, String& output);
+size_t serializeJsonPretty(const JsonVariant& source, Print& output);
+size_t measureJson(const JsonVariant& source);
+
+#endif // SIM_ARDUINOJSON_H
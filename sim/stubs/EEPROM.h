@@ -0,0 +1,59 @@
+#ifndef SIM_EEPROM_H
+#define SIM_EEPROM_H
+
+#include <Arduino.h>
+
+#define SIM_EEPROM_MAX_SIZE 4096
+
+// Emulasi EEPROM ESP8266: buffer RAM yang di-commit ke sektor flash virtual
+class EEPROMClass {
+public:
+    void begin(size_t size);
+    bool commit();
+    bool end();
+
+    uint8_t read(int address) const {
+        return (address >= 0 && (size_t)address < size) ? data[address] : 0;
+    }
+
+    void write(int address, uint8_t value) {
+        if (address < 0 || (size_t)address >= size) return;
+        if (data[address] != value) dirty = true;
+        data[address] = value;
+    }
+
+    template<typename T>
+    T& get(int address, T& value) {
+        if (address >= 0 && address + sizeof(T) <= size) {
+            memcpy(&value, data + address, sizeof(T));
+        }
+        return value;
+    }
+
+    template<typename T>
+    const T& put(int address, const T& value) {
+        if (address >= 0 && address + sizeof(T) <= size) {
+            if (memcmp(data + address, &value, sizeof(T)) != 0) dirty = true;
+            memcpy(data + address, &value, sizeof(T));
+        }
+        return value;
+    }
+
+    uint8_t* getDataPtr() { dirty = true; return data; }
+    const uint8_t* getConstDataPtr() const { return data; }
+    size_t length() const { return size; }
+
+    // Hook simulasi
+    void simErase();
+    uint32_t commitCount = 0;
+
+private:
+    uint8_t data[SIM_EEPROM_MAX_SIZE];
+    uint8_t flash[SIM_EEPROM_MAX_SIZE];
+    size_t size = 0;
+    bool dirty = false;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // SIM_EEPROM_H
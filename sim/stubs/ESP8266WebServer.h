@@ -0,0 +1,160 @@
+#ifndef SIM_ESP8266WEBSERVER_H
+#define SIM_ESP8266WEBSERVER_H
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <FS.h>
+#include <deque>
+#include <vector>
+
+enum HTTPMethod {
+    HTTP_ANY,
+    HTTP_GET,
+    HTTP_HEAD,
+    HTTP_POST,
+    HTTP_PUT,
+    HTTP_PATCH,
+    HTTP_DELETE,
+    HTTP_OPTIONS
+};
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t) -1)
+#define CONTENT_LENGTH_NOT_SET ((size_t) -2)
+
+// Upload multipart: handler upload dipanggil per potongan HTTP_UPLOAD_BUFLEN seperti core ESP8266
+#define HTTP_UPLOAD_BUFLEN 2048
+
+enum HTTPUploadStatus {
+    UPLOAD_FILE_START,
+    UPLOAD_FILE_WRITE,
+    UPLOAD_FILE_END,
+    UPLOAD_FILE_ABORTED
+};
+
+struct HTTPUpload {
+    HTTPUploadStatus status;
+    String filename;
+    String name;
+    String type;
+    size_t totalSize;
+    size_t currentSize;
+    size_t contentLength;
+    uint8_t buf[HTTP_UPLOAD_BUFLEN];
+};
+
+// Request yang disuntikkan harness simulasi
+struct SimHttpRequest {
+    HTTPMethod method;
+    String uri;
+    String body;
+    std::vector<std::pair<String, String>> args;
+    std::vector<std::pair<String, String>> headers;
+    bool isUpload = false;              // body dikirim sebagai file multipart
+    size_t abortAfter = 0;              // > 0: klien putus setelah sekian byte upload
+};
+
+// Response yang ditangkap dari handler
+struct SimHttpResponse {
+    int code = 0;
+    String contentType;
+    String body;
+    std::vector<std::pair<String, String>> headers;
+};
+
+class ESP8266WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    explicit ESP8266WebServer(int port = 80) : port(port) {}
+
+    void begin() { running = true; }
+    void close() { running = false; }
+    void stop() { close(); }
+
+    void on(const String& uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+    void on(const String& uri, HTTPMethod method, THandlerFunction handler) {
+        routes.push_back({uri, method, handler, nullptr});
+    }
+    void on(const String& uri, HTTPMethod method, THandlerFunction handler, THandlerFunction uploadHandler) {
+        routes.push_back({uri, method, handler, uploadHandler});
+    }
+    void onNotFound(THandlerFunction handler) { notFoundHandler = handler; }
+
+    void handleClient();
+
+    // Request accessors
+    String uri() const { return current.uri; }
+    HTTPUpload& upload() { return currentUpload; }
+    HTTPMethod method() const { return current.method; }
+    int args() const { return (int)current.args.size(); }
+    String arg(int index) const { return index < args() ? current.args[index].second : String(); }
+    String argName(int index) const { return index < args() ? current.args[index].first : String(); }
+    String arg(const String& name) const;
+    bool hasArg(const String& name) const;
+    String header(const String& name) const;
+    bool hasHeader(const String& name) const;
+    void collectHeaders(const char* headerKeys[], const size_t count) { (void)headerKeys; (void)count; }
+
+    // Response
+    void send(int code, const char* contentType = nullptr, const String& content = String());
+    void send(int code, const String& contentType, const String& content) { send(code, contentType.c_str(), content); }
+    void send(int code, const char* contentType, const char* content) { send(code, contentType, String(content)); }
+    void send_P(int code, const char* contentType, const char* content) { send(code, contentType, String(content)); }
+    void send_P(int code, const char* contentType, const char* content, size_t length) {
+        send(code, contentType, String(std::string(content, length)));
+    }
+    void sendHeader(const String& name, const String& value, bool first = false);
+    void setContentLength(size_t length) { contentLength = length; }
+    void sendContent(const String& content) { response.body += content; }
+    void sendContent(const char* content, size_t length) { response.body.concat(content, length); }
+
+    template<typename T>
+    size_t streamFile(T& file, const String& contentType) {
+        uint8_t buffer[256];
+        size_t total = 0;
+        size_t n;
+        response.code = 200;
+        response.contentType = contentType;
+        // Seperti core ESP8266: file .gz dikirim apa adanya dengan Content-Encoding
+        String name = file.name();
+        if (name.endsWith(".gz") && contentType != "application/x-gzip" && contentType != "application/octet-stream") {
+            sendHeader("Content-Encoding", "gzip");
+        }
+        while ((n = file.read(buffer, sizeof(buffer))) > 0) {
+            response.body.concat((const char*)buffer, n);
+            total += n;
+        }
+        responded = true;
+        return total;
+    }
+
+    // Hook simulasi
+    void simQueueRequest(const SimHttpRequest& request) { pending.push_back(request); }
+    size_t simPendingRequests() const { return pending.size(); }
+    const SimHttpResponse& simLastResponse() const { return response; }
+    void simSetResponseHook(std::function<void(const SimHttpRequest&, const SimHttpResponse&)> hook) {
+        responseHook = hook;
+    }
+
+private:
+    struct Route {
+        String uri;
+        HTTPMethod method;
+        THandlerFunction handler;
+        THandlerFunction uploadHandler;
+    };
+
+    int port;
+    bool running = false;
+    std::vector<Route> routes;
+    THandlerFunction notFoundHandler;
+    std::deque<SimHttpRequest> pending;
+    SimHttpRequest current;
+    HTTPUpload currentUpload;
+    SimHttpResponse response;
+    std::function<void(const SimHttpRequest&, const SimHttpResponse&)> responseHook;
+    size_t contentLength = CONTENT_LENGTH_NOT_SET;
+    bool responded = false;
+};
+
+#endif // SIM_ESP8266WEBSERVER_H
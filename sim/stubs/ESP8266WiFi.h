@@ -0,0 +1,53 @@
+#ifndef SIM_ESP8266WIFI_H
+#define SIM_ESP8266WIFI_H
+
+#include <Arduino.h>
+
+class IPAddress : public Printable {
+public:
+    IPAddress() : IPAddress(0, 0, 0, 0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+        octets[0] = a; octets[1] = b; octets[2] = c; octets[3] = d;
+    }
+    uint8_t operator[](int index) const { return octets[index]; }
+    String toString() const {
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+        return String(buffer);
+    }
+    size_t printTo(Print& p) const override { return p.print(toString()); }
+    bool operator==(const IPAddress& other) const { return memcmp(octets, other.octets, 4) == 0; }
+
+private:
+    uint8_t octets[4];
+};
+
+typedef enum {
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} WiFiMode_t;
+
+class ESP8266WiFiClass {
+public:
+    bool mode(WiFiMode_t m) { currentMode = m; return true; }
+    bool softAP(const char* ssid, const char* passphrase = nullptr) {
+        (void)ssid; (void)passphrase;
+        return true;
+    }
+    bool begin(const char* ssid, const char* passphrase = nullptr) {
+        (void)ssid; (void)passphrase;
+        return true;
+    }
+    IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+    IPAddress softAPBroadcastIP() { return IPAddress(192, 168, 4, 255); }
+    uint8_t softAPgetStationNum() { return 0; }
+
+private:
+    WiFiMode_t currentMode = WIFI_OFF;
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif // SIM_ESP8266WIFI_H
@@ -0,0 +1,93 @@
+#ifndef SIM_FS_H
+#define SIM_FS_H
+
+#include <Arduino.h>
+#include <memory>
+
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+// File SPIFFS yang dipetakan ke file di direktori host
+class File : public Print {
+public:
+    File() {}
+    File(FILE* handle, const String& path) : handle(handle, fclose), path(path) {}
+
+    explicit operator bool() const { return (bool)handle; }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override {
+        return handle ? fwrite(buffer, 1, size, handle.get()) : 0;
+    }
+    int read() {
+        if (!handle) return -1;
+        int c = fgetc(handle.get());
+        return c == EOF ? -1 : c;
+    }
+    size_t read(uint8_t* buffer, size_t size) {
+        return handle ? fread(buffer, 1, size, handle.get()) : 0;
+    }
+    size_t readBytes(char* buffer, size_t size) { return read((uint8_t*)buffer, size); }
+    int peek() {
+        if (!handle) return -1;
+        int c = fgetc(handle.get());
+        if (c != EOF) ungetc(c, handle.get());
+        return c == EOF ? -1 : c;
+    }
+    int available() {
+        if (!handle) return 0;
+        long position = ftell(handle.get());
+        return (int)(size() - position);
+    }
+    bool seek(uint32_t pos, SeekMode mode = SeekSet) {
+        return handle && fseek(handle.get(), pos, mode == SeekSet ? SEEK_SET : (mode == SeekCur ? SEEK_CUR : SEEK_END)) == 0;
+    }
+    size_t position() const { return handle ? ftell(handle.get()) : 0; }
+    size_t size() const {
+        if (!handle) return 0;
+        long position = ftell(handle.get());
+        fseek(handle.get(), 0, SEEK_END);
+        long end = ftell(handle.get());
+        fseek(handle.get(), position, SEEK_SET);
+        return end;
+    }
+    void flush() override { if (handle) fflush(handle.get()); }
+    void close() { handle.reset(); }
+    const char* name() const { return path.c_str(); }
+
+private:
+    std::shared_ptr<FILE> handle;
+    String path;
+};
+
+// Kapasitas partisi SPIFFS; pemakaian tidak dimodelkan di simulasi (selalu 0)
+struct FSInfo {
+    size_t totalBytes;
+    size_t usedBytes;
+    size_t blockSize;
+    size_t pageSize;
+    size_t maxOpenFiles;
+    size_t maxPathLength;
+};
+
+class FS {
+public:
+    bool begin();
+    void end() {}
+    bool format();
+    bool exists(const char* path);
+    bool exists(const String& path) { return exists(path.c_str()); }
+    File open(const char* path, const char* mode);
+    File open(const String& path, const char* mode) { return open(path.c_str(), mode); }
+    bool remove(const char* path);
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* from, const char* to);
+    bool info(FSInfo& info);
+};
+
+extern FS SPIFFS;
+
+#endif // SIM_FS_H
@@ -0,0 +1,124 @@
+#ifndef SIM_LEDCONTROL_H
+#define SIM_LEDCONTROL_H
+
+#include <Arduino.h>
+
+// Register MAX7219 (sama dengan library LedControl)
+#define OP_NOOP 0
+#define OP_DIGIT0 1
+#define OP_DIGIT1 2
+#define OP_DIGIT2 3
+#define OP_DIGIT3 4
+#define OP_DIGIT4 5
+#define OP_DIGIT5 6
+#define OP_DIGIT6 7
+#define OP_DIGIT7 8
+#define OP_DECODEMODE 9
+#define OP_INTENSITY 10
+#define OP_SCANLIMIT 11
+#define OP_SHUTDOWN 12
+#define OP_DISPLAYTEST 15
+
+// Port LedControl: protokol bit-bang yang sama, sehingga setiap setRow
+// tetap men-shift seluruh chain dan terlihat di virtual chain simulator
+class LedControl {
+public:
+    LedControl(int dataPin, int clkPin, int csPin, int numDevices = 1) {
+        SPI_MOSI = dataPin;
+        SPI_CLK = clkPin;
+        SPI_CS = csPin;
+        maxDevices = (numDevices <= 0 || numDevices > 8) ? 8 : numDevices;
+        pinMode(SPI_MOSI, OUTPUT);
+        pinMode(SPI_CLK, OUTPUT);
+        pinMode(SPI_CS, OUTPUT);
+        digitalWrite(SPI_CS, HIGH);
+        memset(status, 0, sizeof(status));
+        for (int i = 0; i < maxDevices; i++) {
+            spiTransfer(i, OP_DISPLAYTEST, 0);
+            setScanLimit(i, 7);
+            spiTransfer(i, OP_DECODEMODE, 0);
+            clearDisplay(i);
+            shutdown(i, true);
+        }
+    }
+
+    int getDeviceCount() { return maxDevices; }
+
+    void shutdown(int addr, bool status) {
+        if (addr < 0 || addr >= maxDevices) return;
+        spiTransfer(addr, OP_SHUTDOWN, status ? 0 : 1);
+    }
+
+    void setScanLimit(int addr, int limit) {
+        if (addr < 0 || addr >= maxDevices) return;
+        if (limit >= 0 && limit < 8) spiTransfer(addr, OP_SCANLIMIT, limit);
+    }
+
+    void setIntensity(int addr, int intensity) {
+        if (addr < 0 || addr >= maxDevices) return;
+        if (intensity >= 0 && intensity < 16) spiTransfer(addr, OP_INTENSITY, intensity);
+    }
+
+    void clearDisplay(int addr) {
+        if (addr < 0 || addr >= maxDevices) return;
+        int offset = addr * 8;
+        for (int i = 0; i < 8; i++) {
+            status[offset + i] = 0;
+            spiTransfer(addr, i + 1, status[offset + i]);
+        }
+    }
+
+    void setLed(int addr, int row, int column, boolean state) {
+        if (addr < 0 || addr >= maxDevices) return;
+        if (row < 0 || row > 7 || column < 0 || column > 7) return;
+        int offset = addr * 8;
+        byte val = B10000000 >> column;
+        if (state) {
+            status[offset + row] |= val;
+        } else {
+            status[offset + row] &= ~val;
+        }
+        spiTransfer(addr, row + 1, status[offset + row]);
+    }
+
+    void setRow(int addr, int row, byte value) {
+        if (addr < 0 || addr >= maxDevices) return;
+        if (row < 0 || row > 7) return;
+        int offset = addr * 8;
+        status[offset + row] = value;
+        spiTransfer(addr, row + 1, status[offset + row]);
+    }
+
+    void setColumn(int addr, int col, byte value) {
+        if (addr < 0 || addr >= maxDevices) return;
+        if (col < 0 || col > 7) return;
+        for (int row = 0; row < 8; row++) {
+            byte val = value >> (7 - row);
+            val = val & 0x01;
+            setLed(addr, row, col, val);
+        }
+    }
+
+private:
+    void spiTransfer(int addr, volatile byte opcode, volatile byte data) {
+        int offset = addr * 2;
+        int maxbytes = maxDevices * 2;
+        memset(spidata, 0, sizeof(spidata));
+        spidata[offset + 1] = opcode;
+        spidata[offset] = data;
+        digitalWrite(SPI_CS, LOW);
+        for (int i = maxbytes; i > 0; i--) {
+            shiftOut(SPI_MOSI, SPI_CLK, MSBFIRST, spidata[i - 1]);
+        }
+        digitalWrite(SPI_CS, HIGH);
+    }
+
+    byte spidata[16];
+    byte status[64];
+    int SPI_MOSI;
+    int SPI_CLK;
+    int SPI_CS;
+    int maxDevices;
+};
+
+#endif // SIM_LEDCONTROL_H
@@ -0,0 +1,8 @@
+#ifndef SIM_MAXMATRIX_H
+#define SIM_MAXMATRIX_H
+
+#include <Arduino.h>
+
+// Di-include oleh sketch tetapi tidak dipakai; cukup header kosong
+
+#endif // SIM_MAXMATRIX_H
@@ -0,0 +1,80 @@
+#ifndef SIM_PRINT_H
+#define SIM_PRINT_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+class Printable;
+
+// Subset Print Arduino; turunan cukup mengimplementasikan write(uint8_t)
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (size--) n += write(*buffer++);
+        return n;
+    }
+    size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+    virtual void flush() {}
+
+    size_t print(const char* s) { return write(s); }
+    size_t print(const String& s) { return write(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v, int base = DEC) { return print((long)v, base); }
+    size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(long v, int base = DEC) {
+        if (base != DEC) return print((unsigned long)v, base);
+        return printf("%ld", v);
+    }
+    size_t print(unsigned long v, int base = DEC) {
+        if (base == HEX) return printf("%lX", v);
+        if (base == BIN) {
+            char bits[65];
+            int n = 0;
+            do { bits[n++] = '0' + (v & 1); v >>= 1; } while (v);
+            size_t written = 0;
+            while (n--) written += write((uint8_t)bits[n]);
+            return written;
+        }
+        return printf("%lu", v);
+    }
+    size_t print(double v, int digits = 2) { return printf("%.*f", digits, v); }
+    size_t print(const Printable& p);
+
+    template<typename T>
+    size_t println(const T& v) { size_t n = print(v); return n + println(); }
+    template<typename T>
+    size_t println(const T& v, int format) { size_t n = print(v, format); return n + println(); }
+    size_t println() { return write("\r\n"); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        char buffer[512];
+        va_list args;
+        va_start(args, format);
+        int len = vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        if (len < 0) return 0;
+        if ((size_t)len >= sizeof(buffer)) len = sizeof(buffer) - 1;
+        return write((const uint8_t*)buffer, len);
+    }
+};
+
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print& p) const = 0;
+};
+
+inline size_t Print::print(const Printable& p) { return p.printTo(*this); }
+
+#endif // SIM_PRINT_H
@@ -0,0 +1,8 @@
+#ifndef SIM_SPI_H
+#define SIM_SPI_H
+
+#include <Arduino.h>
+
+// SPI hardware tidak dipakai: MAX7219 di-drive lewat shiftOut
+
+#endif // SIM_SPI_H
@@ -0,0 +1,89 @@
+#ifndef SIM_WSTRING_H
+#define SIM_WSTRING_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+
+// Subset String Arduino di atas std::string
+class String {
+public:
+    String() {}
+    String(const char* s) : value(s ? s : "") {}
+    String(const std::string& s) : value(s) {}
+    String(char c) : value(1, c) {}
+    String(int v) : value(std::to_string(v)) {}
+    String(unsigned int v) : value(std::to_string(v)) {}
+    String(long v) : value(std::to_string(v)) {}
+    String(unsigned long v) : value(std::to_string(v)) {}
+    String(float v, unsigned int decimals = 2) { fromDouble(v, decimals); }
+    String(double v, unsigned int decimals = 2) { fromDouble(v, decimals); }
+
+    const char* c_str() const { return value.c_str(); }
+    unsigned int length() const { return value.length(); }
+    bool isEmpty() const { return value.empty(); }
+    bool reserve(unsigned int size) { value.reserve(size); return true; }
+    char charAt(unsigned int index) const { return index < value.length() ? value[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    int indexOf(char c, unsigned int from = 0) const {
+        size_t pos = value.find(c, from);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    int indexOf(const String& s, unsigned int from = 0) const {
+        size_t pos = value.find(s.value, from);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    String substring(unsigned int from) const { return from < value.length() ? String(value.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from >= value.length() || to <= from) return String();
+        return String(value.substr(from, to - from));
+    }
+    bool startsWith(const String& prefix) const { return value.compare(0, prefix.value.length(), prefix.value) == 0; }
+    bool endsWith(const String& suffix) const {
+        return value.length() >= suffix.value.length() &&
+               value.compare(value.length() - suffix.value.length(), suffix.value.length(), suffix.value) == 0;
+    }
+    long toInt() const { return strtol(value.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(value.c_str(), nullptr); }
+    void toLowerCase() { for (auto& c : value) c = tolower(c); }
+    void toUpperCase() { for (auto& c : value) c = toupper(c); }
+    void trim() {
+        size_t start = value.find_first_not_of(" \t\r\n");
+        size_t end = value.find_last_not_of(" \t\r\n");
+        value = (start == std::string::npos) ? std::string() : value.substr(start, end - start + 1);
+    }
+
+    String& operator+=(const String& s) { value += s.value; return *this; }
+    String& operator+=(const char* s) { if (s) value += s; return *this; }
+    String& operator+=(char c) { value += c; return *this; }
+    String& operator+=(int v) { value += std::to_string(v); return *this; }
+    String& operator+=(unsigned int v) { value += std::to_string(v); return *this; }
+    String& operator+=(long v) { value += std::to_string(v); return *this; }
+    String& operator+=(unsigned long v) { value += std::to_string(v); return *this; }
+    bool concat(const String& s) { value += s.value; return true; }
+    bool concat(const char* s, unsigned int length) { value.append(s, length); return true; }
+
+    bool operator==(const String& s) const { return value == s.value; }
+    bool operator==(const char* s) const { return value == (s ? s : ""); }
+    bool operator!=(const String& s) const { return value != s.value; }
+    bool operator!=(const char* s) const { return !(*this == s); }
+    bool equals(const String& s) const { return value == s.value; }
+
+    friend String operator+(const String& a, const String& b) { return String(a.value + b.value); }
+    friend String operator+(const String& a, const char* b) { return String(a.value + (b ? b : "")); }
+    friend String operator+(const char* a, const String& b) { return String(std::string(a ? a : "") + b.value); }
+    friend String operator+(const String& a, char b) { return String(a.value + b); }
+
+    const std::string& str() const { return value; }
+
+private:
+    void fromDouble(double v, unsigned int decimals) {
+        char buffer[48];
+        snprintf(buffer, sizeof(buffer), "%.*f", (int)decimals, v);
+        value = buffer;
+    }
+
+    std::string value;
+};
+
+#endif // SIM_WSTRING_H
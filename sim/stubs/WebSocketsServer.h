@@ -0,0 +1,98 @@
+#ifndef SIM_WEBSOCKETSSERVER_H
+#define SIM_WEBSOCKETSSERVER_H
+
+// Subset API arduinoWebSockets (Links2004) yang dipakai livestream.cpp.
+// Event klien disuntikkan harness lewat simConnect/simReceiveText/simDisconnect dan
+// dikirim ke callback dari loop(), sama seperti library aslinya.
+#include <Arduino.h>
+#include <deque>
+#include <functional>
+#include <string>
+
+#define WEBSOCKETS_SERVER_CLIENT_MAX 5
+
+typedef enum {
+    WStype_ERROR,
+    WStype_DISCONNECTED,
+    WStype_CONNECTED,
+    WStype_TEXT,
+    WStype_BIN
+} WStype_t;
+
+class WebSocketsServer {
+public:
+    typedef std::function<void(uint8_t num, WStype_t type, uint8_t* payload, size_t length)> WebSocketServerEvent;
+    typedef std::function<void(uint8_t num, WStype_t type, const uint8_t* payload, size_t length)> SimSendHook;
+
+    explicit WebSocketsServer(uint16_t port) : port(port) { instance() = this; }
+
+    void begin() { running = true; }
+    void close() { running = false; connected = 0; }
+    void onEvent(WebSocketServerEvent callback) { eventCallback = callback; }
+
+    void loop() {
+        while (running && !incoming.empty()) {
+            SimIncoming event = incoming.front();
+            incoming.pop_front();
+            if (event.num >= WEBSOCKETS_SERVER_CLIENT_MAX) continue;
+            if (event.type == WStype_CONNECTED) connected |= 1 << event.num;
+            else if (event.type == WStype_DISCONNECTED) connected &= ~(1 << event.num);
+            else if (!(connected & (1 << event.num))) continue;
+            if (eventCallback) {
+                eventCallback(event.num, event.type, (uint8_t*)event.payload.data(), event.payload.size());
+            }
+        }
+    }
+
+    bool sendTXT(uint8_t num, const char* payload) { return send(num, WStype_TEXT, (const uint8_t*)payload, strlen(payload)); }
+    bool sendTXT(uint8_t num, const String& payload) { return sendTXT(num, payload.c_str()); }
+    bool broadcastTXT(const char* payload) { return broadcast(WStype_TEXT, (const uint8_t*)payload, strlen(payload)); }
+    bool broadcastTXT(const String& payload) { return broadcastTXT(payload.c_str()); }
+    bool sendBIN(uint8_t num, const uint8_t* payload, size_t length) { return send(num, WStype_BIN, payload, length); }
+    bool broadcastBIN(const uint8_t* payload, size_t length) { return broadcast(WStype_BIN, payload, length); }
+
+    uint8_t connectedClients() {
+        uint8_t count = 0;
+        for (uint8_t mask = connected; mask; mask &= mask - 1) count++;
+        return count;
+    }
+
+    // Hook simulasi
+    static WebSocketsServer*& instance() {
+        static WebSocketsServer* server = nullptr;
+        return server;
+    }
+    void simConnect(uint8_t num) { incoming.push_back({num, WStype_CONNECTED, std::string()}); }
+    void simDisconnect(uint8_t num) { incoming.push_back({num, WStype_DISCONNECTED, std::string()}); }
+    void simReceiveText(uint8_t num, const std::string& text) { incoming.push_back({num, WStype_TEXT, text}); }
+    void simSetSendHook(SimSendHook hook) { sendHook = hook; }
+
+private:
+    struct SimIncoming {
+        uint8_t num;
+        WStype_t type;
+        std::string payload;
+    };
+
+    bool send(uint8_t num, WStype_t type, const uint8_t* payload, size_t length) {
+        if (num >= WEBSOCKETS_SERVER_CLIENT_MAX || !(connected & (1 << num))) return false;
+        if (sendHook) sendHook(num, type, payload, length);
+        return true;
+    }
+
+    bool broadcast(WStype_t type, const uint8_t* payload, size_t length) {
+        for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) {
+            if (connected & (1 << num)) send(num, type, payload, length);
+        }
+        return connected != 0;
+    }
+
+    uint16_t port;
+    bool running = false;
+    uint8_t connected = 0;
+    WebSocketServerEvent eventCallback;
+    SimSendHook sendHook;
+    std::deque<SimIncoming> incoming;
+};
+
+#endif // SIM_WEBSOCKETSSERVER_H
@@ -0,0 +1,40 @@
+#ifndef SIM_WIFIUDP_H
+#define SIM_WIFIUDP_H
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <string>
+
+// UDP di host: tanpa simUdpEnable() socket tidak dibuka (kirim = dibuang, tidak ada paket
+// masuk), jadi run biasa tidak saling mengganggu. Dengan simUdpEnable() semua kiriman
+// broadcast ke 127.255.255.255:port, jadi beberapa proses sim di satu host saling terima.
+class WiFiUDP : public Print {
+public:
+    uint8_t begin(uint16_t port);
+    void stop();
+
+    int beginPacket(IPAddress ip, uint16_t port);
+    int endPacket();
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+
+    int parsePacket();
+    int available();
+    int read();
+    int read(uint8_t* buffer, size_t length);
+    IPAddress remoteIP() const { return remote; }
+    uint16_t remotePort() const { return remotePortNumber; }
+
+private:
+    int socketFd = -1;
+    bool opened = false;
+    uint16_t localPort = 0;
+    uint16_t sendPort = 0;
+    std::string txBuffer;
+    std::string rxBuffer;
+    size_t rxPos = 0;
+    IPAddress remote;
+    uint16_t remotePortNumber = 0;
+};
+
+#endif // SIM_WIFIUDP_H
@@ -0,0 +1,350 @@
+// Beberapa unit sketch (proses anak) di satu host, disinkronkan lewat unitsync.h di atas
+// UDP broadcast loopback. Jam virtual setiap unit berjalan mengikuti jam dinding (1 ms per
+// iterasi loop()) dengan waktu boot dan drift berbeda; trace diumpankan hanya ke pin yang
+// di-wiring ke unit itu, dengan keterlambatan berbeda per unit.
+//
+// Yang diukur per unit terhadap unit 0, dalam waktu dinding bersama:
+//   - priority: kapan rem/sein mulai dan selesai tampil (onset rem bersama)
+//   - sein: setiap kali modul tepi sisi sein aktif menyala/padam (fase kedip)
+//   - clock_error: offset unitsync dibanding selisih jam virtual yang sebenarnya
+#include <Arduino.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "settings.h"
+#include "unitsync.h"
+#include "sim_core.h"
+#include "sim_arduino.h"
+#include "sim_sketch.h"
+
+// Sync Test Constants
+#define SYNC_DEFAULT_TRACE "traces/sync.trace"
+#define SYNC_DEFAULT_WIRING "BRAKE+SEIN_LEFT;BRAKE+SEIN_RIGHT;BRAKE"
+#define SYNC_DEFAULT_DURATION_MS 10500
+#define SYNC_MAX_UNITS (UNITSYNC_MAX_PEERS + 1)
+#define SYNC_FS_ROOT "build/sync_fs"
+#define SYNC_START_DELAY_MS 500         // Waktu setup() semua unit sebelum start bersama
+#define SYNC_BOOT_SPACING_US 3700123    // Unit dinyalakan berselang (jam virtual berbeda)
+#define SYNC_MATCH_WINDOW_MS 250        // Pasangan event antar unit paling jauh sejauh ini
+#define SYNC_CHIP_ID_BASE 0x00B0D100
+
+typedef std::chrono::steady_clock Clock;
+
+typedef struct {
+    std::string wiring;
+    std::vector<uint8_t> pins;
+    uint32_t inputDelayMs;
+    int32_t driftPpm;
+} UnitConfig;
+
+// Event tampilan, tick = ms jam dinding sejak start bersama
+typedef struct {
+    uint32_t tick;
+    char kind;                  // 'P' priority, 'L'/'R' modul tepi sein kiri/kanan
+    uint8_t value;
+} UnitEvent;
+
+typedef struct {
+    std::vector<UnitEvent> events;
+    uint64_t endMicros;         // Jam virtual di tick terakhir
+    int32_t offset;
+    uint32_t masterId;
+    uint32_t maxLatency;
+    uint32_t received;
+    bool ok;
+} UnitResult;
+
+typedef struct {
+    uint32_t total;
+    uint32_t matched;
+    uint32_t maxSkew;
+    double sumSkew;
+} MatchResult;
+
+static bool moduleLit(uint8_t device) {
+    const SimMax7219* module = simChainDevice(device);
+    for (uint8_t row = 0; row < 8; row++) {
+        if (module->digits[row]) return true;
+    }
+    return false;
+}
+
+// ===== Unit (proses anak) =====
+
+static void runUnit(uint8_t index, const UnitConfig& config, const std::vector<SimTraceEvent>& trace,
+                    uint32_t durationMs, bool sync, uint8_t lossPercent, int seinMode, int brakeMode,
+                    Clock::time_point start, int out) {
+    mkdir(SYNC_FS_ROOT, 0755);
+    simSetFsRoot(SYNC_FS_ROOT);
+    simSetChipId(SYNC_CHIP_ID_BASE + index);
+    if (sync) simUdpEnable(lossPercent);
+    simPinsReset();
+    simClockReset((uint64_t)(index + 1) * SYNC_BOOT_SPACING_US);
+    simEepromErase();
+    simTraceClear();
+    simSketchSetup();
+    simSketchSetModes(-1, seinMode, brakeMode);
+
+    std::this_thread::sleep_until(start);
+    uint64_t baseMicros = simNowMicros();
+    uint8_t devices = simChainDeviceCount();
+    uint32_t lastFrame = simChainFrameVersion();
+    uint8_t lastPriority = simSketchPriority();
+    int8_t lastLit[2] = { -1, -1 };
+    size_t nextEvent = 0;
+    std::vector<UnitEvent> events;
+
+    for (uint32_t tick = 0; tick < durationMs; tick++) {
+        while (nextEvent < trace.size() && trace[nextEvent].timeMs + config.inputDelayMs <= tick) {
+            const SimTraceEvent& event = trace[nextEvent++];
+            for (uint8_t pin : config.pins) {
+                if (pin == event.pin) simSetInput(event.pin, event.level);
+            }
+        }
+
+        simSketchLoop();
+
+        if (simChainFrameVersion() != lastFrame) {
+            lastFrame = simChainFrameVersion();
+            uint8_t priority = simSketchPriority();
+            if (priority != lastPriority) {
+                events.push_back({ tick, 'P', priority });
+                lastPriority = priority;
+            }
+            // Sisi tanpa sein menampilkan rem/idle, tidak ikut diukur
+            char direction = simSketchSeinDirection();
+            bool active[2] = { direction == 'L' || direction == 'H', direction == 'R' || direction == 'H' };
+            for (uint8_t side = 0; side < 2; side++) {
+                int8_t lit = active[side] ? moduleLit(side == 0 ? 0 : devices - 1) : -1;
+                if (lit >= 0 && lit != lastLit[side]) {
+                    events.push_back({ tick, side == 0 ? 'L' : 'R', (uint8_t)lit });
+                }
+                lastLit[side] = lit;
+            }
+        }
+
+        // Jam virtual maju 1 ms +- drift per ms jam dinding
+        uint64_t target = baseMicros + (uint64_t)(tick + 1) * 1000 +
+                          (int64_t)(tick + 1) * config.driftPpm / 1000;
+        simAdvanceMicros(target - simNowMicros());
+        std::this_thread::sleep_until(start + std::chrono::milliseconds(tick + 1));
+    }
+
+    FILE* pipe = fdopen(out, "w");
+    const UnitSyncStats* stats = unitsyncGetStats();
+    fprintf(pipe, "T %llu %d %u %u %u\n", (unsigned long long)simNowMicros(), stats->offset,
+            stats->masterId, stats->maxLatency, stats->received);
+    for (const UnitEvent& event : events) {
+        fprintf(pipe, "%c %u %u\n", event.kind, event.tick, event.value);
+    }
+    fclose(pipe);
+    _exit(0);
+}
+
+static bool readResult(int in, UnitResult& result) {
+    FILE* pipe = fdopen(in, "r");
+    result = UnitResult();
+    char kind;
+    while (fscanf(pipe, " %c", &kind) == 1) {
+        if (kind == 'T') {
+            unsigned long long endMicros;
+            if (fscanf(pipe, "%llu %d %u %u %u", &endMicros, &result.offset, &result.masterId,
+                       &result.maxLatency, &result.received) != 5) break;
+            result.endMicros = endMicros;
+            result.ok = true;
+        } else {
+            unsigned tick;
+            unsigned value;
+            if (fscanf(pipe, "%u %u", &tick, &value) != 2) break;
+            result.events.push_back({ tick, kind, (uint8_t)value });
+        }
+    }
+    fclose(pipe);
+    return result.ok;
+}
+
+// ===== Analisis =====
+
+// Setiap event referensi dipasangkan dengan event sejenis terdekat di unit lain
+static MatchResult matchEvents(const UnitResult& reference, const UnitResult& unit, bool sein) {
+    MatchResult match = {};
+    for (const UnitEvent& event : reference.events) {
+        if ((event.kind != 'P') != sein) continue;
+        match.total++;
+
+        uint32_t best = UINT32_MAX;
+        for (const UnitEvent& other : unit.events) {
+            if (other.kind != event.kind || other.value != event.value) continue;
+            uint32_t skew = other.tick > event.tick ? other.tick - event.tick : event.tick - other.tick;
+            if (skew < best) best = skew;
+        }
+        if (best > SYNC_MATCH_WINDOW_MS) continue;
+        match.matched++;
+        match.sumSkew += best;
+        if (best > match.maxSkew) match.maxSkew = best;
+    }
+    return match;
+}
+
+static std::vector<uint8_t> parsePins(const std::string& spec) {
+    std::vector<uint8_t> pins;
+    size_t begin = 0;
+    while (begin <= spec.size()) {
+        size_t end = spec.find('+', begin);
+        if (end == std::string::npos) end = spec.size();
+        std::string name = spec.substr(begin, end - begin);
+        int pin = simPinByName(name.c_str());
+        if (pin < 0) return std::vector<uint8_t>();
+        pins.push_back(pin);
+        begin = end + 1;
+    }
+    return pins;
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --trace FILE       input trace, ms since the common start (default %s)\n"
+        "  --wiring SPEC      pins per unit, units separated by ';', pins by '+' (default \"%s\")\n"
+        "  --duration MS      wall-clock time to run (default %d)\n"
+        "  --input-delay MS   unit i sees every edge i*MS late (default 6)\n"
+        "  --drift PPM        unit clocks spread by PPM around unit 1 (default 400)\n"
+        "  --loss PERCENT     drop incoming sync packets at random (default 0)\n"
+        "  --sein-mode N      seinSettings.mode for every unit (default BASIC)\n"
+        "  --brake-mode N     brakeSettings.mode for every unit (default FULL)\n"
+        "  --no-sync          units free-run on their own inputs (baseline)\n",
+        argv0, SYNC_DEFAULT_TRACE, SYNC_DEFAULT_WIRING, SYNC_DEFAULT_DURATION_MS);
+}
+
+int main(int argc, char** argv) {
+    const char* tracePath = SYNC_DEFAULT_TRACE;
+    std::string wiring = SYNC_DEFAULT_WIRING;
+    uint32_t durationMs = SYNC_DEFAULT_DURATION_MS;
+    uint32_t inputDelayMs = 6;
+    int32_t driftPpm = 400;
+    uint8_t lossPercent = 0;
+    int seinMode = SEIN_MODE_BASIC;
+    int brakeMode = BRAKE_MODE_FULL;
+    bool sync = true;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--trace" && hasValue) tracePath = argv[++i];
+        else if (arg == "--wiring" && hasValue) wiring = argv[++i];
+        else if (arg == "--duration" && hasValue) durationMs = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--input-delay" && hasValue) inputDelayMs = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--drift" && hasValue) driftPpm = atoi(argv[++i]);
+        else if (arg == "--loss" && hasValue) lossPercent = min(strtoul(argv[++i], nullptr, 10), 100ul);
+        else if (arg == "--sein-mode" && hasValue) seinMode = atoi(argv[++i]);
+        else if (arg == "--brake-mode" && hasValue) brakeMode = atoi(argv[++i]);
+        else if (arg == "--no-sync") sync = false;
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<UnitConfig> units;
+    size_t begin = 0;
+    while (begin <= wiring.size()) {
+        size_t end = wiring.find(';', begin);
+        if (end == std::string::npos) end = wiring.size();
+        UnitConfig unit;
+        unit.wiring = wiring.substr(begin, end - begin);
+        unit.pins = parsePins(unit.wiring);
+        if (unit.pins.empty()) {
+            fprintf(stderr, "invalid --wiring unit: %s\n", unit.wiring.c_str());
+            return 2;
+        }
+        units.push_back(unit);
+        begin = end + 1;
+    }
+    if (units.size() < 2 || units.size() > SYNC_MAX_UNITS) {
+        fprintf(stderr, "--wiring needs 2..%d units\n", SYNC_MAX_UNITS);
+        return 2;
+    }
+    for (size_t i = 0; i < units.size(); i++) {
+        units[i].inputDelayMs = i * inputDelayMs;
+        units[i].driftPpm = ((int32_t)i - 1) * driftPpm;
+    }
+
+    if (!simTraceLoad(tracePath)) {
+        fprintf(stderr, "cannot load trace %s\n", tracePath);
+        return 2;
+    }
+    std::vector<SimTraceEvent> trace;
+    for (uint16_t i = 0; i < simTraceCount(); i++) {
+        trace.push_back(*simTraceGet(i));
+    }
+    simTraceClear();
+
+    mkdir("build", 0755);
+    Clock::time_point start = Clock::now() + std::chrono::milliseconds(SYNC_START_DELAY_MS);
+    std::vector<pid_t> pids;
+    std::vector<int> pipes;
+    fflush(stdout);
+    for (size_t i = 0; i < units.size(); i++) {
+        int fds[2];
+        if (pipe(fds) < 0) return 1;
+        pid_t pid = fork();
+        if (pid < 0) return 1;
+        if (pid == 0) {
+            close(fds[0]);
+            runUnit(i, units[i], trace, durationMs, sync, lossPercent, seinMode, brakeMode, start, fds[1]);
+        }
+        close(fds[1]);
+        pids.push_back(pid);
+        pipes.push_back(fds[0]);
+    }
+
+    std::vector<UnitResult> results(units.size());
+    bool failed = false;
+    for (size_t i = 0; i < units.size(); i++) {
+        failed |= !readResult(pipes[i], results[i]);
+        int status = 0;
+        waitpid(pids[i], &status, 0);
+        failed |= !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    }
+    if (failed) {
+        fprintf(stderr, "unit process failed\n");
+        return 1;
+    }
+
+    printf("unit,id,wiring,input_delay_ms,drift_ppm,priority_matched,priority_skew_max_ms,"
+           "sein_matched,sein_skew_max_ms,sein_skew_mean_ms,offset_ms,clock_error_ms,master_id,"
+           "max_latency_ms,received\n");
+    uint32_t worstPriority = 0;
+    uint32_t worstSein = 0;
+    for (size_t i = 0; i < units.size(); i++) {
+        MatchResult priority = matchEvents(results[0], results[i], false);
+        MatchResult sein = matchEvents(results[0], results[i], true);
+        // Offset ideal = selisih jam virtual unit master (unit 0) dan unit ini saat selesai
+        int64_t trueOffset = ((int64_t)(results[0].endMicros / 1000) - (int64_t)(results[i].endMicros / 1000));
+        int64_t clockError = sync ? results[i].offset - trueOffset : 0;
+        printf("%zu,%08X,%s,%u,%d,%u/%u,%u,%u/%u,%u,%.1f,%d,%lld,%08X,%u,%u\n",
+               i, SYNC_CHIP_ID_BASE + (unsigned)i, units[i].wiring.c_str(), units[i].inputDelayMs,
+               units[i].driftPpm, priority.matched, priority.total, priority.maxSkew,
+               sein.matched, sein.total, sein.maxSkew, sein.matched ? sein.sumSkew / sein.matched : 0.0,
+               results[i].offset, (long long)clockError, results[i].masterId,
+               results[i].maxLatency, results[i].received);
+        if (priority.matched < priority.total || sein.matched < sein.total) {
+            worstPriority = worstSein = UINT32_MAX;
+        }
+        worstPriority = max(worstPriority, priority.maxSkew);
+        worstSein = max(worstSein, sein.maxSkew);
+    }
+
+    fflush(stdout);
+    if (worstPriority == UINT32_MAX) {
+        fprintf(stderr, "%s: some units never showed the reference unit's state\n", sync ? "sync" : "no sync");
+    } else {
+        fprintf(stderr, "%s: worst skew vs unit 0: priority %u ms, sein phase %u ms\n",
+                sync ? "sync" : "no sync", worstPriority, worstSein);
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "textraster.h"
+#include "settings.h"
+#include <Arduino.h>
+
+// Build Information
+#define TEXTRASTER_CPP_VERSION "1.0.0"
+#define TEXTRASTER_CPP_BUILD_DATE "2026-10-17 14:20:05"
+#define TEXTRASTER_CPP_AUTHOR "Brodot23"
+
+static const TextFont* textFont = nullptr;
+
+// Bitmap hasil raster, baris r = deretan bit kolom 0..cycleLength+lebar layar
+static uint8_t textRows[FB_ROWS][TEXT_ROW_BYTES];
+static uint16_t cycleLength = 0;    // Teks + jeda, posisi scroll berulang di sini
+static const void* textOwner = nullptr;
+
+static TextRasterStats rasterStats;
+
+// ===== IMPLEMENTASI FUNGSI RASTER =====
+
+void textrasterSetFont(const TextFont* font) {
+    textFont = font;
+    textOwner = nullptr;
+}
+
+static inline void setColumn(uint16_t column, uint8_t bits) {
+    uint8_t mask = 0x80 >> (column % 8);
+    uint16_t index = column / 8;
+    for (uint8_t r = 0; r < FB_ROWS; r++) {
+        if (bits & (1 << r)) {
+            textRows[r][index] |= mask;
+        }
+    }
+}
+
+static inline uint8_t readColumn(uint16_t column) {
+    uint8_t mask = 0x80 >> (column % 8);
+    uint16_t index = column / 8;
+    uint8_t bits = 0;
+    for (uint8_t r = 0; r < FB_ROWS; r++) {
+        if (textRows[r][index] & mask) {
+            bits |= (1 << r);
+        }
+    }
+    return bits;
+}
+
+static uint8_t glyphIndex(char c) {
+    // Font hanya berisi karakter firstChar..firstChar+glyphCount-1,
+    // huruf kecil dipetakan ke huruf besar, karakter lain menjadi spasi.
+    if (c >= 'a' && c <= 'z') {
+        c -= 32;
+    }
+    uint8_t index = (uint8_t)c - textFont->firstChar;
+    return (index < textFont->glyphCount) ? index : (uint8_t)(' ' - textFont->firstChar);
+}
+
+// Raster teks sekali; owner menandai sumber teks (biasanya buffer teksnya)
+// sehingga displayScrollingText cukup membandingkan pointer setiap frame.
+void textrasterBuild(const char* text, const void* owner, uint8_t devices) {
+    memset(textRows, 0, sizeof(textRows));
+    textOwner = owner;
+    rasterStats.rasterizations++;
+    rasterStats.truncated = 0;
+
+    uint16_t window = (uint16_t)devices * 8;
+    // Sisakan tempat untuk jeda (satu layar) dan salinan awal teks
+    uint16_t limit = TEXT_MAX_COLUMNS - 2 * window;
+    uint16_t column = 0;
+
+    for (const char* p = text; textFont && *p; p++) {
+        uint8_t g = glyphIndex(*p);
+        uint8_t width = pgm_read_byte(&textFont->width[g]);
+        if (column + width > limit) {
+            rasterStats.truncated = strlen(p);
+            break;
+        }
+        const uint8_t* glyph = textFont->columns + pgm_read_word(&textFont->offset[g]);
+        for (uint8_t c = 0; c < width; c++) {
+            setColumn(column++, pgm_read_byte(&glyph[c]));
+        }
+        column += TEXT_GLYPH_SPACING;
+    }
+
+    rasterStats.columns = column;
+
+    // Teks keluar penuh dari layar sebelum muncul lagi dari kanan
+    cycleLength = column + window;
+
+    // Salin awal siklus ke belakang: jendela di posisi mana pun tidak perlu wrap
+    for (uint16_t c = 0; c < window; c++) {
+        setColumn(cycleLength + c, readColumn(c));
+    }
+}
+
+bool textrasterIsFor(const void* owner) {
+    return textOwner != nullptr && textOwner == owner;
+}
+
+void textrasterInvalidate() {
+    textOwner = nullptr;
+}
+
+uint16_t textrasterCycleLength() {
+    return cycleLength;
+}
+
+// ===== IMPLEMENTASI FUNGSI RENDER =====
+
+// Satu byte per modul per baris: dua byte bitmap digeser sesuai offset bit
+void textrasterRenderWindow(uint16_t position, uint8_t frame[][FB_ROWS], uint8_t devices) {
+    if (cycleLength) {
+        position %= cycleLength;
+    }
+    uint8_t shift = position % 8;
+
+    for (uint8_t r = 0; r < FB_ROWS; r++) {
+        const uint8_t* row = &textRows[r][position / 8];
+        for (uint8_t d = 0; d < devices; d++) {
+            frame[d][r] = shift ? (uint8_t)((row[d] << shift) | (row[d + 1] >> (8 - shift))) : row[d];
+        }
+    }
+    rasterStats.windows++;
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTIK =====
+
+const TextRasterStats* textrasterGetStats() {
+    return &rasterStats;
+}
@@ -0,0 +1,103 @@
+#ifndef TEXTRASTER_H
+#define TEXTRASTER_H
+
+#include "settings.h"
+#include "framebuffer.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// Build Information
+#define TEXTRASTER_VERSION "1.0.0"
+#define TEXTRASTER_BUILD_DATE "2026-10-17 14:20:05"
+#define TEXTRASTER_AUTHOR "Brodot23"
+
+// Bitmap teks: TEXT_MAX_COLUMNS kolom x 8 baris, disimpan per baris
+// (bit 7 byte pertama = kolom 0, sama dengan urutan bit baris MAX7219).
+// Kapasitas termasuk jeda di akhir teks dan salinan awal teks untuk wrap.
+#define TEXT_MAX_COLUMNS 1024
+#define TEXT_ROW_BYTES (TEXT_MAX_COLUMNS / 8 + 1)  // +1: jendela membaca satu byte lebih
+#define TEXT_GLYPH_SPACING 1        // Kolom kosong setelah setiap glyph
+#define TEXT_SPACE_WIDTH 3          // Lebar glyph kosong (spasi)
+
+// Font proporsional di PROGMEM. Glyph disimpan per kolom (bit 0 = baris atas),
+// kolom kosong kiri/kanan sudah dibuang saat compile.
+typedef struct {
+    uint8_t firstChar;
+    uint8_t glyphCount;
+    const uint16_t* offset;     // Offset kolom pertama setiap glyph
+    const uint8_t* width;       // Lebar setiap glyph (kolom)
+    const uint8_t* columns;
+} TextFont;
+
+// Rasterizer Statistics
+typedef struct {
+    uint32_t rasterizations;    // Teks yang di-raster ulang
+    uint32_t windows;           // Frame yang disalin dari bitmap
+    uint16_t columns;           // Panjang teks terakhir (kolom, tanpa jeda)
+    uint16_t truncated;         // Karakter yang tidak muat di bitmap (teks terakhir)
+} TextRasterStats;
+
+// Function Prototypes
+// Rasterization
+void textrasterSetFont(const TextFont* font);
+void textrasterBuild(const char* text, const void* owner, uint8_t devices);
+bool textrasterIsFor(const void* owner);
+void textrasterInvalidate();
+uint16_t textrasterCycleLength();
+
+// Rendering
+void textrasterRenderWindow(uint16_t position, uint8_t frame[][FB_ROWS], uint8_t devices);
+
+// Statistics
+const TextRasterStats* textrasterGetStats();
+
+// ===== FONT BUILDER (compile-time) =====
+// Font sumber [Count][8] per kolom; hasilnya hanya kolom yang terpakai.
+
+template<size_t Count, size_t Bytes>
+struct TextFontStorage {
+    uint16_t offset[Count];
+    uint8_t width[Count];
+    uint8_t columns[Bytes];
+};
+
+constexpr uint8_t textGlyphFirst(const uint8_t* glyph) {
+    uint8_t first = 0;
+    while (first < 8 && glyph[first] == 0) first++;
+    return first;
+}
+
+constexpr uint8_t textGlyphWidth(const uint8_t* glyph) {
+    uint8_t first = textGlyphFirst(glyph);
+    if (first == 8) return TEXT_SPACE_WIDTH;
+    uint8_t last = 7;
+    while (glyph[last] == 0) last--;
+    return last - first + 1;
+}
+
+template<size_t Count>
+constexpr size_t textFontSize(const uint8_t (&source)[Count][8]) {
+    size_t size = 0;
+    for (size_t g = 0; g < Count; g++) {
+        size += textGlyphWidth(source[g]);
+    }
+    return size;
+}
+
+template<size_t Bytes, size_t Count>
+constexpr TextFontStorage<Count, Bytes> textFontBuild(const uint8_t (&source)[Count][8]) {
+    TextFontStorage<Count, Bytes> storage = {};
+    size_t offset = 0;
+    for (size_t g = 0; g < Count; g++) {
+        uint8_t first = textGlyphFirst(source[g]);
+        uint8_t width = textGlyphWidth(source[g]);
+        storage.offset[g] = offset;
+        storage.width[g] = width;
+        for (uint8_t c = 0; c < width; c++) {
+            storage.columns[offset++] = (first < 8) ? source[g][first + c] : 0;
+        }
+    }
+    return storage;
+}
+
+#endif // TEXTRASTER_H
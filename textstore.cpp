@@ -0,0 +1,110 @@
+#include "textstore.h"
+#include "configstore.h"
+#include <Arduino.h>
+#include <FS.h>
+
+// Build Information
+#define TEXTSTORE_CPP_VERSION "1.0.0"
+#define TEXTSTORE_CPP_BUILD_DATE "2026-10-18 15:02:44"
+#define TEXTSTORE_CPP_AUTHOR "Brodot23"
+
+// Teks terakhir yang dibaca, supaya render dan JSON tidak membaca flash berulang
+static char cacheRef[TEXTSTORE_REF_HEADER + 1] = "";
+static char cacheText[TEXTSTORE_MAX_LENGTH + 1];
+
+static TextStoreStats textStats;
+
+// ===== IMPLEMENTASI FUNGSI FILE =====
+
+static void textstorePath(const char* stored, char* buffer, size_t size) {
+    snprintf(buffer, size, TEXTSTORE_DIR "/%.8s.txt", stored + 1);
+}
+
+static bool writeText(const char* path, const char* text, size_t length) {
+    if (SPIFFS.exists(path)) return true;
+
+    File file = SPIFFS.open(path, "w");
+    if (!file) return false;
+    bool ok = file.write((const uint8_t*)text, length) == length;
+    file.close();
+    if (!ok) {
+        SPIFFS.remove(path);
+        return false;
+    }
+    textStats.writes++;
+    return true;
+}
+
+// ===== IMPLEMENTASI FUNGSI STORAGE =====
+
+bool textstoreIsRef(const char* stored) {
+    return stored[0] == TEXTSTORE_REF_MARKER && strnlen(stored, TEXTSTORE_REF_HEADER) == TEXTSTORE_REF_HEADER;
+}
+
+uint8_t textstoreSet(char* stored, size_t size, const char* text) {
+    size_t length = strlen(text);
+    if (length < size) {
+        strlcpy(stored, text, size);
+        return TEXTSTORE_OK;
+    }
+    if (length > TEXTSTORE_MAX_LENGTH) {
+        return TEXTSTORE_ERR_TOO_LONG;
+    }
+
+    char ref[TEXTSTORE_REF_HEADER + 1];
+    snprintf(ref, sizeof(ref), "%c%08lX", TEXTSTORE_REF_MARKER,
+             (unsigned long)configstoreCrc32(0, text, length));
+    char path[TEXTSTORE_PATH_LENGTH];
+    textstorePath(ref, path, sizeof(path));
+    if (!writeText(path, text, length)) {
+        textStats.errors++;
+        return TEXTSTORE_ERR_WRITE;
+    }
+
+    // Referensi + awal teks (cadangan kalau file hilang)
+    memcpy(stored, ref, TEXTSTORE_REF_HEADER);
+    strlcpy(stored + TEXTSTORE_REF_HEADER, text, size - TEXTSTORE_REF_HEADER);
+    strlcpy(cacheRef, ref, sizeof(cacheRef));
+    strlcpy(cacheText, text, sizeof(cacheText));
+    return TEXTSTORE_OK;
+}
+
+void textstoreRemove(const char* stored) {
+    if (!textstoreIsRef(stored)) return;
+
+    char path[TEXTSTORE_PATH_LENGTH];
+    textstorePath(stored, path, sizeof(path));
+    if (SPIFFS.remove(path)) {
+        textStats.removes++;
+    }
+    if (!strncmp(cacheRef, stored, TEXTSTORE_REF_HEADER)) {
+        cacheRef[0] = '\0';
+    }
+}
+
+// ===== IMPLEMENTASI FUNGSI LOOKUP =====
+
+const char* textstoreResolve(const char* stored) {
+    if (!textstoreIsRef(stored)) return stored;
+    if (!strncmp(cacheRef, stored, TEXTSTORE_REF_HEADER)) return cacheText;
+
+    char path[TEXTSTORE_PATH_LENGTH];
+    textstorePath(stored, path, sizeof(path));
+    File file = SPIFFS.open(path, "r");
+    if (!file) {
+        textStats.errors++;
+        return stored + TEXTSTORE_REF_HEADER;
+    }
+    size_t length = file.read((uint8_t*)cacheText, TEXTSTORE_MAX_LENGTH);
+    file.close();
+    cacheText[length] = '\0';
+    strlcpy(cacheRef, stored, sizeof(cacheRef));
+    textStats.reads++;
+    return cacheText;
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTICS =====
+
+const TextStoreStats* textstoreGetStats() {
+    return &textStats;
+}
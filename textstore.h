@@ -0,0 +1,49 @@
+#ifndef TEXTSTORE_H
+#define TEXTSTORE_H
+
+#include "settings.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// Build Information
+#define TEXTSTORE_VERSION "1.0.0"
+#define TEXTSTORE_BUILD_DATE "2026-10-18 15:02:44"
+#define TEXTSTORE_AUTHOR "Brodot23"
+
+// Teks kustom yang tidak muat di settings.customText (MAX_TEXT_LENGTH) disimpan
+// utuh di SPIFFS TEXTSTORE_DIR "/<crc>.txt". Field setting hanya berisi referensi:
+//   [TEXTSTORE_REF_MARKER] [crc: 8 hex] [awal teks, dipotong]
+// Nama file = CRC isi, jadi preset dan record configstore yang menyimpan referensi
+// yang sama berbagi satu file. Kalau file hilang, awal teks tetap bisa ditampilkan.
+#define TEXTSTORE_DIR "/text"
+#define TEXTSTORE_MAX_LENGTH 255        // Teks terpanjang yang diterima (karakter)
+#define TEXTSTORE_REF_MARKER '\x01'
+#define TEXTSTORE_REF_HEADER 9          // Marker + 8 hex
+#define TEXTSTORE_PATH_LENGTH 24
+
+// Hasil textstoreSet
+#define TEXTSTORE_OK 0
+#define TEXTSTORE_ERR_TOO_LONG 1
+#define TEXTSTORE_ERR_WRITE 2
+
+// Store Statistics
+typedef struct {
+    uint32_t writes;            // File teks yang ditulis
+    uint32_t reads;             // File teks yang dibaca (cache miss)
+    uint32_t removes;           // File yang dihapus karena tidak dirujuk lagi
+    uint32_t errors;            // Gagal tulis / file referensi hilang
+} TextStoreStats;
+
+// Function Prototypes
+// Storage: stored = field setting (mis. settings.customText) sebesar size byte
+uint8_t textstoreSet(char* stored, size_t size, const char* text);
+bool textstoreIsRef(const char* stored);
+void textstoreRemove(const char* stored);
+
+// Lookup: teks lengkap, pointer berlaku sampai pemanggilan berikutnya
+const char* textstoreResolve(const char* stored);
+
+// Statistics
+const TextStoreStats* textstoreGetStats();
+
+#endif // TEXTSTORE_H
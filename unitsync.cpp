@@ -0,0 +1,392 @@
+#include "unitsync.h"
+#include <Arduino.h>
+#include <WiFiUdp.h>
+
+// Build Information
+#define UNITSYNC_CPP_VERSION "1.0.0"
+#define UNITSYNC_CPP_BUILD_DATE "2026-10-18 01:12:40"
+#define UNITSYNC_CPP_AUTHOR "Brodot23"
+
+typedef struct {
+    uint32_t unitId;
+    uint32_t lastSeen;          // millis() lokal saat paket terakhir diterima
+    uint16_t seq;
+    uint8_t inputs;
+    uint32_t origin[SYNC_GROUP_COUNT];  // Waktu bersama (time base master)
+} SyncPeer;
+
+static WiFiUDP udp;
+static bool syncActive = false;
+static uint32_t localId = 0;
+static IPAddress broadcastIp;
+
+// Jam bersama = millis() + clockOffset; clockSource = unit yang sampelnya dipakai
+static int32_t clockOffset = 0;
+static uint32_t clockSource = 0;
+static uint8_t clockLowSamples = 0;     // Sampel berturut-turut di bawah offset
+static int32_t clockLowMax = 0;         // Terbesar di antara sampel itu
+
+// State lokal yang di-broadcast; origin dalam millis() lokal supaya tidak ikut bergeser
+// saat offset dikoreksi
+static uint8_t localInputs = 0;
+static uint32_t localOrigin[SYNC_GROUP_COUNT];
+static uint16_t sequence = 0;
+static uint32_t lastBeacon = 0;
+static uint32_t lastRepeat = 0;
+static uint8_t repeatsLeft = 0;
+
+static SyncPeer peers[UNITSYNC_MAX_PEERS];
+static uint8_t peerCount = 0;
+
+// Hasil service sebelumnya, untuk SYNC_CHANGED_*
+static uint8_t lastRemote = 0;
+static bool lastPhaseValid[SYNC_GROUP_COUNT];
+static uint32_t lastPhaseOrigin[SYNC_GROUP_COUNT];
+
+static UnitSyncStats syncStats;
+
+// ===== IMPLEMENTASI FUNGSI PAKET =====
+
+static void putLe16(uint8_t* out, uint16_t value) {
+    out[0] = value;
+    out[1] = value >> 8;
+}
+
+static void putLe32(uint8_t* out, uint32_t value) {
+    out[0] = value;
+    out[1] = value >> 8;
+    out[2] = value >> 16;
+    out[3] = value >> 24;
+}
+
+static uint16_t getLe16(const uint8_t* in) {
+    return in[0] | (uint16_t)in[1] << 8;
+}
+
+static uint32_t getLe32(const uint8_t* in) {
+    return in[0] | (uint32_t)in[1] << 8 | (uint32_t)in[2] << 16 | (uint32_t)in[3] << 24;
+}
+
+static uint8_t groupInputs(uint8_t group) {
+    return group == SYNC_GROUP_BRAKE ? SYNC_INPUT_BRAKE
+                                     : SYNC_INPUT_SEIN_LEFT | SYNC_INPUT_SEIN_RIGHT | SYNC_INPUT_HAZARD;
+}
+
+static void sendState(uint8_t flags) {
+    uint8_t packet[UNITSYNC_PACKET_SIZE];
+    packet[0] = 'S';
+    packet[1] = 'Y';
+    packet[2] = UNITSYNC_PROTOCOL;
+    packet[3] = flags;
+    putLe32(packet + 4, localId);
+    putLe16(packet + 8, sequence);
+    packet[10] = localInputs;
+    packet[11] = 0;
+    putLe32(packet + 12, unitsyncNow());
+    for (uint8_t g = 0; g < SYNC_GROUP_COUNT; g++) {
+        uint32_t origin = (localInputs & groupInputs(g)) ? localOrigin[g] + clockOffset : 0;
+        putLe32(packet + 16 + g * 4, origin);
+    }
+
+    if (udp.beginPacket(broadcastIp, UNITSYNC_PORT) &&
+        udp.write(packet, sizeof(packet)) == sizeof(packet) &&
+        udp.endPacket()) {
+        syncStats.sent++;
+    } else {
+        syncStats.sendErrors++;
+    }
+}
+
+// ===== IMPLEMENTASI FUNGSI PEER =====
+
+static uint32_t masterId() {
+    uint32_t id = localId;
+    for (uint8_t i = 0; i < peerCount; i++) {
+        if (peers[i].unitId < id) id = peers[i].unitId;
+    }
+    return id;
+}
+
+static SyncPeer* findPeer(uint32_t unitId, bool* isNew) {
+    *isNew = false;
+    for (uint8_t i = 0; i < peerCount; i++) {
+        if (peers[i].unitId == unitId) return &peers[i];
+    }
+    if (peerCount >= UNITSYNC_MAX_PEERS) return NULL;
+
+    SyncPeer* peer = &peers[peerCount++];
+    memset(peer, 0, sizeof(SyncPeer));
+    peer->unitId = unitId;
+    *isNew = true;
+    return peer;
+}
+
+static void expirePeers(uint32_t now) {
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < peerCount; i++) {
+        if (now - peers[i].lastSeen <= UNITSYNC_PEER_TIMEOUT_MS) {
+            peers[kept++] = peers[i];
+        }
+    }
+    peerCount = kept;
+}
+
+// Sampel terbesar = delay jaringan terkecil. Sampel yang lebih kecil baru menurunkan
+// offset kalau berulang beberapa kali (drift): jitter WiFi dan pembulatan millis()
+// hanya sesekali, jadi tidak menggeser jam.
+static void sampleClock(uint32_t unitId, uint32_t syncTime, uint32_t now) {
+    int32_t candidate = (int32_t)(syncTime - now);
+    int32_t error = candidate - clockOffset;
+
+    if (unitId != clockSource || error < -UNITSYNC_RESYNC_MS || error > UNITSYNC_RESYNC_MS) {
+        clockSource = unitId;
+        clockOffset = candidate;
+        clockLowSamples = 0;
+        syncStats.resyncs++;
+        return;
+    }
+    if (error >= 0) {
+        clockOffset = candidate;
+        clockLowSamples = 0;
+        return;
+    }
+    if (clockLowSamples == 0 || candidate > clockLowMax) {
+        clockLowMax = candidate;
+    }
+    if (++clockLowSamples >= UNITSYNC_SLEW_SAMPLES) {
+        clockOffset = clockLowMax;
+        clockLowSamples = 0;
+    }
+}
+
+static void receivePacket(const uint8_t* packet, int length) {
+    if (length != UNITSYNC_PACKET_SIZE || packet[0] != 'S' || packet[1] != 'Y' ||
+        packet[2] != UNITSYNC_PROTOCOL) {
+        syncStats.rejected++;
+        return;
+    }
+
+    uint32_t unitId = getLe32(packet + 4);
+    if (unitId == localId) {
+        return;     // Broadcast sendiri
+    }
+
+    bool isNew;
+    SyncPeer* peer = findPeer(unitId, &isNew);
+    if (!peer) {
+        syncStats.rejected++;
+        return;
+    }
+
+    // Kiriman ulang memakai seq yang sama; unit yang restart sudah kedaluwarsa lebih dulu
+    uint16_t seq = getLe16(packet + 8);
+    if (!isNew && (int16_t)(seq - peer->seq) <= 0) {
+        syncStats.duplicates++;
+        return;
+    }
+
+    uint32_t now = millis();
+    uint32_t syncTime = getLe32(packet + 12);
+    peer->seq = seq;
+    peer->lastSeen = now;
+    peer->inputs = packet[10] & SYNC_INPUT_MASK;
+    for (uint8_t g = 0; g < SYNC_GROUP_COUNT; g++) {
+        peer->origin[g] = getLe32(packet + 16 + g * 4);
+    }
+    syncStats.received++;
+
+    if (unitId == masterId()) {
+        sampleClock(unitId, syncTime, now);
+    }
+
+    if (packet[3] & SYNC_FLAG_CHANGE) {
+        int32_t latency = (int32_t)(unitsyncNow() - syncTime);
+        syncStats.lastLatency = latency > 0 ? latency : 0;
+        if (syncStats.lastLatency > syncStats.maxLatency) {
+            syncStats.maxLatency = syncStats.lastLatency;
+        }
+    }
+}
+
+// ===== IMPLEMENTASI FUNGSI INISIALISASI =====
+
+bool unitsyncBegin(uint32_t unitId, IPAddress broadcast) {
+    if (!udp.begin(UNITSYNC_PORT)) {
+        syncActive = false;
+        return false;
+    }
+
+    localId = unitId;
+    broadcastIp = broadcast;
+    clockOffset = 0;
+    clockSource = unitId;
+    clockLowSamples = 0;
+    localInputs = 0;
+    sequence = 0;
+    repeatsLeft = 0;
+    peerCount = 0;
+    lastRemote = 0;
+    for (uint8_t g = 0; g < SYNC_GROUP_COUNT; g++) {
+        lastPhaseValid[g] = false;
+    }
+    memset(&syncStats, 0, sizeof(syncStats));
+    syncStats.masterId = unitId;
+
+    // Beacon pertama pada service berikutnya: unit lain langsung tahu ada unit baru
+    lastBeacon = millis() - UNITSYNC_BEACON_MS;
+    syncActive = true;
+    return true;
+}
+
+void unitsyncStop() {
+    if (syncActive) {
+        udp.stop();
+    }
+    syncActive = false;
+    peerCount = 0;
+    lastRemote = 0;
+}
+
+bool unitsyncActive() {
+    return syncActive;
+}
+
+// ===== IMPLEMENTASI FUNGSI TIME BASE =====
+
+uint32_t unitsyncNow() {
+    return millis() + clockOffset;
+}
+
+bool unitsyncIsMaster() {
+    return masterId() == localId;
+}
+
+// ===== IMPLEMENTASI FUNGSI STATE =====
+
+void unitsyncPublish(uint8_t inputs) {
+    inputs &= SYNC_INPUT_MASK;
+    if (!syncActive || inputs == localInputs) return;
+
+    uint32_t now = millis();
+    for (uint8_t g = 0; g < SYNC_GROUP_COUNT; g++) {
+        if ((inputs & groupInputs(g)) && !(localInputs & groupInputs(g))) {
+            // Grup sudah aktif di unit lain: ikut episode yang berjalan, bukan mulai baru
+            if (!unitsyncPhaseOrigin(g, &localOrigin[g])) {
+                localOrigin[g] = now;
+            }
+        }
+    }
+    localInputs = inputs;
+
+    // Dikirim sekarang, bukan menunggu beacon: unit lain menerima sebelum frame berikutnya
+    sequence++;
+    sendState(SYNC_FLAG_CHANGE);
+    repeatsLeft = UNITSYNC_REPEAT_COUNT;
+    lastRepeat = now;
+    lastBeacon = now;
+}
+
+uint8_t unitsyncService() {
+    if (!syncActive) return 0;
+
+    uint8_t packet[UNITSYNC_PACKET_SIZE + 1];   // +1: paket yang terlalu panjang terdeteksi
+    while (udp.parsePacket() > 0) {
+        receivePacket(packet, udp.read(packet, sizeof(packet)));
+    }
+
+    uint32_t now = millis();
+    expirePeers(now);
+    if (masterId() == localId) {
+        clockSource = localId;  // Offset dibekukan: jam bersama tetap kontinu saat master hilang
+    }
+
+    if (repeatsLeft && now - lastRepeat >= UNITSYNC_REPEAT_MS) {
+        repeatsLeft--;
+        lastRepeat = now;
+        sendState(SYNC_FLAG_CHANGE);
+    }
+    if (now - lastBeacon >= UNITSYNC_BEACON_MS) {
+        lastBeacon = now;
+        sequence++;
+        sendState(0);
+    }
+
+    syncStats.masterId = masterId();
+    syncStats.offset = clockOffset;
+
+    // Origin lokal ikut yang paling awal, supaya fase tidak bergeser saat unit itu
+    // melepas grup sementara unit lain masih menahannya (mis. hazard dilepas bertahap)
+    for (uint8_t g = 0; g < SYNC_GROUP_COUNT; g++) {
+        uint32_t origin = 0;
+        if ((localInputs & groupInputs(g)) && unitsyncPhaseOrigin(g, &origin)) {
+            localOrigin[g] = origin;
+        }
+    }
+
+    uint8_t changed = 0;
+    uint8_t remote = unitsyncRemoteInputs();
+    if (remote != lastRemote) {
+        lastRemote = remote;
+        changed |= SYNC_CHANGED_INPUTS;
+    }
+    for (uint8_t g = 0; g < SYNC_GROUP_COUNT; g++) {
+        uint32_t origin = 0;
+        bool valid = unitsyncPhaseOrigin(g, &origin);
+        if (valid != lastPhaseValid[g] || (valid && origin != lastPhaseOrigin[g])) {
+            lastPhaseValid[g] = valid;
+            lastPhaseOrigin[g] = origin;
+            changed |= SYNC_CHANGED_PHASE;
+        }
+    }
+    return changed;
+}
+
+uint8_t unitsyncRemoteInputs() {
+    uint8_t inputs = 0;
+    for (uint8_t i = 0; i < peerCount; i++) {
+        inputs |= peers[i].inputs;
+    }
+    return inputs;
+}
+
+// Origin grup paling awal di antara unit yang grupnya aktif, dalam millis() lokal.
+// false jika sendirian (animasi berjalan dari input lokal seperti tanpa sync).
+bool unitsyncPhaseOrigin(uint8_t group, uint32_t* localMillis) {
+    if (!syncActive || peerCount == 0 || group >= SYNC_GROUP_COUNT) return false;
+
+    uint8_t mask = groupInputs(group);
+    bool found = false;
+    uint32_t earliest = 0;
+    if (localInputs & mask) {
+        earliest = localOrigin[group];
+        found = true;
+    }
+    for (uint8_t i = 0; i < peerCount; i++) {
+        if (!(peers[i].inputs & mask)) continue;
+        uint32_t origin = peers[i].origin[group] - clockOffset;
+        if (!found || (int32_t)(origin - earliest) < 0) {
+            earliest = origin;
+            found = true;
+        }
+    }
+    if (found) {
+        *localMillis = earliest;
+    }
+    return found;
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTICS =====
+
+const UnitSyncStats* unitsyncGetStats() {
+    return &syncStats;
+}
+
+uint8_t unitsyncGetPeers(UnitSyncPeer* out) {
+    uint32_t now = millis();
+    for (uint8_t i = 0; i < peerCount; i++) {
+        out[i].unitId = peers[i].unitId;
+        out[i].age = now - peers[i].lastSeen;
+        out[i].inputs = peers[i].inputs;
+    }
+    return peerCount;
+}
@@ -0,0 +1,105 @@
+#ifndef UNITSYNC_H
+#define UNITSYNC_H
+
+#include "settings.h"
+#include <ESP8266WiFi.h>
+#include <stdint.h>
+
+// Build Information
+#define UNITSYNC_VERSION "1.0.0"
+#define UNITSYNC_BUILD_DATE "2026-10-18 01:12:40"
+#define UNITSYNC_AUTHOR "Brodot23"
+
+// Sinkronisasi beberapa unit di satu kendaraan (lampu kiri, kanan, rem atas) lewat UDP
+// broadcast di jaringan soft-AP unit host. Setiap unit mengirim level input lokalnya
+// segera saat berubah dan setiap UNITSYNC_BEACON_MS; input unit lain di-OR dengan input
+// lokal, jadi rem/sein di satu unit menyalakan semua unit.
+//
+// Time base: unit dengan ID terkecil yang masih terdengar menjadi master, unit lain
+// menyetel offset sehingga unitsyncNow() = millis() master. Estimasi offset mengambil
+// sampel terbesar (delay jaringan terkecil); baru turun setelah UNITSYNC_SLEW_SAMPLES
+// sampel berturut-turut lebih kecil (drift kristal), ke sampel terbesar di antaranya.
+// Lompatan besar (master berganti) langsung diterima.
+//
+// Fase: untuk setiap grup (rem, sein) origin = waktu bersama saat grup mulai aktif di
+// unit yang paling dulu. Sketch menghitung langkah animasi dan deadline berikutnya dari
+// origin itu, sehingga semua unit berkedip pada batas periode yang sama.
+//
+// Paket (little endian, UNITSYNC_PACKET_SIZE byte):
+//   0  "SY", version, flags (SYNC_FLAG_*)
+//   4  unitId (u32, ESP.getChipId())
+//   8  seq (u16), inputs (SYNC_INPUT_*), reserved
+//   12 syncTime (u32): unitsyncNow() pengirim saat paket dikirim
+//   16 origin per grup (u32 x SYNC_GROUP_COUNT), hanya berarti jika grup aktif
+#define UNITSYNC_PORT 4210
+#define UNITSYNC_PROTOCOL 1
+#define UNITSYNC_PACKET_SIZE 24
+#define UNITSYNC_MAX_PEERS 4
+#define UNITSYNC_BEACON_MS 250          // State + jam dikirim ulang walau tidak berubah
+#define UNITSYNC_PEER_TIMEOUT_MS 1000   // Unit hilang: input-nya dilepas, master dipilih ulang
+#define UNITSYNC_REPEAT_MS 15           // Broadcast WiFi tanpa ACK: perubahan state dikirim ulang
+#define UNITSYNC_REPEAT_COUNT 2
+#define UNITSYNC_RESYNC_MS 50           // Sampel sejauh ini dari offset = master berganti
+#define UNITSYNC_SLEW_SAMPLES 4         // Sampel berturut-turut di bawah offset sebelum offset diturunkan
+
+// Input Bits (sama dengan INPUT_EDGE_* untuk channel fisik)
+#define SYNC_INPUT_BRAKE 0x01
+#define SYNC_INPUT_SEIN_LEFT 0x02
+#define SYNC_INPUT_SEIN_RIGHT 0x04
+#define SYNC_INPUT_HAZARD 0x08          // Hazard otomatis dari hard brake
+#define SYNC_INPUT_MASK 0x0F
+
+// Phase Groups
+#define SYNC_GROUP_BRAKE 0
+#define SYNC_GROUP_SEIN 1
+#define SYNC_GROUP_COUNT 2
+
+// Packet Flags
+#define SYNC_FLAG_CHANGE 0x01           // Dikirim karena state berubah (bukan beacon)
+
+// Hasil unitsyncService()
+#define SYNC_CHANGED_INPUTS 0x01        // unitsyncRemoteInputs() berubah
+#define SYNC_CHANGED_PHASE 0x02         // Offset jam atau origin grup berubah
+
+// Sync Statistics
+typedef struct {
+    uint32_t sent;
+    uint32_t received;
+    uint32_t rejected;          // Magic/versi/ukuran salah
+    uint32_t duplicates;        // Seq lama (kiriman ulang yang sudah diterima)
+    uint32_t sendErrors;
+    uint32_t resyncs;           // Offset diganti langsung (master baru / lompatan besar)
+    uint32_t masterId;
+    int32_t offset;             // unitsyncNow() - millis()
+    uint32_t lastLatency;       // Perubahan state unit lain: waktu terima - waktu kirim (ms)
+    uint32_t maxLatency;
+} UnitSyncStats;
+
+// Peer Info (untuk /status)
+typedef struct {
+    uint32_t unitId;
+    uint32_t age;               // ms sejak paket terakhir
+    uint8_t inputs;
+} UnitSyncPeer;
+
+// Function Prototypes
+// Initialization
+bool unitsyncBegin(uint32_t unitId, IPAddress broadcast);
+void unitsyncStop();
+bool unitsyncActive();
+
+// Time Base
+uint32_t unitsyncNow();
+bool unitsyncIsMaster();
+
+// State
+void unitsyncPublish(uint8_t inputs);           // SYNC_INPUT_* lokal, dikirim segera saat berubah
+uint8_t unitsyncService();                      // Terima paket, beacon, kirim ulang: SYNC_CHANGED_*
+uint8_t unitsyncRemoteInputs();                 // OR input semua unit lain yang masih terdengar
+bool unitsyncPhaseOrigin(uint8_t group, uint32_t* localMillis);
+
+// Statistics
+const UnitSyncStats* unitsyncGetStats();
+uint8_t unitsyncGetPeers(UnitSyncPeer* peers);
+
+#endif // UNITSYNC_H
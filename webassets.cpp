@@ -0,0 +1,142 @@
+#include "webassets.h"
+#include "settings.h"
+#include <Arduino.h>
+#include <FS.h>
+
+// Build Information
+#define WEBASSETS_CPP_VERSION "1.0.0"
+#define WEBASSETS_CPP_BUILD_DATE "2026-10-17 18:41:09"
+#define WEBASSETS_CPP_AUTHOR "Brodot23"
+
+static WebAsset assets[WEBASSETS_MAX];
+static uint8_t assetCount = 0;
+
+// ===== IMPLEMENTASI FUNGSI MANIFEST =====
+
+static uint32_t readLe32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// String di record selalu diakhiri NUL oleh tool; dipaksa lagi supaya file rusak tidak overflow
+static void copyField(char* out, const uint8_t* field, size_t size) {
+    memcpy(out, field, size);
+    out[size - 1] = '\0';
+}
+
+static bool loadManifest() {
+    assetCount = 0;
+    File file = SPIFFS.open(WEBASSETS_MANIFEST, "r");
+    if (!file) return false;
+
+    uint8_t header[WEBASSETS_HEADER_SIZE];
+    if (file.read(header, sizeof(header)) != sizeof(header) ||
+        memcmp(header, WEBASSETS_MAGIC, 4) != 0 || header[4] != WEBASSETS_FORMAT_VERSION) {
+        file.close();
+        return false;
+    }
+
+    uint8_t count = (header[5] < WEBASSETS_MAX) ? header[5] : WEBASSETS_MAX;
+    uint8_t record[WEBASSETS_RECORD_SIZE];
+    for (uint8_t i = 0; i < count; i++) {
+        if (file.read(record, sizeof(record)) != sizeof(record)) break;
+
+        WebAsset* asset = &assets[assetCount];
+        memset(asset, 0, sizeof(WebAsset));
+        const uint8_t* p = record;
+        copyField(asset->uri, p, WEBASSETS_URI_LENGTH);
+        p += WEBASSETS_URI_LENGTH;
+        copyField(asset->path, p, WEBASSETS_PATH_LENGTH);
+        p += WEBASSETS_PATH_LENGTH;
+        copyField(asset->type, p, WEBASSETS_TYPE_LENGTH);
+        p += WEBASSETS_TYPE_LENGTH;
+        asset->hash = readLe32(p);
+        asset->rawSize = readLe32(p + 4);
+        asset->gzipSize = readLe32(p + 8);
+
+        if (asset->uri[0] == '/' && SPIFFS.exists(asset->path)) {
+            assetCount++;
+        }
+    }
+    file.close();
+    return assetCount > 0;
+}
+
+// ===== IMPLEMENTASI FUNGSI SERVING =====
+
+static void formatEtag(const WebAsset* asset, char* out, size_t size) {
+    snprintf(out, size, "\"%08lx\"", (unsigned long)asset->hash);
+}
+
+static void sendAsset(ESP8266WebServer& server, WebAsset* asset, bool immutable) {
+    char etag[12];
+    formatEtag(asset, etag, sizeof(etag));
+
+    // If-None-Match dikumpulkan oleh webjsonBegin()
+    if (server.hasHeader("If-None-Match") && server.header("If-None-Match").indexOf(etag) >= 0) {
+        server.sendHeader("ETag", etag);
+        server.send(304);
+        asset->notModified++;
+        return;
+    }
+
+    File file = SPIFFS.open(asset->path, "r");
+    if (!file) {
+        server.send(404, "text/plain", "File not found");
+        return;
+    }
+
+    server.sendHeader("Cache-Control", immutable ? WEBASSETS_CACHE_IMMUTABLE : WEBASSETS_CACHE_REVALIDATE);
+    server.sendHeader("ETag", etag);
+
+    // streamFile() menambahkan Content-Encoding: gzip untuk nama file .gz
+    uint32_t start = micros();
+    size_t sent = server.streamFile(file, asset->type);
+    uint32_t elapsed = micros() - start;
+    file.close();
+
+    asset->requests++;
+    asset->bytes += sent;
+    asset->lastMicros = elapsed;
+    if (elapsed > asset->maxMicros) {
+        asset->maxMicros = elapsed;
+    }
+}
+
+// ===== IMPLEMENTASI FUNGSI INISIALISASI =====
+
+// Dipanggil sebelum route lain didaftarkan: route asset ("/" termasuk) menang atas handler lama
+bool webassetsBegin(ESP8266WebServer& server) {
+    if (!loadManifest()) return false;
+
+    for (uint8_t i = 0; i < assetCount; i++) {
+        WebAsset* asset = &assets[i];
+        server.on(asset->uri, HTTP_GET, [&server, asset]() { sendAsset(server, asset, false); });
+
+        char hashed[WEBASSETS_PATH_LENGTH];
+        strlcpy(hashed, asset->path, strlen(asset->path) - 2);
+        server.on(hashed, HTTP_GET, [&server, asset]() { sendAsset(server, asset, true); });
+    }
+    return true;
+}
+
+// ===== IMPLEMENTASI FUNGSI QUERY =====
+
+uint8_t webassetsCount() {
+    return assetCount;
+}
+
+const WebAsset* webassetsGet(uint8_t index) {
+    return index < assetCount ? &assets[index] : NULL;
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTIK =====
+
+void webassetsResetStats() {
+    for (uint8_t i = 0; i < assetCount; i++) {
+        assets[i].requests = 0;
+        assets[i].notModified = 0;
+        assets[i].bytes = 0;
+        assets[i].lastMicros = 0;
+        assets[i].maxMicros = 0;
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef WEBASSETS_H
+#define WEBASSETS_H
+
+#include "settings.h"
+#include <ESP8266WebServer.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Build Information
+#define WEBASSETS_VERSION "1.0.0"
+#define WEBASSETS_BUILD_DATE "2026-10-17 18:41:09"
+#define WEBASSETS_AUTHOR "Brodot23"
+
+// Bundle web di SPIFFS, dibuat oleh sim/assets.cpp (make -C sim assets -> data/):
+//   WEBASSETS_DIR "/<nama>.<hash>.<ext>.gz"   isi gzip, nama berisi hash isi asli
+//   WEBASSETS_MANIFEST                         indeks, format little endian:
+//     0  magic "SAST"
+//     4  version (WEBASSETS_FORMAT_VERSION)
+//     5  count
+//     6  reserved uint16
+//     8  count x record WEBASSETS_RECORD_SIZE byte:
+//        uri[24]   URI logis, mis. "/script.js" ("/" untuk index.html)
+//        path[32]  file gzip; URI ber-hash = path tanpa ".gz"
+//        type[24]  Content-Type
+//        hash, rawSize, gzipSize  uint32
+// URI ber-hash dikirim dengan cache immutable setahun, URI logis dengan ETag = hash
+// dan no-cache (revalidasi murah, 304 tanpa body).
+#define WEBASSETS_MAGIC "SAST"
+#define WEBASSETS_FORMAT_VERSION 1
+#define WEBASSETS_HEADER_SIZE 8
+#define WEBASSETS_DIR "/w"
+#define WEBASSETS_MANIFEST "/w/assets.idx"
+#define WEBASSETS_MAX 6
+#define WEBASSETS_URI_LENGTH 24
+#define WEBASSETS_PATH_LENGTH 32
+#define WEBASSETS_TYPE_LENGTH 24
+#define WEBASSETS_RECORD_SIZE (WEBASSETS_URI_LENGTH + WEBASSETS_PATH_LENGTH + WEBASSETS_TYPE_LENGTH + 12)
+#define WEBASSETS_CACHE_IMMUTABLE "public, max-age=31536000, immutable"
+#define WEBASSETS_CACHE_REVALIDATE "no-cache"
+
+// Asset Entry (+ statistik transfer)
+typedef struct {
+    char uri[WEBASSETS_URI_LENGTH];
+    char path[WEBASSETS_PATH_LENGTH];
+    char type[WEBASSETS_TYPE_LENGTH];
+    uint32_t hash;
+    uint32_t rawSize;
+    uint32_t gzipSize;
+
+    uint32_t requests;          // Body dikirim
+    uint32_t notModified;       // 304 lewat If-None-Match
+    uint32_t bytes;             // Byte gzip yang dikirim
+    uint32_t lastMicros;        // Waktu streamFile() terakhir (handleClient tertahan)
+    uint32_t maxMicros;
+} WebAsset;
+
+// Function Prototypes
+// Initialization: baca manifest dan daftarkan route URI logis + ber-hash,
+// false = bundle tidak ada (handleRoot kembali mengirim /index.html mentah)
+bool webassetsBegin(ESP8266WebServer& server);
+
+// Query
+uint8_t webassetsCount();
+const WebAsset* webassetsGet(uint8_t index);
+
+// Statistics
+void webassetsResetStats();
+
+#endif // WEBASSETS_H
@@ -0,0 +1,146 @@
+#include "webjson.h"
+#include "settings.h"
+#include <Arduino.h>
+
+// Build Information
+#define WEBJSON_CPP_VERSION "1.0.0"
+#define WEBJSON_CPP_BUILD_DATE "2026-10-17 18:05:41"
+#define WEBJSON_CPP_AUTHOR "Brodot23"
+
+#define FNV_OFFSET_BASIS 2166136261UL
+#define FNV_PRIME 16777619UL
+
+static WebJsonStats webStats;
+
+// Print yang hanya menghitung hash dan panjang: satu pass untuk ETag dan Content-Length
+class HashPrint : public Print {
+public:
+    uint32_t hash = FNV_OFFSET_BASIS;
+    size_t length = 0;
+
+    size_t write(uint8_t c) override {
+        hash = (hash ^ c) * FNV_PRIME;
+        length++;
+        return 1;
+    }
+};
+
+// Print yang mengumpulkan byte di stack dan mengirimnya per WEBJSON_CHUNK_SIZE
+class ChunkPrint : public Print {
+public:
+    explicit ChunkPrint(ESP8266WebServer& server) : server(server) {}
+
+    size_t write(uint8_t c) override {
+        buffer[used++] = c;
+        if (used == WEBJSON_CHUNK_SIZE) {
+            flush();
+        }
+        return 1;
+    }
+
+    void flush() override {
+        if (used == 0) return;
+        server.sendContent((const char*)buffer, used);
+        webStats.chunks++;
+        used = 0;
+    }
+
+private:
+    ESP8266WebServer& server;
+    uint8_t buffer[WEBJSON_CHUNK_SIZE];
+    size_t used = 0;
+};
+
+// ===== IMPLEMENTASI FUNGSI INISIALISASI =====
+
+void webjsonBegin(ESP8266WebServer& server) {
+    static const char* headerKeys[] = { "If-None-Match" };
+    server.collectHeaders(headerKeys, 1);
+    webjsonResetStats();
+}
+
+// ===== IMPLEMENTASI FUNGSI ETAG =====
+
+uint32_t webjsonHash(const JsonDocument& doc, size_t* length) {
+    HashPrint hasher;
+    serializeJson(doc, hasher);
+    if (length) {
+        *length = hasher.length;
+    }
+    return hasher.hash;
+}
+
+void webjsonFormatEtag(uint32_t hash, char* out) {
+    snprintf(out, WEBJSON_ETAG_LENGTH, "\"%08lx\"", (unsigned long)hash);
+}
+
+// ===== IMPLEMENTASI FUNGSI RESPONSE =====
+
+// If-None-Match boleh berisi beberapa tag atau "*"; cocok = 304 tanpa body
+bool webjsonNotModified(ESP8266WebServer& server, const char* etag) {
+    if (!etag || !server.hasHeader("If-None-Match")) return false;
+
+    String match = server.header("If-None-Match");
+    if (match != "*" && match.indexOf(etag) < 0) return false;
+
+    server.sendHeader("ETag", etag);
+    server.send(304);
+    webStats.notModified++;
+    return true;
+}
+
+static void streamDocument(ESP8266WebServer& server, int code, const JsonDocument& doc,
+                           const char* etag, size_t length) {
+    if (etag) {
+        server.sendHeader("ETag", etag);
+        // Browser selalu revalidasi, 304 cukup murah
+        server.sendHeader("Cache-Control", "no-cache");
+    }
+    server.setContentLength(length);
+    server.send(code, "application/json", "");
+
+    webStats.chunks = 0;
+    ChunkPrint out(server);
+    serializeJson(doc, out);
+    out.flush();
+
+    webStats.responses++;
+    webStats.bytes += length;
+}
+
+void webjsonSend(ESP8266WebServer& server, int code, const JsonDocument& doc, const char* etag) {
+    streamDocument(server, code, doc, etag, measureJson(doc));
+}
+
+// GET dengan ETag: hash dihitung sekali, dokumen hanya dikirim kalau berbeda dari cache klien
+void webjsonSendCached(ESP8266WebServer& server, const JsonDocument& doc) {
+    char etag[WEBJSON_ETAG_LENGTH];
+    size_t length;
+    webjsonFormatEtag(webjsonHash(doc, &length), etag);
+    if (webjsonNotModified(server, etag)) return;
+    streamDocument(server, 200, doc, etag, length);
+}
+
+// Teks non-JSON (/metrics): panjang tidak diketahui di depan, jadi chunked transfer
+void webjsonSendStream(ESP8266WebServer& server, int code, const char* contentType, WebStreamWriter writer) {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(code, contentType, "");
+
+    webStats.chunks = 0;
+    ChunkPrint out(server);
+    writer(out);
+    out.flush();
+    server.sendContent("");
+
+    webStats.responses++;
+}
+
+// ===== IMPLEMENTASI FUNGSI STATISTIK =====
+
+const WebJsonStats* webjsonGetStats() {
+    return &webStats;
+}
+
+void webjsonResetStats() {
+    memset(&webStats, 0, sizeof(webStats));
+}
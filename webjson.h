@@ -0,0 +1,49 @@
+#ifndef WEBJSON_H
+#define WEBJSON_H
+
+#include "settings.h"
+#include <ESP8266WebServer.h>
+#include <ArduinoJson.h>
+#include <stdint.h>
+
+// Build Information
+#define WEBJSON_VERSION "1.0.0"
+#define WEBJSON_BUILD_DATE "2026-10-17 18:05:41"
+#define WEBJSON_AUTHOR "Brodot23"
+
+// Streaming JSON Configuration
+// Dokumen diserialisasi langsung ke socket lewat buffer stack, tanpa String di heap.
+// ETag = FNV-1a 32-bit dari byte JSON yang dikirim, jadi berubah tepat saat isinya berubah.
+#define WEBJSON_CHUNK_SIZE 256
+#define WEBJSON_ETAG_LENGTH 11      // "xxxxxxxx" dengan tanda kutip + NUL
+
+// Penulis body untuk webjsonSendStream()
+typedef void (*WebStreamWriter)(Print& out);
+
+// Response Statistics
+typedef struct {
+    uint32_t responses;         // Dokumen yang di-stream
+    uint32_t notModified;       // 304 karena If-None-Match cocok
+    uint32_t bytes;             // Byte body JSON yang dikirim
+    uint16_t chunks;            // sendContent() pada respons terakhir
+} WebJsonStats;
+
+// Function Prototypes
+// Initialization (mendaftarkan header If-None-Match ke server)
+void webjsonBegin(ESP8266WebServer& server);
+
+// ETag
+uint32_t webjsonHash(const JsonDocument& doc, size_t* length = NULL);
+void webjsonFormatEtag(uint32_t hash, char* out);
+
+// Response
+bool webjsonNotModified(ESP8266WebServer& server, const char* etag);
+void webjsonSend(ESP8266WebServer& server, int code, const JsonDocument& doc, const char* etag = NULL);
+void webjsonSendCached(ESP8266WebServer& server, const JsonDocument& doc);
+void webjsonSendStream(ESP8266WebServer& server, int code, const char* contentType, WebStreamWriter writer);
+
+// Statistics
+const WebJsonStats* webjsonGetStats();
+void webjsonResetStats();
+
+#endif // WEBJSON_H
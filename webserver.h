@@ -162,7 +162,7 @@ namespace APIHandlers {
     // Pattern Control
     void getCurrentPattern();
     void setPatternMode();
-    void uploadCustomPattern();
+    void uploadCustomPattern();     // POST /api/patterns: handlePatternUpload di sketch, stream ke flash lewat animupload.h
     
     // Configuration
     void getConfiguration();